@@ -32,6 +32,8 @@ namespace rexx {
 
 		int64_t begin_time = utils::Timestamp::HighResolution();
 		const Json::Value &json_items = body["items"];
+		std::vector<Result> item_results;
+		std::vector<TransactionFrm::pointer> item_txs;
 		for (size_t j = 0; j < json_items.size() && running; j++) {
 			const Json::Value &json_item = json_items[j];
 			Json::Value &result_item = results[results.size()];
@@ -42,6 +44,7 @@ namespace rexx {
 			result.set_desc("");
 
 			protocol::TransactionEnv tran_env;
+			TransactionFrm::pointer ptr;
 			do {
 				if (json_item.isMember("transaction_blob")) {
 					if (!json_item.isMember("signatures")) {
@@ -125,15 +128,32 @@ namespace rexx {
 					result_item["hash"] = utils::String::BinToHexString(HashWrapper::Crypto(content));
 				}
 
-				TransactionFrm::pointer ptr = std::make_shared<TransactionFrm>(tran_env);
+				//Signatures are verified in batch below
+				ptr = std::make_shared<TransactionFrm>(tran_env, false);
+			} while (false);
+
+			item_results.push_back(result);
+			item_txs.push_back(ptr);
+		}
+
+		std::vector<TransactionFrm::pointer> verify_txs;
+		for (size_t j = 0; j < item_txs.size(); j++) {
+			if (item_txs[j]) verify_txs.push_back(item_txs[j]);
+		}
+		TransactionFrm::VerifySignatures(verify_txs, false);
+
+		for (size_t j = 0; j < item_txs.size(); j++) {
+			Json::Value &result_item = results[(Json::UInt)j];
+			Result &result = item_results[j];
+			TransactionFrm::pointer ptr = item_txs[j];
+			if (ptr) {
 				GlueManager::Instance().OnTransaction(ptr, result);
 
 				// do not broadcast if OnTransaction failed
 				if (result.code() == protocol::ERRCODE_SUCCESS) {
 					PeerManager::Instance().Broadcast(protocol::OVERLAY_MSGTYPE_TRANSACTION, ptr->GetFullData());
 				}
-
-			} while (false);
+			}
 
 			//Force to exit successfully
 			if (result.code() == protocol::ERRCODE_SUCCESS || result.code() == protocol::ERRCODE_ALREADY_EXIST) {
@@ -238,7 +258,7 @@ namespace rexx {
 					break;
 				}
 
-				test_parameter.code_ = acc->GetProtoAccount().contract().payload();
+				test_parameter.code_ = acc->GetConstProtoAccount().contract().payload();
 			} 
 
 			if (test_parameter.code_.empty()) {
@@ -248,6 +268,17 @@ namespace rexx {
 				break;
 			}
 
+			//A query of a deployed contract reads the state only, its result holds until the ledger closes
+			std::string cache_key;
+			int64_t ledger_seq = 0;
+			if (test_parameter.opt_type_ == ContractTestParameter::QUERY && !test_parameter.contract_address_.empty()) {
+				cache_key = ContractQueryCache::ComposeKey(test_parameter.contract_address_, test_parameter.source_address_, test_parameter.input_);
+				ledger_seq = LedgerManager::Instance().GetLastClosedLedger().seq();
+				if (LedgerManager::Instance().query_cache_.Get(cache_key, ledger_seq, result)) {
+					break;
+				}
+			}
+
 			Result exe_result;
 			if (!LedgerManager::Instance().context_manager_.SyncTestProcess(LedgerContext::AT_TEST_V8,
 				(TestParameter*)&test_parameter,
@@ -258,6 +289,10 @@ namespace rexx {
 				LOG_ERROR("Failed to execute the test.%s", error_desc.c_str());
 				break;
 			}
+
+			if (!cache_key.empty()) {
+				LedgerManager::Instance().query_cache_.Put(cache_key, ledger_seq, result);
+			}
 		} while (false);
 
 		if (error_code == protocol::ERRCODE_CONTRACT_SYNTAX_ERROR) {
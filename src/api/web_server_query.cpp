@@ -11,6 +11,21 @@
 #include <ledger/kv_trie.h>
 
 namespace rexx {
+	//The closed ledger a query reads, given by the as_of parameter. 0 is the last closed ledger.
+	static int64_t GetAsOf(const http::server::request &request) {
+		return utils::String::Stoi64(request.GetParamValue("as_of"));
+	}
+
+	static bool CheckPinned(const StorageReadGuard &guard, Json::Value &reply_json) {
+		if (!guard.IsPinned()) {
+			reply_json["error_desc"] = "the ledger of as_of is not retained";
+			return false;
+		}
+
+		reply_json["as_of"] = (Json::Int64)guard.GetLedgerSeq();
+		return true;
+	}
+
 	void WebServer::GetAccountBase(const http::server::request &request, std::string &reply) {
 		std::string address = request.GetParamValue("address");
 
@@ -21,7 +36,12 @@ namespace rexx {
 		Json::Value record = Json::Value(Json::arrayValue);
 		Json::Value &result = reply_json["result"];
 
-		if (!Environment::AccountFromDB(address, acc)) {
+		StorageReadGuard guard(GetAsOf(request));
+
+		if (!CheckPinned(guard, reply_json)) {
+			error_code = protocol::ERRCODE_NOT_EXIST;
+		}
+		else if (!Environment::AccountFromDB(address, acc)) {
 			error_code = protocol::ERRCODE_NOT_EXIST;
 			LOG_TRACE("Failed to get account, account(%s) not exist", address.c_str());
 		}
@@ -54,9 +74,12 @@ namespace rexx {
 		Json::Value record = Json::Value(Json::arrayValue);
 		Json::Value &result = reply_json["result"];
 
-		utils::ReadLockGuard guard(Storage::Instance().account_ledger_lock_);
+		StorageReadGuard guard(GetAsOf(request));
 
-		if (!Environment::AccountFromDB(address, acc)) {
+		if (!CheckPinned(guard, reply_json)) {
+			error_code = protocol::ERRCODE_NOT_EXIST;
+		}
+		else if (!Environment::AccountFromDB(address, acc)) {
 			error_code = protocol::ERRCODE_NOT_EXIST;
 			LOG_TRACE("Failed to get account, account(%s) not exist", address.c_str());
 		}
@@ -121,9 +144,12 @@ namespace rexx {
 		Json::Value record = Json::Value(Json::arrayValue);
 		Json::Value &result = reply_json["result"];
 
-		utils::ReadLockGuard guard(Storage::Instance().account_ledger_lock_);
+		StorageReadGuard guard(GetAsOf(request));
 
-		if (!Environment::AccountFromDB(address, acc)) {
+		if (!CheckPinned(guard, reply_json)) {
+			error_code = protocol::ERRCODE_NOT_EXIST;
+		}
+		else if (!Environment::AccountFromDB(address, acc)) {
 			error_code = protocol::ERRCODE_NOT_EXIST;
 			LOG_TRACE("Failed to get account, account(%s) not exist", address.c_str());
 		}
@@ -179,9 +205,12 @@ namespace rexx {
 		Json::Value record = Json::Value(Json::arrayValue);
 		Json::Value &result = reply_json["result"];
 
-		utils::ReadLockGuard guard(Storage::Instance().account_ledger_lock_);
+		StorageReadGuard guard(GetAsOf(request));
 
-		if (!Environment::AccountFromDB(address, acc)) {
+		if (!CheckPinned(guard, reply_json)) {
+			error_code = protocol::ERRCODE_NOT_EXIST;
+		}
+		else if (!Environment::AccountFromDB(address, acc)) {
 			error_code = protocol::ERRCODE_NOT_EXIST;
 			LOG_TRACE("Failed to get account, account(%s) not exist", address.c_str());
 		}
@@ -299,6 +328,8 @@ namespace rexx {
 
 		std::string seq = request.GetParamValue("ledger_seq");
 		std::string hash = request.GetParamValue("hash");
+		std::string address = request.GetParamValue("address");
+		std::string cursor = request.GetParamValue("cursor");
 		std::string start = request.GetParamValue("start");
 		std::string limit = request.GetParamValue("limit");
 
@@ -317,14 +348,76 @@ namespace rexx {
 		result["total_count"] = 0;
 
 		do {
-			utils::ReadLockGuard guard(Storage::Instance().account_ledger_lock_);
+			StorageReadGuard guard(GetAsOf(request));
+			if (!CheckPinned(guard, reply_json)) {
+				error_code = protocol::ERRCODE_NOT_EXIST;
+				break;
+			}
 
 			protocol::EntryList list;
 			//Use block height (seq) or transaction hash to search for transaction(s).
 			protocol::LedgerHeader header = LedgerManager::Instance().GetLastClosedLedger();
-			if (!seq.empty()) {
+			if (!address.empty()) {
+				//Transactions of an account from the account transaction index, oldest first, a page at a time
+				if (!Configure::Instance().ledger_configure_.tx_index_) {
+					error_code = protocol::ERRCODE_INVALID_PARAMETER;
+					reply_json["error_desc"] = "the account transaction index is not enabled";
+					break;
+				}
+
+				std::string index_begin;
+				if (db->Get(General::KEY_ACCOUNT_TX_INDEX_BEGIN, index_begin) > 0) {
+					result["indexed_from"] = (Json::Int64)utils::String::Stoi64(index_begin);
+				}
+
+				//The cursor is the position of the next entry, ledger_seq:index
+				int64_t cursor_seq = 0;
+				int32_t cursor_index = 0;
+				if (!cursor.empty()) {
+					std::vector<std::string> parts = utils::String::split(cursor, ":");
+					if (parts.size() != 2) {
+						error_code = protocol::ERRCODE_INVALID_PARAMETER;
+						reply_json["error_desc"] = "the cursor must be ledger_seq:index";
+						break;
+					}
+					cursor_seq = utils::String::Stoi64(parts[0]);
+					cursor_index = utils::String::Stoi(parts[1]);
+				}
+
+				int32_t page_size = MIN(limit_int, (int32_t)web_config.query_limit_);
+				std::string prefix = ComposeAccountTxPrefix(address);
+				bool scan_ok = db->Scan(ComposeAccountTxKey(address, cursor_seq, cursor_index), "", [&](const std::string &key, const std::string &value) {
+					if (key.compare(0, prefix.size(), prefix) != 0) {
+						return false;
+					}
+
+					int64_t next_seq = 0;
+					int32_t next_index = 0;
+					if (list.entry_size() >= page_size && ParseAccountTxKey(address, key, next_seq, next_index)) {
+						result["next_cursor"] = utils::String::Format(FMT_I64 ":%d", next_seq, next_index);
+						return false;
+					}
+
+					list.add_entry(value);
+					return true;
+				});
+
+				if (!scan_ok) {
+					error_code = protocol::ERRCODE_INTERNAL_ERROR;
+					break;
+				}
+
+				if (list.entry_size() == 0) {
+					error_code = protocol::ERRCODE_NOT_EXIST;
+					break;
+				}
+
+				result["total_count"] = list.entry_size();
+				start_int = 0;
+			}
+			else if (!seq.empty()) {
 				std::string hashlist;
-				if (db->Get(ComposePrefix(General::LEDGER_TRANSACTION_PREFIX, seq), hashlist) <= 0) {
+				if (db->Get(ComposeSeqKey(General::LEDGER_TRANSACTION_PREFIX, utils::String::Stoi64(seq)), hashlist) <= 0) {
 					error_code = protocol::ERRCODE_NOT_EXIST;
 					break;
 				}
@@ -375,7 +468,7 @@ namespace rexx {
 		} while (false);
 
 		reply_json["error_code"] = error_code;
-		if (error_code == protocol::ERRCODE_NOT_EXIST){
+		if (error_code == protocol::ERRCODE_NOT_EXIST && !reply_json.isMember("error_desc")){
 			reply_json["error_desc"] = "query result not exist";
 		}
 		reply = reply_json.toFastString();
@@ -569,11 +662,6 @@ namespace rexx {
 		std::string with_block_reward = request.GetParamValue("with_block_reward");
 
 
-		/// By default query the last closed ledger
-		if (ledger_seq.empty())
-			ledger_seq = utils::String::ToString(LedgerManager::Instance().GetLastClosedLedger().seq());
-
-
 		int32_t error_code = protocol::ERRCODE_SUCCESS;
 		Json::Value reply_json = Json::Value(Json::objectValue);
 		Json::Value record = Json::Value(Json::arrayValue);
@@ -581,8 +669,14 @@ namespace rexx {
 
 		LedgerFrm frm;
 		do {
-			utils::ReadLockGuard guard(Storage::Instance().account_ledger_lock_);
-			int64_t seq = utils::String::Stoi64(ledger_seq);
+			StorageReadGuard guard(GetAsOf(request));
+			if (!CheckPinned(guard, reply_json)) {
+				error_code = protocol::ERRCODE_NOT_EXIST;
+				break;
+			}
+
+			/// By default query the pinned ledger, the last closed one unless as_of is given
+			int64_t seq = ledger_seq.empty() ? guard.GetLedgerSeq() : utils::String::Stoi64(ledger_seq);
 			if (!frm.LoadFromDb(seq)) {
 				error_code = protocol::ERRCODE_NOT_EXIST;
 				break;
@@ -17,7 +17,12 @@ namespace rexx {
 		clear_consensus_status_(false),
 		log_dest_(-1),
 		console_(false),
-		create_hardfork_(false){}
+		create_hardfork_(false),
+		upgrade_ledger_db_(false),
+		backfill_tx_index_(false),
+		snapshot_export_(false),
+		snapshot_import_(false),
+		snapshot_seq_(0){}
 	Argument::~Argument() {}
 
 	bool Argument::Parse(int argc, char *argv[]) {
@@ -126,6 +131,24 @@ namespace rexx {
 			else if (s == "--create-hardfork") {
 				create_hardfork_ = true;
 			}
+			else if (s == "--upgrade-ledger-db") {
+				upgrade_ledger_db_ = true;
+			}
+			else if (s == "--backfill-tx-index") {
+				backfill_tx_index_ = true;
+			}
+			else if (s == "--snapshot-export" || s == "--snapshot-import") {
+				if (argc <= 2) {
+					printf("missing parameter, need snapshot file path \n");
+					return true;
+				}
+				snapshot_export_ = (s == "--snapshot-export");
+				snapshot_import_ = !snapshot_export_;
+				snapshot_path_ = argv[2];
+				if (snapshot_export_ && argc > 3) {
+					snapshot_seq_ = utils::String::Stoi64(argv[3]);
+				}
+			}
 			else if (s == "--version") {
 #ifdef SVNVERSION
 				printf("%s,%u; " SVNVERSION "\n", General::REXX_VERSION, General::LEDGER_VERSION);
@@ -454,7 +477,7 @@ namespace rexx {
 #ifdef WIN32
 				ledger_db_ = new LevelDbDriver();
 #else
-				ledger_db_ = new RocksDbDriver();
+				ledger_db_ = new RocksDbDriver(DbProfile(), std::shared_ptr<rocksdb::Cache>());
 #endif
 				if (!ledger_db_->Open(path, -1)) {
 					return false;
@@ -518,6 +541,10 @@ namespace rexx {
 			"  --aes-crypto <value>                                          crypto value\n"
 			"  --version                                                     display version information\n"
 			"  --create-hardfork                                             create hard fork ledger\n"
+			"  --upgrade-ledger-db                                           rewrite the ledger db keys to the latest schema\n"
+			"  --backfill-tx-index                                           index the transactions of the ledgers closed before ledger.tx_index was set\n"
+			"  --snapshot-export <file> [seq]                                export the state of the last closed ledger to a snapshot file\n"
+			"  --snapshot-import <file>                                      rebuild an empty database from a snapshot file\n"
 			"  --clear-peer-addresses                                        clear peer list\n"
 			"  --create-keystore <password>                                  create key store\n"
 			"  --create-keystore-list <path> <nums> <password>               create a number of keystores into path with same password\n"
@@ -19,6 +19,12 @@ namespace rexx {
 		bool clear_peer_addresses_;
 		bool clear_consensus_status_;
 		bool create_hardfork_;
+		bool upgrade_ledger_db_;
+		bool backfill_tx_index_;
+		bool snapshot_export_;
+		bool snapshot_import_;
+		std::string snapshot_path_;
+		int64_t snapshot_seq_;
 
 		bool Parse(int argc, char *argv[]);
 		void Usage();
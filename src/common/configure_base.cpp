@@ -5,13 +5,85 @@
 #include "configure_base.h"
 
 namespace rexx {
+	DbProfile::DbProfile() {
+		name_ = "default";
+		block_cache_size_ = 0;
+		bloom_bits_ = 0;
+		prefix_length_ = 0;
+		write_buffer_size_ = 0;
+		background_threads_ = 0;
+		compaction_style_ = "level";
+		sync_policy_str_ = "always";
+		sync_policy_ = SYNC_ALWAYS;
+	}
+
+	DbProfile::~DbProfile() {}
+
+	bool DbProfile::Load(const Json::Value &value) {
+		ConfigureBase::GetValue(value, "block_cache_size", block_cache_size_);
+		ConfigureBase::GetValue(value, "bloom_bits", bloom_bits_);
+		ConfigureBase::GetValue(value, "prefix_length", prefix_length_);
+		ConfigureBase::GetValue(value, "write_buffer_size", write_buffer_size_);
+		ConfigureBase::GetValue(value, "background_threads", background_threads_);
+		ConfigureBase::GetValue(value, "compaction_style", compaction_style_);
+		if (value.isMember("column_families")) {
+			column_families_.clear();
+			ConfigureBase::GetValue(value, "column_families", column_families_);
+		}
+		ConfigureBase::GetValue(value, "sync_policy", sync_policy_str_);
+
+		if (compaction_style_ != "level" && compaction_style_ != "universal") {
+			LOG_STD_ERR("Db profile(%s) has unknown compaction style(%s)", name_.c_str(), compaction_style_.c_str());
+			return false;
+		}
+
+		if (sync_policy_str_ == "always") {
+			sync_policy_ = SYNC_ALWAYS;
+		}
+		else if (sync_policy_str_ == "batch") {
+			sync_policy_ = SYNC_BATCH;
+		}
+		else if (sync_policy_str_ == "none") {
+			sync_policy_ = SYNC_NONE;
+		}
+		else {
+			LOG_STD_ERR("Db profile(%s) has unknown sync policy(%s)", name_.c_str(), sync_policy_str_.c_str());
+			return false;
+		}
+
+		if (block_cache_size_ < 0 || bloom_bits_ < 0 || prefix_length_ < 0 || write_buffer_size_ < 0 || background_threads_ < 0) {
+			LOG_STD_ERR("Db profile(%s) has negative sizes", name_.c_str());
+			return false;
+		}
+		return true;
+	}
+
 	DbConfigure::DbConfigure() {
 		keyvalue_db_path_ = General::DEFAULT_KEYVALUE_DB_PATH;
 		ledger_db_path_ = General::DEFAULT_LEDGER_DB_PATH;
 		account_db_path_ = General::DEFAULT_ACCOUNT_DB_PATH;
+		unified_db_path_ = General::DEFAULT_UNIFIED_DB_PATH;
+		unified_ = false;
+		snapshot_retain_ = 16;
 		tmp_path_ = "tmp";
 		async_write_sql_ = false; //default sync write sql
 		async_write_kv_ = false; //default sync write kv
+
+		//The default profile keeps the engine defaults
+		profiles_["default"] = DbProfile();
+
+		DbProfile &performance = profiles_["performance"];
+		performance.name_ = "performance";
+		performance.block_cache_size_ = 256;
+		performance.bloom_bits_ = 10;
+		performance.write_buffer_size_ = 64;
+		performance.background_threads_ = 4;
+		performance.sync_policy_str_ = "batch";
+		performance.sync_policy_ = DbProfile::SYNC_BATCH;
+
+		keyvalue_profile_ = "default";
+		ledger_profile_ = "default";
+		account_profile_ = "default";
 	}
 
 	DbConfigure::~DbConfigure() {}
@@ -20,6 +92,9 @@ namespace rexx {
 		ConfigureBase::GetValue(value, "keyvalue_path", keyvalue_db_path_);
 		ConfigureBase::GetValue(value, "ledger_path", ledger_db_path_);
 		ConfigureBase::GetValue(value, "account_path", account_db_path_);
+		ConfigureBase::GetValue(value, "unified_path", unified_db_path_);
+		ConfigureBase::GetValue(value, "unified", unified_);
+		ConfigureBase::GetValue(value, "snapshot_retain", snapshot_retain_);
 		
 		ConfigureBase::GetValue(value, "rational_string", rational_string_);
 		ConfigureBase::GetValue(value, "rational_db_type", rational_db_type_);
@@ -27,6 +102,38 @@ namespace rexx {
 		ConfigureBase::GetValue(value, "async_write_sql", async_write_sql_);
 		ConfigureBase::GetValue(value, "async_write_kv", async_write_kv_);
 
+		//A profile is defined on top of the built in one of the same name, or of the default one
+		const Json::Value &profiles = value["profiles"];
+		if (profiles.isObject()) {
+			Json::Value::Members names = profiles.getMemberNames();
+			for (size_t i = 0; i < names.size(); i++) {
+				const std::string &name = names[i];
+				if (profiles_.find(name) == profiles_.end()) {
+					profiles_[name] = profiles_["default"];
+				}
+
+				DbProfile &profile = profiles_[name];
+				profile.name_ = name;
+				if (!profile.Load(profiles[name])) {
+					return false;
+				}
+			}
+		}
+
+		std::string profile = "default";
+		ConfigureBase::GetValue(value, "profile", profile);
+		keyvalue_profile_ = ledger_profile_ = account_profile_ = profile;
+		ConfigureBase::GetValue(value, "keyvalue_profile", keyvalue_profile_);
+		ConfigureBase::GetValue(value, "ledger_profile", ledger_profile_);
+		ConfigureBase::GetValue(value, "account_profile", account_profile_);
+
+		const std::string *selected[] = { &keyvalue_profile_, &ledger_profile_, &account_profile_ };
+		for (size_t i = 0; i < sizeof(selected) / sizeof(selected[0]); i++) {
+			if (profiles_.find(*selected[i]) == profiles_.end()) {
+				LOG_STD_ERR("Db profile(%s) is not defined", selected[i]->c_str());
+				return false;
+			}
+		}
 
 		std::string rational_decode;
 		std::vector<std::string> nparas = utils::String::split(rational_string_, " ");
@@ -55,12 +162,24 @@ namespace rexx {
 			account_db_path_ = utils::String::Format("%s/%s", utils::File::GetBinHome().c_str(), account_db_path_.c_str());
 		}
 
+		if (!utils::File::IsAbsolute(unified_db_path_)) {
+			unified_db_path_ = utils::String::Format("%s/%s", utils::File::GetBinHome().c_str(), unified_db_path_.c_str());
+		}
+
 		if (!utils::File::IsAbsolute(tmp_path_)) {
 			tmp_path_ = utils::String::Format("%s/%s", utils::File::GetBinHome().c_str(), tmp_path_.c_str());
 		}
 		return true;
 	}
 
+	const DbProfile &DbConfigure::GetProfile(const std::string &name) const {
+		std::map<std::string, DbProfile>::const_iterator iter = profiles_.find(name);
+		if (iter == profiles_.end()) {
+			return profiles_.find("default")->second;
+		}
+		return iter->second;
+	}
+
 	LoggerConfigure::LoggerConfigure() {
 		path_ = General::LOGGER_FILE;
 		dest_ = utils::LOG_DEST_OUT | utils::LOG_DEST_FILE;
@@ -68,6 +187,10 @@ namespace rexx {
 		time_capacity_ = 30;
 		size_capacity_ = 100;
 		expire_days_ = 10;
+		async_ = false;
+		async_ring_size_ = 8192;
+		async_overflow_str_ = "drop";
+		async_overflow_ = utils::LOG_OVERFLOW_DROP;
 	}
 
 	LoggerConfigure::~LoggerConfigure() {}
@@ -79,6 +202,9 @@ namespace rexx {
 		ConfigureBase::GetValue(value, "time_capacity", time_capacity_);
 		ConfigureBase::GetValue(value, "size_capacity", size_capacity_);
 		ConfigureBase::GetValue(value, "expire_days", expire_days_);
+		ConfigureBase::GetValue(value, "async", async_);
+		ConfigureBase::GetValue(value, "async_ring_size", async_ring_size_);
+		ConfigureBase::GetValue(value, "async_overflow", async_overflow_str_);
 
 		time_capacity_ *= (3600 * 24);
 		size_capacity_ *= utils::BYTES_PER_MEGA;
@@ -113,6 +239,9 @@ namespace rexx {
 			else if (levelitem == "FATAL")   level_ |= utils::LOG_LEVEL_FATAL;
 		}
 
+		//A full ring drops the record unless it is set to block
+		async_overflow_ = utils::String::ToUpper(async_overflow_str_) == "BLOCK" ? utils::LOG_OVERFLOW_BLOCK : utils::LOG_OVERFLOW_DROP;
+
 		return true;
 	}
 
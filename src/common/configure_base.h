@@ -2,6 +2,7 @@
 #ifndef CONFIGURE_BASE_H_
 #define CONFIGURE_BASE_H_
 
+#include <map>
 #include <json/json.h>
 #include <utils/singleton.h>
 #include <utils/strings.h>
@@ -23,6 +24,39 @@ namespace rexx {
 		uint32_t dest_;
 		uint32_t level_;
 		int32_t expire_days_;
+
+		//Write from a background thread, every logging thread queues up to async_ring_size_ records
+		bool async_;
+		uint32_t async_ring_size_;
+		std::string async_overflow_str_;
+		uint32_t async_overflow_;
+		bool Load(const Json::Value &value);
+	};
+
+	//Tuning of one key value database. Databases pick a profile by name, and databases sharing
+	//a profile share its block cache.
+	class DbProfile {
+	public:
+		typedef enum SyncPolicy_ {
+			SYNC_ALWAYS = 0, //Sync every write
+			SYNC_BATCH = 1, //Sync write batches only, the ledger close is written as a batch
+			SYNC_NONE = 2 //Leave the WAL sync to the os
+		}SyncPolicy;
+
+		DbProfile();
+		~DbProfile();
+
+		std::string name_;
+		int64_t block_cache_size_; //MB, 0 for the engine default
+		int32_t bloom_bits_; //Bloom filter bits per key, 0 for no filter
+		int32_t prefix_length_; //Fixed key prefix length for prefix blooms, 0 for none
+		int64_t write_buffer_size_; //MB, 0 for the engine default
+		int32_t background_threads_; //0 for the engine default
+		std::string compaction_style_; //level or universal
+		utils::StringList column_families_; //Key prefixes stored in their own column families, fixed when the db is created
+		std::string sync_policy_str_;
+		SyncPolicy sync_policy_;
+
 		bool Load(const Json::Value &value);
 	};
 
@@ -34,12 +68,20 @@ namespace rexx {
 		std::string keyvalue_db_path_;
 		std::string ledger_db_path_;
 		std::string account_db_path_;
+		std::string unified_db_path_;
+		bool unified_; //Keep the three databases in one db, so that a ledger is written atomically with one sync
+		int32_t snapshot_retain_; //Number of closed ledgers the readers of the unified db can pin
 		std::string rational_string_;
 		std::string rational_db_type_;
 		std::string tmp_path_;
 		bool async_write_sql_;
 		bool async_write_kv_;
+		std::string keyvalue_profile_;
+		std::string ledger_profile_;
+		std::string account_profile_;
+		std::map<std::string, DbProfile> profiles_;
 		bool Load(const Json::Value &value);
+		const DbProfile &GetProfile(const std::string &name) const;
 	};
 
 	class SSLConfigure {
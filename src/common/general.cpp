@@ -6,8 +6,12 @@
 #include "proto/cpp/common.pb.h"
 
 namespace rexx {
-	const uint32_t General::OVERLAY_VERSION = 1000;
+	const uint32_t General::OVERLAY_VERSION = 1002;
 	const uint32_t General::OVERLAY_MIN_VERSION = 1000;
+	//Peers from this version accept pre-prepares carrying transaction hashes
+	const uint32_t General::OVERLAY_COMPACT_PBFT_VERSION = 1001;
+	//Peers from this version relay transactions by inventory announcements
+	const uint32_t General::OVERLAY_TX_INV_VERSION = 1002;
 	/*
 		Based on ledger 1000, the following changes have been modified.
 		1.Create a common or contract account without signers.
@@ -24,6 +28,7 @@ namespace rexx {
 	const char *General::DEFAULT_KEYVALUE_DB_PATH = "data/keyvalue.db";
 	const char *General::DEFAULT_LEDGER_DB_PATH = "data/ledger.db";
 	const char *General::DEFAULT_ACCOUNT_DB_PATH = "data/account.db";
+	const char *General::DEFAULT_UNIFIED_DB_PATH = "data/chain.db";
 	
 	const char *General::CONFIG_FILE = "config/rexx.json";
 	const char *General::MONITOR_CONFIG_FILE = "config/monitor.json";
@@ -33,6 +38,7 @@ namespace rexx {
 	const char *General::DEFAULT_KEYVALUE_DB_PATH = "data/keyvalue.db";
 	const char *General::DEFAULT_LEDGER_DB_PATH = "data/ledger.db";
 	const char *General::DEFAULT_ACCOUNT_DB_PATH = "data/account.db";
+	const char *General::DEFAULT_UNIFIED_DB_PATH = "data/chain.db";
 
 	const char *General::CONFIG_FILE = "config/rexx.json";
 	const char *General::LOGGER_FILE = "log/rexx.log";
@@ -51,6 +57,8 @@ namespace rexx {
 
 	const char *General::STATISTICS = "statistics";
 	const char *General::KEY_LEDGER_SEQ = "max_seq";
+	const char *General::KEY_SEQ_KEY_VERSION = "seq_key_version";
+	const char *General::KEY_ACCOUNT_TX_INDEX_BEGIN = "account_tx_index_begin";
 	const char *General::KEY_GENE_ACCOUNT = "genesis_account";
 	const char *General::VALIDATORS = "validators";
 	const char *General::PEERS_TABLE = "peers_table";
@@ -63,6 +71,8 @@ namespace rexx {
 	const char *General::TRANSACTION_PREFIX = "tx";
 	const char *General::LEDGER_TRANSACTION_PREFIX = "lgtx";
 	const char *General::CONSENSUS_VALUE_PREFIX = "cosv";
+	const char *General::CONTRACT_CODE_CACHE_PREFIX = "ccache";
+	const char *General::ACCOUNT_TX_PREFIX = "actx";
 
 	const char *General::ACCOUNT_PREFIX = "acc";
 	const char *General::ASSET_PREFIX = "ast";
@@ -302,6 +312,72 @@ namespace rexx {
 		return result;
 	}
 
+	std::string ComposeSeqKey(const std::string &prefix, int64_t seq) {
+		std::string result = prefix;
+		result += "_";
+		result += (char)General::SEQ_KEY_VERSION;
+		uint64_t value = (uint64_t)seq;
+		for (int i = 7; i >= 0; i--) {
+			result += (char)((value >> (i * 8)) & 0xff);
+		}
+		return result;
+	}
+
+	bool ParseSeqKey(const std::string &prefix, const std::string &key, int64_t &seq) {
+		if (key.size() != prefix.size() + 10 || key.compare(0, prefix.size(), prefix) != 0 ||
+			key[prefix.size()] != '_' || key[prefix.size() + 1] != (char)General::SEQ_KEY_VERSION) {
+			return false;
+		}
+
+		uint64_t value = 0;
+		for (size_t i = prefix.size() + 2; i < key.size(); i++) {
+			value = (value << 8) | (uint8_t)key[i];
+		}
+		seq = (int64_t)value;
+		return true;
+	}
+
+	std::string ComposeAccountTxPrefix(const std::string &address) {
+		//The address length keeps an address from being the prefix of another one
+		std::string result = General::ACCOUNT_TX_PREFIX;
+		result += "_";
+		result += (char)address.size();
+		result += address;
+		return result;
+	}
+
+	std::string ComposeAccountTxKey(const std::string &address, int64_t seq, int32_t index) {
+		std::string result = ComposeAccountTxPrefix(address);
+		uint64_t seq_value = (uint64_t)seq;
+		for (int i = 7; i >= 0; i--) {
+			result += (char)((seq_value >> (i * 8)) & 0xff);
+		}
+		uint32_t index_value = (uint32_t)index;
+		for (int i = 3; i >= 0; i--) {
+			result += (char)((index_value >> (i * 8)) & 0xff);
+		}
+		return result;
+	}
+
+	bool ParseAccountTxKey(const std::string &address, const std::string &key, int64_t &seq, int32_t &index) {
+		std::string prefix = ComposeAccountTxPrefix(address);
+		if (key.size() != prefix.size() + 12 || key.compare(0, prefix.size(), prefix) != 0) {
+			return false;
+		}
+
+		uint64_t seq_value = 0;
+		for (size_t i = prefix.size(); i < prefix.size() + 8; i++) {
+			seq_value = (seq_value << 8) | (uint8_t)key[i];
+		}
+		uint32_t index_value = 0;
+		for (size_t i = prefix.size() + 8; i < key.size(); i++) {
+			index_value = (index_value << 8) | (uint8_t)key[i];
+		}
+		seq = (int64_t)seq_value;
+		index = (int32_t)index_value;
+		return true;
+	}
+
 	int64_t GetBlockReward(const int64_t cur_block_height) {
 		int64_t period_index = cur_block_height / General::REWARD_PERIOD;
 
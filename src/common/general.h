@@ -13,6 +13,8 @@ namespace rexx {
 	public:
 		const static uint32_t OVERLAY_VERSION;
 		const static uint32_t OVERLAY_MIN_VERSION;
+		const static uint32_t OVERLAY_COMPACT_PBFT_VERSION;
+		const static uint32_t OVERLAY_TX_INV_VERSION;
 		const static uint32_t LEDGER_VERSION_HISTORY_1000;
 		const static uint32_t LEDGER_VERSION;
 		const static uint32_t LEDGER_MIN_VERSION;
@@ -44,12 +46,16 @@ namespace rexx {
 
 		const static int LAST_TX_HASHS_LIMIT = 100;
 
+		//Schema of the sequence keys in the ledger db, 1 is the decimal one, 2 the big endian one
+		const static int SEQ_KEY_VERSION = 2;
+
 		const static size_t REXX_DECIMALS = 8;  // 10^8
 
 		const static char *DEFAULT_KEYVALUE_DB_PATH;
 		const static char *DEFAULT_ACCOUNT_DB_PATH;
 
 		const static char *DEFAULT_LEDGER_DB_PATH;
+		const static char *DEFAULT_UNIFIED_DB_PATH;
 		const static char *DEFAULT_RATIONAL_DB_PATH;
 
 		const static char *CONFIG_FILE;
@@ -64,6 +70,8 @@ namespace rexx {
 		const static char *TRANSACTION_PREFIX;
 		const static char *LEDGER_TRANSACTION_PREFIX;
 		const static char *CONSENSUS_VALUE_PREFIX;
+		const static char *CONTRACT_CODE_CACHE_PREFIX;
+		const static char *ACCOUNT_TX_PREFIX;
 		const static char *PEERS_TABLE;
 		const static char *LAST_TX_HASHS;
 		const static char *LAST_PROOF;
@@ -71,6 +79,8 @@ namespace rexx {
 		const static int ACCOUNT_LENGTH_MAX = 40;
 
 		const static char *KEY_LEDGER_SEQ;
+		const static char *KEY_SEQ_KEY_VERSION;
+		const static char *KEY_ACCOUNT_TX_INDEX_BEGIN;
 		const static char *KEY_GENE_ACCOUNT;
 		const static char *VALIDATORS;
 
@@ -267,6 +277,13 @@ namespace rexx {
 	std::string GetDataSecuretKey();
 	std::string ComposePrefix(const std::string &prefix, const std::string &value);
 	std::string ComposePrefix(const std::string &prefix, int64_t value);
+	//Key of a ledger sequence, it sorts in the order of the sequence
+	std::string ComposeSeqKey(const std::string &prefix, int64_t seq);
+	bool ParseSeqKey(const std::string &prefix, const std::string &key, int64_t &seq);
+	//Key of the account transaction index, the entries of an account sort by ledger sequence and transaction index
+	std::string ComposeAccountTxPrefix(const std::string &address);
+	std::string ComposeAccountTxKey(const std::string &address, int64_t seq, int32_t index);
+	bool ParseAccountTxKey(const std::string &address, const std::string &key, int64_t &seq, int32_t &index);
 	int64_t GetBlockReward(const int64_t cur_block_height);
 
 #define CHECK_VERSION_GT_1000 (LedgerManager::Instance().GetLastClosedLedger().version() > General::LEDGER_VERSION_HISTORY_1000)
@@ -1,12 +1,56 @@
 ﻿
+#include <zlib.h>
 #include <utils/timestamp.h>
 #include <utils/logger.h>
 #include "general.h"
 #include "network.h"
 
 #define OVERLAY_PING 1
+#define FRAME_COMPRESSION_ZLIB 1
 namespace rexx {
 
+	//A compressed frame may not grow beyond the message size accepted by websocket
+	static const int64_t FRAME_MAX_RAW_SIZE = 32 * utils::BYTES_PER_MEGA;
+
+	static bool CompressFrameData(const std::string &data, std::string &packed) {
+		uLongf packed_size = compressBound((uLong)data.size());
+		packed.resize(packed_size);
+		if (compress2((Bytef *)&packed[0], &packed_size, (const Bytef *)data.data(), (uLong)data.size(), Z_BEST_SPEED) != Z_OK) {
+			return false;
+		}
+		packed.resize(packed_size);
+		return true;
+	}
+
+	static bool UncompressFrameData(protocol::WsMessage &message) {
+		if (message.compression() != FRAME_COMPRESSION_ZLIB || message.raw_size() < 0 || message.raw_size() > FRAME_MAX_RAW_SIZE) {
+			return false;
+		}
+
+		std::string data;
+		uLongf size = (uLongf)message.raw_size();
+		data.resize((size_t)message.raw_size());
+		if (uncompress((Bytef *)&data[0], &size, (const Bytef *)message.data().data(), (uLong)message.data().size()) != Z_OK ||
+			size != (uLongf)message.raw_size()) {
+			return false;
+		}
+
+		message.set_data(data);
+		message.clear_compression();
+		message.clear_raw_size();
+		return true;
+	}
+
+	FrameParameter::FrameParameter() :
+		compression_(false),
+		compression_min_size_(0),
+		batch_(false),
+		batch_message_size_(0),
+		batch_max_size_(0),
+		batch_interval_(0) {}
+
+	FrameParameter::~FrameParameter() {}
+
 	Connection::Connection(server *server_h, client *client_h, 
 		tls_server *tls_server_h, tls_client *tls_client_h, 
 		connection_hdl con, const std::string &uri, int64_t id) :
@@ -17,6 +61,11 @@ namespace rexx {
 		handle_(con),
 		uri_(uri), 
 		id_(id), 
+		batch_size_(0),
+		batch_time_(0),
+		frame_raw_bytes_(0),
+		frame_sent_bytes_(0),
+		frame_batch_count_(0),
 		sequence_(0){
 		connect_start_time_ = 0;
 		connect_end_time_ = 0;
@@ -116,6 +165,81 @@ namespace rexx {
 		return in_bound_;
 	}
 
+	void Connection::SetFrameParameter(const FrameParameter &frame_parameter) {
+		utils::MutexGuard guard(frame_lock_);
+		frame_parameter_ = frame_parameter;
+	}
+
+	bool Connection::SendWsMessage(const protocol::WsMessage &message, std::error_code &ec) {
+		utils::MutexGuard guard(frame_lock_);
+		size_t size = message.ByteSize();
+		if (!frame_parameter_.batch_ || size >= frame_parameter_.batch_message_size_) {
+			//The coalesced messages go first to keep the order
+			if (batch_.messages_size() > 0 && !SendBatch(ec)) {
+				return false;
+			}
+			return SendFrame(message, ec);
+		}
+
+		if (batch_.messages_size() == 0) {
+			batch_time_ = utils::Timestamp::HighResolution();
+		}
+		*batch_.add_messages() = message;
+		batch_size_ += size;
+
+		if (batch_size_ >= frame_parameter_.batch_max_size_) {
+			return SendBatch(ec);
+		}
+		return true;
+	}
+
+	bool Connection::FlushBatch(int64_t current_time, std::error_code &ec) {
+		utils::MutexGuard guard(frame_lock_);
+		if (batch_.messages_size() == 0 || current_time - batch_time_ < frame_parameter_.batch_interval_) {
+			return true;
+		}
+		return SendBatch(ec);
+	}
+
+	bool Connection::SendBatch(std::error_code &ec) {
+		protocol::WsMessage frame;
+		frame.set_batch(true);
+		frame.set_data(batch_.SerializeAsString());
+		batch_.Clear();
+		batch_size_ = 0;
+		frame_batch_count_++;
+		return SendFrame(frame, ec);
+	}
+
+	bool Connection::SendFrame(const protocol::WsMessage &frame, std::error_code &ec) {
+		std::string bytes = frame.SerializeAsString();
+		frame_raw_bytes_ += bytes.size();
+
+		do {
+			if (!frame_parameter_.compression_ || frame.data().size() < frame_parameter_.compression_min_size_) {
+				break;
+			}
+
+			std::string packed;
+			if (!CompressFrameData(frame.data(), packed) || packed.size() >= frame.data().size()) {
+				break;
+			}
+
+			protocol::WsMessage compressed;
+			compressed.set_type(frame.type());
+			compressed.set_request(frame.request());
+			compressed.set_sequence(frame.sequence());
+			compressed.set_batch(frame.batch());
+			compressed.set_compression(FRAME_COMPRESSION_ZLIB);
+			compressed.set_raw_size(frame.data().size());
+			compressed.set_data(packed);
+			bytes = compressed.SerializeAsString();
+		} while (false);
+
+		frame_sent_bytes_ += bytes.size();
+		return SendByteMessage(bytes, ec);
+	}
+
 	bool Connection::SendByteMessage(const std::string &message, std::error_code &ec) {
 		std::error_code ec1;
 		if (in_bound_){
@@ -193,7 +317,7 @@ namespace rexx {
 		message.set_request(request);
 		message.set_sequence(sequence);
 		message.set_data(data);
-		return SendByteMessage(message.SerializeAsString(), ec);
+		return SendWsMessage(message, ec);
 	}
 
 	bool Connection::SendRequest(int64_t type, const std::string &data, std::error_code &ec) {
@@ -202,7 +326,7 @@ namespace rexx {
 		message.set_request(true);
 		message.set_sequence(sequence_++);
 		message.set_data(data);
-		return SendByteMessage(message.SerializeAsString(), ec);
+		return SendWsMessage(message, ec);
 	}
 
 	bool Connection::SendResponse(const protocol::WsMessage &req_message, const std::string &data, std::error_code &ec) {
@@ -247,6 +371,11 @@ namespace rexx {
 		status["in_bound"] = in_bound_;
 		status["peer_address"] = GetPeerAddress().ToIpPort();
 		status["last_receive_time"] = last_receive_time_;
+		status["frame_compression"] = frame_parameter_.compression_;
+		status["frame_batch"] = frame_parameter_.batch_;
+		status["frame_raw_bytes"] = frame_raw_bytes_;
+		status["frame_sent_bytes"] = frame_sent_bytes_;
+		status["frame_batch_count"] = frame_batch_count_;
 	}
 
 	bool Connection::OnNetworkTimer(int64_t current_time) { return true; }
@@ -254,7 +383,7 @@ namespace rexx {
 	SslParameter::SslParameter() :enable_(false) {}
 	SslParameter::~SslParameter() {}
 
-	Network::Network(const SslParameter &ssl_parameter) : next_id_(0), enabled_(false), ssl_parameter_(ssl_parameter) {
+	Network::Network(const SslParameter &ssl_parameter) : next_id_(0), enabled_(false), ssl_parameter_(ssl_parameter), frame_batch_(false) {
 		last_check_time_ = 0;
 		connect_time_out_ = 60 * utils::MICRO_UNITS_PER_SEC;
 		std::error_code err;
@@ -382,6 +511,28 @@ namespace rexx {
 			conn_id = conn->GetId();
 		} while (false);
 
+		if (message.compression() != 0 && !UncompressFrameData(message)) {
+			LOG_ERROR("Failed to uncompress websocket message, compression(" FMT_I64 "), raw size(" FMT_I64 ")", message.compression(), message.raw_size());
+			return;
+		}
+
+		if (!message.batch()) {
+			ProcessMessage(hdl, conn_id, message);
+			return;
+		}
+
+		protocol::WsMessageBatch batch;
+		if (!batch.ParseFromString(message.data())) {
+			LOG_ERROR("Failed to parse websocket batch message");
+			return;
+		}
+
+		for (int32_t i = 0; i < batch.messages_size(); i++) {
+			if (!ProcessMessage(hdl, conn_id, *batch.mutable_messages(i))) break;
+		}
+	}
+
+	bool Network::ProcessMessage(connection_hdl hdl, int64_t conn_id, protocol::WsMessage &message) {
 		do {
 			MessageConnPoc proc;
 			if (message.request()) {
@@ -410,7 +561,10 @@ namespace rexx {
 			} while (false);
 
 			RemoveConnection(conn_id);
+			return false;
 		} while (false);
+
+		return true;
 	}
 
 	void Network::Stop() {
@@ -447,6 +601,16 @@ namespace rexx {
 				utils::Sleep(1);
 
 				int64_t now = utils::Timestamp::HighResolution();
+				if (frame_batch_) {
+					utils::MutexGuard guard_(conns_list_lock_);
+					for (ConnectionMap::iterator iter = connections_.begin();
+						iter != connections_.end();
+						iter++) {
+						std::error_code ec;
+						iter->second->FlushBatch(now, ec);
+					}
+				}
+
 				if (now - last_check_time > utils::MICRO_UNITS_PER_SEC) {
 
 					utils::MutexGuard guard_(conns_list_lock_);
@@ -34,6 +34,20 @@ namespace rexx {
 		MOZILLA_MODERN = 2
 	};
 
+	//How the frames sent on a connection are built, both are off until the peer accepts them
+	class FrameParameter {
+	public:
+		FrameParameter();
+		~FrameParameter();
+
+		bool compression_;
+		size_t compression_min_size_; //frames from this size are compressed
+		bool batch_;
+		size_t batch_message_size_; //messages below this size are coalesced
+		size_t batch_max_size_; //a batch reaching this size is sent at once
+		int64_t batch_interval_; //micro second, a batch is sent at the latest after it
+	};
+
 	class Connection {
 	private:
 		server *server_;
@@ -52,6 +66,19 @@ namespace rexx {
 		bool in_bound_;
 		utils::InetAddress peer_address_;
 
+		//Frames
+		utils::Mutex frame_lock_;
+		FrameParameter frame_parameter_;
+		protocol::WsMessageBatch batch_;
+		size_t batch_size_;
+		int64_t batch_time_;
+		int64_t frame_raw_bytes_;
+		int64_t frame_sent_bytes_;
+		int64_t frame_batch_count_;
+
+		bool SendFrame(const protocol::WsMessage &frame, std::error_code &ec);
+		bool SendBatch(std::error_code &ec);
+
 	protected:
 		int64_t connect_start_time_;
 		int64_t sequence_;
@@ -64,6 +91,7 @@ namespace rexx {
 		virtual ~Connection();
 		
 		bool SendByteMessage(const std::string &message, std::error_code &ec);
+		bool SendWsMessage(const protocol::WsMessage &message, std::error_code &ec);
 		bool SendMsg(int64_t type, bool request, int64_t sequence, const std::string &data, std::error_code &ec);
 		bool SendRequest(int64_t type, const std::string &data, std::error_code &ec);
 		bool SendResponse(const protocol::WsMessage &req_message, const std::string &data, std::error_code &ec);
@@ -79,6 +107,10 @@ namespace rexx {
 		connection_hdl GetHandle() const;
 		websocketpp::lib::error_code GetErrorCode() const;
 		bool InBound() const;
+		void SetFrameParameter(const FrameParameter &frame_parameter);
+
+		//Send the batch once it has waited for the batch interval
+		bool FlushBatch(int64_t current_time, std::error_code &ec);
 
 		//Get status
 		bool IsConnectExpired(int64_t time_out) const;
@@ -125,6 +157,7 @@ namespace rexx {
 		bool enabled_;
 
 		SslParameter ssl_parameter_;
+		bool frame_batch_; //set if some connections coalesce messages
 
 		std::error_code ec_;
 		utils::Mutex conns_list_lock_;
@@ -143,6 +176,7 @@ namespace rexx {
 		void OnOpen(connection_hdl hdl);
 		void OnClose(connection_hdl hdl);
 		virtual void OnMessage(connection_hdl hdl, server::message_ptr msg);
+		bool ProcessMessage(connection_hdl hdl, int64_t conn_id, protocol::WsMessage &message);
 		void OnFailed(connection_hdl hdl);
 
 		//For client
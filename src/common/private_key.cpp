@@ -284,6 +284,67 @@ namespace rexx {
         return false;
     }
 
+    size_t PublicKey::VerifyBatch(std::vector<SignatureItem> &items, size_t begin, size_t end) {
+        if (end > items.size()) end = items.size();
+        if (begin >= end) return 0;
+
+        size_t valid_count = 0;
+        std::vector<size_t> batch_index;
+        std::vector<std::string> raw_pubkeys;
+        batch_index.reserve(end - begin);
+        raw_pubkeys.reserve(end - begin);
+        for (size_t i = begin; i < end; i++) {
+            SignatureItem &item = items[i];
+            item.valid_ = false;
+
+            PrivateKeyPrefix prefix;
+            SignatureType sign_type;
+            std::string raw_pubkey;
+            bool valid = GetPublicKeyElement(item.public_key_, prefix, sign_type, raw_pubkey);
+            if (!valid || prefix != PUBLICKEY_PREFIX || item.signature_.size() != 64) {
+                continue;
+            }
+
+            if (sign_type == SIGNTYPE_ED25519) {
+                //Non-canonical S is rejected by ed25519_sign_open but not by the batch equation, keep them identical.
+                if ((uint8_t) item.signature_[63] & 224) {
+                    continue;
+                }
+                batch_index.push_back(i);
+                raw_pubkeys.push_back(raw_pubkey);
+            } else if (sign_type == SIGNTYPE_CFCASM2) {
+                item.valid_ = utils::EccSm2::verify(utils::EccSm2::GetCFCAGroup(), raw_pubkey, "1234567812345678", item.data_,
+                                                    item.signature_) == 1;
+                if (item.valid_) valid_count++;
+            } else {
+                LOG_ERROR("Failed to verify. Unknown signature type(%d)", sign_type);
+            }
+        }
+
+        if (batch_index.empty()) {
+            return valid_count;
+        }
+
+        size_t num = batch_index.size();
+        std::vector<const unsigned char *> messages(num), pubkeys(num), signatures(num);
+        std::vector<size_t> lengths(num);
+        std::vector<int> valids(num, 0);
+        for (size_t i = 0; i < num; i++) {
+            const SignatureItem &item = items[batch_index[i]];
+            messages[i] = (const unsigned char *) item.data_.c_str();
+            lengths[i] = item.data_.size();
+            pubkeys[i] = (const unsigned char *) raw_pubkeys[i].c_str();
+            signatures[i] = (const unsigned char *) item.signature_.c_str();
+        }
+
+        ed25519_sign_open_batch(&messages[0], &lengths[0], &pubkeys[0], &signatures[0], num, &valids[0]);
+        for (size_t i = 0; i < num; i++) {
+            items[batch_index[i]].valid_ = (valids[i] == 1);
+            if (valids[i] == 1) valid_count++;
+        }
+        return valid_count;
+    }
+
     //Generate keypair according to signature type.
     PrivateKey::PrivateKey(SignatureType type) {
         std::string raw_pub_key = "";
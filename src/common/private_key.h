@@ -46,6 +46,18 @@ namespace rexx {
 	bool GetKeyElement(const std::string &encode_key, PrivateKeyPrefix &prefix, SignatureType &sign_type, std::string &raw_data);
 	std::string GetSignTypeDesc(SignatureType type);
 	SignatureType GetSignTypeByDesc(const std::string &desc);
+
+	//A signature waiting for verification, valid_ is set by PublicKey::VerifyBatch.
+	struct SignatureItem {
+		SignatureItem() : valid_(false) {}
+		SignatureItem(const std::string &data, const std::string &signature, const std::string &public_key) :
+			data_(data), signature_(signature), public_key_(public_key), valid_(false) {}
+
+		std::string data_;
+		std::string signature_;
+		std::string public_key_; //Encoded public key
+		bool valid_;
+	};
 	
 
 	class PublicKey {
@@ -70,6 +82,10 @@ namespace rexx {
 		SignatureType GetSignType() { return type_; };
 
 		static bool Verify(const std::string &data, const std::string &signature, const std::string &encode_public_key);
+
+		//Verify items in [begin, end). Ed25519 signatures are checked together by the batch equation,
+		//which falls back to single verification when the batch fails. Returns the number of valid items.
+		static size_t VerifyBatch(std::vector<SignatureItem> &items, size_t begin, size_t end);
 		static bool IsAddressValid(const std::string &encode_address);
 	private:
 		std::string raw_pub_key_;
@@ -0,0 +1,250 @@
+#include "signature_verifier.h"
+
+namespace rexx {
+
+	SignatureVerifier::SignatureVerifier() :
+		batch_size_(64),
+		pending_signatures_(0),
+		cache_size_(0),
+		cache_hit_count_(0),
+		batch_count_(0),
+		signature_count_(0),
+		invalid_count_(0) {
+		timer_name_ = "Signature Verifier";
+	}
+
+	SignatureVerifier::~SignatureVerifier() {}
+
+	bool SignatureVerifier::Initialize(size_t batch_size, size_t thread_count, size_t cache_size) {
+		batch_size_ = batch_size > 0 ? batch_size : 1;
+		cache_size_ = cache_size;
+		if (cache_size_ > 0) {
+			verified_cache_ = std::make_shared<cache::lru_cache<std::string, bool>>(cache_size_);
+		}
+		if (thread_count == 0) {
+			thread_count = utils::System::GetCpuCoreCount();
+		}
+
+		if (!pool_.Initialize("verifier", thread_count)) {
+			LOG_ERROR("Failed to start %u signature verification threads", (uint32_t)thread_count);
+			return false;
+		}
+
+		StatusModule::RegisterModule(this);
+		TimerNotify::RegisterModule(this);
+		return true;
+	}
+
+	bool SignatureVerifier::Exit() {
+		Flush();
+		return pool_.Exit();
+	}
+
+	size_t SignatureVerifier::Verify(std::vector<SignatureItem> &items, bool strict) {
+		if (items.empty()) {
+			return 0;
+		}
+
+		size_t chunk_count = (items.size() + batch_size_ - 1) / batch_size_;
+		std::vector<size_t> valid_counts(chunk_count, 0);
+		std::vector<WorkerPool::Task> tasks;
+		for (size_t i = 0; i < chunk_count; i++) {
+			size_t begin = i * batch_size_;
+			size_t end = std::min(begin + batch_size_, items.size());
+			size_t *valid_count = &valid_counts[i];
+			tasks.push_back([&items, begin, end, strict, valid_count]() {
+				if (!strict) {
+					*valid_count = PublicKey::VerifyBatch(items, begin, end);
+					return;
+				}
+
+				for (size_t j = begin; j < end; j++) {
+					SignatureItem &item = items[j];
+					item.valid_ = PublicKey::Verify(item.data_, item.signature_, item.public_key_);
+					if (item.valid_) (*valid_count)++;
+				}
+			});
+		}
+		pool_.RunAndWait(tasks);
+
+		size_t total_valid = 0;
+		for (size_t i = 0; i < chunk_count; i++) {
+			total_valid += valid_counts[i];
+		}
+
+		AddStatistics(items.size(), total_valid);
+		return total_valid;
+	}
+
+	size_t SignatureVerifier::VerifyCached(std::vector<SignatureItem> &items) {
+		if (!verified_cache_) {
+			return Verify(items, true);
+		}
+
+		std::vector<std::string> keys;
+		for (size_t i = 0; i < items.size(); i++) {
+			keys.push_back(GetCacheKey(items[i].data_, items[i].signature_, items[i].public_key_));
+		}
+
+		std::vector<SignatureItem> unchecked;
+		std::vector<size_t> positions;
+		size_t total_valid = 0;
+		do {
+			utils::MutexGuard guard(cache_lock_);
+			for (size_t i = 0; i < items.size(); i++) {
+				bool valid = false;
+				if (verified_cache_->get(keys[i], valid)) {
+					items[i].valid_ = true;
+					total_valid++;
+					cache_hit_count_++;
+				}
+				else {
+					unchecked.push_back(items[i]);
+					positions.push_back(i);
+				}
+			}
+		} while (false);
+
+		total_valid += Verify(unchecked, true);
+
+		utils::MutexGuard guard(cache_lock_);
+		for (size_t i = 0; i < unchecked.size(); i++) {
+			items[positions[i]].valid_ = unchecked[i].valid_;
+			if (unchecked[i].valid_) {
+				verified_cache_->put(keys[positions[i]], true);
+			}
+		}
+		return total_valid;
+	}
+
+	bool SignatureVerifier::VerifyCached(const std::string &data, const std::string &signature, const std::string &public_key) {
+		if (!verified_cache_) {
+			return PublicKey::Verify(data, signature, public_key);
+		}
+
+		std::string key = GetCacheKey(data, signature, public_key);
+		do {
+			utils::MutexGuard guard(cache_lock_);
+			bool valid = false;
+			if (verified_cache_->get(key, valid)) {
+				cache_hit_count_++;
+				return true;
+			}
+		} while (false);
+
+		if (!PublicKey::Verify(data, signature, public_key)) {
+			return false;
+		}
+
+		utils::MutexGuard guard(cache_lock_);
+		verified_cache_->put(key, true);
+		return true;
+	}
+
+	std::string SignatureVerifier::GetCacheKey(const std::string &data, const std::string &signature, const std::string &public_key) {
+		//The signature length keeps a signature and public key pair from aliasing another split of the same bytes
+		std::string key = HashWrapper::Crypto(data);
+		key += utils::String::Format("%u:", (uint32_t)signature.size());
+		key += signature;
+		key += public_key;
+		return HashWrapper::Crypto(key);
+	}
+
+	void SignatureVerifier::AsyncVerify(const std::vector<SignatureItem> &items, const VerifiedCallback &callback) {
+		bool need_flush = false;
+		do {
+			utils::MutexGuard guard(pending_lock_);
+			PendingRequest request;
+			request.items_ = items;
+			request.callback_ = callback;
+			pending_requests_.push_back(request);
+			pending_signatures_ += items.size();
+			need_flush = pending_signatures_ >= batch_size_;
+		} while (false);
+
+		if (need_flush) {
+			Flush();
+		}
+	}
+
+	void SignatureVerifier::Flush() {
+		PendingRequestList requests;
+		do {
+			utils::MutexGuard guard(pending_lock_);
+			requests.swap(pending_requests_);
+			pending_signatures_ = 0;
+		} while (false);
+
+		//Cut the queued requests into batches of about batch_size_ signatures
+		std::shared_ptr<PendingRequestList> batch = std::make_shared<PendingRequestList>();
+		size_t batch_signatures = 0;
+		for (size_t i = 0; i < requests.size(); i++) {
+			batch_signatures += requests[i].items_.size();
+			batch->push_back(requests[i]);
+			if (batch_signatures >= batch_size_ || i + 1 == requests.size()) {
+				pool_.Post(std::bind(&SignatureVerifier::VerifyRequests, this, batch));
+				batch = std::make_shared<PendingRequestList>();
+				batch_signatures = 0;
+			}
+		}
+	}
+
+	void SignatureVerifier::VerifyRequests(std::shared_ptr<PendingRequestList> requests) {
+		std::vector<SignatureItem> items;
+		for (size_t i = 0; i < requests->size(); i++) {
+			const std::vector<SignatureItem> &request_items = (*requests)[i].items_;
+			items.insert(items.end(), request_items.begin(), request_items.end());
+		}
+
+		size_t valid_count = PublicKey::VerifyBatch(items, 0, items.size());
+		AddStatistics(items.size(), valid_count);
+
+		size_t offset = 0;
+		for (size_t i = 0; i < requests->size(); i++) {
+			PendingRequest &request = (*requests)[i];
+			for (size_t j = 0; j < request.items_.size(); j++) {
+				request.items_[j].valid_ = items[offset + j].valid_;
+			}
+			offset += request.items_.size();
+			request.callback_(request.items_);
+		}
+	}
+
+	void SignatureVerifier::AddStatistics(size_t signature_count, size_t valid_count) {
+		utils::MutexGuard guard(statistics_lock_);
+		batch_count_++;
+		signature_count_ += signature_count;
+		invalid_count_ += signature_count - valid_count;
+	}
+
+	void SignatureVerifier::OnTimer(int64_t current_time) {
+		bool has_pending = false;
+		do {
+			utils::MutexGuard guard(pending_lock_);
+			has_pending = !pending_requests_.empty();
+		} while (false);
+
+		if (has_pending) {
+			Flush();
+		}
+	}
+
+	void SignatureVerifier::GetModuleStatus(Json::Value &data) {
+		data["name"] = "signature_verifier";
+		data["batch_size"] = (Json::UInt64)batch_size_;
+		data["thread_count"] = (Json::UInt64)pool_.Size();
+		data["pending_tasks"] = (Json::Int64)pool_.GetPendingCount();
+
+		do {
+			utils::MutexGuard guard(cache_lock_);
+			data["cache_size"] = (Json::UInt64)cache_size_;
+			data["cache_count"] = (Json::UInt64)(verified_cache_ ? verified_cache_->size() : 0);
+			data["cache_hit_count"] = (Json::Int64)cache_hit_count_;
+		} while (false);
+
+		utils::MutexGuard guard(statistics_lock_);
+		data["batch_count"] = (Json::Int64)batch_count_;
+		data["signature_count"] = (Json::Int64)signature_count_;
+		data["invalid_count"] = (Json::Int64)invalid_count_;
+	}
+}
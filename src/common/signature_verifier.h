@@ -0,0 +1,74 @@
+#ifndef SIGNATURE_VERIFIER_H_
+#define SIGNATURE_VERIFIER_H_
+
+#include <utils/lrucache.hpp>
+#include "general.h"
+#include "private_key.h"
+#include "worker_pool.h"
+
+namespace rexx {
+
+	//Verifies signatures on a worker pool. Requests arriving close together are merged into
+	//batches of batch_size signatures, so ed25519 signatures can share one batch equation.
+	class SignatureVerifier : public utils::Singleton<rexx::SignatureVerifier>,
+		public TimerNotify,
+		public StatusModule {
+		friend class utils::Singleton<rexx::SignatureVerifier>;
+	public:
+		typedef std::function<void(std::vector<SignatureItem> &items)> VerifiedCallback;
+
+		SignatureVerifier();
+		~SignatureVerifier();
+
+		bool Initialize(size_t batch_size, size_t thread_count, size_t cache_size);
+		bool Exit();
+
+		//Verify items across the pool and return the number of valid ones.
+		//The strict mode checks every signature on its own, use it where the result affects consensus.
+		size_t Verify(std::vector<SignatureItem> &items, bool strict);
+
+		//Strictly verify items whose result is remembered, a signature seen by several consensus paths
+		//is checked once. The items not cached yet are verified across the pool.
+		size_t VerifyCached(std::vector<SignatureItem> &items);
+		bool VerifyCached(const std::string &data, const std::string &signature, const std::string &public_key);
+
+		//Queue items for batch verification, the callback runs on a worker thread once they are checked.
+		void AsyncVerify(const std::vector<SignatureItem> &items, const VerifiedCallback &callback);
+
+		virtual void OnTimer(int64_t current_time) override;
+		virtual void OnSlowTimer(int64_t current_time) override {};
+		virtual void GetModuleStatus(Json::Value &data);
+
+	private:
+		struct PendingRequest {
+			std::vector<SignatureItem> items_;
+			VerifiedCallback callback_;
+		};
+		typedef std::vector<PendingRequest> PendingRequestList;
+
+		void Flush();
+		void VerifyRequests(std::shared_ptr<PendingRequestList> requests);
+		void AddStatistics(size_t signature_count, size_t valid_count);
+		static std::string GetCacheKey(const std::string &data, const std::string &signature, const std::string &public_key);
+
+		WorkerPool pool_;
+		size_t batch_size_;
+
+		utils::Mutex pending_lock_;
+		PendingRequestList pending_requests_;
+		size_t pending_signatures_;
+
+		//Keys of the signatures verified valid
+		utils::Mutex cache_lock_;
+		std::shared_ptr<cache::lru_cache<std::string, bool>> verified_cache_;
+		size_t cache_size_;
+		int64_t cache_hit_count_;
+
+		utils::Mutex statistics_lock_;
+		int64_t batch_count_;
+		int64_t signature_count_;
+		int64_t invalid_count_;
+	};
+}
+
+#endif
@@ -5,6 +5,11 @@
 #include <utils/file.h>
 #include "storage.h"
 #include "general.h"
+#ifndef WIN32
+#include <rocksdb/table.h>
+#include <rocksdb/filter_policy.h>
+#include <rocksdb/slice_transform.h>
+#endif
 #define REXX_ROCKSDB_MAX_OPEN_FILES 5000
 
 namespace rexx {
@@ -12,6 +17,16 @@ namespace rexx {
 
 	KeyValueDb::~KeyValueDb() {}
 
+	bool KeyValueDb::GetRange(const std::string &begin, const std::string &end, size_t limit, KeyValueList &records) {
+		return Scan(begin, end, [&records, limit](const std::string &key, const std::string &value) {
+			if (records.size() >= limit) {
+				return false;
+			}
+			records.push_back(std::make_pair(key, value));
+			return true;
+		});
+	}
+
 #ifdef WIN32
 	LevelDbDriver::LevelDbDriver() {
 		db_ = NULL;
@@ -113,47 +128,233 @@ namespace rexx {
 		return db_->NewIterator(leveldb::ReadOptions());
 	}
 
+	bool LevelDbDriver::Scan(const std::string &begin, const std::string &end, const KeyValueVisitor &visitor) {
+		std::unique_ptr<leveldb::Iterator> it(db_->NewIterator(leveldb::ReadOptions()));
+		for (it->Seek(begin); it->Valid(); it->Next()) {
+			if (!end.empty() && it->key().compare(end) >= 0) {
+				break;
+			}
+			if (!visitor(it->key().ToString(), it->value().ToString())) {
+				break;
+			}
+		}
+
+		if (!it->status().ok()) {
+			utils::MutexGuard guard(mutex_);
+			error_desc_ = it->status().ToString();
+			return false;
+		}
+		return true;
+	}
+
 	bool LevelDbDriver::GetOptions(Json::Value &options) {
 		return true;
 	}
 
 #else
 
-	RocksDbDriver::RocksDbDriver() {
+	//The snapshot the reads of the current thread are on, see StorageReadGuard
+	static thread_local const rocksdb::Snapshot *thread_snapshot = NULL;
+
+	RocksDbDriver::RocksDbDriver(const DbProfile &profile, std::shared_ptr<rocksdb::Cache> block_cache) {
 		db_ = NULL;
+		owns_db_ = true;
+		profile_ = profile;
+		block_cache_ = block_cache;
+		default_family_ = NULL;
+	}
+
+	RocksDbDriver::RocksDbDriver(rocksdb::DB *db, rocksdb::ColumnFamilyHandle *family, const DbProfile &profile, std::shared_ptr<rocksdb::Cache> block_cache) {
+		db_ = db;
+		owns_db_ = false;
+		profile_ = profile;
+		block_cache_ = block_cache;
+		default_family_ = family;
 	}
 
 	RocksDbDriver::~RocksDbDriver() {
-		if (db_ != NULL) {
-			delete db_;
-			db_ = NULL;
-		}
+		Close();
 	}
 
-	bool RocksDbDriver::Open(const std::string &db_path, int max_open_files) {
-		rocksdb::Options options;
+	rocksdb::DBOptions RocksDbDriver::GetDbOptions(int max_open_files) {
+		rocksdb::DBOptions options;
 		if (max_open_files > 0)
 		{
 			options.max_open_files = max_open_files;
 		}
+		if (profile_.background_threads_ > 0) {
+			options.IncreaseParallelism(profile_.background_threads_);
+		}
 		options.create_if_missing = true;
-		rocksdb::Status status = rocksdb::DB::Open(options, db_path, &db_);
+		options.create_missing_column_families = true;
+		return options;
+	}
+
+	rocksdb::ColumnFamilyOptions RocksDbDriver::GetFamilyOptions() {
+		rocksdb::ColumnFamilyOptions options;
+		rocksdb::BlockBasedTableOptions table_options;
+		if (block_cache_) {
+			table_options.block_cache = block_cache_;
+		}
+		if (profile_.bloom_bits_ > 0) {
+			table_options.filter_policy.reset(rocksdb::NewBloomFilterPolicy(profile_.bloom_bits_));
+		}
+		options.table_factory.reset(rocksdb::NewBlockBasedTableFactory(table_options));
+
+		if (profile_.prefix_length_ > 0) {
+			options.prefix_extractor.reset(rocksdb::NewFixedPrefixTransform(profile_.prefix_length_));
+		}
+
+		if (profile_.write_buffer_size_ > 0) {
+			options.write_buffer_size = (size_t)profile_.write_buffer_size_ * utils::BYTES_PER_MEGA;
+		}
+
+		if (profile_.compaction_style_ == "universal") {
+			options.compaction_style = rocksdb::kCompactionStyleUniversal;
+		}
+		else {
+			options.compaction_style = rocksdb::kCompactionStyleLevel;
+		}
+		return options;
+	}
+
+	rocksdb::WriteOptions RocksDbDriver::GetWriteOptions(bool batch) {
+		rocksdb::WriteOptions opt;
+		switch (profile_.sync_policy_) {
+		case DbProfile::SYNC_ALWAYS:
+			opt.sync = true;
+			break;
+		case DbProfile::SYNC_BATCH:
+			opt.sync = batch;
+			break;
+		default:
+			opt.sync = false;
+			break;
+		}
+		return opt;
+	}
+
+	rocksdb::ReadOptions RocksDbDriver::GetReadOptions() {
+		rocksdb::ReadOptions opt;
+		//Only the views of the unified db read on the snapshot of the thread, it is a snapshot of that db
+		if (!owns_db_) {
+			opt.snapshot = thread_snapshot;
+		}
+		return opt;
+	}
+
+	rocksdb::ColumnFamilyHandle *RocksDbDriver::GetFamily(const rocksdb::Slice &key) {
+		//The longest matching prefix wins
+		rocksdb::ColumnFamilyHandle *family = default_family_;
+		size_t matched = 0;
+		for (std::map<std::string, rocksdb::ColumnFamilyHandle *>::iterator iter = families_.begin(); iter != families_.end(); iter++) {
+			if (iter->first.size() > matched && key.starts_with(iter->first)) {
+				family = iter->second;
+				matched = iter->first.size();
+			}
+		}
+		return family;
+	}
+
+	void RocksDbDriver::CloseFamilies() {
+		for (std::map<std::string, rocksdb::ColumnFamilyHandle *>::iterator iter = families_.begin(); iter != families_.end(); iter++) {
+			delete iter->second;
+		}
+		families_.clear();
+
+		if (default_family_ != NULL) {
+			delete default_family_;
+			default_family_ = NULL;
+		}
+	}
+
+	bool RocksDbDriver::Open(const std::string &db_path, int max_open_files) {
+		rocksdb::DBOptions options = GetDbOptions(max_open_files);
+
+		//The column families of an existing db stay as they were created, or its keys could not be found
+		std::vector<std::string> names;
+		rocksdb::Status status = rocksdb::DB::ListColumnFamilies(options, db_path, &names);
+		if (status.ok()) {
+			std::set<std::string> configured(profile_.column_families_.begin(), profile_.column_families_.end());
+			configured.insert(rocksdb::kDefaultColumnFamilyName);
+			if (configured != std::set<std::string>(names.begin(), names.end())) {
+				LOG_WARN("The column families of db(%s) differ from profile(%s), the ones of the db are used",
+					db_path.c_str(), profile_.name_.c_str());
+			}
+		}
+		else {
+			names.clear();
+			names.push_back(rocksdb::kDefaultColumnFamilyName);
+			for (utils::StringList::const_iterator iter = profile_.column_families_.begin(); iter != profile_.column_families_.end(); iter++) {
+				if (*iter != rocksdb::kDefaultColumnFamilyName && !iter->empty()) {
+					names.push_back(*iter);
+				}
+			}
+		}
+
+		rocksdb::ColumnFamilyOptions family_options = GetFamilyOptions();
+		std::vector<rocksdb::ColumnFamilyDescriptor> descriptors;
+		for (size_t i = 0; i < names.size(); i++) {
+			descriptors.push_back(rocksdb::ColumnFamilyDescriptor(names[i], family_options));
+		}
+
+		std::vector<rocksdb::ColumnFamilyHandle *> handles;
+		status = rocksdb::DB::Open(options, db_path, descriptors, &handles, &db_);
 		if (!status.ok()) {
 			utils::MutexGuard guard(mutex_);
 			error_desc_ = status.ToString();
+			return false;
 		}
-		return status.ok();
+
+		for (size_t i = 0; i < handles.size(); i++) {
+			if (handles[i]->GetName() == rocksdb::kDefaultColumnFamilyName) {
+				default_family_ = handles[i];
+			}
+			else {
+				families_[handles[i]->GetName()] = handles[i];
+			}
+		}
+		return true;
+	}
+
+	rocksdb::DB *RocksDbDriver::OpenUnified(const std::string &db_path, int max_open_files, const DbProfile &profile, std::shared_ptr<rocksdb::Cache> block_cache,
+		const std::vector<std::string> &names, std::vector<RocksDbDriver *> &views, std::string &error_desc) {
+		RocksDbDriver tuning(profile, block_cache);
+		rocksdb::ColumnFamilyOptions family_options = tuning.GetFamilyOptions();
+		std::vector<rocksdb::ColumnFamilyDescriptor> descriptors;
+		descriptors.push_back(rocksdb::ColumnFamilyDescriptor(rocksdb::kDefaultColumnFamilyName, family_options));
+		for (size_t i = 0; i < names.size(); i++) {
+			descriptors.push_back(rocksdb::ColumnFamilyDescriptor(names[i], family_options));
+		}
+
+		rocksdb::DB *db = NULL;
+		std::vector<rocksdb::ColumnFamilyHandle *> handles;
+		rocksdb::Status status = rocksdb::DB::Open(tuning.GetDbOptions(max_open_files), db_path, descriptors, &handles, &db);
+		if (!status.ok()) {
+			error_desc = status.ToString();
+			return NULL;
+		}
+
+		//Nothing is kept in the default family
+		delete handles[0];
+		for (size_t i = 1; i < handles.size(); i++) {
+			views.push_back(new RocksDbDriver(db, handles[i], profile, block_cache));
+		}
+		return db;
 	}
 
 	bool RocksDbDriver::Close() {
-		delete db_;
+		CloseFamilies();
+		if (owns_db_ && db_ != NULL) {
+			delete db_;
+		}
 		db_ = NULL;
 		return true;
 	}
 
 	int32_t RocksDbDriver::Get(const std::string &key, std::string &value) {
 		assert(db_ != NULL);
-		rocksdb::Status status = db_->Get(rocksdb::ReadOptions(), key, &value);
+		rocksdb::Status status = db_->Get(GetReadOptions(), GetFamily(key), key, &value);
 		if (status.ok()) {
 			return 1;
 		}
@@ -169,9 +370,7 @@ namespace rexx {
 
 	bool RocksDbDriver::Put(const std::string &key, const std::string &value) {
 		assert(db_ != NULL);
-		rocksdb::WriteOptions opt;
-		opt.sync = true;
-		rocksdb::Status status = db_->Put(opt, key, value);
+		rocksdb::Status status = db_->Put(GetWriteOptions(false), GetFamily(key), key, value);
 		if (!status.ok()) {
 			utils::MutexGuard guard(mutex_);
 			error_desc_ = status.ToString();
@@ -181,9 +380,7 @@ namespace rexx {
 
 	bool RocksDbDriver::Delete(const std::string &key) {
 		assert(db_ != NULL);
-		rocksdb::WriteOptions opt;
-		opt.sync = true;
-		rocksdb::Status status = db_->Delete(opt, key);
+		rocksdb::Status status = db_->Delete(GetWriteOptions(false), GetFamily(key), key);
 		if (!status.ok()) {
 			utils::MutexGuard guard(mutex_);
 			error_desc_ = status.ToString();
@@ -191,11 +388,39 @@ namespace rexx {
 		return status.ok();
 	}
 
-	bool RocksDbDriver::WriteBatch(WRITE_BATCH &write_batch) {
+	//Copy the records of a batch built on the default column family into the families of their keys
+	class FamilyRouter : public rocksdb::WriteBatch::Handler {
+	public:
+		FamilyRouter(rocksdb::WriteBatch &batch, std::function<rocksdb::ColumnFamilyHandle *(const rocksdb::Slice &)> get_family)
+			: batch_(batch), get_family_(get_family) {}
 
-		rocksdb::WriteOptions opt;
-		opt.sync = true;
-		rocksdb::Status status = db_->Write(opt, &write_batch);
+		rocksdb::Status PutCF(uint32_t column_family_id, const rocksdb::Slice& key, const rocksdb::Slice& value) {
+			batch_.Put(get_family_(key), key, value);
+			return rocksdb::Status::OK();
+		}
+
+		rocksdb::Status DeleteCF(uint32_t column_family_id, const rocksdb::Slice& key) {
+			batch_.Delete(get_family_(key), key);
+			return rocksdb::Status::OK();
+		}
+
+	private:
+		rocksdb::WriteBatch &batch_;
+		std::function<rocksdb::ColumnFamilyHandle *(const rocksdb::Slice &)> get_family_;
+	};
+
+	bool RocksDbDriver::Route(WRITE_BATCH &from, WRITE_BATCH &to) {
+		FamilyRouter router(to, [this](const rocksdb::Slice &key) { return GetFamily(key); });
+		rocksdb::Status status = from.Iterate(&router);
+		if (!status.ok()) {
+			utils::MutexGuard guard(mutex_);
+			error_desc_ = status.ToString();
+		}
+		return status.ok();
+	}
+
+	bool RocksDbDriver::WriteRouted(WRITE_BATCH &batch) {
+		rocksdb::Status status = db_->Write(GetWriteOptions(true), &batch);
 		if (!status.ok()) {
 			utils::MutexGuard guard(mutex_);
 			error_desc_ = status.ToString();
@@ -203,8 +428,61 @@ namespace rexx {
 		return status.ok();
 	}
 
+	bool RocksDbDriver::WriteBatch(WRITE_BATCH &write_batch) {
+		if (owns_db_ && families_.empty()) {
+			return WriteRouted(write_batch);
+		}
+
+		WRITE_BATCH routed;
+		return Route(write_batch, routed) && WriteRouted(routed);
+	}
+
 	void* RocksDbDriver::NewIterator() {
-		return db_->NewIterator(rocksdb::ReadOptions());
+		return db_->NewIterator(rocksdb::ReadOptions(), default_family_);
+	}
+
+	bool RocksDbDriver::Scan(const std::string &begin, const std::string &end, const KeyValueVisitor &visitor) {
+		//Ranges may cross column families, so the iterators of all families are merged in key order
+		rocksdb::ReadOptions read_options = GetReadOptions();
+		read_options.total_order_seek = true;
+		std::vector<std::unique_ptr<rocksdb::Iterator>> iters;
+		iters.emplace_back(db_->NewIterator(read_options, default_family_));
+		for (std::map<std::string, rocksdb::ColumnFamilyHandle *>::iterator iter = families_.begin(); iter != families_.end(); iter++) {
+			iters.emplace_back(db_->NewIterator(read_options, iter->second));
+		}
+
+		for (size_t i = 0; i < iters.size(); i++) {
+			iters[i]->Seek(begin);
+		}
+
+		do {
+			rocksdb::Iterator *it = NULL;
+			for (size_t i = 0; i < iters.size(); i++) {
+				if (iters[i]->Valid() && (it == NULL || iters[i]->key().compare(it->key()) < 0)) {
+					it = iters[i].get();
+				}
+			}
+
+			if (it == NULL) {
+				break;
+			}
+			if (!end.empty() && it->key().compare(end) >= 0) {
+				break;
+			}
+			if (!visitor(it->key().ToString(), it->value().ToString())) {
+				break;
+			}
+			it->Next();
+		} while (true);
+
+		for (size_t i = 0; i < iters.size(); i++) {
+			if (!iters[i]->status().ok()) {
+				utils::MutexGuard guard(mutex_);
+				error_desc_ = iters[i]->status().ToString();
+				return false;
+			}
+		}
+		return true;
 	}
 
 	bool RocksDbDriver::GetOptions(Json::Value &options) {
@@ -217,6 +495,18 @@ namespace rexx {
 
 		db_->GetProperty("rocksdb.stats", &out);
 		options["rocksdb.stats"] = out;
+
+		options["profile"] = profile_.name_;
+		options["sync_policy"] = profile_.sync_policy_str_;
+		if (block_cache_) {
+			options["block_cache_usage"] = (Json::UInt64)block_cache_->GetUsage();
+			options["block_cache_capacity"] = (Json::UInt64)block_cache_->GetCapacity();
+		}
+		Json::Value &families = options["column_families"];
+		families = Json::Value(Json::arrayValue);
+		for (std::map<std::string, rocksdb::ColumnFamilyHandle *>::iterator iter = families_.begin(); iter != families_.end(); iter++) {
+			families.append(iter->first);
+		}
 		return true;
 	}
 #endif
@@ -225,6 +515,11 @@ namespace rexx {
 		keyvalue_db_ = NULL;
 		ledger_db_ = NULL;
 		account_db_ = NULL;
+#ifndef WIN32
+		unified_db_ = NULL;
+		snapshot_retain_ = 0;
+		snapshot_readers_ = 0;
+#endif
 		check_interval_ = utils::MICRO_UNITS_PER_SEC;
 	}
 
@@ -255,8 +550,8 @@ namespace rexx {
 				do {
 					//Check only for linux or mac whether the account db can be opened.
 #ifndef WIN32
-					KeyValueDb *account_db = NewKeyValueDb(db_config);
-					if (!account_db->Open(db_config.account_db_path_, -1)) {
+					KeyValueDb *account_db = NewKeyValueDb(db_config, db_config.account_profile_);
+					if (!account_db->Open(db_config.unified_ ? db_config.unified_db_path_ : db_config.account_db_path_, -1)) {
 						LOG_ERROR("Failed to drop db.Error description(%s)", account_db->error_desc().c_str());
 						delete account_db;
 						break;
@@ -278,6 +573,11 @@ namespace rexx {
 						LOG_ERROR_ERRNO("Failed to delete account db", STD_ERR_CODE, STD_ERR_DESC);
 						break;
 					}
+
+					if (utils::File::IsExist(db_config.unified_db_path_) && !utils::File::DeleteFolder(db_config.unified_db_path_)) {
+						LOG_ERROR_ERRNO("Failed to delete unified db", STD_ERR_CODE, STD_ERR_DESC);
+						break;
+					}
 					
 					LOG_INFO("Drop db successful");
 					do_success = true;
@@ -320,21 +620,83 @@ namespace rexx {
 			LOG_INFO("Assigned number of file handles in mac os, max :%d, keyvaule used:%d, ledger used:%d, account used:%d:",
 				max_open_files, keyvaule_max_open_files, ledger_max_open_files, account_max_open_files);
 #endif
-			keyvalue_db_ = NewKeyValueDb(db_config);
+			if (db_config.unified_) {
+#ifdef WIN32
+				LOG_WARN("The unified storage needs rocksdb, the databases are opened apart");
+#else
+				//Opening an empty unified db next to the separate ones would start the node again from the genesis ledger
+				if (!utils::File::IsExist(db_config.unified_db_path_) &&
+					(utils::File::IsExist(db_config.keyvalue_db_path_) || utils::File::IsExist(db_config.ledger_db_path_) ||
+					utils::File::IsExist(db_config.account_db_path_))) {
+					LOG_ERROR("Failed to open unified db path(%s), it does not exist while the separate databases do. "
+						"Turn the unified mode off, or drop the databases with --dropdb and synchronize again", db_config.unified_db_path_.c_str());
+					break;
+				}
+
+				//One db with a column family for each database, it is tuned by the account profile
+				const DbProfile &profile = db_config.GetProfile(db_config.account_profile_);
+				if (!profile.column_families_.empty()) {
+					LOG_WARN("The column families of profile(%s) are not used by the unified db", profile.name_.c_str());
+				}
+
+				int32_t unified_max_open_files = -1;
+				if (keyvaule_max_open_files > 0 && ledger_max_open_files > 0 && account_max_open_files > 0) {
+					unified_max_open_files = keyvaule_max_open_files + ledger_max_open_files + account_max_open_files;
+				}
+
+				std::vector<std::string> names;
+				names.push_back("keyvalue");
+				names.push_back("ledger");
+				names.push_back("account");
+				std::vector<RocksDbDriver *> views;
+				std::string error_desc;
+				unified_db_ = RocksDbDriver::OpenUnified(db_config.unified_db_path_, unified_max_open_files, profile, GetBlockCache(profile), names, views, error_desc);
+				if (unified_db_ == NULL) {
+					LOG_ERROR("Failed to open unified db path(%s), the reason is(%s)\n",
+						db_config.unified_db_path_.c_str(), error_desc.c_str());
+					break;
+				}
+
+				keyvalue_db_ = views[0];
+				ledger_db_ = views[1];
+				account_db_ = views[2];
+
+				//Readers can pin the last closed ledger from the start
+				snapshot_retain_ = db_config.snapshot_retain_ > 0 ? db_config.snapshot_retain_ : 1;
+				std::string seq;
+				if (ledger_db_->Get(General::KEY_LEDGER_SEQ, seq) > 0) {
+					RetainSnapshot(utils::String::Stoi64(seq));
+				}
+
+				TimerNotify::RegisterModule(this);
+				return true;
+#endif
+			}
+
+#ifndef WIN32
+			if (!db_config.unified_ && utils::File::IsExist(db_config.unified_db_path_) && !utils::File::IsExist(db_config.account_db_path_)) {
+				LOG_ERROR("Failed to open account db path(%s), it does not exist while the unified db(%s) does. "
+					"Turn the unified mode on, or drop the databases with --dropdb and synchronize again",
+					db_config.account_db_path_.c_str(), db_config.unified_db_path_.c_str());
+				break;
+			}
+#endif
+
+			keyvalue_db_ = NewKeyValueDb(db_config, db_config.keyvalue_profile_);
 			if (!keyvalue_db_->Open(db_config.keyvalue_db_path_, keyvaule_max_open_files)) {
 				LOG_ERROR("Failed to open keyvalue db path(%s), the reason is(%s)\n",
 					db_config.keyvalue_db_path_.c_str(), keyvalue_db_->error_desc().c_str());
 				break;
 			}
 
-			ledger_db_ = NewKeyValueDb(db_config);
+			ledger_db_ = NewKeyValueDb(db_config, db_config.ledger_profile_);
 			if (!ledger_db_->Open(db_config.ledger_db_path_, ledger_max_open_files)) {
 				LOG_ERROR("Failed to open ledger db path(%s), the reason is(%s)\n",
 					db_config.ledger_db_path_.c_str(), ledger_db_->error_desc().c_str());
 				break;
 			}
 
-			account_db_ = NewKeyValueDb(db_config);
+			account_db_ = NewKeyValueDb(db_config, db_config.account_profile_);
 			if (!account_db_->Open(db_config.account_db_path_, account_max_open_files)) {
 				LOG_ERROR("Failed to open account db path(%s), the reason is(%s)\n",
 					db_config.account_db_path_.c_str(), account_db_->error_desc().c_str());
@@ -353,6 +715,18 @@ namespace rexx {
 
 	bool  Storage::CloseDb() {
 		bool ret1 = true, ret2 = true, ret3 = true;
+#ifndef WIN32
+		//No new reader pins a snapshot once they are cleared, wait for those still reading the views
+		if (unified_db_ != NULL) {
+			for (int64_t readers = -1; readers != 0;) {
+				if (readers > 0) utils::Sleep(10);
+
+				utils::MutexGuard guard(snapshots_mutex_);
+				snapshots_.clear();
+				readers = snapshot_readers_;
+			}
+		}
+#endif
 		if (keyvalue_db_ != NULL) {
 			ret1 = keyvalue_db_->Close();
 			delete keyvalue_db_;
@@ -371,6 +745,14 @@ namespace rexx {
 			account_db_ = NULL;
 		}
 
+#ifndef WIN32
+		//The views and the snapshots are released before their db
+		if (unified_db_ != NULL) {
+			delete unified_db_;
+			unified_db_ = NULL;
+		}
+#endif
+
 		return ret1 && ret2 && ret3;
 	}
 
@@ -393,14 +775,157 @@ namespace rexx {
 		return account_db_;
 	}
 
-	KeyValueDb *Storage::NewKeyValueDb(const DbConfigure &db_config) {
+	bool Storage::WriteLedger(int64_t seq, WRITE_BATCH &ledger_batch, WRITE_BATCH &account_batch, std::function<void()> written) {
+#ifndef WIN32
+		if (unified_db_ != NULL) {
+			RocksDbDriver *ledger_db = (RocksDbDriver *)ledger_db_;
+			RocksDbDriver *account_db = (RocksDbDriver *)account_db_;
+			WRITE_BATCH batch;
+			if (!ledger_db->Route(ledger_batch, batch) || !account_db->Route(account_batch, batch)) {
+				LOG_ERROR("Failed to route the ledger batches, ledger(%s) account(%s)", ledger_db->error_desc().c_str(), account_db->error_desc().c_str());
+				return false;
+			}
+
+			if (!ledger_db->WriteRouted(batch)) {
+				LOG_ERROR("Failed to write ledger to unified db(%s)", ledger_db->error_desc().c_str());
+				return false;
+			}
+
+			RetainSnapshot(seq);
+			if (written) written();
+			return true;
+		}
+#endif
+
+		utils::WriteLockGuard guard(account_ledger_lock_);
+		if (!ledger_db_->WriteBatch(ledger_batch)) {
+			LOG_ERROR("Failed to write ledger to database(%s)", ledger_db_->error_desc().c_str());
+			return false;
+		}
+
+		if (!account_db_->WriteBatch(account_batch)) {
+			LOG_ERROR("Failed to write accounts to database(%s)", account_db_->error_desc().c_str());
+			return false;
+		}
+
+		if (written) written();
+		return true;
+	}
+
+	bool Storage::IsUnified() {
+#ifndef WIN32
+		return unified_db_ != NULL;
+#else
+		return false;
+#endif
+	}
+
+	KeyValueDb *Storage::NewKeyValueDb(const DbConfigure &db_config, const std::string &profile_name) {
 		KeyValueDb *db = NULL;
+		const DbProfile &profile = db_config.GetProfile(profile_name);
 #ifdef WIN32
 		db = new LevelDbDriver();
 #else
-		db = new RocksDbDriver();
+		db = new RocksDbDriver(profile, GetBlockCache(profile));
 #endif
 
 		return db;
 	}
+
+#ifndef WIN32
+	void Storage::RetainSnapshot(int64_t seq) {
+		rocksdb::DB *db = unified_db_;
+		SnapshotPointer snapshot(db->GetSnapshot(), [db](const rocksdb::Snapshot *snapshot) {
+			db->ReleaseSnapshot(snapshot);
+		});
+
+		//A reader still holding an evicted snapshot releases it when it is done
+		utils::MutexGuard guard(snapshots_mutex_);
+		snapshots_[seq] = snapshot;
+		while (snapshots_.size() > snapshot_retain_) {
+			snapshots_.erase(snapshots_.begin());
+		}
+	}
+
+	std::shared_ptr<rocksdb::Cache> Storage::GetBlockCache(const DbProfile &profile) {
+		if (profile.block_cache_size_ <= 0) {
+			return std::shared_ptr<rocksdb::Cache>();
+		}
+
+		std::shared_ptr<rocksdb::Cache> &cache = block_caches_[profile.name_];
+		if (!cache) {
+			cache = rocksdb::NewLRUCache((size_t)profile.block_cache_size_ * utils::BYTES_PER_MEGA);
+		}
+		return cache;
+	}
+#endif
+
+	StorageReadGuard::StorageReadGuard(int64_t seq) {
+		Storage &storage = Storage::Instance();
+		locked_ = false;
+		pinned_ = false;
+		seq_ = 0;
+#ifndef WIN32
+		previous_ = thread_snapshot;
+		if (storage.unified_db_ != NULL) {
+			utils::MutexGuard guard(storage.snapshots_mutex_);
+			std::map<int64_t, SnapshotPointer>::iterator iter = storage.snapshots_.end();
+			if (seq != 0) {
+				iter = storage.snapshots_.find(seq);
+			}
+			else if (!storage.snapshots_.empty()) {
+				iter--;
+			}
+
+			if (iter != storage.snapshots_.end()) {
+				seq_ = iter->first;
+				snapshot_ = iter->second;
+				thread_snapshot = snapshot_.get();
+				pinned_ = true;
+				storage.snapshot_readers_++;
+			}
+			return;
+		}
+#endif
+		storage.account_ledger_lock_.ReadLock();
+		locked_ = true;
+
+		std::string last_seq;
+		if (storage.ledger_db_->Get(General::KEY_LEDGER_SEQ, last_seq) > 0) {
+			seq_ = utils::String::Stoi64(last_seq);
+		}
+		pinned_ = (seq == 0 || seq == seq_);
+	}
+
+	StorageReadGuard::~StorageReadGuard() {
+#ifndef WIN32
+		if (snapshot_) {
+			thread_snapshot = previous_;
+			snapshot_.reset();
+
+			Storage &storage = Storage::Instance();
+			utils::MutexGuard guard(storage.snapshots_mutex_);
+			storage.snapshot_readers_--;
+		}
+#endif
+		if (locked_) {
+			Storage::Instance().account_ledger_lock_.ReadUnlock();
+		}
+	}
+
+	bool StorageReadGuard::IsPinned() const {
+		return pinned_;
+	}
+
+	int64_t StorageReadGuard::GetLedgerSeq() const {
+		return seq_;
+	}
+
+	bool StorageReadGuard::OnSnapshot() {
+#ifndef WIN32
+		return thread_snapshot != NULL;
+#else
+		return false;
+#endif
+	}
 }
@@ -11,6 +11,7 @@
 #include <leveldb/leveldb.h>
 #else
 #include <rocksdb/db.h>
+#include <rocksdb/cache.h>
 #endif
 
 namespace rexx {
@@ -28,6 +29,9 @@ namespace rexx {
 #define SLICE       rocksdb::Slice
 #endif
 
+	typedef std::function<bool(const std::string &key, const std::string &value)> KeyValueVisitor;
+	typedef std::vector<std::pair<std::string, std::string>> KeyValueList;
+
 	class KeyValueDb {
 	protected:
 		utils::Mutex mutex_;
@@ -47,6 +51,11 @@ namespace rexx {
 		virtual bool WriteBatch(WRITE_BATCH &values) = 0;
 
 		virtual void* NewIterator() = 0;
+
+		//Visit the records in [begin, end) in key order, an empty end means no upper bound.
+		//The visit stops when the visitor returns false.
+		virtual bool Scan(const std::string &begin, const std::string &end, const KeyValueVisitor &visitor) = 0;
+		bool GetRange(const std::string &begin, const std::string &end, size_t limit, KeyValueList &records);
 	};
 
 #ifdef WIN32
@@ -67,16 +76,41 @@ namespace rexx {
 		bool WriteBatch(WRITE_BATCH &values);
 
 		void* NewIterator();
+		bool Scan(const std::string &begin, const std::string &end, const KeyValueVisitor &visitor);
 	};
 #else
 	class RocksDbDriver : public KeyValueDb {
 	private:
 		rocksdb::DB* db_;
+		bool owns_db_;
+		DbProfile profile_;
+		std::shared_ptr<rocksdb::Cache> block_cache_;
+
+		//Handles of the column families by key prefix, keys out of every prefix go to the default one
+		rocksdb::ColumnFamilyHandle *default_family_;
+		std::map<std::string, rocksdb::ColumnFamilyHandle *> families_;
+
+		rocksdb::ColumnFamilyHandle *GetFamily(const rocksdb::Slice &key);
+		rocksdb::DBOptions GetDbOptions(int max_open_files);
+		rocksdb::ColumnFamilyOptions GetFamilyOptions();
+		rocksdb::WriteOptions GetWriteOptions(bool batch);
+		rocksdb::ReadOptions GetReadOptions();
+		void CloseFamilies();
 
 	public:
-		RocksDbDriver();
+		RocksDbDriver(const DbProfile &profile, std::shared_ptr<rocksdb::Cache> block_cache);
+		//A view of one column family of a db opened by OpenUnified, the view does not own the db
+		RocksDbDriver(rocksdb::DB *db, rocksdb::ColumnFamilyHandle *family, const DbProfile &profile, std::shared_ptr<rocksdb::Cache> block_cache);
 		~RocksDbDriver();
 
+		//Open one db with a column family for each name, and return a view of every family in the order of names
+		static rocksdb::DB *OpenUnified(const std::string &db_path, int max_open_files, const DbProfile &profile, std::shared_ptr<rocksdb::Cache> block_cache,
+			const std::vector<std::string> &names, std::vector<RocksDbDriver *> &views, std::string &error_desc);
+
+		//Copy the records of a batch into the column families of this db, then write batches of several views at once
+		bool Route(WRITE_BATCH &from, WRITE_BATCH &to);
+		bool WriteRouted(WRITE_BATCH &batch);
+
 		bool Open(const std::string &db_path, int max_open_files);
 		bool Close();
 		int32_t Get(const std::string &key, std::string &value);
@@ -85,12 +119,45 @@ namespace rexx {
 		bool GetOptions(Json::Value &options);
 		bool WriteBatch(WRITE_BATCH &values);
 
+		//Iterates the default column family only
 		void* NewIterator();
+		bool Scan(const std::string &begin, const std::string &end, const KeyValueVisitor &visitor);
 	};
 #endif
 
+#ifndef WIN32
+	typedef std::shared_ptr<const rocksdb::Snapshot> SnapshotPointer;
+#endif
+
+	//Consistent reads over the account and ledger databases, pinned to one closed ledger. With the unified
+	//storage the reads of the current thread see the snapshot taken when that ledger was written and take
+	//no lock. Otherwise only the last closed ledger can be pinned, and the guard holds the read side of
+	//account_ledger_lock_ so that no ledger is written meanwhile.
+	class StorageReadGuard {
+	public:
+		//seq 0 pins the last closed ledger
+		StorageReadGuard(int64_t seq = 0);
+		~StorageReadGuard();
+
+		//False when the ledger asked for is not retained any more, nothing is pinned then
+		bool IsPinned() const;
+		int64_t GetLedgerSeq() const;
+
+		//Whether the reads of the current thread are on a snapshot
+		static bool OnSnapshot();
+	private:
+		bool locked_;
+		bool pinned_;
+		int64_t seq_;
+#ifndef WIN32
+		SnapshotPointer snapshot_;
+		const rocksdb::Snapshot *previous_;
+#endif
+	};
+
 	class Storage : public utils::Singleton<rexx::Storage>, public TimerNotify {
 		friend class utils::Singleton<Storage>;
+		friend class StorageReadGuard;
 	private:
 		Storage();
 		~Storage();
@@ -98,12 +165,29 @@ namespace rexx {
 		KeyValueDb *keyvalue_db_;
 		KeyValueDb *ledger_db_;
 		KeyValueDb *account_db_;
+#ifndef WIN32
+		//The db holding the three databases as column families in the unified storage mode
+		rocksdb::DB *unified_db_;
+
+		//Snapshots of the last closed ledgers by seq, for the readers of the unified db
+		utils::Mutex snapshots_mutex_;
+		std::map<int64_t, SnapshotPointer> snapshots_;
+		size_t snapshot_retain_;
+		int64_t snapshot_readers_; //guards holding a snapshot, the db is closed once they are done
+		void RetainSnapshot(int64_t seq);
+#endif
 
 		bool CloseDb();
 		bool DescribeTable(const std::string &name, const std::string &sql_create_table);
 		bool ManualDescribeTables();
 
-		KeyValueDb *NewKeyValueDb(const DbConfigure &db_config);
+#ifndef WIN32
+		//Block caches by profile name, the databases of a profile share one cache
+		std::map<std::string, std::shared_ptr<rocksdb::Cache>> block_caches_;
+		std::shared_ptr<rocksdb::Cache> GetBlockCache(const DbProfile &profile);
+#endif
+
+		KeyValueDb *NewKeyValueDb(const DbConfigure &db_config, const std::string &profile_name);
 	public:
 		bool Initialize(const DbConfigure &db_config, bool bdropdb);
 		bool Exit();
@@ -112,6 +196,12 @@ namespace rexx {
 		KeyValueDb *account_db();   //Store account tree.
 		KeyValueDb *ledger_db();    //Store transactions and ledgers.
 
+		//Write the batches of a closed ledger. With the unified storage both batches are one atomic write with
+		//a single sync, otherwise the ledger batch is written first under the write side of account_ledger_lock_.
+		//written is called after the write, still under the lock.
+		bool WriteLedger(int64_t seq, WRITE_BATCH &ledger_batch, WRITE_BATCH &account_batch, std::function<void()> written = nullptr);
+		bool IsUnified();
+
 		//Lock the account db and ledger db to make the databases in synchronization.
 		utils::ReadWriteLock account_ledger_lock_;
 
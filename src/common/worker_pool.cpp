@@ -0,0 +1,96 @@
+#include "worker_pool.h"
+
+namespace rexx {
+
+	WorkerPool::WorkerPool() {}
+
+	WorkerPool::~WorkerPool() {
+		Exit();
+	}
+
+	bool WorkerPool::Initialize(const std::string &name, size_t thread_count) {
+		name_ = name;
+		for (size_t i = 0; i < thread_count; i++) {
+			utils::Thread *thread_p = new utils::Thread(this);
+			if (!thread_p->Start(utils::String::Format("%s-%d", name_.c_str(), (int32_t)i))) {
+				delete thread_p;
+				return false;
+			}
+
+			threads_.push_back(thread_p);
+			thread_ids_.insert(thread_p->thread_id());
+		}
+
+		return true;
+	}
+
+	bool WorkerPool::Exit() {
+		if (threads_.empty()) {
+			return true;
+		}
+
+		io_service_.stop();
+		for (size_t i = 0; i < threads_.size(); i++) {
+			utils::Thread *thread_p = threads_[i];
+			if (thread_p) {
+				thread_p->JoinWithStop();
+				delete thread_p;
+			}
+		}
+		threads_.clear();
+		thread_ids_.clear();
+		return true;
+	}
+
+	void WorkerPool::Post(const Task &task) {
+		if (threads_.empty()) {
+			task();
+			return;
+		}
+
+		pending_count_.Inc();
+		io_service_.post([this, task]() {
+			pending_count_.Dec();
+			task();
+		});
+	}
+
+	void WorkerPool::RunAndWait(const std::vector<Task> &tasks) {
+		if (tasks.empty()) {
+			return;
+		}
+
+		if (threads_.empty() || IsPoolThread()) {
+			for (size_t i = 0; i < tasks.size(); i++) {
+				tasks[i]();
+			}
+			return;
+		}
+
+		utils::Semaphore done;
+		for (size_t i = 0; i + 1 < tasks.size(); i++) {
+			const Task &task = tasks[i];
+			Post([&task, &done]() {
+				task();
+				done.Signal();
+			});
+		}
+
+		tasks.back()();
+		for (size_t i = 0; i + 1 < tasks.size(); i++) {
+			done.Wait();
+		}
+	}
+
+	bool WorkerPool::IsPoolThread() const {
+		return thread_ids_.find(utils::Thread::current_thread_id()) != thread_ids_.end();
+	}
+
+	void WorkerPool::Run(utils::Thread *thread) {
+		asio::io_service::work work(io_service_);
+		while (!io_service_.stopped()) {
+			asio::error_code err;
+			io_service_.run(err);
+		}
+	}
+}
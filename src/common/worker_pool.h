@@ -0,0 +1,43 @@
+#ifndef WORKER_POOL_H_
+#define WORKER_POOL_H_
+
+#include <asio.hpp>
+#include <utils/headers.h>
+
+namespace rexx {
+
+	//A fixed number of threads running one io_service, tasks are posted as closures.
+	class WorkerPool : public utils::Runnable {
+	public:
+		typedef std::function<void()> Task;
+
+		WorkerPool();
+		~WorkerPool();
+
+		bool Initialize(const std::string &name, size_t thread_count);
+		bool Exit();
+
+		//Queue a task, it runs on the caller's thread if the pool has no thread.
+		void Post(const Task &task);
+
+		//Run all the tasks on the pool and wait until every one of them returns.
+		//The calling thread runs the last task itself, and a call from the pool's own thread runs all of them inline.
+		void RunAndWait(const std::vector<Task> &tasks);
+
+		size_t Size() const { return threads_.size(); }
+		int64_t GetPendingCount() const { return pending_count_.value(); }
+
+		virtual void Run(utils::Thread *thread) override;
+
+	private:
+		bool IsPoolThread() const;
+
+		std::string name_;
+		asio::io_service io_service_;
+		std::vector<utils::Thread *> threads_;
+		std::set<size_t> thread_ids_;
+		utils::AtomicInt64 pending_count_;
+	};
+}
+
+#endif
@@ -1,6 +1,7 @@
 
 #include <utils/headers.h>
 #include <common/pb2json.h>
+#include <common/signature_verifier.h>
 #include "bft.h"
 
 namespace rexx {
@@ -450,8 +451,11 @@ namespace rexx {
 			return false;
 		}
 
-		//Check the signature
-		if (!PublicKey::Verify(pbft.SerializeAsString(), sig.sign_data(), sig.public_key())) {
+		//Check the signature, once for all the paths a message goes through
+		SignatureVerifier *verifier = SignatureVerifier::GetInstance();
+		bool verified = verifier ? verifier->VerifyCached(pbft.SerializeAsString(), sig.sign_data(), sig.public_key()) :
+			PublicKey::Verify(pbft.SerializeAsString(), sig.sign_data(), sig.public_key());
+		if (!verified) {
 			LOG_ERROR("Failed to check received message's signature, desc(%s)", PbftDesc::GetPbft(pbft).c_str());
 			return false;
 		}
@@ -1124,10 +1128,6 @@ namespace rexx {
 		//New view message
 		PbftEnvPointer msg = NewNewView(vc_instance);
 
-		LOG_INFO("Sending new view message, new view number(" FMT_I64 ")", vc_instance.view_number_);
-		//Send new view message
-		vc_instance.SendNewView(this, utils::Timestamp::HighResolution(), msg);
-
 		//Get last prepared consensus value
 		std::string last_cons_value;
 		if (vc_instance.pre_prepared_env_set.has_pre_prepare()) {
@@ -1161,6 +1161,11 @@ namespace rexx {
 		saver.SaveValue(PbftDesc::VIEWNUMBER_NAME, view_number_);
 
 		ClearViewChanges();
+		saver.Commit();
+
+		//Send new view message, after the view it enters is saved
+		LOG_INFO("Sending new view message, new view number(" FMT_I64 ")", vc_instance.view_number_);
+		vc_instance.SendNewView(this, utils::Timestamp::HighResolution(), msg);
 
 		notify_->OnResetCloseTimer();
 		OnViewChanged(last_cons_value);
@@ -1440,6 +1445,7 @@ namespace rexx {
 		view_active_ = false;
 		ValueSaver saver;
 		saver.SaveValue(PbftDesc::VIEW_ACTIVE, view_active_ ? 1 : 0);
+		saver.Commit();
 		protocol::PbftPreparedSet null_set;
 		PbftEnvPointer msg = NewViewChangeRawValue(view_number_ + 1, null_set);
 		SendMessage(msg);
@@ -1534,6 +1540,7 @@ namespace rexx {
 		data["view_active"] = view_active_;
 		data["is_leader"] = (replica_id_ == view_number_ % validators_.size());
 		data["validator_address"] = replica_id_ >= 0 ? private_key_.GetEncAddress() : "none";
+		ValueSaver::GetModuleStatus(data["value_saver"]);
 		Json::Value &instances = data["instances"];
 		for (PbftInstanceMap::const_iterator iter = instances_.begin(); iter != instances_.end(); iter++) {
 			const PbftInstance &instance = iter->second;
@@ -1742,6 +1749,17 @@ namespace rexx {
 			return false;
 		}
 
+		//Verify the commits not seen yet across the verifier pool, the checks below then hit the cache
+		SignatureVerifier *verifier = SignatureVerifier::GetInstance();
+		if (verifier) {
+			std::vector<SignatureItem> items;
+			for (int32_t i = 0; i < pbft_evidence.commits_size(); i++) {
+				const protocol::PbftEnv &env = pbft_evidence.commits(i);
+				items.push_back(SignatureItem(env.pbft().SerializeAsString(), env.signature().sign_data(), env.signature().public_key()));
+			}
+			verifier->VerifyCached(items);
+		}
+
 		for (int32_t i = 0; i < pbft_evidence.commits_size(); i++) {
 			const protocol::PbftEnv &env = pbft_evidence.commits(i);
 			const protocol::Pbft &pbft = env.pbft();
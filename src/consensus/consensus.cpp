@@ -91,6 +91,12 @@ namespace rexx {
 			return true;
 		}
 
+		//The state the message depends on must be durable before it leaves
+		if (!ValueSaver::Flush()) {
+			LOG_ERROR("Failed to send the consensus message, the values it depends on are not written");
+			return false;
+		}
+
 		notify_->SendConsensusMessage(message);
 		return true;
 	}
@@ -137,6 +143,11 @@ namespace rexx {
 	}
 
 	bool Consensus::SaveValue(const std::string &name, const std::string &value) {
+		//Never write ahead of the values still waiting for the group commit
+		if (!ValueSaver::Flush()) {
+			return false;
+		}
+
 		KeyValueDb *db = Storage::Instance().keyvalue_db();
 		return db->Put(utils::String::Format("%s_%s", rexx::General::CONSENSUS_PREFIX, name.c_str()), value);
 	}
@@ -147,11 +158,16 @@ namespace rexx {
 	}
 
 	int32_t Consensus::LoadValue(const std::string &name, std::string &value) {
+		ValueSaver::Flush();
 		KeyValueDb *db = Storage::Instance().keyvalue_db();
 		return db->Get(utils::String::Format("%s_%s", rexx::General::CONSENSUS_PREFIX, name.c_str()), value) ? 1 : 0;
 	}
 
 	bool Consensus::DelValue(const std::string &name) {
+		if (!ValueSaver::Flush()) {
+			return false;
+		}
+
 		KeyValueDb *db = Storage::Instance().keyvalue_db();
 		return db->Delete(utils::String::Format("%s_%s", rexx::General::CONSENSUS_PREFIX, name.c_str())) ? 1 : 0;
 	}
@@ -182,13 +198,25 @@ namespace rexx {
 		data["type"] = name_;
 	}
 
+	utils::Mutex ValueSaver::group_lock_;
+	WRITE_BATCH ValueSaver::group_writes_;
+	size_t ValueSaver::group_size_ = 0;
+	bool ValueSaver::flush_posted_ = false;
+	bool ValueSaver::flush_failed_ = false;
+	int64_t ValueSaver::flush_count_ = 0;
+	int64_t ValueSaver::commit_count_ = 0;
+
 	ValueSaver::ValueSaver() :write_size(0) {};
 	ValueSaver::~ValueSaver() {
 		Commit();
 	};
 
 	void ValueSaver::SaveValue(const std::string &name, const std::string &value) {
-		writes.Put(utils::String::Format("%s_%s", rexx::General::CONSENSUS_PREFIX, name.c_str()), value);
+		Write write;
+		write.key_ = utils::String::Format("%s_%s", rexx::General::CONSENSUS_PREFIX, name.c_str());
+		write.value_ = value;
+		write.delete_ = false;
+		writes.push_back(write);
 		write_size++;
 		LOG_TRACE("Set %s, value size =" FMT_SIZE ".", name.c_str(), value.size());
 	}
@@ -199,18 +227,78 @@ namespace rexx {
 	}
 
 	void ValueSaver::DelValue(const std::string &name) {
-		writes.Delete(name);
+		Write write;
+		write.key_ = name;
+		write.delete_ = true;
+		writes.push_back(write);
 		write_size++;
 	}
 
 	bool ValueSaver::Commit() {
-		KeyValueDb *db = Storage::Instance().keyvalue_db();
+		if (write_size == 0) {
+			return true;
+		}
+
+		bool post_flush = false;
 		bool ret = true;
-		if (write_size > 0) {
-			ret = db->WriteBatch(writes);
-			write_size = 0;
+		do {
+			utils::MutexGuard guard(group_lock_);
+			for (size_t i = 0; i < writes.size(); i++) {
+				if (writes[i].delete_) {
+					group_writes_.Delete(writes[i].key_);
+				}
+				else {
+					group_writes_.Put(writes[i].key_, writes[i].value_);
+				}
+			}
+			group_size_ += write_size;
+			commit_count_++;
+
+			post_flush = !flush_posted_;
+			flush_posted_ = true;
+			ret = !flush_failed_;
+		} while (false);
+
+		writes.clear();
+		write_size = 0;
+
+		//Flush when the current turn of the event loop ends
+		if (post_flush) {
+			Global::Instance().GetIoService().post([]() {
+				ValueSaver::Flush();
+			});
+		}
+
+		//The values are not lost, but they wait for the db as long as it fails
+		return ret;
+	}
+
+	bool ValueSaver::Flush() {
+		//Written under the lock, so batches reach the db in the order they were committed
+		utils::MutexGuard guard(group_lock_);
+		flush_posted_ = false;
+		if (group_size_ == 0) {
+			return true;
 		}
 
+		KeyValueDb *db = Storage::Instance().keyvalue_db();
+		flush_failed_ = !db->WriteBatch(group_writes_);
+		if (flush_failed_) {
+			//Keep the batch, the next flush writes it again and nothing is sent before
+			LOG_ERROR("Failed to write " FMT_SIZE " consensus values, error desc(%s)", group_size_, db->error_desc().c_str());
+			return false;
+		}
+
+		group_writes_.Clear();
+		group_size_ = 0;
+		flush_count_++;
 		return true;
 	}
+
+	void ValueSaver::GetModuleStatus(Json::Value &data) {
+		utils::MutexGuard guard(group_lock_);
+		data["commit_count"] = (Json::Int64)commit_count_;
+		data["flush_count"] = (Json::Int64)flush_count_;
+		data["pending_count"] = (Json::UInt64)group_size_;
+	}
 }
\ No newline at end of file
@@ -90,18 +90,41 @@ namespace rexx {
 		bool GetValidation(protocol::ValidatorSet &validators, size_t &quorum_size);
 	};
 
+	//The values committed by savers within one turn of the event loop are written to the db in one batch,
+	//flushed when the turn ends and before any consensus message is sent, so no message gets ahead of
+	//the state it depends on.
 	class ValueSaver {
 	public:
 		ValueSaver();
 		~ValueSaver();
 
+		struct Write {
+			std::string key_;
+			std::string value_;
+			bool delete_;
+		};
+
 		size_t write_size;
-		WRITE_BATCH writes;
+		std::vector<Write> writes;
 
 		void SaveValue(const std::string &name, const std::string &value);
 		void SaveValue(const std::string &name, int64_t value);
 		void DelValue(const std::string &name);
+		//False while the group commit fails to write, the values are kept until it succeeds
 		bool Commit();
+
+		//Write the values committed so far, false keeps them for the next flush
+		static bool Flush();
+		static void GetModuleStatus(Json::Value &data);
+
+	private:
+		static utils::Mutex group_lock_;
+		static WRITE_BATCH group_writes_;
+		static size_t group_size_;
+		static bool flush_posted_;
+		static bool flush_failed_;
+		static int64_t flush_count_;
+		static int64_t commit_count_;
 	};
 
 	class OneNode : public Consensus {
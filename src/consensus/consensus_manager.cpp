@@ -32,7 +32,10 @@ namespace rexx {
 	}
 
 	bool ConsensusManager::Exit() {
-		return consensus_->Exit();
+		bool ret = consensus_->Exit();
+
+		//Write the consensus values still waiting for the group commit
+		return ValueSaver::Flush() && ret;
 	}
 
 	std::shared_ptr<Consensus> ConsensusManager::GetConsensus() {
@@ -485,6 +485,12 @@ namespace rexx {
 		utils::Timestamp process_time_stamp(process_uptime_ * utils::MICRO_UNITS_PER_SEC);
 		system_json["process_uptime"] = process_time_stamp.ToFormatString(false);
 		system_json["current_time"] = utils::Timestamp::Now().ToFormatString(false);
+
+		utils::Logger &logger = utils::Logger::Instance();
+		Json::Value &logger_json = system_json["logger"];
+		logger_json["async"] = logger.IsAsync();
+		logger_json["async_written_count"] = (Json::Int64)logger.GetAsyncWrittenCount();
+		logger_json["dropped_count"] = (Json::Int64)logger.GetDroppedCount();
 		 
 		ledger_upgrade_.GetModuleStatus(data["ledger_upgrade"]);
 	}
@@ -2,98 +2,192 @@
 #include "transaction_queue.h"
 #include <ledger/ledger_manager.h>
 #include <algorithm>
+#include <queue>
 
 namespace rexx {
 
 	int64_t const QUEUE_TRANSACTION_TIMEOUT = 600 * utils::MICRO_UNITS_PER_SEC;
 
 	TransactionQueue::TransactionQueue(uint32_t queue_limit, uint32_t account_txs_limit)
-		: queue_(PriorityCompare{ *this }),
-		queue_limit_(queue_limit),
+		: queue_limit_(queue_limit),
 		account_txs_limit_(account_txs_limit)
 	{
 	}
 
 	TransactionQueue::~TransactionQueue(){}
 
-	
-	std::pair<bool, TransactionFrm::pointer> TransactionQueue::Remove(QueueByAddressAndNonce::iterator& account_it, QueueByNonce::iterator& tx_it, bool del_empty){
-		TransactionFrm::pointer ptr = nullptr;
-		ptr = *tx_it->second.first;
-		queue_.erase(tx_it->second.first);
-		time_queue_.erase(tx_it->second.second);
-		account_it->second.erase(tx_it);
-		queue_by_hash_.erase(ptr->GetContentHash());
-
-		if (del_empty && account_it->second.empty()){
-			account_nonce_.erase(account_it->first);
-			queue_by_address_and_nonce_.erase(account_it);
+	TransactionQueue::Shard& TransactionQueue::GetShard(const std::string& account_address){
+		return shards_[std::hash<std::string>()(account_address) % SHARD_COUNT];
+	}
+
+	TransactionQueue::HashShard& TransactionQueue::GetHashShard(const std::string& hash){
+		return hash_shards_[std::hash<std::string>()(hash) % SHARD_COUNT];
+	}
+
+	void TransactionQueue::DetachTail(Shard& shard, Lane& lane){
+		if (lane.has_tail_){
+			shard.tails_.erase(lane.tail_);
+			lane.has_tail_ = false;
+		}
+	}
+
+	void TransactionQueue::AttachTail(Shard& shard, const std::string& account_address, Lane& lane){
+		if (lane.txs_.empty()){
+			return;
+		}
+
+		const TransactionFrm::pointer& tail = lane.txs_.rbegin()->second.first;
+		lane.tail_.height_ = tail->GetNonce() - lane.account_nonce_;
+		lane.tail_.gas_price_ = tail->GetGasPrice();
+		lane.tail_.address_ = account_address;
+		lane.has_tail_ = true;
+		shard.tails_.insert(lane.tail_);
+	}
+
+	TransactionFrm::pointer TransactionQueue::Remove(Shard& shard, std::unordered_map<std::string, Lane>::iterator lane_it, QueueByNonce::iterator tx_it){
+		Lane& lane = lane_it->second;
+		TransactionFrm::pointer ptr = tx_it->second.first;
+
+		DetachTail(shard, lane);
+		shard.time_queue_.erase(tx_it->second.second);
+		lane.txs_.erase(tx_it);
+		if (lane.txs_.empty()){
+			shard.lanes_.erase(lane_it);
+		}
+		else{
+			AttachTail(shard, lane_it->first, lane);
 		}
-		return std::move(std::make_pair(true, ptr));
+
+		do {
+			HashShard& hash_shard = GetHashShard(ptr->GetContentHash());
+			utils::MutexGuard guard(hash_shard.lock_);
+			hash_shard.txs_.erase(ptr->GetContentHash());
+		} while (false);
+
+		size_.Dec();
+		return ptr;
 	}
-	
 
-	std::pair<bool, TransactionFrm::pointer> TransactionQueue::Remove(const std::string& account_address,const int64_t& nonce){
+	std::pair<bool, TransactionFrm::pointer> TransactionQueue::Remove(const std::string& account_address, const int64_t& nonce, bool close_ledger){
 		TransactionFrm::pointer ptr = nullptr;
-		auto account_it =queue_by_address_and_nonce_.find(account_address);
-		if (account_it != queue_by_address_and_nonce_.end()){
-			auto tx_it = account_it->second.find(nonce);
-			if (tx_it != account_it->second.end()){
-				ptr = *tx_it->second.first;
-				queue_.erase(tx_it->second.first);
-				time_queue_.erase(tx_it->second.second);
-				account_it->second.erase(tx_it);
-				queue_by_hash_.erase(ptr->GetContentHash());
-
-				if (account_it->second.empty()){
-					queue_by_address_and_nonce_.erase(account_it);
-					account_nonce_.erase(account_address);
-				}
-				return std::move(std::make_pair(true, ptr));
+		bool removed = false;
+		Shard& shard = GetShard(account_address);
+		utils::MutexGuard guard(shard.lock_);
+		auto lane_it = shard.lanes_.find(account_address);
+		if (lane_it == shard.lanes_.end()){
+			return std::make_pair(false, ptr);
+		}
+
+		auto tx_it = lane_it->second.txs_.find(nonce);
+		if (tx_it != lane_it->second.txs_.end()){
+			bool last = lane_it->second.txs_.size() == 1;
+			ptr = Remove(shard, lane_it, tx_it);
+			removed = true;
+			if (last){
+				return std::make_pair(removed, ptr);
 			}
 		}
-		return std::move(std::make_pair(false, ptr));
+
+		//Update system account nonce
+		Lane& lane = lane_it->second;
+		if (close_ledger && lane.account_nonce_ < nonce){
+			DetachTail(shard, lane);
+			lane.account_nonce_ = nonce;
+			AttachTail(shard, account_address, lane);
+		}
+		return std::make_pair(removed, ptr);
 	}
-	
-	void TransactionQueue::Insert(TransactionFrm::pointer const& tx){
+
+	void TransactionQueue::Insert(Shard& shard, Lane& lane, TransactionFrm::pointer const& tx){
 		// Insert into the queue
-		auto inserted = queue_by_address_and_nonce_[tx->GetSourceAddress()].insert(std::make_pair(tx->GetNonce(), std::make_pair(PriorityQueue::iterator(), TimeQueue::iterator())));
-		PriorityQueue::iterator left = queue_.emplace(tx);
-		TimeQueue::iterator right = time_queue_.emplace(tx);
-		inserted.first->second.first = left;
-		inserted.first->second.second = right;
-		queue_by_hash_[tx->GetContentHash()]=tx;
+		TimeQueue::iterator time_it = shard.time_queue_.emplace(tx);
+		lane.txs_[tx->GetNonce()] = std::make_pair(tx, time_it);
+
+		HashShard& hash_shard = GetHashShard(tx->GetContentHash());
+		utils::MutexGuard guard(hash_shard.lock_);
+		hash_shard.txs_[tx->GetContentHash()] = tx;
+		size_.Inc();
+	}
+
+	bool TransactionQueue::RemoveWorst(TransactionFrm::pointer& tx){
+		//Find the shard holding the worst tail without taking two shard locks at once
+		int32_t worst_shard = -1;
+		SortKey worst;
+		for (size_t i = 0; i < SHARD_COUNT; i++){
+			utils::MutexGuard guard(shards_[i].lock_);
+			if (shards_[i].tails_.empty()){
+				continue;
+			}
+
+			const SortKey& key = *shards_[i].tails_.rbegin();
+			if (worst_shard < 0 || worst < key){
+				worst = key;
+				worst_shard = (int32_t)i;
+			}
+		}
+
+		if (worst_shard < 0){
+			return false;
+		}
+
+		Shard& shard = shards_[worst_shard];
+		utils::MutexGuard guard(shard.lock_);
+		if (shard.tails_.empty()){
+			return false;
+		}
+
+		auto lane_it = shard.lanes_.find(shard.tails_.rbegin()->address_);
+		if (lane_it == shard.lanes_.end() || lane_it->second.txs_.empty()){
+			return false;
+		}
+
+		auto tx_it = lane_it->second.txs_.end();
+		tx_it--;
+		tx = Remove(shard, lane_it, tx_it);
+		return true;
 	}
 
 	bool TransactionQueue::Import(TransactionFrm::pointer tx, const int64_t& cur_source_nonce,Result &result){
-		utils::WriteLockGuard g(lock_);
 		bool inserted = false;
 		bool replace = false;
 		uint32_t account_txs_size = 0;
 
-		account_nonce_[tx->GetSourceAddress()] = cur_source_nonce;
-
 		LOG_TRACE("Import transaction: Account address(%s), transaction hash(%s), nonce(" FMT_I64 "), gas_price(" FMT_I64 ").",
 			tx->GetSourceAddress().c_str(), utils::String::BinToHexString(tx->GetContentHash()).c_str(), tx->GetNonce(), tx->GetGasPrice());
-		auto account_it = queue_by_address_and_nonce_.find(tx->GetSourceAddress());
-		if (account_it != queue_by_address_and_nonce_.end()) {
 
-			account_txs_size = account_it->second.size();
+		do {
+			Shard& shard = GetShard(tx->GetSourceAddress());
+			utils::MutexGuard guard(shard.lock_);
+			auto lane_it = shard.lanes_.insert(std::make_pair(tx->GetSourceAddress(), Lane())).first;
+			Lane& lane = lane_it->second;
 
-			auto tx_it = account_it->second.find(tx->GetNonce());
-			if (tx_it != account_it->second.end()){
-				int64_t p = (*tx_it->second.first)->GetGasPrice();
+			DetachTail(shard, lane);
+			lane.account_nonce_ = cur_source_nonce;
+			account_txs_size = lane.txs_.size();
+
+			auto tx_it = lane.txs_.find(tx->GetNonce());
+			if (tx_it != lane.txs_.end()){
+				int64_t p = tx_it->second.first->GetGasPrice();
 				if ((tx->GetGasPrice() - p)>=(p*0.1)) {
 					//You need to replace the previous transaction by deleting the previous transaction and then inserting a new transaction.
-					std::string drop_hash = (*tx_it->second.first)->GetContentHash();
-					Remove(account_it, tx_it);
-					account_nonce_[tx->GetSourceAddress()] = cur_source_nonce;
+					std::string drop_hash = tx_it->second.first->GetContentHash();
+					shard.time_queue_.erase(tx_it->second.second);
+					lane.txs_.erase(tx_it);
+					do {
+						HashShard& hash_shard = GetHashShard(drop_hash);
+						utils::MutexGuard hash_guard(hash_shard.lock_);
+						hash_shard.txs_.erase(drop_hash);
+					} while (false);
+					size_.Dec();
+
 					replace = true;
 					account_txs_size--;
 					LOG_TRACE("Replace transaction: removing old transaction(hash: %s) from the queue, and inserting new transaction(hash: %s, account address: %s, gas_price: " FMT_I64 ", nonce: " FMT_I64 ") into the queue.",
 						utils::String::BinToHexString(drop_hash).c_str(), utils::String::BinToHexString(tx->GetContentHash()).c_str(), tx->GetSourceAddress().c_str(), tx->GetGasPrice(), tx->GetNonce());
 				}
 				else{
+					AttachTail(shard, lane_it->first, lane);
+
 					//Discard new transaction
 					std::string error_desc = utils::String::Format("Drop the transaction to insert queue because of low fee: transaction hash(%s), account address(%s), gas_price(" FMT_I64 "), nonce(" FMT_I64 ").",
 						utils::String::BinToHexString(tx->GetContentHash()).c_str(), tx->GetSourceAddress().c_str(), tx->GetGasPrice(), tx->GetNonce());
@@ -103,24 +197,33 @@ namespace rexx {
 					return inserted;
 				}
 			}
-		}
 
-		if (replace || account_txs_size < account_txs_limit_) {
-			Insert(tx);	
-			inserted = true;
-			//todo...
-			while (queue_.size() > queue_limit_) {
-				TransactionFrm::pointer t = *queue_.rbegin();
-				Remove(t->GetSourceAddress(), t->GetNonce());
-
-				std::string error_desc = utils::String::Format("Delete the transaction at the end of the queue: transaction hash(%s), account address(%s), gas_price(" FMT_I64 "), nonce(" FMT_I64 ").", utils::String::BinToHexString(t->GetContentHash()).c_str(), t->GetSourceAddress().c_str(), t->GetGasPrice(), t->GetNonce());
-				LOG_TRACE("%s", error_desc.c_str());
-				if (t->GetContentHash() == tx->GetContentHash()){
-					result.set_code(protocol::ERRCODE_TX_INSERT_QUEUE_FAIL);
-					result.set_desc(error_desc);
-					LOG_ERROR("%s", error_desc.c_str());
-					inserted = false;
-				}
+			if (replace || account_txs_size < account_txs_limit_) {
+				Insert(shard, lane, tx);
+				inserted = true;
+			}
+
+			if (lane.txs_.empty()){
+				shard.lanes_.erase(lane_it);
+			}
+			else{
+				AttachTail(shard, lane_it->first, lane);
+			}
+		} while (false);
+
+		while (inserted && size_.value() > (int64_t)queue_limit_) {
+			TransactionFrm::pointer t;
+			if (!RemoveWorst(t)){
+				break;
+			}
+
+			std::string error_desc = utils::String::Format("Delete the transaction at the end of the queue: transaction hash(%s), account address(%s), gas_price(" FMT_I64 "), nonce(" FMT_I64 ").", utils::String::BinToHexString(t->GetContentHash()).c_str(), t->GetSourceAddress().c_str(), t->GetGasPrice(), t->GetNonce());
+			LOG_TRACE("%s", error_desc.c_str());
+			if (t->GetContentHash() == tx->GetContentHash()){
+				result.set_code(protocol::ERRCODE_TX_INSERT_QUEUE_FAIL);
+				result.set_desc(error_desc);
+				LOG_ERROR("%s", error_desc.c_str());
+				inserted = false;
 			}
 		}
 
@@ -135,53 +238,102 @@ namespace rexx {
 		return inserted;
 	}
 
+	void TransactionQueue::VisitByPriority(uint32_t lane_limit, const Visitor& visitor){
+		struct LaneSnapshot {
+			int64_t account_nonce_;
+			std::vector<TransactionFrm::pointer> txs_;
+		};
+
+		//Copy the head of every lane, one shard lock at a time
+		std::vector<LaneSnapshot> lanes;
+		for (size_t i = 0; i < SHARD_COUNT; i++){
+			utils::MutexGuard guard(shards_[i].lock_);
+			for (auto lane_it = shards_[i].lanes_.begin(); lane_it != shards_[i].lanes_.end(); lane_it++){
+				LaneSnapshot snapshot;
+				snapshot.account_nonce_ = lane_it->second.account_nonce_;
+				for (auto tx_it = lane_it->second.txs_.begin(); tx_it != lane_it->second.txs_.end() && snapshot.txs_.size() < lane_limit; tx_it++){
+					snapshot.txs_.push_back(tx_it->second.first);
+				}
+				lanes.push_back(snapshot);
+			}
+		}
+
+		//K-way merge of the lanes, the heap holds the next transaction of each lane
+		struct HeadKey {
+			int64_t height_;
+			int64_t gas_price_;
+			size_t lane_;
+			size_t position_;
+			bool operator<(const HeadKey& other) const {
+				if (height_ != other.height_) return height_ > other.height_;
+				if (gas_price_ != other.gas_price_) return gas_price_ < other.gas_price_;
+				return lane_ > other.lane_;
+			}
+		};
+
+		std::priority_queue<HeadKey> heads;
+		for (size_t i = 0; i < lanes.size(); i++){
+			if (lanes[i].txs_.empty()) continue;
+			const TransactionFrm::pointer& tx = lanes[i].txs_[0];
+			heads.push(HeadKey{ tx->GetNonce() - lanes[i].account_nonce_, tx->GetGasPrice(), i, 0 });
+		}
+
+		while (!heads.empty()){
+			HeadKey head = heads.top();
+			heads.pop();
+
+			const LaneSnapshot& lane = lanes[head.lane_];
+			VisitAction action = visitor(lane.txs_[head.position_], lane.account_nonce_);
+			if (action == VISIT_STOP){
+				break;
+			}
+
+			size_t next = head.position_ + 1;
+			if (action == VISIT_NEXT && next < lane.txs_.size()){
+				const TransactionFrm::pointer& tx = lane.txs_[next];
+				heads.push(HeadKey{ tx->GetNonce() - lane.account_nonce_, tx->GetGasPrice(), head.lane_, next });
+			}
+		}
+	}
+
 	protocol::TransactionEnvSet TransactionQueue::TopTransaction(uint32_t limit){
 		protocol::TransactionEnvSet set;
-		std::unordered_map<std::string, int64_t> topic_seqs;
-		std::unordered_map<std::string, int64_t> break_nonce_accounts;
 		int64_t last_block_seq = LedgerManager::Instance().GetLastClosedLedger().seq();
-		utils::WriteLockGuard g(lock_);
 		uint32_t i = 0;
 		int64_t set_size = 0;
-		
-		for (auto t = queue_.begin(); set.txs().size() < limit && t != queue_.end(); ++t) {
-			const TransactionFrm::pointer& tx = *t;
+		//Nonce of the last transaction taken from the account being visited
+		std::unordered_map<std::string, int64_t> topic_seqs;
+
+		VisitByPriority(limit, [&](const TransactionFrm::pointer& tx, int64_t account_nonce) {
+			if (set.txs().size() >= (int32_t)limit){
+				return VISIT_STOP;
+			}
 
 			if (i + set_size + tx->GetTransactionEnv().ByteSize() >= General::TXSET_LIMIT_SIZE){
 				if (set.ByteSize() + tx->GetTransactionEnv().ByteSize() >= General::TXSET_LIMIT_SIZE)
-					break;
+					return VISIT_STOP;
 			}
 
 			set_size += tx->GetTransactionEnv().ByteSize();
-			
-			if (break_nonce_accounts.find(tx->GetSourceAddress()) == break_nonce_accounts.end()) {
-
-				int64_t last_seq = 0;
-				do {
-					//Find this cache
-					auto this_iter = topic_seqs.find(tx->GetSourceAddress());
-					if (this_iter != topic_seqs.end()) {
-						last_seq = this_iter->second;
-						break;
-					}
 
-					last_seq = account_nonce_[tx->GetSourceAddress()];
-
-				} while (false);
-
-				if (tx->GetNonce() > last_seq + 1) {
-					break_nonce_accounts[tx->GetSourceAddress()] = last_seq + 1;
-					continue;
-				}
+			int64_t last_seq = account_nonce;
+			auto this_iter = topic_seqs.find(tx->GetSourceAddress());
+			if (this_iter != topic_seqs.end()) {
+				last_seq = this_iter->second;
+			}
 
-				topic_seqs[tx->GetSourceAddress()] = tx->GetNonce();
+			//The nonce is broken, the rest of the account can not be applied either
+			if (tx->GetNonce() > last_seq + 1) {
+				return VISIT_SKIP_ACCOUNT;
+			}
 
-				*set.add_txs() = tx->GetProtoTxEnv();
+			topic_seqs[tx->GetSourceAddress()] = tx->GetNonce();
+			*set.add_txs() = tx->GetProtoTxEnv();
+			i++;
+			//LOG_TRACE("top(%u) addr(%s) tx(%s) nonce(" FMT_I64 ") gas_price(" FMT_I64 ") last block seq(" FMT_I64 ")", i, tx->GetSourceAddress().c_str(), utils::String::BinToHexString(tx->GetContentHash()).c_str(), tx->GetNonce(), tx->GetGasPrice(), last_block_seq);
+			return VISIT_NEXT;
+		});
 
-				i++;
-				//LOG_TRACE("top(%u) addr(%s) tx(%s) nonce(" FMT_I64 ") gas_price(" FMT_I64 ") last block seq(" FMT_I64 ")", i, tx->GetSourceAddress().c_str(), utils::String::BinToHexString(tx->GetContentHash()).c_str(), tx->GetNonce(), tx->GetGasPrice(), last_block_seq);
-			}
-		}
 		LOG_TRACE("Get transactions at the top of the queue. Current top size(%u), last ledger sequence(" FMT_I64 "), limit(%u), txset byte size(%d), (%d)M.",
 			i, last_block_seq, limit, set.ByteSize() ,set.ByteSize() / utils::BYTES_PER_MEGA);
 		return std::move(set);
@@ -191,90 +343,87 @@ namespace rexx {
 		
 		uint32_t ret = 0;
 		int64_t last_seq = LedgerManager::Instance().GetLastClosedLedger().seq();
-		utils::WriteLockGuard g(lock_);
 		for (int i = 0; i < set.txs_size(); i++) {
-			auto txproto = set.txs(i);
-			std::string source_address = txproto.transaction().source_address();
-			int64_t nonce = txproto.transaction().nonce();
-			std::pair<bool, TransactionFrm::pointer> result = Remove(source_address, nonce);
+			const protocol::Transaction &tran = set.txs(i).transaction();
+			std::pair<bool, TransactionFrm::pointer> result = Remove(tran.source_address(), tran.nonce(), close_ledger);
 			if (result.first)
 				++ret;
 			
 			//LOG_TRACE("RemoveTxs close_ledger_flag(%d) (%d) removed(%d) addr(%s) nonce(" FMT_I64 ") fee(" FMT_I64 ") last seq(" FMT_I64 ")",
 			//	(int)close_ledger, i, (int)result.first, source_address.c_str(), nonce, (int64_t)txproto.transaction().fee(), last_seq);
-
-			//Update system account nonce
-			auto it = account_nonce_.find(source_address);
-			if (close_ledger && it != account_nonce_.end() && it->second < nonce)
-				it->second = nonce;
 		}
 
-		LOG_TRACE("Remove transactions: close ledger flag(%d), transaction set size(%d), actual deletion quantity(%u), remaining size of queue(%u), last ledger sequence(" FMT_I64 ")", 
-			(int)close_ledger, set.txs_size(), ret, queue_.size(), last_seq);
+		LOG_TRACE("Remove transactions: close ledger flag(%d), transaction set size(%d), actual deletion quantity(%u), remaining size of queue(" FMT_I64 "), last ledger sequence(" FMT_I64 ")", 
+			(int)close_ledger, set.txs_size(), ret, size_.value(), last_seq);
 		return ret;
 	}
 
 	void TransactionQueue::RemoveTxs(std::vector<TransactionFrm::pointer>& txs, bool close_ledger){
-		utils::WriteLockGuard g(lock_);
 		uint32_t i = 0;
 		int64_t last_seq = LedgerManager::Instance().GetLastClosedLedger().seq();
 		for (auto it = txs.begin(); it != txs.end(); it++){
-			std::string source_address = (*it)->GetSourceAddress();
-			int64_t nonce = (*it)->GetNonce();
-
-			auto result = Remove(source_address, nonce);
+			auto result = Remove((*it)->GetSourceAddress(), (*it)->GetNonce(), close_ledger);
 			i++;
 			LOG_TRACE("Remove transactions: close ledger flag(%d), sequence of transaction removed(%u), removed result(%d), account address(%s), transaction hash(%s), nonce(" FMT_I64 "), gas_price(" FMT_I64 ") last seq(" FMT_I64 ")", 
 				(int)close_ledger, i, (int)result.first, (*it)->GetSourceAddress().c_str(),
 				utils::String::BinToHexString((*it)->GetContentHash()).c_str(), (*it)->GetNonce(), (*it)->GetGasPrice(), last_seq);
-
-			//Update system account nonce
-			auto iter = account_nonce_.find(source_address);
-			if (close_ledger && iter != account_nonce_.end() && iter->second < nonce)
-				iter->second = nonce;
 		}
-		LOG_TRACE("remaining size of queue(%u)", queue_.size());
+		LOG_TRACE("remaining size of queue(" FMT_I64 ")", size_.value());
 	}
 
 	void TransactionQueue::SafeRemoveTx(const std::string& account_address, const int64_t& nonce) {
-		utils::WriteLockGuard g(lock_);
-		std::pair<bool, TransactionFrm::pointer> result = Remove(account_address, nonce);
+		Remove(account_address, nonce);
 	}
 
-
-
 	void TransactionQueue::CheckTimeout(int64_t current_time, std::vector<TransactionFrm::pointer>& timeout_txs){
-		utils::ReadLockGuard g(lock_);
-		for (auto it = time_queue_.begin(); it != time_queue_.end();it++){
-			if (!(*it)->CheckTimeout(current_time - QUEUE_TRANSACTION_TIMEOUT))
-				break;
-			timeout_txs.emplace_back(*it);
+		for (size_t i = 0; i < SHARD_COUNT; i++){
+			utils::MutexGuard guard(shards_[i].lock_);
+			const TimeQueue& time_queue = shards_[i].time_queue_;
+			for (auto it = time_queue.begin(); it != time_queue.end(); it++){
+				if (!(*it)->CheckTimeout(current_time - QUEUE_TRANSACTION_TIMEOUT))
+					break;
+				timeout_txs.emplace_back(*it);
+			}
 		}
 	}
 
 	void TransactionQueue::CheckTimeoutAndDel(int64_t current_time,std::vector<TransactionFrm::pointer>& timeout_txs){
-		utils::WriteLockGuard g(lock_);
 		int64_t last_seq = LedgerManager::Instance().GetLastClosedLedger().seq();		
-		while (!time_queue_.empty()){
-			auto it =time_queue_.begin();
-			if (!(*it)->CheckTimeout(current_time - QUEUE_TRANSACTION_TIMEOUT))
-				break;
-			timeout_txs.emplace_back(*it);
-			std::string account_address = (*it)->GetSourceAddress();
-			int64_t nonce = (*it)->GetNonce();
-			Remove(account_address, nonce);
+		for (size_t i = 0; i < SHARD_COUNT; i++){
+			Shard& shard = shards_[i];
+			utils::MutexGuard guard(shard.lock_);
+			while (!shard.time_queue_.empty()){
+				TransactionFrm::pointer tx = *shard.time_queue_.begin();
+				if (!tx->CheckTimeout(current_time - QUEUE_TRANSACTION_TIMEOUT))
+					break;
+
+				auto lane_it = shard.lanes_.find(tx->GetSourceAddress());
+				if (lane_it == shard.lanes_.end()){
+					shard.time_queue_.erase(shard.time_queue_.begin());
+					continue;
+				}
+
+				auto tx_it = lane_it->second.txs_.find(tx->GetNonce());
+				if (tx_it == lane_it->second.txs_.end()){
+					shard.time_queue_.erase(shard.time_queue_.begin());
+					continue;
+				}
+
+				timeout_txs.emplace_back(tx);
+				Remove(shard, lane_it, tx_it);
+			}
 		}
 		LOG_TRACE("Deleted timeout transactions(number: %u) for the last closed ledger(" FMT_I64 ").", timeout_txs.size(), last_seq);
 	}
 
 	bool TransactionQueue::IsExist(const TransactionFrm::pointer& tx){
-		utils::ReadLockGuard g(lock_);
-		auto account_it1 = queue_by_address_and_nonce_.find(tx->GetSourceAddress());
-		if (account_it1 != queue_by_address_and_nonce_.end()){
-			auto tx_it = account_it1->second.find(tx->GetNonce());
-			if (tx_it != account_it1->second.end()){
-				TransactionFrm::pointer t = *tx_it->second.first;
-				if (t->GetContentHash() == tx->GetContentHash()){
+		Shard& shard = GetShard(tx->GetSourceAddress());
+		utils::MutexGuard guard(shard.lock_);
+		auto lane_it = shard.lanes_.find(tx->GetSourceAddress());
+		if (lane_it != shard.lanes_.end()){
+			auto tx_it = lane_it->second.txs_.find(tx->GetNonce());
+			if (tx_it != lane_it->second.txs_.end()){
+				if (tx_it->second.first->GetContentHash() == tx->GetContentHash()){
 					return true;
 				}
 			}
@@ -284,37 +433,33 @@ namespace rexx {
 	}
 
 	bool TransactionQueue::IsExist(const std::string& hash){
-		utils::ReadLockGuard g(lock_);
-		auto it = queue_by_hash_.find(hash);
-		if (it != queue_by_hash_.end()){
-			return true;
-		}
-		return false;
+		HashShard& hash_shard = GetHashShard(hash);
+		utils::MutexGuard guard(hash_shard.lock_);
+		return hash_shard.txs_.find(hash) != hash_shard.txs_.end();
 	}
 
 	size_t TransactionQueue::Size() {
-		utils::ReadLockGuard g(lock_);
-		return queue_.size();
+		return (size_t)size_.value();
 	}
 
 	void TransactionQueue::Query(const uint32_t& num, std::vector<TransactionFrm::pointer>& txs){
-		utils::ReadLockGuard g(lock_);
-		uint32_t count = 0;
-
-		for (auto it = queue_.begin(); it != queue_.end() && count < num; it++) {
-			txs.push_back(*it);
-			count++;
-		}
+		VisitByPriority(num, [&](const TransactionFrm::pointer& tx, int64_t account_nonce) {
+			if (txs.size() >= num){
+				return VISIT_STOP;
+			}
+			txs.push_back(tx);
+			return VISIT_NEXT;
+		});
 	}
 
 	bool TransactionQueue::Query(const std::string& hash, TransactionFrm::pointer& tx){
-		utils::ReadLockGuard g(lock_);
-		auto it = queue_by_hash_.find(hash);
-		if (it != queue_by_hash_.end()){
+		HashShard& hash_shard = GetHashShard(hash);
+		utils::MutexGuard guard(hash_shard.lock_);
+		auto it = hash_shard.txs_.find(hash);
+		if (it != hash_shard.txs_.end()){
 			tx = it->second;
 			return true;
 		}
 		return false;
 	}
 }
-
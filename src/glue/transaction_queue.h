@@ -13,6 +13,8 @@
 
 namespace rexx {
 
+	//Transactions are kept in per account lanes ordered by nonce. The lanes are spread over shards by
+	//address and every shard has its own lock, so imports of different accounts do not wait for each other.
 	class TransactionQueue{
 	public:
 		TransactionQueue(uint32_t queue_limit, uint32_t account_txs_limit);
@@ -32,23 +34,24 @@ namespace rexx {
 		void Query(const uint32_t& num,std::vector<TransactionFrm::pointer>& txs);
 		bool Query(const std::string& hash,TransactionFrm::pointer& tx);
 	private:
+		static const size_t SHARD_COUNT = 16;
 
-		struct PriorityCompare
+		//Priority of a transaction, computed when the transaction or its account nonce changes.
+		//Lower nonce distance to the account first, then higher gas price.
+		struct SortKey
 		{
-			TransactionQueue& transaction_queue_;
-			/// Compare transactions by nonce height and fee.
-			bool operator()(TransactionFrm::pointer const& first, TransactionFrm::pointer const& second) const
+			int64_t height_;
+			int64_t gas_price_;
+			std::string address_;
+
+			bool operator<(const SortKey& other) const
 			{
-				int64_t const& height1 = first->GetNonce() - transaction_queue_.account_nonce_[first->GetSourceAddress()];
-				int64_t const& height2 = second->GetNonce() - transaction_queue_.account_nonce_[second->GetSourceAddress()];
-				return height1 < height2 || (height1 == height2 && first->GetGasPrice() > second->GetGasPrice());
+				if (height_ != other.height_) return height_ < other.height_;
+				if (gas_price_ != other.gas_price_) return gas_price_ > other.gas_price_;
+				return address_ < other.address_;
 			}
 		};
 
-		using PriorityQueue = std::multiset<TransactionFrm::pointer, PriorityCompare>;
-		PriorityQueue queue_;
-
-
 		struct TimePriorityCompare
 		{
 			/// Compare transactions by incoming time
@@ -60,26 +63,64 @@ namespace rexx {
 
 		//Time order
 		using TimeQueue = std::multiset<TransactionFrm::pointer, TimePriorityCompare>;
-		TimeQueue time_queue_;
+		using QueueByNonce = std::map<int64_t, std::pair<TransactionFrm::pointer, TimeQueue::iterator>>;
 
-		using QueueIterPair = std::pair<PriorityQueue::iterator, TimeQueue::iterator>;
-		using QueueByNonce = std::map<int64_t, QueueIterPair>;
-		using QueueByAddressAndNonce = std::unordered_map<std::string, QueueByNonce>;
-		QueueByAddressAndNonce queue_by_address_and_nonce_;
+		struct Lane
+		{
+			//Record account system nonce
+			int64_t account_nonce_;
+			QueueByNonce txs_;
+			//The last transaction of the lane is the worst one of the account
+			bool has_tail_;
+			SortKey tail_;
+			Lane() : account_nonce_(0), has_tail_(false){}
+		};
 
-		std::unordered_map<std::string, TransactionFrm::pointer> queue_by_hash_;
-		//Record account system nonce
-		std::unordered_map<std::string, int64_t> account_nonce_;
+		struct Shard
+		{
+			utils::Mutex lock_;
+			std::unordered_map<std::string, Lane> lanes_;
+			std::set<SortKey> tails_;
+			TimeQueue time_queue_;
+		};
+
+		struct HashShard
+		{
+			utils::Mutex lock_;
+			std::unordered_map<std::string, TransactionFrm::pointer> txs_;
+		};
+
+		enum VisitAction
+		{
+			VISIT_NEXT,
+			VISIT_SKIP_ACCOUNT,
+			VISIT_STOP
+		};
+		typedef std::function<VisitAction(const TransactionFrm::pointer& tx, int64_t account_nonce)> Visitor;
+
+		Shard& GetShard(const std::string& account_address);
+		HashShard& GetHashShard(const std::string& hash);
+
+		//The shard lock must be held by the caller
+		void DetachTail(Shard& shard, Lane& lane);
+		void AttachTail(Shard& shard, const std::string& account_address, Lane& lane);
+		TransactionFrm::pointer Remove(Shard& shard, std::unordered_map<std::string, Lane>::iterator lane_it, QueueByNonce::iterator tx_it);
+		std::pair<bool, TransactionFrm::pointer> Remove(const std::string& account_address, const int64_t& nonce, bool close_ledger = false);
+		void Insert(Shard& shard, Lane& lane, TransactionFrm::pointer const& tx);
+
+		//Remove the worst transaction of the whole queue
+		bool RemoveWorst(TransactionFrm::pointer& tx);
+
+		//Merge the lanes in priority order, at most lane_limit transactions of each account are visited
+		void VisitByPriority(uint32_t lane_limit, const Visitor& visitor);
+
+		Shard shards_[SHARD_COUNT];
+		HashShard hash_shards_[SHARD_COUNT];
+		utils::AtomicInt64 size_;
 
 		uint32_t queue_limit_;
 		//Maximum number of transactions per account
 		uint32_t account_txs_limit_;
-
-		std::pair<bool, TransactionFrm::pointer> Remove(const std::string& account_address,const int64_t& nonce);
-		std::pair<bool, TransactionFrm::pointer> Remove(QueueByAddressAndNonce::iterator& account_it, QueueByNonce::iterator& tx_it, bool del_empty = true);
-		void Insert(TransactionFrm::pointer const& tx);
-
-		utils::ReadWriteLock lock_;
 	};
 }
 
@@ -7,6 +7,11 @@
 
 namespace rexx {
 
+	static void InitStorageTrie(KVTrie &trie, std::shared_ptr<WRITE_BATCH> batch, const std::string &prefix) {
+		trie.SetCache(&LedgerManager::Instance().trie_cache_);
+		trie.Init(Storage::Instance().account_db(), batch, prefix, 1);
+	}
+
 	//AccountFrm::AccountFrm() {
 	//	utils::AtomicInc(&rexx::General::account_new_count);
 	//	assets_ = nullptr;
@@ -14,14 +19,24 @@ namespace rexx {
 	//}
 
 	AccountFrm::AccountFrm(protocol::Account account_info) 
-		: account_info_(account_info) {
+		: account_info_(std::make_shared<protocol::Account>(account_info)),
+		assets_(std::make_shared<AssetMap>()),
+		metadata_(std::make_shared<MetadataMap>()) {
+		utils::AtomicInc(&rexx::General::account_new_count);
+	}
+
+	AccountFrm::AccountFrm(const AccountFrm &account)
+		: account_info_(account.account_info_),
+		assets_(account.assets_),
+		metadata_(account.metadata_) {
 		utils::AtomicInc(&rexx::General::account_new_count);
 	}
 
-	AccountFrm::AccountFrm(std::shared_ptr<AccountFrm> account){
-		account_info_.CopyFrom(account->ProtocolAccount());
-		assets_ = account->assets_;
-		metadata_ = account->metadata_;
+	AccountFrm::AccountFrm(std::shared_ptr<AccountFrm> account)
+		: account_info_(account->account_info_),
+		assets_(account->assets_),
+		metadata_(account->metadata_) {
+		utils::AtomicInc(&rexx::General::account_new_count);
 	}
 
 	AccountFrm::~AccountFrm() {
@@ -29,11 +44,11 @@ namespace rexx {
 	}
 
 	std::string AccountFrm::Serializer() {
-		return account_info_.SerializeAsString();
+		return account_info_->SerializeAsString();
 	}
 
 	bool AccountFrm::UnSerializer(const std::string &str) {
-		if (!account_info_.ParseFromString(str)) {
+		if (!MutableAccount().ParseFromString(str)) {
 			LOG_ERROR("Account deserialization failed!");
 			return false;
 		}
@@ -41,40 +56,41 @@ namespace rexx {
 	}
 
 	int64_t AccountFrm::GetAccountBalance() const {
-		return account_info_.balance();
+		return account_info_->balance();
 	}
 
 	std::string AccountFrm::GetAccountAddress()const {
-		return account_info_.address();
+		return account_info_->address();
 	}
 
 	bool AccountFrm::AddBalance(int64_t amount){
 		int64_t balance = 0;
-		if (!utils::SafeIntAdd(account_info_.balance(), amount, balance)) {
+		if (!utils::SafeIntAdd(account_info_->balance(), amount, balance)) {
 			LOG_ERROR("The result overflowed when the balance increased for the account: account address:%s, balance(" FMT_I64 "), increasing amount(" FMT_I64 ")", 
-				account_info_.address().c_str(), account_info_.balance(), amount);
+				account_info_->address().c_str(), account_info_->balance(), amount);
 			return false;
 		}
-		account_info_.set_balance(balance);
+		MutableAccount().set_balance(balance);
 		return true;
 	}
 	
 	bool AccountFrm::UpdateSigner(const std::string &signer, int64_t weight) {
+		protocol::Account &account_info = MutableAccount();
 		if (weight > 0) {
 			bool found = false;
-			for (int32_t i = 0; i < account_info_.mutable_priv()->signers_size(); i++) {
-				if (account_info_.mutable_priv()->signers(i).address() == signer) {
+			for (int32_t i = 0; i < account_info.mutable_priv()->signers_size(); i++) {
+				if (account_info.mutable_priv()->signers(i).address() == signer) {
 					found = true;
-					account_info_.mutable_priv()->mutable_signers(i)->set_weight(weight);
+					account_info.mutable_priv()->mutable_signers(i)->set_weight(weight);
 				}
 			}
 
 			if (!found) {
-				if (account_info_.priv().signers_size() >= protocol::Signer_Limit_SIGNER) {
+				if (account_info.priv().signers_size() >= protocol::Signer_Limit_SIGNER) {
 					return false;
 				}
 
-				protocol::Signer* signer1 = account_info_.mutable_priv()->add_signers();
+				protocol::Signer* signer1 = account_info.mutable_priv()->add_signers();
 				signer1->set_address(signer);
 				signer1->set_weight(weight);
 			}
@@ -82,9 +98,9 @@ namespace rexx {
 		else {
 			bool found = false;
 			std::vector<std::pair<std::string, int64_t> > nold;
-			for (int32_t i = 0; i < account_info_.mutable_priv()->signers_size(); i++) {
-				if (account_info_.mutable_priv()->signers(i).address() != signer) {
-					nold.push_back(std::make_pair(account_info_.mutable_priv()->signers(i).address(), account_info_.mutable_priv()->signers(i).weight()));
+			for (int32_t i = 0; i < account_info.mutable_priv()->signers_size(); i++) {
+				if (account_info.mutable_priv()->signers(i).address() != signer) {
+					nold.push_back(std::make_pair(account_info.mutable_priv()->signers(i).address(), account_info.mutable_priv()->signers(i).weight()));
 				}
 				else {
 					found = true;
@@ -92,9 +108,9 @@ namespace rexx {
 			}
 
 			if (found) {
-				account_info_.mutable_priv()->clear_signers();
+				account_info.mutable_priv()->clear_signers();
 				for (size_t i = 0; i < nold.size(); i++) {
-					protocol::Signer* signer = account_info_.mutable_priv()->add_signers();
+					protocol::Signer* signer = account_info.mutable_priv()->add_signers();
 					signer->set_address(nold[i].first);
 					signer->set_weight(nold[i].second);
 				}
@@ -105,7 +121,7 @@ namespace rexx {
 	}
 
 	const int64_t AccountFrm::GetTypeThreshold(const protocol::Operation::Type type) const {
-		const protocol::AccountThreshold &thresholds = account_info_.priv().thresholds();
+		const protocol::AccountThreshold &thresholds = account_info_->priv().thresholds();
 		for (int32_t i = 0; i < thresholds.type_thresholds_size(); i++) {
 			if (thresholds.type_thresholds(i).type() == type) {
 				return thresholds.type_thresholds(i).threshold();
@@ -116,9 +132,10 @@ namespace rexx {
 	}
 
 	bool AccountFrm::UpdateTypeThreshold(const protocol::Operation::Type type, int64_t threshold) {
+		protocol::Account &account_info = MutableAccount();
 		threshold = threshold & UINT64_MAX;
 		if (threshold > 0) {
-			protocol::AccountThreshold *thresholds = account_info_.mutable_priv()->mutable_thresholds();
+			protocol::AccountThreshold *thresholds = account_info.mutable_priv()->mutable_thresholds();
 			bool found = false;
 			for (int32_t i = 0; i < thresholds->type_thresholds_size(); i++) {
 				if (thresholds->type_thresholds(i).type() == type) {
@@ -139,7 +156,7 @@ namespace rexx {
 		}
 		else {
 			bool found = false;
-			protocol::AccountThreshold *thresholds = account_info_.mutable_priv()->mutable_thresholds();
+			protocol::AccountThreshold *thresholds = account_info.mutable_priv()->mutable_thresholds();
 			std::vector<std::pair<protocol::Operation::Type, int64_t> > nold;
 			for (int32_t i = 0; i < thresholds->type_thresholds_size(); i++) {
 				if (thresholds->type_thresholds(i).type() != type) {
@@ -164,14 +181,14 @@ namespace rexx {
 
 
 	void AccountFrm::ToJson(Json::Value &result) {
-		result = rexx::Proto2Json(account_info_);
+		result = rexx::Proto2Json(*account_info_);
 	}
 
 	void AccountFrm::GetAllAssets(std::vector<protocol::AssetStore>& assets){
 		KVTrie trie;
 		auto batch = std::make_shared<WRITE_BATCH>();
-		std::string prefix = ComposePrefix(General::ASSET_PREFIX, DecodeAddress(account_info_.address()));
-		trie.Init(Storage::Instance().account_db(), batch, prefix, 1);
+		std::string prefix = ComposePrefix(General::ASSET_PREFIX, DecodeAddress(account_info_->address()));
+		InitStorageTrie(trie, batch, prefix);
 		std::vector<std::string> values;
 		trie.GetAll("", values);
 		for (size_t i = 0; i < values.size(); i++){
@@ -184,8 +201,8 @@ namespace rexx {
 	void AccountFrm::GetAllMetaData(std::vector<protocol::KeyPair>& metadata){
 		KVTrie trie;
 		auto batch = std::make_shared<WRITE_BATCH>();
-		std::string prefix = ComposePrefix(General::METADATA_PREFIX, DecodeAddress(account_info_.address()));
-		trie.Init(Storage::Instance().account_db(), batch, prefix, 1);
+		std::string prefix = ComposePrefix(General::METADATA_PREFIX, DecodeAddress(account_info_->address()));
+		InitStorageTrie(trie, batch, prefix);
 		std::vector<std::string> values;
 		trie.GetAll("", values);
 		for (size_t i = 0; i < values.size(); i++){
@@ -197,8 +214,8 @@ namespace rexx {
 
 	bool AccountFrm::GetAsset(const protocol::AssetKey &asset_key, protocol::AssetStore& asset){
 		//LOG_INFO("%p GetAsset", this);
-		auto it = assets_.find(asset_key);
-		if (it != assets_.end()){
+		auto it = assets_->find(asset_key);
+		if (it != assets_->end()){
 			if (it->second.action_ == utils::DEL){
 				return false;
 			}
@@ -207,9 +224,9 @@ namespace rexx {
 		}
 
 		auto batch = std::make_shared<WRITE_BATCH>();
-		std::string asset_prefix = ComposePrefix(General::ASSET_PREFIX, DecodeAddress(account_info_.address()));
+		std::string asset_prefix = ComposePrefix(General::ASSET_PREFIX, DecodeAddress(account_info_->address()));
 		KVTrie trie;
-		trie.Init(Storage::Instance().account_db(), batch, asset_prefix, 1);
+		InitStorageTrie(trie, batch, asset_prefix);
 
 		auto asset_key_str = asset_key.SerializeAsString();
 		std::string buff;
@@ -225,7 +242,7 @@ namespace rexx {
 			PROCESS_EXIT("fatal error,Asset ParseFromString fail, data may damaged");
 		}
 		Rec.data_.CopyFrom(asset);
-		assets_.insert({ asset_key, Rec });
+		MutableAssets().insert({ asset_key, Rec });
 		return true;
 	}
 
@@ -233,14 +250,14 @@ namespace rexx {
 		DataCache<protocol::AssetStore> Rec;
 		Rec.action_ = utils::ADD;
 		Rec.data_.CopyFrom(data_ptr);
-		assets_[data_ptr.key()] = Rec;
+		MutableAssets()[data_ptr.key()] = Rec;
 	}
 
 	//
 	bool AccountFrm::GetMetaData(const std::string& binkey, protocol::KeyPair& keypair_ptr){
 		//return assets_->GetEntry(asset_property, asset);
-		auto it = metadata_.find(binkey);
-		if (it != metadata_.end()){
+		auto it = metadata_->find(binkey);
+		if (it != metadata_->end()){
 			if (it->second.action_ == utils::DEL){
 				return false;
 			}
@@ -250,8 +267,8 @@ namespace rexx {
 
 		auto batch = std::make_shared<WRITE_BATCH>();
 		KVTrie trie;
-		std::string prefix = ComposePrefix(General::METADATA_PREFIX, DecodeAddress(account_info_.address()));
-		trie.Init(Storage::Instance().account_db(), batch, prefix, 1);
+		std::string prefix = ComposePrefix(General::METADATA_PREFIX, DecodeAddress(account_info_->address()));
+		InitStorageTrie(trie, batch, prefix);
 
 		std::string buff;
 		if (!trie.Get(binkey, buff)){
@@ -264,7 +281,7 @@ namespace rexx {
 		DataCache<protocol::KeyPair> Rec;
 		Rec.action_ = utils::MOD;
 		Rec.data_.CopyFrom(keypair_ptr);
-		metadata_.insert({ binkey, Rec });
+		MutableMetadata().insert({ binkey, Rec });
 
 		return true;
 	}
@@ -273,27 +290,27 @@ namespace rexx {
 		DataCache<protocol::KeyPair> Rec;
 		Rec.action_ = utils::ADD;
 		Rec.data_.CopyFrom(dataptr);
-		metadata_[dataptr.key()] = Rec;
+		MutableMetadata()[dataptr.key()] = Rec;
 	}
 
 	bool AccountFrm::DeleteMetaData(const protocol::KeyPair& dataptr){		
 		DataCache<protocol::KeyPair> Rec;
 		Rec.action_ = utils::DEL;
 		Rec.data_.CopyFrom(dataptr);
-		metadata_[dataptr.key()] = Rec;
+		MutableMetadata()[dataptr.key()] = Rec;
 		return true;
 	}
 
 	void AccountFrm::UpdateHash(std::shared_ptr<WRITE_BATCH> batch){
 		KVTrie trie_asset;
-		std::string asset_prefix = ComposePrefix(General::ASSET_PREFIX, DecodeAddress(account_info_.address()));
-		trie_asset.Init(Storage::Instance().account_db(), batch, asset_prefix, 1);
+		std::string asset_prefix = ComposePrefix(General::ASSET_PREFIX, DecodeAddress(account_info_->address()));
+		InitStorageTrie(trie_asset, batch, asset_prefix);
 
 		KVTrie trie_metadata;
-		std::string meta_prefix = ComposePrefix(General::METADATA_PREFIX, DecodeAddress(account_info_.address()));
-		trie_metadata.Init(Storage::Instance().account_db(), batch, meta_prefix, 1);
+		std::string meta_prefix = ComposePrefix(General::METADATA_PREFIX, DecodeAddress(account_info_->address()));
+		InitStorageTrie(trie_metadata, batch, meta_prefix);
 
-		auto& map = assets_;
+		const AssetMap &map = *assets_;
 		for (auto it = map.begin(); it != map.end(); it++){
 			auto action = it->second.action_;
 			auto asset = it->second.data_;
@@ -316,9 +333,9 @@ namespace rexx {
 			}
 		}
 		trie_asset.UpdateHash();
-		account_info_.set_assets_hash(trie_asset.GetRootHash());
+		MutableAccount().set_assets_hash(trie_asset.GetRootHash());
 		
-		for (auto it = metadata_.begin(); it != metadata_.end(); it++){
+		for (auto it = metadata_->begin(); it != metadata_->end(); it++){
 			auto action = it->second.action_;
 			auto kp = it->second.data_;
 
@@ -337,12 +354,33 @@ namespace rexx {
 			}
 		}
 		trie_metadata.UpdateHash();
-		account_info_.set_metadatas_hash(trie_metadata.GetRootHash());
+		MutableAccount().set_metadatas_hash(trie_metadata.GetRootHash());
 	}
 
 	void AccountFrm::NonceIncrease(){
-		int64_t new_nonce = account_info_.nonce() + 1;
-		account_info_.set_nonce(new_nonce);
+		int64_t new_nonce = account_info_->nonce() + 1;
+		MutableAccount().set_nonce(new_nonce);
+	}
+
+	protocol::Account &AccountFrm::MutableAccount() {
+		if (account_info_.use_count() > 1) {
+			account_info_ = std::make_shared<protocol::Account>(*account_info_);
+		}
+		return *account_info_;
+	}
+
+	AccountFrm::AssetMap &AccountFrm::MutableAssets() {
+		if (assets_.use_count() > 1) {
+			assets_ = std::make_shared<AssetMap>(*assets_);
+		}
+		return *assets_;
+	}
+
+	AccountFrm::MetadataMap &AccountFrm::MutableMetadata() {
+		if (metadata_.use_count() > 1) {
+			metadata_ = std::make_shared<MetadataMap>(*metadata_);
+		}
+		return *metadata_;
 	}
 
 	AccountFrm::pointer AccountFrm::CreatAccountFrm(const std::string& account_address, int64_t balance) {
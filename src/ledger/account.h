@@ -33,6 +33,8 @@ namespace rexx {
 
 		//AccountFrm();
 		AccountFrm(protocol::Account account);
+		//Copies share the account, assets and metadata with the source until one of them writes
+		AccountFrm(const AccountFrm &account);
 		AccountFrm(std::shared_ptr< AccountFrm> account);
 
 		~AccountFrm();
@@ -58,34 +60,39 @@ namespace rexx {
 
 		bool DeleteMetaData(const protocol::KeyPair& dataptr);
 
+		//Writable account, detaches it from the other copies
 		protocol::Account &GetProtoAccount() {
-			return account_info_;
+			return MutableAccount();
+		}
+
+		const protocol::Account &GetConstProtoAccount() const {
+			return *account_info_;
 		}
 
 		protocol::Account ProtocolAccount() const{
-			return account_info_;
+			return *account_info_;
 		}
 
 		int64_t GetAccountNonce() const {
-			return account_info_.nonce();
+			return account_info_->nonce();
 		}
 
 		const int64_t GetProtoMasterWeight() const {
-			return account_info_.priv().master_weight();
+			return account_info_->priv().master_weight();
 		}
 
 		const int64_t GetProtoTxThreshold() const {
-			return account_info_.priv().thresholds().tx_threshold();
+			return account_info_->priv().thresholds().tx_threshold();
 		}
 
 		const int64_t GetTypeThreshold(const protocol::Operation::Type type) const;
 
 		void SetProtoMasterWeight(int64_t weight) {
-			return account_info_.mutable_priv()->set_master_weight(weight);
+			return MutableAccount().mutable_priv()->set_master_weight(weight);
 		}
 
 		void SetProtoTxThreshold(int64_t threshold) {
-			return account_info_.mutable_priv()->mutable_thresholds()->set_tx_threshold(threshold);
+			return MutableAccount().mutable_priv()->mutable_thresholds()->set_tx_threshold(threshold);
 		}
 
 		bool UpdateSigner(const std::string &signer, int64_t weight);
@@ -103,10 +110,17 @@ namespace rexx {
 			T data_;
 		};
 
-		std::map<protocol::AssetKey, DataCache<protocol::AssetStore>, AssetSort> assets_;
-		std::map<std::string, DataCache<protocol::KeyPair>> metadata_;
+		typedef std::map<protocol::AssetKey, DataCache<protocol::AssetStore>, AssetSort> AssetMap;
+		typedef std::map<std::string, DataCache<protocol::KeyPair>> MetadataMap;
+
 	private:
-		protocol::Account	account_info_;
+		protocol::Account &MutableAccount();
+		AssetMap &MutableAssets();
+		MetadataMap &MutableMetadata();
+
+		std::shared_ptr<protocol::Account> account_info_;
+		std::shared_ptr<AssetMap> assets_;
+		std::shared_ptr<MetadataMap> metadata_;
 	};
 
 }
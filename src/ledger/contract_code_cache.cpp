@@ -0,0 +1,164 @@
+#include <common/general.h>
+#include <common/storage.h>
+#include "contract_code_cache.h"
+
+namespace rexx {
+
+	ContractCodeCache::ContractCodeCache() :
+		capacity_(1000),
+		hit_count_(0),
+		miss_count_(0),
+		load_count_(0),
+		reject_count_(0) {}
+
+	ContractCodeCache::~ContractCodeCache() {}
+
+	void ContractCodeCache::SetCapacity(size_t capacity) {
+		utils::MutexGuard guard(lock_);
+		capacity_ = capacity;
+		while (entries_.size() > capacity_) {
+			entries_.erase(lru_.back());
+			lru_.pop_back();
+		}
+	}
+
+	bool ContractCodeCache::Get(const std::string &hash, std::string &data) {
+		do {
+			utils::MutexGuard guard(lock_);
+			auto iter = entries_.find(hash);
+			if (iter == entries_.end()) {
+				break;
+			}
+
+			lru_.splice(lru_.begin(), lru_, iter->second.lru_);
+			data = iter->second.data_;
+			hit_count_++;
+			return true;
+		} while (false);
+
+		KeyValueDb *db = Storage::Instance().keyvalue_db();
+		if (db->Get(ComposePrefix(General::CONTRACT_CODE_CACHE_PREFIX, hash), data) <= 0) {
+			utils::MutexGuard guard(lock_);
+			miss_count_++;
+			return false;
+		}
+
+		utils::MutexGuard guard(lock_);
+		load_count_++;
+		Insert(hash, data);
+		return true;
+	}
+
+	void ContractCodeCache::LoadPersisted() {
+		//Every key of the prefix sorts between "prefix_" and "prefix`"
+		std::string begin = ComposePrefix(General::CONTRACT_CODE_CACHE_PREFIX, "");
+		std::string end = std::string(General::CONTRACT_CODE_CACHE_PREFIX) + "`";
+		std::list<std::string> hashes;
+		KeyValueDb *db = Storage::Instance().keyvalue_db();
+		if (!db->Scan(begin, end, [&hashes, &begin](const std::string &key, const std::string &value) {
+			hashes.push_back(key.substr(begin.size()));
+			return true;
+		})) {
+			LOG_ERROR("Failed to scan the contract code cache, %s", db->error_desc().c_str());
+			return;
+		}
+
+		std::list<std::string> deleted;
+		do {
+			utils::MutexGuard guard(lock_);
+			for (auto iter = hashes.begin(); iter != hashes.end(); iter++) {
+				if (persisted_index_.find(*iter) == persisted_index_.end()) {
+					persisted_index_[*iter] = persisted_.insert(persisted_.end(), *iter);
+				}
+			}
+			TrimPersisted(deleted);
+		} while (false);
+
+		for (auto iter = deleted.begin(); iter != deleted.end(); iter++) {
+			db->Delete(ComposePrefix(General::CONTRACT_CODE_CACHE_PREFIX, *iter));
+		}
+	}
+
+	void ContractCodeCache::Put(const std::string &hash, const std::string &data, bool persist) {
+		std::list<std::string> deleted;
+		do {
+			utils::MutexGuard guard(lock_);
+			Insert(hash, data);
+			if (!persist || persisted_index_.find(hash) != persisted_index_.end()) {
+				persist = false;
+				break;
+			}
+
+			persisted_index_[hash] = persisted_.insert(persisted_.end(), hash);
+			TrimPersisted(deleted);
+		} while (false);
+
+		KeyValueDb *db = Storage::Instance().keyvalue_db();
+		if (persist && !db->Put(ComposePrefix(General::CONTRACT_CODE_CACHE_PREFIX, hash), data)) {
+			LOG_ERROR("Failed to save the contract code cache, %s", db->error_desc().c_str());
+		}
+
+		for (auto iter = deleted.begin(); iter != deleted.end(); iter++) {
+			db->Delete(ComposePrefix(General::CONTRACT_CODE_CACHE_PREFIX, *iter));
+		}
+	}
+
+	void ContractCodeCache::TrimPersisted(std::list<std::string> &deleted) {
+		while (persisted_.size() > capacity_) {
+			persisted_index_.erase(persisted_.front());
+			deleted.push_back(persisted_.front());
+			persisted_.pop_front();
+		}
+	}
+
+	void ContractCodeCache::Remove(const std::string &hash) {
+		Storage::Instance().keyvalue_db()->Delete(ComposePrefix(General::CONTRACT_CODE_CACHE_PREFIX, hash));
+
+		utils::MutexGuard guard(lock_);
+		reject_count_++;
+		auto persisted = persisted_index_.find(hash);
+		if (persisted != persisted_index_.end()) {
+			persisted_.erase(persisted->second);
+			persisted_index_.erase(persisted);
+		}
+
+		auto iter = entries_.find(hash);
+		if (iter != entries_.end()) {
+			lru_.erase(iter->second.lru_);
+			entries_.erase(iter);
+		}
+	}
+
+	void ContractCodeCache::Insert(const std::string &hash, const std::string &data) {
+		if (capacity_ == 0) {
+			return;
+		}
+
+		auto iter = entries_.find(hash);
+		if (iter != entries_.end()) {
+			lru_.splice(lru_.begin(), lru_, iter->second.lru_);
+			iter->second.data_ = data;
+			return;
+		}
+
+		lru_.push_front(hash);
+		Entry &entry = entries_[hash];
+		entry.data_ = data;
+		entry.lru_ = lru_.begin();
+		while (entries_.size() > capacity_) {
+			entries_.erase(lru_.back());
+			lru_.pop_back();
+		}
+	}
+
+	void ContractCodeCache::GetModuleStatus(Json::Value &data) {
+		utils::MutexGuard guard(lock_);
+		data["capacity"] = (Json::UInt64)capacity_;
+		data["entry_count"] = (Json::UInt64)entries_.size();
+		data["persisted_count"] = (Json::UInt64)persisted_.size();
+		data["hit_count"] = (Json::Int64)hit_count_;
+		data["miss_count"] = (Json::Int64)miss_count_;
+		data["load_count"] = (Json::Int64)load_count_;
+		data["reject_count"] = (Json::Int64)reject_count_;
+	}
+}
@@ -0,0 +1,53 @@
+#ifndef CONTRACT_CODE_CACHE_H_
+#define CONTRACT_CODE_CACHE_H_
+
+#include <list>
+#include <unordered_map>
+#include <utils/headers.h>
+#include <json/json.h>
+
+namespace rexx {
+
+	//V8 code cache of contract and jslib scripts, keyed by the hash of the source.
+	//Recently used entries are kept in memory, persisted entries survive restarts in the keyvalue db,
+	//where at most capacity entries are kept and the oldest saved is deleted first.
+	class ContractCodeCache {
+	public:
+		ContractCodeCache();
+		~ContractCodeCache();
+
+		void SetCapacity(size_t capacity);
+		//Collect the entries saved before the restart, deleting those beyond the capacity
+		void LoadPersisted();
+
+		bool Get(const std::string &hash, std::string &data);
+		void Put(const std::string &hash, const std::string &data, bool persist);
+		//V8 rejected the data, e.g. it was produced by another V8 version
+		void Remove(const std::string &hash);
+
+		void GetModuleStatus(Json::Value &data);
+
+	private:
+		struct Entry {
+			std::string data_;
+			std::list<std::string>::iterator lru_;
+		};
+
+		void Insert(const std::string &hash, const std::string &data);
+		void TrimPersisted(std::list<std::string> &deleted);
+
+		utils::Mutex lock_;
+		std::unordered_map<std::string, Entry> entries_;
+		std::list<std::string> lru_;
+		size_t capacity_;
+		std::list<std::string> persisted_; //hashes saved in the keyvalue db, oldest first
+		std::unordered_map<std::string, std::list<std::string>::iterator> persisted_index_;
+
+		int64_t hit_count_;
+		int64_t miss_count_;
+		int64_t load_count_;
+		int64_t reject_count_;
+	};
+}
+
+#endif
@@ -115,27 +115,111 @@ namespace rexx{
 	const std::string V8Contract::pay_asset_amount_name_ = "thisPayAsset";
 	const std::string V8Contract::block_timestamp_name_ = "blockTimestamp";
 	const std::string V8Contract::block_number_name_ = "blockNumber";
-	utils::Mutex V8Contract::isolate_to_contract_mutex_;
-	std::unordered_map<v8::Isolate*, V8Contract *> V8Contract::isolate_to_contract_;
 
 	v8::Platform* V8Contract::platform_ = nullptr;
 	v8::Isolate::CreateParams V8Contract::create_params_;
+	utils::Mutex V8Contract::isolate_pool_mutex_;
+	std::list<v8::Isolate *> V8Contract::isolate_pool_;
+	size_t V8Contract::isolate_pool_size_ = 0;
+	ContractCodeCache V8Contract::code_cache_;
 
 	V8Contract::V8Contract(bool readonly, const ContractParameter &parameter) : Contract(readonly,parameter) {
 		type_ = TYPE_V8;
-		isolate_ = v8::Isolate::New(create_params_);
-
-		utils::MutexGuard guard(isolate_to_contract_mutex_);
-		isolate_to_contract_[isolate_] = this;
+		isolate_ = AcquireIsolate();
+		isolate_->SetData(contract_data_slot_, this);
 	}
 
 	V8Contract::~V8Contract() {
-		utils::MutexGuard guard(isolate_to_contract_mutex_);
-		isolate_to_contract_.erase(isolate_);
-		isolate_->Dispose();
+		isolate_->SetData(contract_data_slot_, NULL);
+		ReleaseIsolate(isolate_);
 		isolate_ = NULL;
 	}
 
+	//The pooled isolates move between the ledger, query and test threads, so every use holds a v8::Locker,
+	//which also sets the stack limit of the thread entering the isolate
+	v8::Isolate *V8Contract::AcquireIsolate() {
+		do {
+			utils::MutexGuard guard(isolate_pool_mutex_);
+			if (isolate_pool_.empty()) {
+				break;
+			}
+
+			v8::Isolate *isolate = isolate_pool_.front();
+			isolate_pool_.pop_front();
+			return isolate;
+		} while (false);
+
+		return v8::Isolate::New(create_params_);
+	}
+
+	void V8Contract::ReleaseIsolate(v8::Isolate *isolate) {
+		do {
+			//A cancelled execution leaves the isolate terminating
+			v8::Locker locker(isolate);
+			v8::Isolate::Scope isolate_scope(isolate);
+			isolate->CancelTerminateExecution();
+			isolate->ContextDisposedNotification();
+		} while (false);
+
+		do {
+			utils::MutexGuard guard(isolate_pool_mutex_);
+			if (isolate_pool_.size() >= isolate_pool_size_) {
+				break;
+			}
+
+			isolate_pool_.push_back(isolate);
+			return;
+		} while (false);
+
+		isolate->Dispose();
+	}
+
+	void V8Contract::Exit() {
+		utils::MutexGuard guard(isolate_pool_mutex_);
+		for (auto iter = isolate_pool_.begin(); iter != isolate_pool_.end(); iter++) {
+			(*iter)->Dispose();
+		}
+		isolate_pool_.clear();
+	}
+
+	bool V8Contract::CompileScript(v8::Isolate* isolate, const std::string &code, bool persist_cache, v8::Local<v8::Script> &script) {
+		v8::Local<v8::Context> context = isolate->GetCurrentContext();
+		v8::Local<v8::String> source_string = v8::String::NewFromUtf8(isolate, code.c_str());
+		v8::Local<v8::String> check_time_name(
+			v8::String::NewFromUtf8(isolate, "__enable_check_time__",
+			v8::NewStringType::kNormal).ToLocalChecked());
+		v8::ScriptOrigin origin_check_time_name(check_time_name);
+
+		//The code cache only skips parsing and compiling, the generated code is the same, so results stay deterministic.
+		//V8 itself rejects data of another version or flags.
+		std::string hash = HashWrapper::Crypto(code);
+		std::string cache_data;
+		if (code_cache_.Get(hash, cache_data)) {
+			v8::ScriptCompiler::CachedData *cached = new v8::ScriptCompiler::CachedData(
+				(const uint8_t *)cache_data.c_str(), (int)cache_data.size());
+			v8::ScriptCompiler::Source source(source_string, origin_check_time_name, cached);
+			if (!v8::ScriptCompiler::Compile(context, &source, v8::ScriptCompiler::kConsumeCodeCache).ToLocal(&script)) {
+				return false;
+			}
+
+			if (source.GetCachedData()->rejected) {
+				code_cache_.Remove(hash);
+			}
+			return true;
+		}
+
+		v8::ScriptCompiler::Source source(source_string, origin_check_time_name);
+		if (!v8::ScriptCompiler::Compile(context, &source, v8::ScriptCompiler::kProduceCodeCache).ToLocal(&script)) {
+			return false;
+		}
+
+		const v8::ScriptCompiler::CachedData *produced = source.GetCachedData();
+		if (produced != NULL && produced->length > 0 && !produced->rejected) {
+			code_cache_.Put(hash, std::string((const char *)produced->data, produced->length), persist_cache);
+		}
+		return true;
+	}
+
 	bool V8Contract::LoadJsLibSource() {
 		std::string lib_path = utils::String::Format("%s/jslib", utils::File::GetBinHome().c_str());
 		utils::FileAttributes files;
@@ -230,10 +314,16 @@ namespace rexx{
 		create_params_.array_buffer_allocator =
 			v8::ArrayBuffer::Allocator::NewDefaultAllocator();
 
+		const LedgerConfigure &ledger_config = Configure::Instance().ledger_configure_;
+		isolate_pool_size_ = ledger_config.contract_isolate_pool_size_;
+		code_cache_.SetCapacity(ledger_config.contract_code_cache_size_);
+		code_cache_.LoadPersisted();
+
 		return true;
 	}
 
 	bool V8Contract::ExecuteCode(const char* fname){
+		v8::Locker locker(isolate_);
 		v8::Isolate::Scope isolate_scope(isolate_);
 		v8::HandleScope handle_scope(isolate_);
 		v8::TryCatch try_catch(isolate_);
@@ -288,7 +378,6 @@ namespace rexx{
 			v8::String::NewFromUtf8(isolate_, block_timestamp_name_.c_str(), v8::NewStringType::kNormal).ToLocalChecked(),
 			timestamp_v8);
 
-		v8::Local<v8::String> v8src = v8::String::NewFromUtf8(isolate_, parameter_.code_.c_str());
 		v8::Local<v8::Script> compiled_script;
 
 		do {
@@ -298,12 +387,10 @@ namespace rexx{
 				break;
 			}
 
-			v8::Local<v8::String> check_time_name(
-				v8::String::NewFromUtf8(context->GetIsolate(), "__enable_check_time__",
-				v8::NewStringType::kNormal).ToLocalChecked());
-			v8::ScriptOrigin origin_check_time_name(check_time_name);
-
-			if (!v8::Script::Compile(context, v8src, &origin_check_time_name).ToLocal(&compiled_script)) {
+			//Only scripts applied by consensus are persisted, test and query contexts may carry any code
+			bool persist_cache = parameter_.ledger_context_ != NULL &&
+				parameter_.ledger_context_->GetType() == LedgerContext::AT_NORMAL && !readonly_;
+			if (!CompileScript(isolate_, parameter_.code_, persist_cache, compiled_script)) {
 				result_.set_desc(ReportException(isolate_, &try_catch).toFastString());
 				break;
 			}
@@ -366,6 +453,7 @@ namespace rexx{
 	}
 
 	bool V8Contract::SourceCodeCheck() {
+		v8::Locker locker(isolate_);
 		v8::Isolate::Scope isolate_scope(isolate_);
 		v8::HandleScope handle_scope(isolate_);
 		v8::TryCatch try_catch(isolate_);
@@ -463,6 +551,7 @@ namespace rexx{
 	}
 
 	bool V8Contract::Query(Json::Value& js_result) {
+		v8::Locker locker(isolate_);
 		v8::Isolate::Scope isolate_scope(isolate_);
 		v8::HandleScope    handle_scope(isolate_);
 		v8::TryCatch       try_catch(isolate_);
@@ -496,7 +585,6 @@ namespace rexx{
 			timestamp_v8);
 
 
-		v8::Local<v8::String> v8src = v8::String::NewFromUtf8(isolate_, parameter_.code_.c_str());
 		v8::Local<v8::Script> compiled_script;
 
 		Json::Value error_desc_f;
@@ -506,12 +594,7 @@ namespace rexx{
 				break;
 			}
 
-			v8::Local<v8::String> check_time_name(
-				v8::String::NewFromUtf8(context->GetIsolate(), "__enable_check_time__",
-				v8::NewStringType::kNormal).ToLocalChecked());
-			v8::ScriptOrigin origin_check_time_name(check_time_name);
-
-			if (!v8::Script::Compile(context, v8src, &origin_check_time_name).ToLocal(&compiled_script)) {
+			if (!CompileScript(isolate_, parameter_.code_, false, compiled_script)) {
 				error_desc_f = ReportException(isolate_, &try_catch);
 				break;
 			}
@@ -560,13 +643,7 @@ namespace rexx{
 
 
 	V8Contract *V8Contract::GetContractFrom(v8::Isolate* isolate) {
-		utils::MutexGuard guard(isolate_to_contract_mutex_);
-		std::unordered_map<v8::Isolate*, V8Contract *>::iterator iter = isolate_to_contract_.find(isolate);
-		if (iter != isolate_to_contract_.end()){
-			return iter->second;
-		}
-
-		return NULL;
+		return (V8Contract *)isolate->GetData(contract_data_slot_);
 	}
 
 	bool V8Contract::RemoveRandom(v8::Isolate* isolate, Json::Value &error_msg) {
@@ -806,17 +883,10 @@ namespace rexx{
 			}
 
 			v8::TryCatch try_catch(args.GetIsolate());
-			std::string js_file = find_source->second; //load_file(*str);
-
-			v8::Local<v8::String> source = v8::String::NewFromUtf8(args.GetIsolate(), js_file.c_str());
 			v8::Local<v8::Script> script;
 
-			v8::Local<v8::String> check_time_name(
-				v8::String::NewFromUtf8(args.GetIsolate()->GetCurrentContext()->GetIsolate(), "__enable_check_time__",
-				v8::NewStringType::kNormal).ToLocalChecked());
-			v8::ScriptOrigin origin_check_time_name(check_time_name);
-
-			if (!v8::Script::Compile(args.GetIsolate()->GetCurrentContext(), source, &origin_check_time_name).ToLocal(&script)) {
+			//The jslib sources are fixed, so their code cache is always persisted
+			if (!CompileScript(args.GetIsolate(), find_source->second, true, script)) {
 				ReportException(args.GetIsolate(), &try_catch);
 				break;
 			}
@@ -1059,12 +1129,12 @@ namespace rexx{
 				}
 			}
 
-			if (!account_frm->GetProtoAccount().has_contract()) {
+			if (!account_frm->GetConstProtoAccount().has_contract()) {
 				LOG_TRACE("The account(%s) has no contract.", address.c_str());
 				break;
 			}
 
-			protocol::Contract contract = account_frm->GetProtoAccount().contract();
+			protocol::Contract contract = account_frm->GetConstProtoAccount().contract();
 			if (contract.payload().size() == 0) {
 				LOG_TRACE("The account(%s) has no contract.", address.c_str());
 				break;
@@ -2057,6 +2127,7 @@ namespace rexx{
 	}
 
 	bool ContractManager::Exit() {
+		V8Contract::Exit();
 		return true;
 	}
 
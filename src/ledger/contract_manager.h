@@ -11,6 +11,7 @@
 #include <libplatform/libplatform-export.h>
 #include <proto/cpp/chain.pb.h>
 #include "ledgercontext_manager.h"
+#include "contract_code_cache.h"
 
 namespace rexx{
 
@@ -141,12 +142,24 @@ namespace rexx{
 		static const std::string block_timestamp_name_;
 		static const std::string block_number_name_;
 
-		static utils::Mutex isolate_to_contract_mutex_;
-		static std::unordered_map<v8::Isolate*, V8Contract *> isolate_to_contract_;
+		//An isolate runs one contract at a time, the contract is kept in this embedder data slot of its isolate
+		static const uint32_t contract_data_slot_ = 0;
 
 		static v8::Platform* 	platform_;
 		static v8::Isolate::CreateParams create_params_;
 
+		//Idle isolates are reused by later contracts, every execution still runs in a new context
+		static utils::Mutex isolate_pool_mutex_;
+		static std::list<v8::Isolate *> isolate_pool_;
+		static size_t isolate_pool_size_;
+		static v8::Isolate *AcquireIsolate();
+		static void ReleaseIsolate(v8::Isolate *isolate);
+		static void Exit();
+
+		static ContractCodeCache code_cache_;
+		//Compile in the current context of the isolate, consuming or producing the V8 code cache
+		static bool CompileScript(v8::Isolate* isolate, const std::string &code, bool persist_cache, v8::Local<v8::Script> &script);
+
 		static bool RemoveRandom(v8::Isolate* isolate, Json::Value &error_msg);
 		static v8::Local<v8::Context> CreateContext(v8::Isolate* isolate, bool readonly);
 		static V8Contract *GetContractFrom(v8::Isolate* isolate);
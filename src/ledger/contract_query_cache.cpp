@@ -0,0 +1,83 @@
+#include <common/general.h>
+#include "contract_query_cache.h"
+
+namespace rexx {
+
+	ContractQueryCache::ContractQueryCache() :
+		capacity_(1000),
+		hit_count_(0),
+		miss_count_(0) {}
+
+	ContractQueryCache::~ContractQueryCache() {}
+
+	void ContractQueryCache::SetCapacity(size_t capacity) {
+		utils::MutexGuard guard(lock_);
+		capacity_ = capacity;
+		while (entries_.size() > capacity_) {
+			entries_.erase(lru_.back());
+			lru_.pop_back();
+		}
+	}
+
+	std::string ContractQueryCache::ComposeKey(const std::string &contract_address, const std::string &source_address, const std::string &input) {
+		std::string key = contract_address;
+		key.push_back('\0');
+		key += source_address;
+		key.push_back('\0');
+		key += HashWrapper::Crypto(input);
+		return key;
+	}
+
+	bool ContractQueryCache::Get(const std::string &key, int64_t ledger_seq, Json::Value &result) {
+		utils::MutexGuard guard(lock_);
+		auto iter = entries_.find(key);
+		if (iter == entries_.end() || iter->second.ledger_seq_ != ledger_seq) {
+			miss_count_++;
+			return false;
+		}
+
+		lru_.splice(lru_.begin(), lru_, iter->second.lru_);
+		result = iter->second.result_;
+		hit_count_++;
+		return true;
+	}
+
+	void ContractQueryCache::Put(const std::string &key, int64_t ledger_seq, const Json::Value &result) {
+		utils::MutexGuard guard(lock_);
+		if (capacity_ == 0) {
+			return;
+		}
+
+		auto iter = entries_.find(key);
+		if (iter != entries_.end()) {
+			lru_.splice(lru_.begin(), lru_, iter->second.lru_);
+			iter->second.ledger_seq_ = ledger_seq;
+			iter->second.result_ = result;
+			return;
+		}
+
+		lru_.push_front(key);
+		Entry &entry = entries_[key];
+		entry.ledger_seq_ = ledger_seq;
+		entry.result_ = result;
+		entry.lru_ = lru_.begin();
+		while (entries_.size() > capacity_) {
+			entries_.erase(lru_.back());
+			lru_.pop_back();
+		}
+	}
+
+	void ContractQueryCache::Clear() {
+		utils::MutexGuard guard(lock_);
+		entries_.clear();
+		lru_.clear();
+	}
+
+	void ContractQueryCache::GetModuleStatus(Json::Value &data) {
+		utils::MutexGuard guard(lock_);
+		data["capacity"] = (Json::UInt64)capacity_;
+		data["entry_count"] = (Json::UInt64)entries_.size();
+		data["hit_count"] = (Json::Int64)hit_count_;
+		data["miss_count"] = (Json::Int64)miss_count_;
+	}
+}
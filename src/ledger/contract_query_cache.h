@@ -0,0 +1,44 @@
+#ifndef CONTRACT_QUERY_CACHE_H_
+#define CONTRACT_QUERY_CACHE_H_
+
+#include <list>
+#include <unordered_map>
+#include <utils/headers.h>
+#include <json/json.h>
+
+namespace rexx {
+
+	//Results of read only contract queries of the api, keyed by the contract address, the source address and
+	//the hash of the input. An entry is served only for the ledger it was executed on, all entries are dropped on ledger close.
+	class ContractQueryCache {
+	public:
+		ContractQueryCache();
+		~ContractQueryCache();
+
+		void SetCapacity(size_t capacity);
+
+		static std::string ComposeKey(const std::string &contract_address, const std::string &source_address, const std::string &input);
+		bool Get(const std::string &key, int64_t ledger_seq, Json::Value &result);
+		void Put(const std::string &key, int64_t ledger_seq, const Json::Value &result);
+		void Clear();
+
+		void GetModuleStatus(Json::Value &data);
+
+	private:
+		struct Entry {
+			int64_t ledger_seq_;
+			Json::Value result_;
+			std::list<std::string>::iterator lru_;
+		};
+
+		utils::Mutex lock_;
+		std::unordered_map<std::string, Entry> entries_;
+		std::list<std::string> lru_;
+		size_t capacity_;
+
+		int64_t hit_count_;
+		int64_t miss_count_;
+	};
+}
+
+#endif
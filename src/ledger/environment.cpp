@@ -10,11 +10,13 @@ namespace rexx{
 	{
 		useAtomMap_ = Configure::Instance().ledger_configure_.use_atom_map_;
 		parent_ = nullptr;
+		base_ = nullptr;
 	}
 
 	Environment::Environment(Environment* parent){
 
 		useAtomMap_ = Configure::Instance().ledger_configure_.use_atom_map_;
+		base_ = nullptr;
 		if (useAtomMap_)
 		{
 			parent_ = nullptr;
@@ -77,7 +79,24 @@ namespace rexx{
 
 	bool Environment::GetFromDB(const std::string &address, AccountFrm::pointer &account_ptr)
 	{
-		return AccountFromDB(address, account_ptr);
+		if (base_ == nullptr) {
+			return AccountFromDB(address, account_ptr);
+		}
+
+		read_keys_.insert(address);
+		const mapKV &committed = base_->GetData();
+		auto iter = committed.find(address);
+		if (iter == committed.end()) {
+			return AccountFromDB(address, account_ptr);
+		}
+
+		if (iter->second.type_ == DEL) {
+			return false;
+		}
+
+		//The copy shares the account with base until it writes
+		account_ptr = std::make_shared<AccountFrm>(*(iter->second.value_));
+		return true;
 	}
 
 	bool Environment::AccountFromDB(const std::string &address, AccountFrm::pointer &account_ptr){
@@ -85,7 +104,7 @@ namespace rexx{
 		auto db = Storage::Instance().account_db();
 		std::string index = DecodeAddress(address);
 		std::string buff;
-		if (!LedgerManager::Instance().tree_->Get(index, buff)){
+		if (!LedgerManager::Instance().tree_->GetLeafFromDB(index, buff)){
 			return false;
 		}
 
@@ -107,6 +126,13 @@ namespace rexx{
 		return next;
 	}
 
+	std::shared_ptr<Environment> Environment::NewSpeculativeEnv(Environment *base)
+	{
+		std::shared_ptr<Environment> next = std::make_shared<Environment>(nullptr, nullptr);
+		next->base_ = base;
+		return next;
+	}
+
 	bool Environment::UpdateFeeConfig(const Json::Value &feeConfig) {
 		std::shared_ptr<Json::Value> fees;
 		settings_.Get(feesKey, fees);
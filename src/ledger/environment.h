@@ -23,6 +23,10 @@ namespace rexx {
 		Environment *parent_;
 		bool useAtomMap_;
 
+		//Set on a speculative environment, see NewSpeculativeEnv
+		Environment *base_;
+		std::set<std::string> read_keys_;
+
 		Environment() = default;
 		Environment(Environment const&) = delete;
 		Environment& operator=(Environment const&) = delete;
@@ -46,6 +50,10 @@ namespace rexx {
 		virtual bool GetFromDB(const std::string &address, AccountFrm::pointer &account_ptr);
 		static bool AccountFromDB(const std::string &address, AccountFrm::pointer &account_ptr);
 		std::shared_ptr<Environment> NewStackFrameEnv();
+
+		//An environment reading the committed accounts of base without writing to it. Every account it
+		//looks up outside its own buffers is recorded in read_keys_, base must not change while it is in use.
+		static std::shared_ptr<Environment> NewSpeculativeEnv(Environment *base);
 	};
 }
 #endif
\ No newline at end of file
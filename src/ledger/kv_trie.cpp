@@ -5,6 +5,9 @@ namespace rexx{
 
 	KVTrie::KVTrie(){
 		//leafcount_ = 0;
+		mdb_ = nullptr;
+		cache_ = nullptr;
+		time_ = 0;
 	}
 
 	KVTrie::~KVTrie(){
@@ -28,6 +31,14 @@ namespace rexx{
 		return true;
 	}
 
+	void KVTrie::SetCache(TrieCache* cache){
+		cache_ = cache;
+	}
+
+	bool KVTrie::GetLeafFromDB(const std::string& key, std::string& value){
+		return StorageGetLeaf(Key2Location(key), value);
+	}
+
 	void KVTrie::Load(NodeFrm::POINTER node, int depth){
 		if (depth < 0){
 			return;
@@ -54,12 +65,14 @@ namespace rexx{
 		std::string buff = node->info_.SerializeAsString();
 		std::string key = Location2DBkey(node->location_, false);
 		batch_->Put(key, buff);
+		if (cache_) cache_->MarkDirty(prefix_);
 		//LOG_DEBUG("save INNER(%s)", utils::String::BinToHexString(key).c_str());
 	}
 
 	void  KVTrie::StorageSaveLeaf(NodeFrm::POINTER node){
 		std::string key = Location2DBkey(node->location_, true);
 		batch_->Put(key, *node->leaf_);
+		if (cache_) cache_->MarkDirty(prefix_);
 		//LOG_DEBUG("save LEAF(%s)", utils::String::BinToHexString(key).c_str());
 	}
 
@@ -68,7 +81,7 @@ namespace rexx{
 		std::string key = Location2DBkey(location, false);
 		std::string buff;
 		//LOG_DEBUG("LOAD INNER:%s", utils::String::BinToHexString(key).c_str());
-		int32_t stat = mdb_->Get(key, buff);
+		int32_t stat = LoadValue(key, buff);
 		int64_t t2 = utils::Timestamp::HighResolution();
 
 		time_ += (t2 - t1);
@@ -88,18 +101,20 @@ namespace rexx{
 		std::string key = Location2DBkey(node->location_, false);
 		//LOG_DEBUG("DELETE INNER %s", utils::String::BinToHexString(key).c_str());
 		batch_->Delete(key);
+		if (cache_) cache_->MarkDirty(prefix_);
 	}
 
 	void KVTrie::StorageDeleteLeaf(NodeFrm::POINTER node){
 		std::string key = Location2DBkey(node->location_, true);
 		//LOG_DEBUG("DELETE LEAF %s", utils::String::BinToHexString(key).c_str());
 		batch_->Delete(key);
+		if (cache_) cache_->MarkDirty(prefix_);
 	}
 
 	bool KVTrie::StorageGetLeaf(const Location& location, std::string& value) {
 		std::string key = Location2DBkey(location, true);
 		//LOG_DEBUG("GET LEAF %s", utils::String::BinToHexString(key).c_str());
-		int32_t stat = mdb_->Get(key, value);
+		int32_t stat = LoadValue(key, value);
 		if (stat == 1){
 			return true;
 		}
@@ -111,6 +126,25 @@ namespace rexx{
 		}
 	}
 
+	int32_t KVTrie::LoadValue(const std::string& key, std::string& value){
+		//The cache follows the last closed ledger, a reader on a snapshot must not see newer values
+		if (cache_ == nullptr || StorageReadGuard::OnSnapshot()){
+			return mdb_->Get(key, value);
+		}
+
+		bool exist = false;
+		if (cache_->Get(prefix_, key, value, exist)){
+			return exist ? 1 : 0;
+		}
+
+		int64_t version = cache_->GetVersion();
+		int32_t stat = mdb_->Get(key, value);
+		if (stat >= 0){
+			cache_->Put(prefix_, key, value, stat == 1, version);
+		}
+		return stat;
+	}
+
 	std::string KVTrie::HashCrypto(const std::string& input){
 		return HashWrapper::Crypto(input);
 	}
@@ -4,12 +4,14 @@
 
 #include <common/storage.h>
 #include "trie.h"
+#include "trie_cache.h"
 
 namespace rexx{
 
 	class KVTrie :public Trie{
 		KeyValueDb* mdb_;
 		std::string prefix_;
+		TrieCache* cache_;
 	public:
 		std::shared_ptr<WRITE_BATCH> batch_;
 		int64_t time_;
@@ -18,11 +20,19 @@ namespace rexx{
 		~KVTrie();
 		bool Init(rexx::KeyValueDb* db, std::shared_ptr<WRITE_BATCH>, const std::string& prefix, int depth);
 
+		//Read nodes and leaves through the cache, set it before Init
+		void SetCache(TrieCache* cache);
+
+		//Read a committed value straight from the database without loading nodes into memory,
+		//it can be called from any thread. A value is stored under the leaf key of its full location.
+		bool GetLeafFromDB(const std::string& key, std::string& value);
+
 		//int LeafCount();
 		bool AddToDB();
 	private:
 		void Load(NodeFrm::POINTER node, int depth);
 	    std::string Location2DBkey(const Location& location, bool leaf);
+		int32_t LoadValue(const std::string& key, std::string& value);
 	protected:
 		virtual void StorageSaveNode(NodeFrm::POINTER node) override;
 		virtual void StorageSaveLeaf(NodeFrm::POINTER node) override;
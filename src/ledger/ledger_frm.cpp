@@ -9,6 +9,7 @@
 #include "ledger_frm.h"
 #include "ledgercontext_manager.h"
 #include "contract_manager.h"
+#include "parallel_executor.h"
 
 namespace rexx {
 
@@ -41,7 +42,7 @@ namespace rexx {
 
 		rexx::KeyValueDb *db = rexx::Storage::Instance().ledger_db();
 		std::string ledger_header;
-		int32_t ret = db->Get(ComposePrefix(General::LEDGER_PREFIX, ledger_seq), ledger_header);
+		int32_t ret = db->Get(ComposeSeqKey(General::LEDGER_PREFIX, ledger_seq), ledger_header);
 		if (ret > 0) {
 			ledger_.mutable_header()->ParseFromString(ledger_header);
 			return true;
@@ -55,11 +56,53 @@ namespace rexx {
 	}
 
 
-	bool LedgerFrm::AddToDb(WRITE_BATCH &batch) {
+	void LedgerFrm::AddAccountTxIndex(WRITE_BATCH &batch, const protocol::Transaction &tx, int64_t seq, int32_t index, const std::string &hash) {
+		std::set<std::string> addresses;
+		addresses.insert(tx.source_address());
+		for (int32_t i = 0; i < tx.operations_size(); i++) {
+			const protocol::Operation &ope = tx.operations(i);
+			addresses.insert(ope.source_address());
+			switch (ope.type()) {
+			case protocol::Operation_Type_CREATE_ACCOUNT:
+				addresses.insert(ope.create_account().dest_address());
+				break;
+			case protocol::Operation_Type_PAY_ASSET:
+				addresses.insert(ope.pay_asset().dest_address());
+				break;
+			case protocol::Operation_Type_PAY_COIN:
+				addresses.insert(ope.pay_coin().dest_address());
+				break;
+			default:
+				break;
+			}
+		}
+
+		for (std::set<std::string>::const_iterator iter = addresses.begin(); iter != addresses.end(); iter++) {
+			if (!iter->empty()) {
+				batch.Put(ComposeAccountTxKey(*iter, seq, index), hash);
+			}
+		}
+	}
+
+	bool LedgerFrm::AddToBatch(WRITE_BATCH &batch) {
 		KeyValueDb *db = Storage::Instance().ledger_db();
+		bool tx_index = Configure::Instance().ledger_configure_.tx_index_;
+		int64_t seq = ledger_.header().seq();
+
+		//The index is complete from the first ledger closed with it, a backfill moves the beginning down
+		if (tx_index) {
+			std::string begin;
+			int32_t ncount = db->Get(General::KEY_ACCOUNT_TX_INDEX_BEGIN, begin);
+			if (ncount < 0) {
+				LOG_ERROR("Failed to load the beginning of the account transaction index, error desc(%s)", db->error_desc().c_str());
+			}
+			else if (ncount == 0) {
+				batch.Put(General::KEY_ACCOUNT_TX_INDEX_BEGIN, utils::String::ToString(seq));
+			}
+		}
 
 		batch.Put(rexx::General::KEY_LEDGER_SEQ, utils::String::ToString(ledger_.header().seq()));
-		batch.Put(ComposePrefix(General::LEDGER_PREFIX, ledger_.header().seq()), ledger_.header().SerializeAsString());
+		batch.Put(ComposeSeqKey(General::LEDGER_PREFIX, ledger_.header().seq()), ledger_.header().SerializeAsString());
 		
 		protocol::EntryList list;
 		for (size_t i = 0; i < apply_tx_frms_.size(); i++) {
@@ -84,6 +127,9 @@ namespace rexx {
 			}
 
 			batch.Put(ComposePrefix(General::TRANSACTION_PREFIX, ptr->GetContentHash()), env_store.SerializeAsString());
+			if (tx_index) {
+				AddAccountTxIndex(batch, env_store.transaction_env().transaction(), seq, list.entry_size(), ptr->GetContentHash());
+			}
 			list.add_entry(ptr->GetContentHash());
 
 			//If a transaction succeeds, the transactions tiggerred by it can be stored in db.
@@ -95,11 +141,14 @@ namespace rexx {
 					std::string hash = HashWrapper::Crypto(env_sto.transaction_env().transaction().SerializeAsString());
 					env_sto.set_hash(hash);
 					batch.Put(ComposePrefix(General::TRANSACTION_PREFIX, hash), env_sto.SerializeAsString());
+					if (tx_index) {
+						AddAccountTxIndex(batch, env_sto.transaction_env().transaction(), seq, list.entry_size(), hash);
+					}
 					list.add_entry(hash);
 				}
 		}
 
-		batch.Put(ComposePrefix(General::LEDGER_TRANSACTION_PREFIX, ledger_.header().seq()), list.SerializeAsString());
+		batch.Put(ComposeSeqKey(General::LEDGER_TRANSACTION_PREFIX, ledger_.header().seq()), list.SerializeAsString());
 
 		//save the last tx hash
 		if (list.entry_size() > 0) {
@@ -133,10 +182,6 @@ namespace rexx {
 
 			batch.Put(General::LAST_TX_HASHS, new_last_hashs.SerializeAsString());
 		}
-
-		if (!db->WriteBatch(batch)){
-			PROCESS_EXIT("Failed to write ledger and transaction to database(%s)", db->error_desc().c_str());
-		}
 		return true;
 	}
 
@@ -207,6 +252,78 @@ namespace rexx {
 		}
 	}
 
+	void LedgerFrm::LoadTransactions(const protocol::ConsensusValue& request, std::vector<TransactionFrm::pointer> &tx_frms) {
+		//A value taken from the sync buffer has its signatures verified already
+		if (lpledger_context_ != NULL &&
+			LedgerManager::Instance().sync_buffer_.TakeTransactions(lpledger_context_->GetHash(), tx_frms)) {
+			return;
+		}
+
+		for (int i = 0; i < request.txset().txs_size(); i++) {
+			tx_frms.push_back(std::make_shared<TransactionFrm>(request.txset().txs(i), false));
+		}
+
+		//The signatures decide whether a transaction applies, so check each of them on its own
+		TransactionFrm::VerifySignatures(tx_frms, true);
+	}
+
+	LedgerFrm::APPLY_RESULT LedgerFrm::ApplyTransaction(TransactionFrm::pointer tx_frm,
+		std::shared_ptr<Environment> environment,
+		int64_t &total_fee,
+		APPLY_MODE mode,
+		bool expired,
+		bool stacked) {
+
+		if (mode != APPLY_MODE_FOLLOW && !tx_frm->ValidForApply(environment, !IsTestMode())) {
+			return APPLY_RESULT_INVALID;
+		}
+
+		//pay fee
+		if (!tx_frm->PayFee(environment, total_fee)) {
+			return APPLY_RESULT_NO_FEE;
+		}
+
+		if (stacked) lpledger_context_->transaction_stack_.push_back(tx_frm);
+		tx_frm->NonceIncrease(this, environment);
+		if (environment->useAtomMap_) environment->Commit();
+
+		APPLY_RESULT result = APPLY_RESULT_SUCCESS;
+		if (mode == APPLY_MODE_FOLLOW && expired) {
+			//Follow the consensus value, and do not apply the transaction set.
+			tx_frm->ApplyExpireResult();
+			result = APPLY_RESULT_EXPIRED;
+		}
+		else {
+			if (mode != APPLY_MODE_FOLLOW) {
+				tx_frm->EnableChecked();
+				tx_frm->SetMaxEndTime(utils::Timestamp::HighResolution() + General::TX_EXECUTE_TIME_OUT);
+			}
+
+			bool ret = tx_frm->Apply(this, environment, false, stacked ? nullptr : tx_frm);
+			//Caculate the required mininum fee by calculting the bytes of the transaction. Do not store the transaction when the user-specified fee is less than this fee. 
+			std::string error_info;
+			if (tx_frm->IsExpire(error_info)) {
+				LOG_ERROR("Failed to apply transaction(%s): %s, %s",
+					utils::String::BinToHexString(tx_frm->GetContentHash()).c_str(), tx_frm->GetResult().desc().c_str(),
+					error_info.c_str());
+				result = APPLY_RESULT_EXPIRED;
+			}
+			else if (!ret) {
+				LOG_ERROR("Failed to apply transaction(%s): %s",
+					utils::String::BinToHexString(tx_frm->GetContentHash()).c_str(), tx_frm->GetResult().desc().c_str());
+				result = APPLY_RESULT_FAILED;
+			}
+			else {
+				tx_frm->ReturnFee(total_fee);
+				tx_frm->environment_->Commit();
+			}
+		}
+
+		environment->ClearChangeBuf();
+		if (stacked) lpledger_context_->transaction_stack_.pop_back();
+		return result;
+	}
+
 	bool LedgerFrm::ApplyPropose(const protocol::ConsensusValue& request,
 		LedgerContext *ledger_context,
 		ProposeTxsResult &proposed_result) {
@@ -227,56 +344,30 @@ namespace rexx {
 			return false;
 		}
 
+		std::vector<TransactionFrm::pointer> tx_frms;
+		LoadTransactions(request, tx_frms);
+		ParallelExecutor executor(this, APPLY_MODE_PROPOSE, tx_frms, NULL);
 		for (int i = 0; i < request.txset().txs_size() && enabled_; i++) {
 			const protocol::TransactionEnv &txproto = request.txset().txs(i);
 
-			TransactionFrm::pointer tx_frm = std::make_shared<TransactionFrm>(txproto);
+			TransactionFrm::pointer tx_frm = tx_frms[i];
 
-			if (!tx_frm->ValidForApply(environment_, !IsTestMode())) {
+			APPLY_RESULT result = executor.Apply(i, environment_, total_fee_);
+			if (result == APPLY_RESULT_INVALID || result == APPLY_RESULT_NO_FEE) {
 				dropped_tx_frms_.push_back(tx_frm);
 				proposed_result.need_dropped_tx_.insert(i); //for drop
 				continue;
 			}
 
-			//pay fee
-			if (!tx_frm->PayFee(environment_, total_fee_)) {
-				dropped_tx_frms_.push_back(tx_frm);
-				proposed_result.need_dropped_tx_.insert(i);//for drop
-				continue;
-			}
-
-			ledger_context->transaction_stack_.push_back(tx_frm);
-			tx_frm->NonceIncrease(this, environment_);
-			if (environment_->useAtomMap_) environment_->Commit();
-
-			tx_frm->EnableChecked();
-			tx_frm->SetMaxEndTime(utils::Timestamp::HighResolution() + General::TX_EXECUTE_TIME_OUT);
-
-			bool ret = tx_frm->Apply(this, environment_);
-			//Caculate the required mininum fee by calculting the bytes of the transaction. Do not store the transaction when the user-specified fee is less than this fee. 
-			std::string error_info;
-			if (tx_frm->IsExpire(error_info)) {
-				LOG_ERROR("Failed to apply transaction(%s): %s, %s",
-					utils::String::BinToHexString(tx_frm->GetContentHash()).c_str(), tx_frm->GetResult().desc().c_str(),
-					error_info.c_str());
+			if (result == APPLY_RESULT_EXPIRED) {
 				expire_txs.insert(i - proposed_result.need_dropped_tx_.size());//for check
 			}
-			else {
-				if (!ret) {
-					LOG_ERROR("Failed to apply transaction(%s): %s",
-						utils::String::BinToHexString(tx_frm->GetContentHash()).c_str(), tx_frm->GetResult().desc().c_str());
-					error_txs.insert(i - proposed_result.need_dropped_tx_.size());//for check
-				}
-				else {
-					tx_frm->ReturnFee(total_fee_);
-					tx_frm->environment_->Commit();
-				}
+			else if (result == APPLY_RESULT_FAILED) {
+				error_txs.insert(i - proposed_result.need_dropped_tx_.size());//for check
 			}
 
-			environment_->ClearChangeBuf();
 			apply_tx_frms_.push_back(tx_frm);
 			ledger_.add_transaction_envs()->CopyFrom(txproto);
-			ledger_context->transaction_stack_.pop_back();
 
 			if ( utils::Timestamp::HighResolution() - start_time > General::BLOCK_EXECUTE_TIME_OUT) {
 				LOG_ERROR("Applying block timeout(" FMT_I64 ") ", utils::Timestamp::HighResolution() - start_time);
@@ -311,54 +402,34 @@ namespace rexx {
 			return false;
 		}
 
+		std::vector<TransactionFrm::pointer> tx_frms;
+		LoadTransactions(request, tx_frms);
+		ParallelExecutor executor(this, APPLY_MODE_CHECK, tx_frms, NULL);
 		for (int i = 0; i < request.txset().txs_size() && enabled_; i++) {
 			auto txproto = request.txset().txs(i);
 
-			TransactionFrm::pointer tx_frm = std::make_shared<TransactionFrm>(txproto);
+			TransactionFrm::pointer tx_frm = tx_frms[i];
 
-			if (!tx_frm->ValidForApply(environment_, !IsTestMode())) {
+			APPLY_RESULT result = executor.Apply(i, environment_, total_fee_);
+			if (result == APPLY_RESULT_INVALID) {
 				LOG_ERROR("Validition for application failed: consensus value sequence(" FMT_I64 ")", request.ledger_seq());
 				return false;
 			}
 
-			//pay fee
-			if (!tx_frm->PayFee(environment_, total_fee_)) {
+			if (result == APPLY_RESULT_NO_FEE) {
 				LOG_ERROR("Failed to pay fee, consensus value sequence(" FMT_I64 ")", request.ledger_seq());
 				return false;
 			}
 
-			ledger_context->transaction_stack_.push_back(tx_frm);
-			tx_frm->NonceIncrease(this, environment_);
-			if (environment_->useAtomMap_) environment_->Commit();
-
-			tx_frm->EnableChecked();
-			tx_frm->SetMaxEndTime(utils::Timestamp::HighResolution() + General::TX_EXECUTE_TIME_OUT);
-
-			bool ret = tx_frm->Apply(this, environment_);
-			//Caculate the required mininum fee by calculting the bytes of the transaction. Do not store the transaction when the user-specified fee is less than this fee. 
-			std::string error_info;
-			if (tx_frm->IsExpire(error_info)) {
-				LOG_ERROR("Failed to apply transaction(%s). %s, %s",
-					utils::String::BinToHexString(tx_frm->GetContentHash()).c_str(), tx_frm->GetResult().desc().c_str(),
-					error_info.c_str());
+			if (result == APPLY_RESULT_EXPIRED) {
 				expire_txs.insert(i);//for check
 			}
-			else {
-				if (!ret) {
-					LOG_ERROR("Failed to apply transaction(%s). %s",
-						utils::String::BinToHexString(tx_frm->GetContentHash()).c_str(), tx_frm->GetResult().desc().c_str());
-					error_txs.insert(i);//for check
-				}
-				else {
-					tx_frm->ReturnFee(total_fee_);
-					tx_frm->environment_->Commit();
-				}
+			else if (result == APPLY_RESULT_FAILED) {
+				error_txs.insert(i);//for check
 			}
 
-			environment_->ClearChangeBuf();
 			apply_tx_frms_.push_back(tx_frm);
 			ledger_.add_transaction_envs()->CopyFrom(txproto);
-			ledger_context->transaction_stack_.pop_back();
 
 			if (utils::Timestamp::HighResolution() - start_time > General::BLOCK_EXECUTE_TIME_OUT) {
 				LOG_ERROR("Applying block timeout(" FMT_I64 ") ", utils::Timestamp::HighResolution() - start_time);
@@ -396,49 +467,27 @@ namespace rexx {
 			return false;
 		}
 
+		std::vector<TransactionFrm::pointer> tx_frms;
+		LoadTransactions(request, tx_frms);
+		ParallelExecutor executor(this, APPLY_MODE_FOLLOW, tx_frms, &expire_txs_check);
 		for (int i = 0; i < request.txset().txs_size() && enabled_; i++) {
 			auto txproto = request.txset().txs(i);
 			
-			TransactionFrm::pointer tx_frm = std::make_shared<TransactionFrm>(txproto);
+			TransactionFrm::pointer tx_frm = tx_frms[i];
 
-			/*if (!tx_frm->ValidForApply(environment_,!IsTestMode())){
-				LOG_WARN("Should not go hear");
-				continue;
-			}*/
-
-			//Pay fee
-			if (!tx_frm->PayFee(environment_, total_fee_)) {
+			//Follow the consensus value, the transactions were checked when it was proposed
+			APPLY_RESULT result = executor.Apply(i, environment_, total_fee_);
+			if (result == APPLY_RESULT_NO_FEE) {
 				LOG_WARN("Failed to pay fee.");
 				continue;
 			}
 
-			ledger_context->transaction_stack_.push_back(tx_frm);
-			tx_frm->NonceIncrease(this, environment_);
-			if (environment_->useAtomMap_) environment_->Commit();
-
-
-			if ( expire_txs_check.find(i) != expire_txs_check.end()) {
-				//Follow the consensus value, and do not apply the transaction set.
-				tx_frm->ApplyExpireResult();
-			}
-			else {
-				bool ret = tx_frm->Apply(this, environment_);
-				if (!ret) {
-					LOG_ERROR("Failed to apply transaction(%s). %s",
-						utils::String::BinToHexString(tx_frm->GetContentHash()).c_str(), tx_frm->GetResult().desc().c_str());
-					error_txs.insert(i);//for check
-				}
-				else {
-					tx_frm->ReturnFee(total_fee_);
-					tx_frm->environment_->Commit();
-				}
+			if (result == APPLY_RESULT_FAILED) {
+				error_txs.insert(i);//for check
 			}
 
-			environment_->ClearChangeBuf();
 			apply_tx_frms_.push_back(tx_frm);			
 			ledger_.add_transaction_envs()->CopyFrom(txproto);
-			ledger_context->transaction_stack_.pop_back();
-
 		}
 		AllocateReward();
 		apply_time_ = utils::Timestamp::HighResolution() - start_time;
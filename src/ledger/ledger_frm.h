@@ -35,6 +35,14 @@ namespace rexx {
 			APPLY_MODE_FOLLOW = 2
 		} APPLY_MODE;
 
+		typedef enum tagAPPLY_RESULT {
+			APPLY_RESULT_INVALID = 0, //dropped before paying the fee
+			APPLY_RESULT_NO_FEE = 1, //dropped as the fee could not be paid
+			APPLY_RESULT_EXPIRED = 2,
+			APPLY_RESULT_FAILED = 3,
+			APPLY_RESULT_SUCCESS = 4
+		} APPLY_RESULT;
+
 		LedgerFrm();
 		~LedgerFrm();
 
@@ -55,11 +63,24 @@ namespace rexx {
 		bool ApplyCheck(const protocol::ConsensusValue& request,
 			LedgerContext *ledger_context);
 
+		//Apply one transaction of the consensus value, expired is the expire validation of a followed value.
+		//A stacked transaction is pushed to the ledger context, an unstacked one pays its own gas and must not call a contract.
+		APPLY_RESULT ApplyTransaction(TransactionFrm::pointer tx_frm,
+			std::shared_ptr<Environment> environment,
+			int64_t &total_fee,
+			APPLY_MODE mode,
+			bool expired,
+			bool stacked);
+
 		bool Cancel();
 
 		// void GetSqlTx(std::string &sqltx, std::string &sql_account_tx);
 
-		bool AddToDb(WRITE_BATCH& batch);
+		//Put the ledger and its transactions into the ledger db batch, the caller writes it with Storage::WriteLedger
+		bool AddToBatch(WRITE_BATCH& batch);
+
+		//Index a transaction under the addresses it touches, index is its position in the transaction list of the ledger
+		static void AddAccountTxIndex(WRITE_BATCH& batch, const protocol::Transaction &tx, int64_t seq, int32_t index, const std::string &hash);
 
 		bool LoadFromDb(int64_t seq);
 
@@ -95,6 +116,8 @@ namespace rexx {
 		bool IsTestMode();
 
 	private:
+		void LoadTransactions(const protocol::ConsensusValue& request, std::vector<TransactionFrm::pointer> &tx_frms);
+
 		protocol::Ledger ledger_;
 		bool is_test_mode_;
 	public:
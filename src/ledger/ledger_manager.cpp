@@ -6,6 +6,7 @@
 #include "ledger_manager.h"
 #include "contract_manager.h"
 #include "fee_calculate.h"
+#include "parallel_executor.h"
 
 namespace rexx {
 	LedgerManager::LedgerManager() : tree_(NULL) {
@@ -39,12 +40,51 @@ namespace rexx {
 
 	bool LedgerManager::Initialize() {
 		HashWrapper::SetLedgerHashType(Configure::Instance().ledger_configure_.hash_type_);
+		if (!UpgradeSeqKeys()) {
+			LOG_ERROR("Failed to upgrade the sequence keys of the ledger db");
+			return false;
+		}
+
+		trie_cache_.SetCapacity(Configure::Instance().ledger_configure_.trie_cache_size_);
+		query_cache_.SetCapacity(Configure::Instance().ledger_configure_.contract_query_cache_size_);
+
+		size_t hash_thread_count = Configure::Instance().ledger_configure_.hash_thread_count_;
+		if (hash_thread_count == 0) {
+			hash_thread_count = utils::System::GetCpuCoreCount();
+		}
+		if (hash_thread_count > 1 && !hash_pool_.Initialize("hash", hash_thread_count)) {
+			LOG_ERROR("Failed to start %u hash threads", (uint32_t)hash_thread_count);
+			return false;
+		}
+
+		const LedgerConfigure &ledger_config = Configure::Instance().ledger_configure_;
+		size_t sync_capacity = (size_t)MAX(ledger_config.max_ledger_per_message_, 1) * MAX(ledger_config.sync_windows_, 1);
+		if (!sync_buffer_.Initialize(ledger_config.sync_thread_count_, sync_capacity, []() {
+			Global::Instance().GetIoService().post([]() {
+				LedgerManager::Instance().CloseSyncLedgers();
+			});
+		})) {
+			LOG_ERROR("Failed to start %u sync threads", ledger_config.sync_thread_count_);
+			return false;
+		}
+
+		if (ledger_config.parallel_thread_count_ > 0) {
+			if (!ledger_config.use_atom_map_) {
+				LOG_WARN("Parallel execution needs use_atom_map, the transactions are applied serially");
+			}
+			else if (!apply_pool_.Initialize("apply", ledger_config.parallel_thread_count_)) {
+				LOG_ERROR("Failed to start %u apply threads", ledger_config.parallel_thread_count_);
+				return false;
+			}
+		}
 
 		tree_ = new KVTrie();
 		auto batch = std::make_shared<WRITE_BATCH>();
 		tree_->Init(Storage::Instance().account_db(), batch, General::ACCOUNT_PREFIX, 4);
 
-		context_manager_.Initialize();
+		if (!context_manager_.Initialize()) {
+			return false;
+		}
 
 		auto kvdb = Storage::Instance().account_db();
 		std::string str_max_seq;
@@ -123,6 +163,10 @@ namespace rexx {
 
 	bool LedgerManager::Exit() {
 		LOG_INFO("Ledger manager stoping...");
+		sync_buffer_.Exit();
+		hash_pool_.Exit();
+		context_manager_.Exit();
+		apply_pool_.Exit();
 
 		if (tree_) {
 			delete tree_;
@@ -168,14 +212,13 @@ namespace rexx {
 			gl.set_end(next_seq);
 			gl.set_timestamp(current_time);
 
+			int64_t max_window = MAX(Configure::Instance().ledger_configure_.max_ledger_per_message_, 1);
 			for (std::set<int64_t>::iterator it = active_peers.begin(); it != active_peers.end(); it++) {
 				int64_t pid = *it;
 				auto iter = sync_.peers_.find(pid);
 				if (iter != sync_.peers_.end()) {
 					SyncStat& st = iter->second;
-					if (current_time - st.send_time_ > 30 * utils::MICRO_UNITS_PER_SEC) {
-						st.send_time_ = 0;
-					}
+					st.Expire(current_time, max_window);
 					if (st.probation_ > current_time) {
 						continue;
 					}
@@ -193,7 +236,16 @@ namespace rexx {
 	}
 
 	void LedgerManager::OnSlowTimer(int64_t current_time) {
-
+		utils::MutexGuard guard(gmutex_);
+		if (sync_.rate_time_ == 0) {
+			sync_.rate_time_ = current_time;
+			sync_.rate_count_ = sync_.closed_count_;
+		}
+		else if (current_time - sync_.rate_time_ >= 5 * utils::MICRO_UNITS_PER_SEC) {
+			sync_.rate_ = (double)(sync_.closed_count_ - sync_.rate_count_) * utils::MICRO_UNITS_PER_SEC / (current_time - sync_.rate_time_);
+			sync_.rate_time_ = current_time;
+			sync_.rate_count_ = sync_.closed_count_;
+		}
 	}
 
 	protocol::LedgerHeader LedgerManager::GetLastClosedLedger() {
@@ -298,13 +350,13 @@ namespace rexx {
 		FeesConfigSet(batch, fees_);
 
 		WRITE_BATCH batch_ledger;
-		if (!last_closed_ledger_->AddToDb(batch_ledger)) {
-			PROCESS_EXIT("AddToDb failed");
+		if (!last_closed_ledger_->AddToBatch(batch_ledger)) {
+			PROCESS_EXIT("AddToBatch failed");
 		}
 
 		batch->Put(General::STATISTICS, statistics_.toFastString());
-		if (!Storage::Instance().account_db()->WriteBatch(*batch)) {
-			PROCESS_EXIT("Failed to write account to database, %s", Storage::Instance().account_db()->error_desc().c_str());
+		if (!Storage::Instance().WriteLedger(1, batch_ledger, *batch)) {
+			PROCESS_EXIT("Failed to write genesis ledger to database");
 		}
 
 		return true;
@@ -335,7 +387,7 @@ namespace rexx {
 			protocol::LedgerHeader last_closed_ledger_hdr;
 			rexx::KeyValueDb *ledger_db = rexx::Storage::Instance().ledger_db();
 			std::string ledger_header;
-			if (ledger_db->Get(ComposePrefix(General::LEDGER_PREFIX, seq_kvdb), ledger_header) <= 0) {
+			if (ledger_db->Get(ComposeSeqKey(General::LEDGER_PREFIX, seq_kvdb), ledger_header) <= 0) {
 				LOG_ERROR("Failed to load ledger from database, error(%s)", ledger_db->error_desc().c_str());
 				break;
 			}
@@ -413,8 +465,8 @@ namespace rexx {
 			//Write ledger db
 			WRITE_BATCH batch_ledger;
 			batch_ledger.Put(rexx::General::KEY_LEDGER_SEQ, utils::String::ToString(header->seq()));
-			batch_ledger.Put(ComposePrefix(General::LEDGER_PREFIX, header->seq()), header->SerializeAsString());
-			batch_ledger.Put(ComposePrefix(General::CONSENSUS_VALUE_PREFIX, header->seq()), request.SerializeAsString());
+			batch_ledger.Put(ComposeSeqKey(General::LEDGER_PREFIX, header->seq()), header->SerializeAsString());
+			batch_ledger.Put(ComposeSeqKey(General::CONSENSUS_VALUE_PREFIX, header->seq()), request.SerializeAsString());
 			if (!ledger_db->WriteBatch(batch_ledger)) {
 				PROCESS_EXIT("Failed to write ledger and transaction to database(%s)", ledger_db->error_desc().c_str());
 			}
@@ -432,10 +484,154 @@ namespace rexx {
 	}
 
 
+	bool LedgerManager::UpgradeSeqKeys() {
+		KeyValueDb *ledger_db = Storage::Instance().ledger_db();
+		std::string str_version;
+		if (ledger_db->Get(General::KEY_SEQ_KEY_VERSION, str_version) > 0 &&
+			utils::String::Stoi(str_version) >= General::SEQ_KEY_VERSION) {
+			return true;
+		}
+
+		const char *prefixes[] = { General::LEDGER_PREFIX, General::LEDGER_TRANSACTION_PREFIX, General::CONSENSUS_VALUE_PREFIX };
+		for (size_t i = 0; i < sizeof(prefixes) / sizeof(prefixes[0]); i++) {
+			std::string prefix = prefixes[i];
+			WRITE_BATCH batch;
+			size_t batch_count = 0;
+			int64_t total_count = 0;
+			bool write_ok = true;
+
+			//Decimal keys are prefix_ followed by digits, ':' is the character after '9'
+			bool scan_ok = ledger_db->Scan(prefix + "_0", prefix + "_:", [&](const std::string &key, const std::string &value) {
+				int64_t seq = utils::String::Stoi64(key.substr(prefix.size() + 1));
+				batch.Put(ComposeSeqKey(prefix, seq), value);
+				batch.Delete(key);
+				total_count++;
+
+				//Each batch moves its records atomically
+				if (++batch_count >= 1000) {
+					write_ok = ledger_db->WriteBatch(batch);
+					batch.Clear();
+					batch_count = 0;
+					if (write_ok) {
+						LOG_INFO("Upgraded " FMT_I64 " %s keys of the ledger db", total_count, prefix.c_str());
+					}
+				}
+				return write_ok;
+			});
+
+			if (write_ok && batch_count > 0) {
+				write_ok = ledger_db->WriteBatch(batch);
+			}
+
+			if (!scan_ok || !write_ok) {
+				LOG_ERROR("Failed to upgrade the %s keys of the ledger db, error(%s)", prefix.c_str(), ledger_db->error_desc().c_str());
+				return false;
+			}
+
+			if (total_count > 0) {
+				LOG_INFO("Upgraded all the " FMT_I64 " %s keys of the ledger db", total_count, prefix.c_str());
+			}
+		}
+
+		if (!ledger_db->Put(General::KEY_SEQ_KEY_VERSION, utils::String::ToString(General::SEQ_KEY_VERSION))) {
+			LOG_ERROR("Failed to save the sequence key version, error(%s)", ledger_db->error_desc().c_str());
+			return false;
+		}
+		return true;
+	}
+
+	bool LedgerManager::BackfillAccountTxIndex() {
+		if (!Configure::Instance().ledger_configure_.tx_index_) {
+			LOG_ERROR("The account transaction index is not enabled, set tx_index of the ledger configuration first");
+			return false;
+		}
+
+		//The ledgers are read by their sequence keys, which an old db still has in the decimal form
+		if (!UpgradeSeqKeys()) {
+			LOG_ERROR("Failed to upgrade the sequence keys of the ledger db");
+			return false;
+		}
+
+		KeyValueDb *ledger_db = Storage::Instance().ledger_db();
+		std::string str_seq;
+		int64_t top_seq = 0;
+		if (ledger_db->Get(General::KEY_ACCOUNT_TX_INDEX_BEGIN, str_seq) > 0) {
+			top_seq = utils::String::Stoi64(str_seq) - 1;
+		}
+		else if (ledger_db->Get(General::KEY_LEDGER_SEQ, str_seq) > 0) {
+			top_seq = utils::String::Stoi64(str_seq);
+		}
+
+		WRITE_BATCH batch;
+		size_t batch_count = 0;
+		int64_t total_count = 0;
+		int64_t begin_seq = 1;
+		for (int64_t seq = top_seq; seq >= 1; seq--) {
+			std::string hashlist;
+			int32_t ret = ledger_db->Get(ComposeSeqKey(General::LEDGER_TRANSACTION_PREFIX, seq), hashlist);
+			if (ret == 0) {
+				//Every closed ledger has its transaction list, but the ledger of an imported snapshot, the oldest in the db
+				std::string str_header;
+				if (seq > 1 && ledger_db->Get(ComposeSeqKey(General::LEDGER_PREFIX, seq), str_header) > 0 &&
+					ledger_db->Get(ComposeSeqKey(General::LEDGER_PREFIX, seq - 1), str_header) == 0) {
+					LOG_INFO("Ledger(" FMT_I64 ") is the oldest in the db, the index begins after it", seq);
+					begin_seq = seq + 1;
+					break;
+				}
+
+				LOG_ERROR("The transaction list of ledger(" FMT_I64 ") is missing", seq);
+				return false;
+			}
+
+			protocol::EntryList list;
+			if (ret < 0 || !list.ParseFromString(hashlist)) {
+				LOG_ERROR("Failed to load the transaction list of ledger(" FMT_I64 "), error(%s)", seq, ledger_db->error_desc().c_str());
+				return false;
+			}
+
+			for (int32_t i = 0; i < list.entry_size(); i++) {
+				std::string str_tx;
+				protocol::TransactionEnvStore env_store;
+				if (ledger_db->Get(ComposePrefix(General::TRANSACTION_PREFIX, list.entry(i)), str_tx) <= 0 || !env_store.ParseFromString(str_tx)) {
+					LOG_ERROR("Failed to load transaction(%s) of ledger(" FMT_I64 ")", utils::String::BinToHexString(list.entry(i)).c_str(), seq);
+					return false;
+				}
+
+				LedgerFrm::AddAccountTxIndex(batch, env_store.transaction_env().transaction(), seq, i, list.entry(i));
+				batch_count++;
+			}
+
+			//Each batch moves the beginning of the index down together with its entries
+			if (batch_count >= 10000 && !WriteAccountTxIndex(batch, seq, total_count, batch_count)) {
+				return false;
+			}
+		}
+
+		if (top_seq >= 1 && !WriteAccountTxIndex(batch, begin_seq, total_count, batch_count)) {
+			return false;
+		}
+		return true;
+	}
+
+	bool LedgerManager::WriteAccountTxIndex(WRITE_BATCH &batch, int64_t begin_seq, int64_t &total_count, size_t &batch_count) {
+		KeyValueDb *ledger_db = Storage::Instance().ledger_db();
+		batch.Put(General::KEY_ACCOUNT_TX_INDEX_BEGIN, utils::String::ToString(begin_seq));
+		if (!ledger_db->WriteBatch(batch)) {
+			LOG_ERROR("Failed to write the account transaction index, error(%s)", ledger_db->error_desc().c_str());
+			return false;
+		}
+
+		total_count += batch_count;
+		batch.Clear();
+		batch_count = 0;
+		LOG_INFO("Indexed " FMT_I64 " transactions down to ledger(" FMT_I64 ")", total_count, begin_seq);
+		return true;
+	}
+
 	bool LedgerManager::ConsensusValueFromDB(int64_t seq, protocol::ConsensusValue& consensus_value) {
 		KeyValueDb *ledger_db = Storage::Instance().ledger_db();
 		std::string str_cons;
-		if (ledger_db->Get(ComposePrefix(General::CONSENSUS_VALUE_PREFIX, seq), str_cons) <= 0) {
+		if (ledger_db->Get(ComposeSeqKey(General::CONSENSUS_VALUE_PREFIX, seq), str_cons) <= 0) {
 			return false;
 		}
 
@@ -490,7 +686,12 @@ namespace rexx {
 			(utils::Timestamp::HighResolution() - begin_time) / utils::MICRO_UNITS_PER_MILLI);
 		data["hash_type"] = HashWrapper::GetLedgerHashType() == HashWrapper::HASH_TYPE_SM3 ? "sm3" : "sha256";
 		data["sync"] = sync_.ToJson();
+		sync_buffer_.GetModuleStatus(data["sync"]["buffer"]);
 		context_manager_.GetModuleStatus(data["ledger_context"]);
+		trie_cache_.GetModuleStatus(data["trie_cache"]);
+		query_cache_.GetModuleStatus(data["contract_query_cache"]);
+		V8Contract::code_cache_.GetModuleStatus(data["contract_code_cache"]);
+		ParallelExecutor::GetModuleStatus(data["parallel_execution"]);
 
 		data["chain_max_ledger_seq"] = chain_max_ledger_probaly_ > data["ledger_sequence"].asInt64() ?
 		chain_max_ledger_probaly_ : data["ledger_sequence"].asInt64();
@@ -532,7 +733,7 @@ namespace rexx {
 
 		int64_t time1 = utils::Timestamp().HighResolution();
 
-		tree_->UpdateHash();
+		tree_->UpdateHash(&hash_pool_);
 		int64_t time2 = utils::Timestamp().HighResolution();
 
 		header->set_account_tree_hash(tree_->GetRootHash());
@@ -589,20 +790,16 @@ namespace rexx {
 
 		//consensus value
 		WRITE_BATCH ledger_db_batch;
-		ledger_db_batch.Put(ComposePrefix(General::CONSENSUS_VALUE_PREFIX, consensus_value.ledger_seq()), consensus_value.SerializeAsString());
-
-		do {
-			utils::WriteLockGuard guard(Storage::Instance().account_ledger_lock_);
-
-			if (!closing_ledger->AddToDb(ledger_db_batch)) {
-				PROCESS_EXIT("Failed to write ledger to database.");
-			}
+		ledger_db_batch.Put(ComposeSeqKey(General::CONSENSUS_VALUE_PREFIX, consensus_value.ledger_seq()), consensus_value.SerializeAsString());
 
-			if (!Storage::Instance().account_db()->WriteBatch(*account_db_batch)) {
-				PROCESS_EXIT("Failed to write accounts to database: %s", Storage::Instance().account_db()->error_desc().c_str());
-			}
+		if (!closing_ledger->AddToBatch(ledger_db_batch)) {
+			PROCESS_EXIT("Failed to add ledger to batch.");
+		}
 
-		} while (false);
+		//Readers must not see the new ledger through stale cached trie nodes
+		if (!Storage::Instance().WriteLedger(ledger_seq, ledger_db_batch, *account_db_batch, [this]() { trie_cache_.InvalidateDirty(); })) {
+			PROCESS_EXIT("Failed to write ledger and accounts to database");
+		}
 
 		//Update the variable when the write is successful.
 		last_closed_ledger_ = closing_ledger;
@@ -635,6 +832,9 @@ namespace rexx {
 			tmp_lcl_header = lcl_header_ = last_closed_ledger_->GetProtoHeader();
 		} while (false);
 
+		//The queries were executed on the previous state
+		query_cache_.Clear();
+
 		protocol::ValidatorSet tmp_v = validators_;
 		std::string tmp_proof = proof_;
 		Global::Instance().GetIoService().post([tmp_v, tmp_proof, has_upgrade]() { //avoid deadlock
@@ -708,8 +908,9 @@ namespace rexx {
 		do {
 			utils::MutexGuard guard(gmutex_);
 			LOG_TRACE("OnRequestLedgers pid(" FMT_I64 "),[" FMT_I64 ", " FMT_I64 "]", peer_id, message.begin(), message.end());
-			if (message.end() - message.begin() + 1 > 5) {
-				LOG_ERROR("Only 5 blocks can be requested at a time while try to (" FMT_I64 ")", message.end() - message.begin());
+			int64_t max_ledgers = Configure::Instance().ledger_configure_.max_ledger_per_message_;
+			if (message.end() - message.begin() + 1 > max_ledgers) {
+				LOG_ERROR("Only " FMT_I64 " blocks can be requested at a time while try to (" FMT_I64 ")", max_ledgers, message.end() - message.begin());
 				return;
 			}
 
@@ -727,9 +928,20 @@ namespace rexx {
 
 			ledgers.set_max_seq(last_closed_ledger_->GetProtoHeader().seq());
 
+			//The sequence keys are in order, so the values are read with one range scan
+			KeyValueList records;
+			KeyValueDb *ledger_db = Storage::Instance().ledger_db();
+			if (!ledger_db->GetRange(ComposeSeqKey(General::CONSENSUS_VALUE_PREFIX, message.begin()),
+				ComposeSeqKey(General::CONSENSUS_VALUE_PREFIX, message.end() + 1), (size_t)(message.end() - message.begin() + 1), records)) {
+				ret = false;
+				LOG_ERROR("Failed to get consensus values from database, error(%s)", ledger_db->error_desc().c_str());
+				break;
+			}
+
 			for (int64_t i = message.begin(); i <= message.end(); i++) {
 				protocol::ConsensusValue item;
-				if (!ConsensusValueFromDB(i, item)) {
+				size_t index = (size_t)(i - message.begin());
+				if (index >= records.size() || !item.ParseFromString(records[index].second) || item.ledger_seq() != i) {
 					ret = false;
 					LOG_ERROR("Failed to get consensus value from database: consensus value sequence=" FMT_I64, i);
 					break;
@@ -794,42 +1006,129 @@ namespace rexx {
 
 			itm.gl_.set_begin(0);
 			itm.gl_.set_end(0);
+			itm.max_seq_ = ledgers.max_seq();
+			//Grow the window back by one ledger per reply, a peer which timed out at a window reaches it again slowly
+			int64_t max_window = MAX(Configure::Instance().ledger_configure_.max_ledger_per_message_, 1);
+			itm.window_ = itm.window_ == 0 ? max_window : MIN(itm.window_ + 1, max_window);
 
-			for (int i = 0; i < ledgers.values_size(); i++) {
-				const protocol::ConsensusValue& consensus_value = ledgers.values(i);
-				std::string proof;
-				if (i < ledgers.values_size() - 1) {
-					proof = ledgers.values(i + 1).previous_proof();
+			if (ledgers.max_seq() > chain_max_ledger_probaly_) {
+				chain_max_ledger_probaly_ = ledgers.max_seq();
+			}
+			next = last_closed_ledger_->GetProtoHeader().seq();
+			valid = true;
+		} while (false);
+
+		if (valid) {
+			//The values are verified on the sync threads, then closed in order by CloseSyncLedgers
+			sync_buffer_.Add(ledgers, next, peer_id);
+			RequestSyncWindows(utils::Timestamp::HighResolution());
+		}
+	}
+
+	void LedgerManager::RequestSyncWindows(int64_t current_time) {
+		std::vector<std::pair<int64_t, protocol::GetLedgers>> requests;
+
+		do {
+			utils::MutexGuard guard(gmutex_);
+			const LedgerConfigure &ledger_config = Configure::Instance().ledger_configure_;
+			int64_t max_window = MAX(ledger_config.max_ledger_per_message_, 1);
+			int64_t next = last_closed_ledger_->GetProtoHeader().seq() + 1;
+			int64_t last = MIN(chain_max_ledger_probaly_, next + max_window * MAX(ledger_config.sync_windows_, 1) - 1);
+
+			//Ranges in flight
+			std::map<int64_t, int64_t> inflight;
+			std::vector<int64_t> idle_peers;
+			for (auto iter = sync_.peers_.begin(); iter != sync_.peers_.end(); iter++) {
+				SyncStat &st = iter->second;
+				st.Expire(current_time, max_window);
+
+				if (st.send_time_ != 0) {
+					inflight[st.gl_.begin()] = st.gl_.end();
 				}
-				else {
-					proof = ledgers.proof();
+				else if (st.probation_ <= current_time && st.max_seq_ >= next) {
+					idle_peers.push_back(iter->first);
 				}
-				if (consensus_value.ledger_seq() == last_closed_ledger_->GetProtoHeader().seq() + 1) {
-					if (!CloseLedger(consensus_value, proof)) {
-						valid = false;
-						itm.probation_ = utils::Timestamp::HighResolution() + 60 * utils::MICRO_UNITS_PER_SEC;
+			}
+
+			int64_t seq = next;
+			while (seq <= last && !idle_peers.empty()) {
+				if (sync_buffer_.Contains(seq)) {
+					seq++;
+					continue;
+				}
+
+				bool skipped = false;
+				for (auto iter = inflight.begin(); iter != inflight.end(); iter++) {
+					if (iter->first <= seq && seq <= iter->second) {
+						seq = iter->second + 1;
+						skipped = true;
 						break;
 					}
-					valid = true;
 				}
-			}
-			next = last_closed_ledger_->GetProtoHeader().seq() + 1;
-		} while (false);
+				if (skipped) {
+					continue;
+				}
 
+				//The peer knowing the most ledgers takes the range
+				size_t best = 0;
+				for (size_t i = 1; i < idle_peers.size(); i++) {
+					if (sync_.peers_[idle_peers[i]].max_seq_ > sync_.peers_[idle_peers[best]].max_seq_) {
+						best = i;
+					}
+				}
+				int64_t pid = idle_peers[best];
+				SyncStat &st = sync_.peers_[pid];
+				if (st.max_seq_ < seq) {
+					break;
+				}
 
-		if (valid) {
-			int64_t current_time = utils::Timestamp::HighResolution();
-			if (next <= ledgers.max_seq()) {
+				int64_t window = st.window_ > 0 ? st.window_ : max_window;
 				protocol::GetLedgers gl;
-				gl.set_begin(next);
-				gl.set_end(MIN(ledgers.max_seq(), next + 4));
+				gl.set_begin(seq);
+				gl.set_end(MIN(MIN(seq + window - 1, last), st.max_seq_));
 				gl.set_timestamp(current_time);
-				RequestConsensusValues(peer_id, gl, current_time);
+				requests.push_back(std::make_pair(pid, gl));
+
+				inflight[gl.begin()] = gl.end();
+				idle_peers.erase(idle_peers.begin() + best);
+				seq = gl.end() + 1;
 			}
+		} while (false);
 
-			if (ledgers.max_seq() > chain_max_ledger_probaly_) {
-				chain_max_ledger_probaly_ = ledgers.max_seq();
+		for (size_t i = 0; i < requests.size(); i++) {
+			RequestConsensusValues(requests[i].first, requests[i].second, current_time);
+		}
+	}
+
+	void LedgerManager::CloseSyncLedgers() {
+		int64_t closed_count = 0;
+		do {
+			utils::MutexGuard guard(gmutex_);
+			while (true) {
+				protocol::ConsensusValue consensus_value;
+				std::string proof;
+				int64_t peer_id = 0;
+				if (!sync_buffer_.Take(last_closed_ledger_->GetProtoHeader().seq() + 1, consensus_value, proof, peer_id)) {
+					break;
+				}
+
+				if (!CloseLedger(consensus_value, proof)) {
+					LOG_ERROR("Failed to close the synchronized ledger(" FMT_I64 ") from peer(" FMT_I64 ")", consensus_value.ledger_seq(), peer_id);
+					auto iter = sync_.peers_.find(peer_id);
+					if (iter != sync_.peers_.end()) {
+						iter->second.probation_ = utils::Timestamp::HighResolution() + 60 * utils::MICRO_UNITS_PER_SEC;
+					}
+					//The following values may come from the same peer, fetch them again
+					sync_buffer_.Clear();
+					break;
+				}
+				closed_count++;
 			}
+			sync_.closed_count_ += closed_count;
+		} while (false);
+
+		if (closed_count > 0) {
+			RequestSyncWindows(utils::Timestamp::HighResolution());
 		}
 	}
 
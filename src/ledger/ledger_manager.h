@@ -7,12 +7,16 @@
 #include <common/general.h>
 #include <common/storage.h>
 #include <common/private_key.h>
+#include <common/worker_pool.h>
 #include <main/configure.h>
 #include <overlay/peer.h>
 #include "ledger/ledger_frm.h"
 #include "ledgercontext_manager.h"
 #include "environment.h"
 #include "kv_trie.h"
+#include "trie_cache.h"
+#include "contract_query_cache.h"
+#include "sync_buffer.h"
 #include "proto/cpp/consensus.pb.h"
 
 #ifdef WIN32
@@ -50,6 +54,10 @@ namespace rexx {
 			return validators_;
 		}
 
+		static void ValidatorsSet(std::shared_ptr<WRITE_BATCH> batch, const protocol::ValidatorSet& validators);
+		static bool ValidatorsGet(const std::string& hash, protocol::ValidatorSet& vlidators_set);
+
+		static void FeesConfigSet(std::shared_ptr<WRITE_BATCH> batch, const protocol::FeeConfig &fee);
 		static bool FeesConfigGet(const std::string& hash, protocol::FeeConfig &fee);
 		bool ConsensusValueFromDB(int64_t seq, protocol::ConsensusValue& request);
 		protocol::FeeConfig GetCurFeeConfig();
@@ -62,10 +70,20 @@ namespace rexx {
 		virtual void GetModuleStatus(Json::Value &data);
 
 		static void CreateHardforkLedger();
+		//Rewrite the sequence keys of the ledger db written by older versions, an interrupted upgrade resumes on the next run
+		static bool UpgradeSeqKeys();
+		//Index the transactions of the ledgers closed before the account transaction index was enabled,
+		//from the beginning of the index down to the first ledger. An interrupted backfill resumes on the next run.
+		static bool BackfillAccountTxIndex();
 	public:
 		utils::Mutex gmutex_;
 		Json::Value statistics_;
 		KVTrie* tree_;
+		TrieCache trie_cache_;
+		ContractQueryCache query_cache_;
+		WorkerPool hash_pool_;
+		WorkerPool apply_pool_; //executes transactions speculatively, see ParallelExecutor
+		SyncBuffer sync_buffer_;
 
 		LedgerContextManager context_manager_;
 	private:
@@ -73,6 +91,12 @@ namespace rexx {
 		~LedgerManager();
 
 		void RequestConsensusValues(int64_t pid, protocol::GetLedgers& gl, int64_t time);
+		//Spread the ledgers after the last closed one over the idle peers
+		void RequestSyncWindows(int64_t current_time);
+		//Close the buffered ledgers that follow the last closed one
+		void CloseSyncLedgers();
+		//Write a batch of the backfill together with the beginning of the index it reaches
+		static bool WriteAccountTxIndex(WRITE_BATCH &batch, int64_t begin_seq, int64_t &total_count, size_t &batch_count);
 
 		int64_t GetMaxLedger();
 
@@ -80,11 +104,6 @@ namespace rexx {
 
 		bool CreateGenesisAccount();
 
-		static void ValidatorsSet(std::shared_ptr<WRITE_BATCH> batch, const protocol::ValidatorSet& validators);
-		static bool ValidatorsGet(const std::string& hash, protocol::ValidatorSet& vlidators_set);
-
-		static void FeesConfigSet(std::shared_ptr<WRITE_BATCH> batch, const protocol::FeeConfig &fee);
-		
 		LedgerFrm::pointer last_closed_ledger_;
 		protocol::ValidatorSet validators_;
 		std::string proof_;
@@ -100,14 +119,31 @@ namespace rexx {
 			int64_t send_time_;
 			protocol::GetLedgers gl_;
 			int64_t probation_; //
+			int64_t max_seq_; //The maximum ledger sequence the peer has reported
+			int64_t window_; //Ledgers per request, halved when a request times out
 			SyncStat(){
 				send_time_ = 0;
 				probation_ = 0;
+				max_seq_ = 0;
+				window_ = 0;
+			}
+			//Give up a request without response for 30 seconds and halve the window of the peer
+			bool Expire(int64_t current_time, int64_t max_window) {
+				if (send_time_ == 0 || current_time - send_time_ <= 30 * utils::MICRO_UNITS_PER_SEC) {
+					return false;
+				}
+				send_time_ = 0;
+				gl_.set_begin(0);
+				gl_.set_end(0);
+				window_ = MAX((window_ == 0 ? max_window : window_) / 2, 1);
+				return true;
 			}
 			Json::Value ToJson(){
 				Json::Value v;
 				v["send_time"] = send_time_;
 				v["probation"] = probation_;
+				v["max_seq"] = max_seq_;
+				v["window"] = window_;
 				v["gl"] = Proto2Json(gl_);
 				return v;
 			}
@@ -117,12 +153,22 @@ namespace rexx {
 			int64_t update_time_;
 			/*std::map<int64_t, int> buffer_;*/
 			std::map<int64_t, SyncStat> peers_;
+			int64_t closed_count_; //Ledgers closed from the sync buffer
+			int64_t rate_time_;
+			int64_t rate_count_;
+			double rate_; //Ledgers closed per second from the sync buffer
 			Sync(){
 				update_time_ = 0;
+				closed_count_ = 0;
+				rate_time_ = 0;
+				rate_count_ = 0;
+				rate_ = 0;
 			}
 			Json::Value ToJson(){
 				Json::Value v;
 				v["update_time"] = update_time_;
+				v["closed_count"] = closed_count_;
+				v["ledgers_per_second"] = rate_;
 				Json::Value& peers = v["peers"];
 				for (auto it = peers_.begin(); it != peers_.end(); it++){
 					Json::Value tmp = it->second.ToJson();
@@ -13,7 +13,9 @@ namespace rexx {
 		start_time_(-1),
 		tx_timeout_(-1),
 		timeout_tx_index_(-1),
-		apply_mode_(LedgerFrm::APPLY_MODE_FOLLOW) {
+		apply_mode_(LedgerFrm::APPLY_MODE_FOLLOW),
+		cancelled_(false),
+		done_(false) {
 		closing_ledger_ = std::make_shared<LedgerFrm>();
 	}
 
@@ -25,7 +27,9 @@ namespace rexx {
 		hash_(chash),
 		consensus_value_(consvalue),
 		start_time_(-1),
-		timeout_tx_index_(-1){
+		timeout_tx_index_(-1),
+		cancelled_(false),
+		done_(false) {
 		apply_mode_ = propose ? LedgerFrm::APPLY_MODE_PROPOSE : LedgerFrm::APPLY_MODE_CHECK;
 		closing_ledger_ = std::make_shared<LedgerFrm>();
 	}
@@ -36,7 +40,9 @@ namespace rexx {
 		const ContractTestParameter &parameter) :
 		type_(type), 
 		parameter_(parameter),
-		lpmanager_(NULL) {
+		lpmanager_(NULL),
+		cancelled_(false),
+		done_(false) {
 		apply_mode_ = LedgerFrm::APPLY_MODE_PROPOSE;
 		closing_ledger_ = std::make_shared<LedgerFrm>();
 	}
@@ -47,7 +53,9 @@ namespace rexx {
 		type_(type),
 		consensus_value_(consensus_value),
 		lpmanager_(NULL),
-		tx_timeout_(timeout) {
+		tx_timeout_(timeout),
+		cancelled_(false),
+		done_(false) {
 		apply_mode_ = LedgerFrm::APPLY_MODE_PROPOSE;
 		closing_ledger_ = std::make_shared<LedgerFrm>();
 	}
@@ -56,24 +64,65 @@ namespace rexx {
 	void LedgerContext::Run() {
 		LOG_INFO("Preprocessing the consensus value, ledger(" FMT_I64 ")", consensus_value_.ledger_seq());
 		start_time_ = utils::Timestamp::HighResolution();
-		switch (type_)
-		{
-		case AT_NORMAL:
-			Do();
-			break;
-		case AT_TEST_V8:
-			TestV8();
-			break;
-		case AT_TEST_EVM:
-			LOG_ERROR("Test evm not support");
-			break;
-		case AT_TEST_TRANSACTION:
-			TestTransaction();
-			break;
-		default:
-			LOG_ERROR("Action type unknown of LedgerContext.");
-			break;
+		bool cancelled = false;
+		do {
+			utils::MutexGuard guard(lock_);
+			cancelled = cancelled_;
+		} while (false);
+
+		if (cancelled) {
+			LOG_ERROR("Cancelled the consensus value before its execution, ledger(" FMT_I64 ")", consensus_value_.ledger_seq());
+			propose_result_.exec_result_ = false;
+		}
+		else {
+			switch (type_)
+			{
+			case AT_NORMAL:
+				Do();
+				break;
+			case AT_TEST_V8:
+				TestV8();
+				break;
+			case AT_TEST_EVM:
+				LOG_ERROR("Test evm not support");
+				break;
+			case AT_TEST_TRANSACTION:
+				TestTransaction();
+				break;
+			default:
+				LOG_ERROR("Action type unknown of LedgerContext.");
+				break;
+			}
+		}
+
+		//Signal before handing the context over, the manager may delete it as soon as it is in a list
+		LedgerContextManager *lpmanager = lpmanager_;
+		bool exec_result = propose_result_.exec_result_;
+		do {
+			//Notify under the lock, a waiter may delete the context once it sees done_
+			std::lock_guard<std::mutex> guard(done_lock_);
+			done_ = true;
+			done_cond_.notify_all();
+		} while (false);
+		if (lpmanager) {
+			//Move the finished transactions to the complete list.
+			if (exec_result) {
+				lpmanager->MoveRunningToComplete(this);
+			}
+			else { //delete
+				lpmanager->MoveRunningToDelete(this);
+			}
+		}
+	}
+
+	bool LedgerContext::Wait(int64_t timeout) {
+		std::unique_lock<std::mutex> guard(done_lock_);
+		if (timeout < 0) {
+			done_cond_.wait(guard, [this]() { return done_; });
+			return true;
 		}
+
+		return done_cond_.wait_for(guard, std::chrono::microseconds(timeout), [this]() { return done_; });
 	}
 
 	void LedgerContext::Do() {
@@ -95,17 +144,6 @@ namespace rexx {
 		else {
 			propose_result_.exec_result_ = closing_ledger_->ApplyFollow(consensus_value_, this);
 		}
-
-		//async
-		if (lpmanager_) {
-			//Move the finished transactions to the complete list.
-			if (propose_result_.exec_result_) {
-				lpmanager_->MoveRunningToComplete(this);
-			}
-			else { //delete
-				lpmanager_->MoveRunningToDelete(this);
-			}
-		}
 	}
 
 	bool LedgerContext::TestV8() {
@@ -230,12 +268,12 @@ namespace rexx {
 					LOG_ERROR("not found account");
 					break;
 				}
-				if (!account_frm->GetProtoAccount().has_contract()) {
+				if (!account_frm->GetConstProtoAccount().has_contract()) {
 					LOG_ERROR("the called address not contract");
 					break;
 				}
 
-				protocol::Contract contract = account_frm->GetProtoAccount().contract();
+				protocol::Contract contract = account_frm->GetConstProtoAccount().contract();
 				if (contract.payload().size() == 0) {
 					LOG_ERROR("the called address not contract");
 					break;
@@ -281,6 +319,7 @@ namespace rexx {
 		std::stack<int64_t> copy_stack;
 		do {
 			utils::MutexGuard guard(lock_);
+			cancelled_ = true;
 			copy_stack = contract_ids_;
 		} while (false);
 
@@ -290,7 +329,7 @@ namespace rexx {
 			copy_stack.pop();
 		}
 
-		JoinWithStop();
+		Wait(-1);
 	}
 
 	bool LedgerContext::CheckExpire(int64_t total_timeout) {
@@ -355,6 +394,10 @@ namespace rexx {
 		return timeout_tx_index_;
 	}
 
+	int32_t LedgerContext::GetType() {
+		return type_;
+	}
+
 	bool LedgerContext::TestTransaction() {
 		protocol::LedgerHeader lcl = LedgerManager::Instance().GetLastClosedLedger();
 		consensus_value_.set_ledger_seq(lcl.seq() + 1);
@@ -371,8 +414,38 @@ namespace rexx {
 	LedgerContextManager::~LedgerContextManager() {
 	}
 
-	void LedgerContextManager::Initialize() {
+	bool LedgerContextManager::Initialize() {
+		const LedgerConfigure &ledger_config = Configure::Instance().ledger_configure_;
+		//A context waits for its result with a timeout, so the pools need at least one thread
+		uint32_t exec_count = ledger_config.context_thread_count_ > 0 ? ledger_config.context_thread_count_ : 1;
+		uint32_t test_count = ledger_config.context_test_thread_count_ > 0 ? ledger_config.context_test_thread_count_ : 1;
+		if (!exec_pool_.Initialize("process-value", exec_count)) {
+			LOG_ERROR("Failed to start %u threads of processing consensus value", exec_count);
+			return false;
+		}
+
+		if (!test_pool_.Initialize("test", test_count)) {
+			LOG_ERROR("Failed to start %u test threads", test_count);
+			return false;
+		}
+
 		TimerNotify::RegisterModule(this);
+		return true;
+	}
+
+	bool LedgerContextManager::Exit() {
+		exec_pool_.Exit();
+		test_pool_.Exit();
+		return true;
+	}
+
+	void LedgerContextManager::Post(WorkerPool &pool, LedgerContext *ledger_context) {
+		running_count_.Inc();
+		pool.Post([this, ledger_context]() {
+			//The context may be deleted once it has run, only the manager is touched afterwards
+			ledger_context->Run();
+			running_count_.Dec();
+		});
 	}
 
 	int32_t LedgerContextManager::CheckComplete(const std::string &chash) {
@@ -420,9 +493,7 @@ namespace rexx {
 		Json::Value &stat,
 		int32_t signature_number) {
 		LedgerContext *ledger_context = nullptr;
-		std::string thread_name = "test";
 		if (type == LedgerContext::AT_TEST_V8){
-			thread_name = "test-contract";
 			ledger_context = new LedgerContext(type, *((ContractTestParameter*)parameter));
 
 			do {
@@ -449,7 +520,6 @@ namespace rexx {
 			} while (false);
 		}
 		else if (type == LedgerContext::AT_TEST_TRANSACTION){
-			thread_name = "test-transaction";
 			ledger_context = new LedgerContext(type, ((TransactionTestParameter*)parameter)->consensus_value_, total_timeout);
 		}
 		else {
@@ -457,31 +527,23 @@ namespace rexx {
 			return false;
 		}
 
-		if (!ledger_context->Start(thread_name)) {
-			LOG_ERROR_ERRNO("Failed to start test thread.",
-				STD_ERR_CODE, STD_ERR_DESC);
+		//Admission control, a test waiting behind too many others would time out anyway
+		uint32_t queue_limit = Configure::Instance().ledger_configure_.context_test_queue_limit_;
+		if (queue_limit > 0 && test_pool_.GetPendingCount() >= (int64_t)queue_limit) {
+			rejected_count_.Inc();
 			result.set_code(protocol::ERRCODE_INTERNAL_ERROR);
-			result.set_desc("Failed to start thread.");
+			result.set_desc(utils::String::Format("Too many tests are waiting(" FMT_I64 "), try again later", test_pool_.GetPendingCount()));
+			LOG_ERROR("%s", result.desc().c_str());
 			delete ledger_context;
 			return false;
 		}
 
-		int64_t time_start = utils::Timestamp::HighResolution();
-		bool is_timeout = false;
-		while (ledger_context->IsRunning()) {
-			utils::Sleep(10);
-			if (utils::Timestamp::HighResolution() - time_start > total_timeout) {
-				is_timeout = true;
-				break;
-			}
-		}
-
-		if (is_timeout) { //cancel it
+		Post(test_pool_, ledger_context);
+		if (!ledger_context->Wait(total_timeout)) { //cancel it
 			ledger_context->Cancel();
 			result.set_code(protocol::ERRCODE_TX_TIMEOUT);
 			result.set_desc("Contract execution timeout");
 			LOG_ERROR("Testing consensus value(" FMT_I64 "ms) timeout", total_timeout / utils::MICRO_UNITS_PER_MILLI);
-			ledger_context->JoinWithStop();
 			delete ledger_context;
 			return false;
 		}
@@ -557,7 +619,6 @@ namespace rexx {
 
 		ledger_context->GetLogs(logs);
 		ledger_context->GetRets(rets);
-		ledger_context->JoinWithStop();
 		delete ledger_context;
 		return true;
 	}
@@ -572,27 +633,12 @@ namespace rexx {
 			return check_complete == 1;
 		} 
 
+		//The context hands itself over to the completed or deleted list when it finishes
 		LedgerContext *ledger_context = new LedgerContext(this, chash, consensus_value, propose);
-
-		if (!ledger_context->Start("process-value")) {
-			LOG_ERROR_ERRNO("Failed to start processing consensus value, consensus value hash(%s)", utils::String::BinToHexString(chash).c_str(), 
-				STD_ERR_CODE, STD_ERR_DESC);
-
-			propose_result.block_timeout_ = true;
-			delete ledger_context;
-			return false;
-		}
-
 		int64_t time_start = utils::Timestamp::HighResolution();
-		while (ledger_context->IsRunning()) {
-			utils::Sleep(10);
-			if (utils::Timestamp::HighResolution() - time_start > General::BLOCK_EXECUTE_TIME_OUT) {
-				propose_result.block_timeout_ = true;
-				break;
-			}
-		}
-
-		if (propose_result.block_timeout_) { //cancel it
+		Post(exec_pool_, ledger_context);
+		if (!ledger_context->Wait(General::BLOCK_EXECUTE_TIME_OUT)) { //cancel it
+			propose_result.block_timeout_ = true;
 			ledger_context->Cancel();
 			LOG_ERROR("Pre-executing consensus value(" FMT_I64 "ms) timeout", (utils::Timestamp::HighResolution() - time_start) / utils::MICRO_UNITS_PER_MILLI);
 			return false;
@@ -621,6 +667,11 @@ namespace rexx {
 		utils::MutexGuard guard(ctxs_lock_);
 		data["completed_size"] = (Json::UInt64)completed_ctxs_.size();
 		data["running_size"] = (Json::UInt64)running_ctxs_.size();
+		data["thread_count"] = (Json::UInt64)exec_pool_.Size();
+		data["test_thread_count"] = (Json::UInt64)test_pool_.Size();
+		data["queued_count"] = (Json::Int64)(exec_pool_.GetPendingCount() + test_pool_.GetPendingCount());
+		data["running_count"] = (Json::Int64)running_count_.value(); //queued or executing
+		data["rejected_count"] = (Json::Int64)rejected_count_.value();
 	}
 
 	void LedgerContextManager::OnTimer(int64_t current_time) {
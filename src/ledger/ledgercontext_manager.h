@@ -2,8 +2,11 @@
 #ifndef LEDGER_CONTEXT_MANAGER_H_
 #define LEDGER_CONTEXT_MANAGER_H_
 
+#include <mutex>
+#include <condition_variable>
 #include <utils/headers.h>
 #include <common/general.h>
+#include <common/worker_pool.h>
 #include <proto/cpp/chain.pb.h>
 #include "ledger_frm.h"
 #include "contract_manager.h"
@@ -13,7 +16,7 @@ namespace rexx {
 	class LedgerContextManager;
 	class LedgerContext;
 	typedef std::function< void(bool check_result)> PreProcessCallback;
-	class LedgerContext : public utils::Thread {
+	class LedgerContext {
 		std::stack<int64_t> contract_ids_; //The contract_ids may be called by checking the thread or executing the thread, so contract_ids needs to be locked.
 		//parameter
 		int32_t type_; // -1 : normal, 0 : test v8 , 1: test evm ,2 test transaction
@@ -27,6 +30,12 @@ namespace rexx {
 
 		Json::Value logs_;
 		Json::Value rets_;
+
+		bool cancelled_; //guarded by lock_, a cancelled context skips the run if it is still queued
+		//Set when Run returns, every waiter sees it
+		std::mutex done_lock_;
+		std::condition_variable done_cond_;
+		bool done_;
 	public:
 		LedgerContext(
 			LedgerContextManager *lpmanager,
@@ -70,7 +79,10 @@ namespace rexx {
 
 		utils::Mutex lock_;
 
-		virtual void Run();
+		//Runs on a pool thread of the manager
+		void Run();
+		//Wait for Run to return, false if it is still running after the timeout in micro seconds, negative waits forever
+		bool Wait(int64_t timeout);
 		void Do();
 		bool TestV8();
 		bool TestTransaction();
@@ -89,6 +101,7 @@ namespace rexx {
 		
 		std::string GetHash();
 		int32_t GetTxTimeoutIndex();
+		int32_t GetType();
 
 		void PushLog();
 		std::shared_ptr<TransactionFrm> GetBottomTx();
@@ -104,11 +117,19 @@ namespace rexx {
 		LedgerContextMultiMap running_ctxs_;
 		LedgerContextMap completed_ctxs_;
 		LedgerContextTimeMultiMap delete_ctxs_;
+
+		WorkerPool exec_pool_; //executes the consensus values before they are proposed or voted
+		WorkerPool test_pool_; //executes the contract and transaction tests of the api
+		utils::AtomicInt64 running_count_;
+		utils::AtomicInt64 rejected_count_;
+
+		void Post(WorkerPool &pool, LedgerContext *ledger_context);
 	public:
 		LedgerContextManager();
 		~LedgerContextManager();
 
-		void Initialize();
+		bool Initialize();
+		bool Exit();
 		virtual void OnTimer(int64_t current_time);
 		virtual void OnSlowTimer(int64_t current_time);
 		void MoveRunningToComplete(LedgerContext *ledger_context);
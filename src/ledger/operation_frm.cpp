@@ -543,7 +543,7 @@ namespace rexx {
 
 			if (!create_account.contract().payload().empty()) {
 				ContractParameter parameter;
-				parameter.code_ = dest_account->GetProtoAccount().contract().payload();
+				parameter.code_ = dest_account->GetConstProtoAccount().contract().payload();
 				parameter.input_ = create_account.init_input();
 				parameter.this_address_ = dest_address;
 				parameter.sender_ = source_account_->GetAccountAddress();
@@ -658,7 +658,7 @@ namespace rexx {
 				}
 			}
 			
-			std::string javascript = dest_account->GetProtoAccount().contract().payload();
+			std::string javascript = dest_account->GetConstProtoAccount().contract().payload();
 			if (!javascript.empty()){
 				ContractParameter parameter;
 				parameter.code_ = javascript;
@@ -838,7 +838,7 @@ namespace rexx {
 			}
 			proto_dest_account.set_balance(dest_balance);
 
-			std::string javascript = dest_account_ptr->GetProtoAccount().contract().payload();
+			std::string javascript = dest_account_ptr->GetConstProtoAccount().contract().payload();
 			if (!javascript.empty()) {
 
 				ContractParameter parameter;
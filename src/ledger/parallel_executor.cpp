@@ -0,0 +1,348 @@
+#include "ledger_manager.h"
+#include "parallel_executor.h"
+
+namespace rexx {
+
+	utils::AtomicInt64 ParallelExecutor::speculated_count_;
+	utils::AtomicInt64 ParallelExecutor::reapplied_count_;
+	utils::AtomicInt64 ParallelExecutor::conflict_count_;
+	utils::AtomicInt64 ParallelExecutor::undeclared_count_;
+	utils::AtomicInt64 ParallelExecutor::fee_count_;
+	utils::AtomicInt64 ParallelExecutor::verified_count_;
+	utils::AtomicInt64 ParallelExecutor::mismatch_count_;
+	std::atomic<bool> ParallelExecutor::disabled_(false);
+
+	ParallelExecutor::ParallelExecutor(LedgerFrm *ledger,
+		LedgerFrm::APPLY_MODE mode,
+		const std::vector<TransactionFrm::pointer> &tx_frms,
+		const std::set<int32_t> *expire_txs) :
+		ledger_(ledger),
+		mode_(mode),
+		tx_frms_(tx_frms),
+		expire_txs_(expire_txs),
+		run_begin_(0),
+		run_end_(0) {
+		const LedgerConfigure &ledger_config = Configure::Instance().ledger_configure_;
+		enabled_ = LedgerManager::Instance().apply_pool_.Size() > 0 &&
+			ledger_config.use_atom_map_ &&
+			ledger_config.parallel_batch_size_ > 1 &&
+			!ledger_->IsTestMode() &&
+			!disabled_.load();
+		verify_ = enabled_ && ledger_config.parallel_verify_;
+		if (enabled_) {
+			declared_.resize(tx_frms_.size(), -1);
+			accounts_.resize(tx_frms_.size());
+		}
+	}
+
+	ParallelExecutor::~ParallelExecutor() {}
+
+	LedgerFrm::APPLY_RESULT ParallelExecutor::Apply(size_t index, std::shared_ptr<Environment> environment, int64_t &total_fee) {
+		if (!enabled_) {
+			return ledger_->ApplyTransaction(tx_frms_[index], environment, total_fee, mode_, IsExpired(index), true);
+		}
+
+		if (index >= run_end_) {
+			//Start a run if the transaction and at least the next one can be executed in parallel
+			speculations_.clear();
+			written_.clear();
+			run_begin_ = run_end_ = index;
+
+			size_t end = index;
+			size_t batch_size = Configure::Instance().ledger_configure_.parallel_batch_size_;
+			while (end < tx_frms_.size() && end - index < batch_size && Declare(end, environment.get())) {
+				end++;
+			}
+
+			if (end - index > 1) {
+				if (verify_) {
+					ExecuteReference(index, end, environment.get(), total_fee);
+				}
+				Speculate(index, end, environment.get());
+				run_end_ = end;
+			}
+		}
+
+		LedgerFrm::APPLY_RESULT result;
+		if (index >= run_begin_ && index < run_end_ && Merge(index, environment, total_fee)) {
+			result = speculations_[index - run_begin_].result_;
+		}
+		else {
+			if (index < run_end_) {
+				reapplied_count_.Inc();
+			}
+			result = ledger_->ApplyTransaction(tx_frms_[index], environment, total_fee, mode_, IsExpired(index), true);
+		}
+
+		//A dropped transaction writes nothing
+		if (index < run_end_ && result != LedgerFrm::APPLY_RESULT_INVALID && result != LedgerFrm::APPLY_RESULT_NO_FEE) {
+			written_.insert(accounts_[index].begin(), accounts_[index].end());
+		}
+
+		if (verify_ && index < run_end_) {
+			reference_.applied_results_.push_back(result);
+			if (index + 1 == run_end_ && !VerifyRun(environment.get(), total_fee)) {
+				//Keep the rest of the process on the serial execution
+				mismatch_count_.Inc();
+				disabled_.store(true);
+				enabled_ = false;
+			}
+		}
+		return result;
+	}
+
+	bool ParallelExecutor::Declare(size_t index, Environment *environment) {
+		if (declared_[index] >= 0) {
+			return declared_[index] == 1;
+		}
+
+		declared_[index] = 0;
+		const protocol::Transaction &tx = tx_frms_[index]->GetTx();
+		std::set<std::string> &accounts = accounts_[index];
+		accounts.insert(tx.source_address());
+		for (int32_t i = 0; i < tx.operations_size(); i++) {
+			const protocol::Operation &ope = tx.operations(i);
+			if (!ope.source_address().empty()) {
+				accounts.insert(ope.source_address());
+			}
+
+			std::string dest_address;
+			switch (ope.type()) {
+			case protocol::Operation_Type_PAY_COIN:
+				dest_address = ope.pay_coin().dest_address();
+				break;
+			case protocol::Operation_Type_PAY_ASSET:
+				dest_address = ope.pay_asset().dest_address();
+				break;
+			case protocol::Operation_Type_SET_METADATA:
+				continue;
+			default:
+				return false;
+			}
+
+			//No transaction of a run creates a contract, so the state before the run tells whether the payment triggers one
+			if (IsContract(dest_address, environment)) {
+				return false;
+			}
+			accounts.insert(dest_address);
+		}
+
+		declared_[index] = 1;
+		return true;
+	}
+
+	bool ParallelExecutor::IsContract(const std::string &address, Environment *environment) {
+		AccountFrm::pointer account;
+		if (!GetAccount(address, environment, account)) {
+			return false;
+		}
+
+		return !account->GetConstProtoAccount().contract().payload().empty();
+	}
+
+	bool ParallelExecutor::GetAccount(const std::string &address, Environment *environment, AccountFrm::pointer &account) {
+		const Environment::mapKV &committed = environment->GetData();
+		auto iter = committed.find(address);
+		if (iter == committed.end()) {
+			return Environment::AccountFromDB(address, account);
+		}
+
+		if (iter->second.type_ == Environment::DEL) {
+			return false;
+		}
+		account = iter->second.value_;
+		return true;
+	}
+
+	void ParallelExecutor::Speculate(size_t begin, size_t end, Environment *environment) {
+		speculations_.resize(end - begin);
+		std::vector<WorkerPool::Task> tasks;
+		for (size_t i = begin; i < end; i++) {
+			tasks.push_back([this, i, begin, environment]() {
+				Speculation &speculation = speculations_[i - begin];
+				speculation.tx_frm_ = std::make_shared<TransactionFrm>(*tx_frms_[i]);
+				speculation.environment_ = Environment::NewSpeculativeEnv(environment);
+				speculation.result_ = ledger_->ApplyTransaction(speculation.tx_frm_, speculation.environment_,
+					speculation.fee_, mode_, IsExpired(i), false);
+				speculated_count_.Inc();
+			});
+		}
+
+		LedgerManager::Instance().apply_pool_.RunAndWait(tasks);
+	}
+
+	bool ParallelExecutor::Merge(size_t index, std::shared_ptr<Environment> environment, int64_t &total_fee) {
+		Speculation &speculation = speculations_[index - run_begin_];
+		const std::set<std::string> &accounts = accounts_[index];
+
+		//The speculation read the state before the run, it holds if nothing it could read was written since
+		for (auto iter = accounts.begin(); iter != accounts.end(); iter++) {
+			if (written_.find(*iter) != written_.end()) {
+				conflict_count_.Inc();
+				return false;
+			}
+		}
+
+		//Guard the declaration, and the total fee the serial execution would have checked for overflow
+		const std::set<std::string> &read_keys = speculation.environment_->read_keys_;
+		for (auto iter = read_keys.begin(); iter != read_keys.end(); iter++) {
+			if (accounts.find(*iter) == accounts.end()) {
+				LOG_WARN("Transaction(%s) read the undeclared account(%s), applying it again",
+					utils::String::BinToHexString(tx_frms_[index]->GetContentHash()).c_str(), iter->c_str());
+				undeclared_count_.Inc();
+				return false;
+			}
+		}
+
+		int64_t new_total_fee = 0;
+		if (!speculation.environment_->settings_.GetData().empty() ||
+			!utils::SafeIntAdd(total_fee, tx_frms_[index]->GetFeeLimit(), new_total_fee)) {
+			fee_count_.Inc();
+			return false;
+		}
+
+		const Environment::mapKV &changes = speculation.environment_->GetData();
+		if (!changes.empty()) {
+			Environment::mapKV &action_buf = environment->GetActionBuf();
+			for (auto iter = changes.begin(); iter != changes.end(); iter++) {
+				action_buf[iter->first] = iter->second;
+			}
+			environment->Commit();
+		}
+
+		total_fee += speculation.fee_;
+		*tx_frms_[index] = *speculation.tx_frm_;
+		return true;
+	}
+
+	bool ParallelExecutor::IsExpired(size_t index) {
+		return expire_txs_ != NULL && expire_txs_->find((int32_t)index) != expire_txs_->end();
+	}
+
+	void ParallelExecutor::ExecuteReference(size_t begin, size_t end, Environment *environment, int64_t total_fee) {
+		reference_.tx_frms_.clear();
+		reference_.results_.clear();
+		reference_.applied_results_.clear();
+		reference_.before_.clear();
+		reference_.total_fee_ = total_fee;
+		reference_.environment_ = Environment::NewSpeculativeEnv(environment);
+
+		//Nothing is merged before the reference has run, so it reads the same state as the speculations
+		for (size_t i = begin; i < end; i++) {
+			for (auto iter = accounts_[i].begin(); iter != accounts_[i].end(); iter++) {
+				if (reference_.before_.find(*iter) != reference_.before_.end()) {
+					continue;
+				}
+
+				AccountFrm::pointer account;
+				if (GetAccount(*iter, environment, account)) {
+					reference_.before_[*iter] = std::make_shared<AccountFrm>(*account);
+				}
+				else {
+					reference_.before_[*iter] = nullptr;
+				}
+			}
+
+			TransactionFrm::pointer tx_frm = std::make_shared<TransactionFrm>(*tx_frms_[i]);
+			reference_.results_.push_back(ledger_->ApplyTransaction(tx_frm, reference_.environment_,
+				reference_.total_fee_, mode_, IsExpired(i), false));
+			reference_.tx_frms_.push_back(tx_frm);
+		}
+	}
+
+	bool ParallelExecutor::VerifyRun(Environment *environment, int64_t total_fee) {
+		verified_count_.Inc();
+		bool match = true;
+		if (total_fee != reference_.total_fee_) {
+			LOG_ERROR("Parallel execution of transactions(" FMT_SIZE "-" FMT_SIZE ") left the total fee(" FMT_I64 "), the serial execution(" FMT_I64 ")",
+				run_begin_, run_end_, total_fee, reference_.total_fee_);
+			match = false;
+		}
+
+		for (size_t i = 0; i < reference_.results_.size(); i++) {
+			const TransactionFrm::pointer &tx_frm = tx_frms_[run_begin_ + i];
+			if (reference_.applied_results_[i] != reference_.results_[i] ||
+				tx_frm->GetResult().code() != reference_.tx_frms_[i]->GetResult().code()) {
+				LOG_ERROR("Parallel execution of transaction(%s) returned(%d) code(%d), the serial execution(%d) code(%d)",
+					utils::String::BinToHexString(tx_frm->GetContentHash()).c_str(),
+					reference_.applied_results_[i], tx_frm->GetResult().code(),
+					reference_.results_[i], reference_.tx_frms_[i]->GetResult().code());
+				match = false;
+			}
+		}
+
+		//Compare the account tree leaves of every account the run could write
+		std::set<std::string> addresses;
+		for (auto iter = reference_.before_.begin(); iter != reference_.before_.end(); iter++) {
+			addresses.insert(iter->first);
+		}
+		const Environment::mapKV &changes = reference_.environment_->GetData();
+		for (auto iter = changes.begin(); iter != changes.end(); iter++) {
+			addresses.insert(iter->first);
+		}
+
+		std::string expected_leaves;
+		std::string actual_leaves;
+		for (auto iter = addresses.begin(); iter != addresses.end(); iter++) {
+			std::string expected_leaf;
+			auto change = changes.find(*iter);
+			if (change != changes.end()) {
+				if (change->second.type_ != Environment::DEL) {
+					expected_leaf = GetAccountLeaf(change->second.value_);
+				}
+			}
+			else {
+				auto before = reference_.before_.find(*iter);
+				if (before != reference_.before_.end() && before->second) {
+					expected_leaf = GetAccountLeaf(before->second);
+				}
+			}
+
+			std::string actual_leaf;
+			AccountFrm::pointer account;
+			if (GetAccount(*iter, environment, account)) {
+				actual_leaf = GetAccountLeaf(account);
+			}
+
+			if (expected_leaf != actual_leaf) {
+				LOG_ERROR("Parallel execution of transactions(" FMT_SIZE "-" FMT_SIZE ") left the account(%s) different from the serial execution",
+					run_begin_, run_end_, iter->c_str());
+			}
+			expected_leaves += *iter + expected_leaf;
+			actual_leaves += *iter + actual_leaf;
+		}
+
+		std::string expected_hash = HashWrapper::Crypto(expected_leaves);
+		std::string actual_hash = HashWrapper::Crypto(actual_leaves);
+		if (expected_hash != actual_hash) {
+			LOG_ERROR("Parallel execution of transactions(" FMT_SIZE "-" FMT_SIZE ") hashed the accounts to(%s), the serial execution(%s)",
+				run_begin_, run_end_, utils::String::BinToHexString(actual_hash).c_str(), utils::String::BinToHexString(expected_hash).c_str());
+			match = false;
+		}
+
+		if (!match) {
+			LOG_ERROR("Parallel execution differs from the serial execution, applying every transaction serially from now on");
+		}
+		reference_.environment_.reset();
+		return match;
+	}
+
+	std::string ParallelExecutor::GetAccountLeaf(AccountFrm::pointer account) {
+		//Hash a copy on a scratch batch the way LedgerFrm::Commit does before it sets the leaf
+		AccountFrm copy(*account);
+		copy.UpdateHash(std::make_shared<WRITE_BATCH>());
+		return copy.Serializer();
+	}
+
+	void ParallelExecutor::GetModuleStatus(Json::Value &data) {
+		data["thread_count"] = (Json::UInt64)LedgerManager::Instance().apply_pool_.Size();
+		data["speculated_count"] = (Json::Int64)speculated_count_.value();
+		data["reapplied_count"] = (Json::Int64)reapplied_count_.value();
+		data["conflict_count"] = (Json::Int64)conflict_count_.value();
+		data["undeclared_count"] = (Json::Int64)undeclared_count_.value();
+		data["fee_overflow_count"] = (Json::Int64)fee_count_.value();
+		data["verified_count"] = (Json::Int64)verified_count_.value();
+		data["mismatch_count"] = (Json::Int64)mismatch_count_.value();
+		data["disabled"] = disabled_.load();
+	}
+}
@@ -0,0 +1,92 @@
+#ifndef PARALLEL_EXECUTOR_H_
+#define PARALLEL_EXECUTOR_H_
+
+#include <atomic>
+#include <utils/headers.h>
+#include "ledger_frm.h"
+
+namespace rexx {
+
+	//Applies the transactions of a consensus value in order. A run of transactions which only pay coins or
+	//assets to non contract accounts or set metadata is executed speculatively on the apply pool, each one on
+	//its own environment over the state before the run. The results are merged in order, and a transaction
+	//touching an account written earlier in the run is executed again on the merged state, so the ledger
+	//ends up exactly as the serial execution leaves it.
+	//With ledger.parallel.verify each run is also executed serially before it is merged, and the results, the
+	//total fee and the account tree leaves of the run are compared once it is merged. A mismatch turns the
+	//executor off for the rest of the process.
+	class ParallelExecutor {
+	public:
+		//expire_txs is the expire validation of a followed value, NULL in the other modes
+		ParallelExecutor(LedgerFrm *ledger,
+			LedgerFrm::APPLY_MODE mode,
+			const std::vector<TransactionFrm::pointer> &tx_frms,
+			const std::set<int32_t> *expire_txs);
+		~ParallelExecutor();
+
+		//Apply the transaction at index on the ledger environment, the indexes must come in order
+		LedgerFrm::APPLY_RESULT Apply(size_t index, std::shared_ptr<Environment> environment, int64_t &total_fee);
+
+		static void GetModuleStatus(Json::Value &data);
+
+	private:
+		struct Speculation {
+			TransactionFrm::pointer tx_frm_;
+			std::shared_ptr<Environment> environment_;
+			int64_t fee_;
+			LedgerFrm::APPLY_RESULT result_;
+			Speculation() : fee_(0), result_(LedgerFrm::APPLY_RESULT_INVALID) {}
+		};
+
+		//The accounts a transaction may touch, false if it may touch others or call a contract
+		bool Declare(size_t index, Environment *environment);
+		bool IsContract(const std::string &address, Environment *environment);
+		void Speculate(size_t begin, size_t end, Environment *environment);
+		bool Merge(size_t index, std::shared_ptr<Environment> environment, int64_t &total_fee);
+		bool IsExpired(size_t index);
+		bool GetAccount(const std::string &address, Environment *environment, AccountFrm::pointer &account);
+
+		//Verification against the serial execution of the run
+		void ExecuteReference(size_t begin, size_t end, Environment *environment, int64_t total_fee);
+		bool VerifyRun(Environment *environment, int64_t total_fee);
+		static std::string GetAccountLeaf(AccountFrm::pointer account);
+
+		LedgerFrm *ledger_;
+		LedgerFrm::APPLY_MODE mode_;
+		const std::vector<TransactionFrm::pointer> &tx_frms_;
+		const std::set<int32_t> *expire_txs_;
+		bool enabled_;
+
+		std::vector<int8_t> declared_; //-1 unknown, 0 not parallel, 1 parallel
+		std::vector<std::set<std::string>> accounts_;
+
+		//The current run
+		size_t run_begin_;
+		size_t run_end_;
+		std::vector<Speculation> speculations_;
+		std::set<std::string> written_;
+
+		//The serial execution of the current run
+		struct Reference {
+			std::vector<TransactionFrm::pointer> tx_frms_;
+			std::vector<LedgerFrm::APPLY_RESULT> results_;
+			std::vector<LedgerFrm::APPLY_RESULT> applied_results_; //what Apply returned for the run
+			int64_t total_fee_; //the total fee after the run
+			std::shared_ptr<Environment> environment_;
+			std::map<std::string, AccountFrm::pointer> before_; //the declared accounts before the run, NULL if absent
+		};
+		bool verify_;
+		Reference reference_;
+
+		static utils::AtomicInt64 speculated_count_;
+		static utils::AtomicInt64 reapplied_count_;
+		static utils::AtomicInt64 conflict_count_;
+		static utils::AtomicInt64 undeclared_count_;
+		static utils::AtomicInt64 fee_count_;
+		static utils::AtomicInt64 verified_count_;
+		static utils::AtomicInt64 mismatch_count_;
+		static std::atomic<bool> disabled_; //set when a verification failed, read by every executing context
+	};
+}
+
+#endif
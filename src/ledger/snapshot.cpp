@@ -0,0 +1,605 @@
+#include <zlib.h>
+#include <common/general.h>
+#include <common/storage.h>
+#include <common/private_key.h>
+#include "ledger_manager.h"
+#include "kv_trie.h"
+#include "snapshot.h"
+
+namespace rexx {
+
+	//File layout, all the integers are little endian
+	//  magic, format version, hash type, ledger header, consensus value
+	//  chunks: raw size (0 ends the chunks), packed size, hash of the raw records, packed records
+	//  trailer: record count, hash over the header and the chunk hashes
+	//A record is its type, key and value, the key and value are prefixed with their length.
+	static const char *SNAPSHOT_MAGIC = "rexxsnap";
+	static const uint32_t SNAPSHOT_VERSION = 1;
+	static const size_t SNAPSHOT_CHUNK_SIZE = 4 * 1024 * 1024;
+	//Reject the lengths of a damaged file before allocating for them
+	static const uint32_t SNAPSHOT_MAX_CHUNK_SIZE = 256 * 1024 * 1024;
+	//Accounts rebuilt between two writes of the import batch
+	static const int64_t SNAPSHOT_IMPORT_BATCH = 10000;
+
+	enum SnapshotRecordType {
+		SNAPSHOT_RECORD_VALIDATORS = 1,
+		SNAPSHOT_RECORD_FEES = 2,
+		SNAPSHOT_RECORD_PROOF = 3,
+		SNAPSHOT_RECORD_STATISTICS = 4,
+		SNAPSHOT_RECORD_ACCOUNT = 5,
+		SNAPSHOT_RECORD_ASSET = 6,
+		SNAPSHOT_RECORD_METADATA = 7
+	};
+
+	static void AppendUint32(std::string &buffer, uint32_t value) {
+		for (int i = 0; i < 4; i++) {
+			buffer.push_back((char)((value >> (i * 8)) & 0xff));
+		}
+	}
+
+	static void AppendUint64(std::string &buffer, uint64_t value) {
+		for (int i = 0; i < 8; i++) {
+			buffer.push_back((char)((value >> (i * 8)) & 0xff));
+		}
+	}
+
+	static void AppendBytes(std::string &buffer, const std::string &value) {
+		AppendUint32(buffer, (uint32_t)value.size());
+		buffer += value;
+	}
+
+	static uint64_t ParseUint(const std::string &buffer, size_t offset, size_t size) {
+		uint64_t value = 0;
+		for (size_t i = 0; i < size; i++) {
+			value |= (uint64_t)(uint8_t)buffer[offset + i] << (i * 8);
+		}
+		return value;
+	}
+
+	//Leaves of the trie under prefix are stored under prefix + LEAF_PREFIX + key
+	static std::string LeafPrefix(const std::string &prefix) {
+		return prefix + Trie::LEAF_PREFIX;
+	}
+
+	static std::string LeafPrefixEnd(const std::string &prefix) {
+		return prefix + (char)(Trie::LEAF_PREFIX + 1);
+	}
+
+	class SnapshotWriter {
+	public:
+		SnapshotWriter() : chunk_records_(0), record_count_(0) {}
+
+		bool Open(const std::string &path, const std::string &header) {
+			if (!file_.Open(path, utils::File::FILE_M_WRITE | utils::File::FILE_M_BINARY)) {
+				LOG_ERROR_ERRNO("Failed to open snapshot file(%s)", path.c_str(), STD_ERR_CODE, STD_ERR_DESC);
+				return false;
+			}
+			total_hash_.Update(header);
+			return Write(header);
+		}
+
+		bool Add(SnapshotRecordType type, const std::string &key, const std::string &value) {
+			chunk_.push_back((char)type);
+			AppendBytes(chunk_, key);
+			AppendBytes(chunk_, value);
+			chunk_records_++;
+			record_count_++;
+			if (chunk_.size() >= SNAPSHOT_CHUNK_SIZE) {
+				return Flush();
+			}
+			return true;
+		}
+
+		bool Close() {
+			if (!Flush()) {
+				return false;
+			}
+
+			std::string trailer;
+			AppendUint32(trailer, 0);
+			AppendUint64(trailer, (uint64_t)record_count_);
+			AppendBytes(trailer, total_hash_.Final());
+			return Write(trailer) && file_.Close();
+		}
+
+		int64_t GetRecordCount() {
+			return record_count_;
+		}
+
+	private:
+		bool Flush() {
+			if (chunk_records_ == 0) {
+				return true;
+			}
+
+			uLongf packed_size = compressBound((uLong)chunk_.size());
+			std::string packed;
+			packed.resize(packed_size);
+			if (compress2((Bytef *)&packed[0], &packed_size, (const Bytef *)chunk_.data(), (uLong)chunk_.size(), Z_DEFAULT_COMPRESSION) != Z_OK) {
+				LOG_ERROR("Failed to compress snapshot chunk");
+				return false;
+			}
+			packed.resize(packed_size);
+
+			std::string chunk_hash = HashWrapper::Crypto(chunk_);
+			total_hash_.Update(chunk_hash);
+
+			std::string head;
+			AppendUint32(head, (uint32_t)chunk_.size());
+			AppendUint32(head, (uint32_t)packed.size());
+			AppendBytes(head, chunk_hash);
+			chunk_.clear();
+			chunk_records_ = 0;
+			return Write(head) && Write(packed);
+		}
+
+		bool Write(const std::string &data) {
+			if (file_.Write(data.data(), 1, data.size()) != data.size()) {
+				LOG_ERROR_ERRNO("Failed to write snapshot file", STD_ERR_CODE, STD_ERR_DESC);
+				return false;
+			}
+			return true;
+		}
+
+		utils::File file_;
+		std::string chunk_;
+		int64_t chunk_records_;
+		int64_t record_count_;
+		HashWrapper total_hash_;
+	};
+
+	class SnapshotReader {
+	public:
+		SnapshotReader() : offset_(0), record_count_(0), hash_type_(0) {}
+
+		bool Open(const std::string &path, std::string &header, std::string &consensus_value) {
+			if (!file_.Open(path, utils::File::FILE_M_READ | utils::File::FILE_M_BINARY)) {
+				LOG_ERROR_ERRNO("Failed to open snapshot file(%s)", path.c_str(), STD_ERR_CODE, STD_ERR_DESC);
+				return false;
+			}
+
+			std::string magic;
+			uint32_t version = 0;
+			if (!Read(strlen(SNAPSHOT_MAGIC), magic) || magic != SNAPSHOT_MAGIC ||
+				!ReadUint32(version) || version != SNAPSHOT_VERSION) {
+				LOG_ERROR("The file(%s) is not a snapshot of version %u", path.c_str(), SNAPSHOT_VERSION);
+				return false;
+			}
+
+			if (!ReadUint32(hash_type_) || !ReadBytes(header) || !ReadBytes(consensus_value)) {
+				LOG_ERROR("Failed to read the snapshot header");
+				return false;
+			}
+
+			//The total hash starts with the header bytes exactly as they were written
+			std::string raw_header = magic;
+			AppendUint32(raw_header, version);
+			AppendUint32(raw_header, hash_type_);
+			AppendBytes(raw_header, header);
+			AppendBytes(raw_header, consensus_value);
+			total_hash_.Update(raw_header);
+			return true;
+		}
+
+		uint32_t GetHashType() {
+			return hash_type_;
+		}
+
+		//Return 1 for a record, 0 at the end of a verified file, -1 on error
+		int32_t Next(uint8_t &type, std::string &key, std::string &value) {
+			if (offset_ >= chunk_.size()) {
+				int32_t ret = ReadChunk();
+				if (ret <= 0) {
+					return ret;
+				}
+			}
+
+			if (!ParseBytes(key, 1) || !ParseBytes(value, 1 + 4 + key.size())) {
+				LOG_ERROR("Snapshot record at chunk offset(" FMT_SIZE ") is damaged", offset_);
+				return -1;
+			}
+			type = (uint8_t)chunk_[offset_];
+			offset_ += 1 + 4 + key.size() + 4 + value.size();
+			record_count_++;
+			return 1;
+		}
+
+	private:
+		int32_t ReadChunk() {
+			uint32_t raw_size = 0;
+			if (!ReadUint32(raw_size)) {
+				LOG_ERROR("Snapshot file is truncated");
+				return -1;
+			}
+
+			if (raw_size == 0) {
+				return ReadTrailer();
+			}
+
+			uint32_t packed_size = 0;
+			std::string chunk_hash, packed;
+			if (raw_size > SNAPSHOT_MAX_CHUNK_SIZE || !ReadUint32(packed_size) || packed_size > SNAPSHOT_MAX_CHUNK_SIZE ||
+				!ReadBytes(chunk_hash) || !Read(packed_size, packed)) {
+				LOG_ERROR("Snapshot chunk is damaged or truncated");
+				return -1;
+			}
+
+			uLongf size = raw_size;
+			chunk_.resize(raw_size);
+			if (uncompress((Bytef *)&chunk_[0], &size, (const Bytef *)packed.data(), (uLong)packed.size()) != Z_OK || size != raw_size) {
+				LOG_ERROR("Failed to uncompress snapshot chunk");
+				return -1;
+			}
+
+			if (HashWrapper::Crypto(chunk_) != chunk_hash) {
+				LOG_ERROR("Snapshot chunk hash(%s) does not match its records", utils::String::BinToHexString(chunk_hash).c_str());
+				return -1;
+			}
+			total_hash_.Update(chunk_hash);
+			offset_ = 0;
+			return 1;
+		}
+
+		int32_t ReadTrailer() {
+			std::string count, total_hash;
+			if (!Read(8, count) || !ReadBytes(total_hash)) {
+				LOG_ERROR("Snapshot file is truncated");
+				return -1;
+			}
+
+			if ((int64_t)ParseUint(count, 0, 8) != record_count_ || total_hash_.Final() != total_hash) {
+				LOG_ERROR("Snapshot file hash(%s) does not match its chunks", utils::String::BinToHexString(total_hash).c_str());
+				return -1;
+			}
+			return 0;
+		}
+
+		bool ParseBytes(std::string &value, size_t position) {
+			size_t offset = offset_ + position;
+			if (offset + 4 > chunk_.size()) {
+				return false;
+			}
+
+			size_t size = (size_t)ParseUint(chunk_, offset, 4);
+			if (offset + 4 + size > chunk_.size()) {
+				return false;
+			}
+			value = chunk_.substr(offset + 4, size);
+			return true;
+		}
+
+		bool Read(size_t size, std::string &data) {
+			data.resize(size);
+			return size == 0 || file_.Read(&data[0], 1, size) == size;
+		}
+
+		bool ReadUint32(uint32_t &value) {
+			std::string data;
+			if (!Read(4, data)) {
+				return false;
+			}
+			value = (uint32_t)ParseUint(data, 0, 4);
+			return true;
+		}
+
+		bool ReadBytes(std::string &value) {
+			uint32_t size = 0;
+			return ReadUint32(size) && size <= SNAPSHOT_MAX_CHUNK_SIZE && Read(size, value);
+		}
+
+		utils::File file_;
+		std::string chunk_;
+		size_t offset_;
+		int64_t record_count_;
+		uint32_t hash_type_;
+		HashWrapper total_hash_;
+	};
+
+	static bool ExportTrie(KeyValueDb *db, const std::string &prefix, SnapshotRecordType type, SnapshotWriter &writer) {
+		std::string leaf_prefix = LeafPrefix(prefix);
+		bool write_ok = true;
+		bool scan_ok = db->Scan(leaf_prefix, LeafPrefixEnd(prefix), [&](const std::string &key, const std::string &value) {
+			write_ok = writer.Add(type, key.substr(leaf_prefix.size()), value);
+			return write_ok;
+		});
+
+		if (!scan_ok) {
+			LOG_ERROR("Failed to read trie(%s), error(%s)", utils::String::BinToHexString(prefix).c_str(), db->error_desc().c_str());
+		}
+		return scan_ok && write_ok;
+	}
+
+	bool Snapshot::Export(const std::string &path, int64_t seq) {
+		HashWrapper::SetLedgerHashType(Configure::Instance().ledger_configure_.hash_type_);
+		//Runs before the ledger manager, bring the sequence keys up to date as it would
+		if (!LedgerManager::UpgradeSeqKeys()) {
+			LOG_ERROR("Failed to upgrade the sequence keys of the ledger db");
+			return false;
+		}
+
+		KeyValueDb *account_db = Storage::Instance().account_db();
+		KeyValueDb *ledger_db = Storage::Instance().ledger_db();
+
+		std::string str_seq;
+		if (account_db->Get(General::KEY_LEDGER_SEQ, str_seq) <= 0) {
+			LOG_ERROR("There is no closed ledger to export");
+			return false;
+		}
+
+		//Only the state of the last closed ledger is kept
+		int64_t last_seq = utils::String::Stoi64(str_seq);
+		if (seq != 0 && seq != last_seq) {
+			LOG_ERROR("Failed to export ledger(" FMT_I64 "), the state is only kept for the last closed ledger(" FMT_I64 ")", seq, last_seq);
+			return false;
+		}
+
+		std::string str_header, str_consensus;
+		protocol::LedgerHeader header;
+		if (ledger_db->Get(ComposeSeqKey(General::LEDGER_PREFIX, last_seq), str_header) <= 0 || !header.ParseFromString(str_header) ||
+			ledger_db->Get(ComposeSeqKey(General::CONSENSUS_VALUE_PREFIX, last_seq), str_consensus) <= 0) {
+			LOG_ERROR("Failed to load ledger(" FMT_I64 ") from database, error(%s)", last_seq, ledger_db->error_desc().c_str());
+			return false;
+		}
+
+		protocol::ValidatorSet validators;
+		protocol::FeeConfig fees;
+		if (!LedgerManager::ValidatorsGet(header.validators_hash(), validators) || !LedgerManager::FeesConfigGet(header.fees_hash(), fees)) {
+			LOG_ERROR("Failed to load the validators and fees of ledger(" FMT_I64 ")", last_seq);
+			return false;
+		}
+
+		std::string proof, statistics;
+		account_db->Get(General::LAST_PROOF, proof);
+		account_db->Get(General::STATISTICS, statistics);
+
+		std::string raw_header = SNAPSHOT_MAGIC;
+		AppendUint32(raw_header, SNAPSHOT_VERSION);
+		AppendUint32(raw_header, (uint32_t)HashWrapper::GetLedgerHashType());
+		AppendBytes(raw_header, str_header);
+		AppendBytes(raw_header, str_consensus);
+
+		SnapshotWriter writer;
+		if (!writer.Open(path, raw_header) ||
+			!writer.Add(SNAPSHOT_RECORD_VALIDATORS, "", validators.SerializeAsString()) ||
+			!writer.Add(SNAPSHOT_RECORD_FEES, "", fees.SerializeAsString()) ||
+			!writer.Add(SNAPSHOT_RECORD_PROOF, "", proof) ||
+			!writer.Add(SNAPSHOT_RECORD_STATISTICS, "", statistics)) {
+			return false;
+		}
+
+		std::string leaf_prefix = LeafPrefix(General::ACCOUNT_PREFIX);
+		int64_t account_count = 0;
+		bool write_ok = true;
+		bool scan_ok = account_db->Scan(leaf_prefix, LeafPrefixEnd(General::ACCOUNT_PREFIX), [&](const std::string &key, const std::string &value) {
+			protocol::Account account;
+			if (!account.ParseFromString(value)) {
+				LOG_ERROR("Failed to parse account(%s)", utils::String::BinToHexString(key).c_str());
+				write_ok = false;
+				return false;
+			}
+
+			std::string address = DecodeAddress(account.address());
+			write_ok = writer.Add(SNAPSHOT_RECORD_ACCOUNT, key.substr(leaf_prefix.size()), value) &&
+				ExportTrie(account_db, ComposePrefix(General::ASSET_PREFIX, address), SNAPSHOT_RECORD_ASSET, writer) &&
+				ExportTrie(account_db, ComposePrefix(General::METADATA_PREFIX, address), SNAPSHOT_RECORD_METADATA, writer);
+
+			if (write_ok && ++account_count % 100000 == 0) {
+				LOG_INFO("Exported " FMT_I64 " accounts", account_count);
+			}
+			return write_ok;
+		});
+
+		if (!scan_ok) {
+			LOG_ERROR("Failed to read accounts, error(%s)", account_db->error_desc().c_str());
+			return false;
+		}
+
+		if (!write_ok || !writer.Close()) {
+			return false;
+		}
+
+		LOG_INFO("Exported snapshot of ledger(" FMT_I64 ") to %s: " FMT_I64 " accounts, " FMT_I64 " records",
+			last_seq, path.c_str(), account_count, writer.GetRecordCount());
+		return true;
+	}
+
+	//An empty trie is stored with an empty root hash by older versions
+	static bool CheckTrieHash(KVTrie &trie, int64_t count, const std::string &expected) {
+		if (expected.empty()) {
+			return count == 0;
+		}
+		trie.UpdateHash();
+		return trie.GetRootHash() == expected;
+	}
+
+	bool Snapshot::Import(const std::string &path) {
+		HashWrapper::SetLedgerHashType(Configure::Instance().ledger_configure_.hash_type_);
+		//Runs before the ledger manager, bring the sequence keys up to date as it would
+		if (!LedgerManager::UpgradeSeqKeys()) {
+			LOG_ERROR("Failed to upgrade the sequence keys of the ledger db");
+			return false;
+		}
+
+		KeyValueDb *account_db = Storage::Instance().account_db();
+		KeyValueDb *ledger_db = Storage::Instance().ledger_db();
+
+		std::string str_seq;
+		if (account_db->Get(General::KEY_LEDGER_SEQ, str_seq) != 0 || ledger_db->Get(General::KEY_LEDGER_SEQ, str_seq) != 0) {
+			LOG_ERROR("The database is not empty, clean it up with --dropdb before importing a snapshot");
+			return false;
+		}
+
+		SnapshotReader reader;
+		std::string str_header, str_consensus;
+		if (!reader.Open(path, str_header, str_consensus)) {
+			return false;
+		}
+
+		if (reader.GetHashType() != (uint32_t)HashWrapper::GetLedgerHashType()) {
+			LOG_ERROR("Snapshot hash type(%u) is not the configured one(%d)", reader.GetHashType(), HashWrapper::GetLedgerHashType());
+			return false;
+		}
+
+		protocol::LedgerHeader header;
+		protocol::ConsensusValue consensus_value;
+		if (!header.ParseFromString(str_header) || !consensus_value.ParseFromString(str_consensus) ||
+			consensus_value.ledger_seq() != header.seq() ||
+			HashWrapper::Crypto(str_consensus) != header.consensus_value_hash()) {
+			LOG_ERROR("Snapshot ledger header does not match its consensus value");
+			return false;
+		}
+
+		auto batch = std::make_shared<WRITE_BATCH>();
+		KVTrie tree;
+		tree.Init(account_db, batch, General::ACCOUNT_PREFIX, 4);
+
+		std::shared_ptr<protocol::Account> account;
+		std::shared_ptr<KVTrie> asset_trie, metadata_trie;
+		int64_t asset_count = 0, metadata_count = 0, account_count = 0;
+		bool has_validators = false, has_fees = false;
+		std::string proof, statistics;
+
+		//The asset and metadata records of an account follow it, check its tries before the next one
+		auto finish_account = [&]() {
+			if (!account) {
+				return true;
+			}
+
+			if (!CheckTrieHash(*asset_trie, asset_count, account->assets_hash()) ||
+				!CheckTrieHash(*metadata_trie, metadata_count, account->metadatas_hash())) {
+				LOG_ERROR("The assets or metadata of account(%s) do not match its hashes", account->address().c_str());
+				return false;
+			}
+
+			account.reset();
+			asset_trie.reset();
+			metadata_trie.reset();
+			if (++account_count % SNAPSHOT_IMPORT_BATCH == 0) {
+				tree.UpdateHash();
+				if (!account_db->WriteBatch(*batch)) {
+					LOG_ERROR("Failed to write account db, error(%s)", account_db->error_desc().c_str());
+					return false;
+				}
+				batch->Clear();
+				tree.FreeMemory(4);
+				LOG_INFO("Imported " FMT_I64 " accounts", account_count);
+			}
+			return true;
+		};
+
+		int32_t ret = 0;
+		uint8_t type = 0;
+		std::string key, value;
+		while ((ret = reader.Next(type, key, value)) > 0) {
+			bool ok = true;
+			switch (type) {
+			case SNAPSHOT_RECORD_VALIDATORS:{
+				protocol::ValidatorSet validators;
+				ok = validators.ParseFromString(value) && HashWrapper::Crypto(value) == header.validators_hash();
+				if (ok) {
+					LedgerManager::ValidatorsSet(batch, validators);
+					has_validators = true;
+				}
+				break;
+			}
+			case SNAPSHOT_RECORD_FEES:{
+				protocol::FeeConfig fees;
+				ok = fees.ParseFromString(value) && HashWrapper::Crypto(value) == header.fees_hash();
+				if (ok) {
+					LedgerManager::FeesConfigSet(batch, fees);
+					has_fees = true;
+				}
+				break;
+			}
+			case SNAPSHOT_RECORD_PROOF:
+				proof = value;
+				break;
+			case SNAPSHOT_RECORD_STATISTICS:
+				statistics = value;
+				break;
+			case SNAPSHOT_RECORD_ACCOUNT:{
+				if (!finish_account()) {
+					return false;
+				}
+
+				account = std::make_shared<protocol::Account>();
+				ok = account->ParseFromString(value) && DecodeAddress(account->address()) == key;
+				if (ok) {
+					tree.Set(key, value);
+					asset_trie = std::make_shared<KVTrie>();
+					asset_trie->Init(account_db, batch, ComposePrefix(General::ASSET_PREFIX, key), 1);
+					metadata_trie = std::make_shared<KVTrie>();
+					metadata_trie->Init(account_db, batch, ComposePrefix(General::METADATA_PREFIX, key), 1);
+					asset_count = 0;
+					metadata_count = 0;
+				}
+				break;
+			}
+			case SNAPSHOT_RECORD_ASSET:
+				ok = account != nullptr;
+				if (ok) {
+					asset_trie->Set(key, value);
+					asset_count++;
+				}
+				break;
+			case SNAPSHOT_RECORD_METADATA:
+				ok = account != nullptr;
+				if (ok) {
+					metadata_trie->Set(key, value);
+					metadata_count++;
+				}
+				break;
+			default:
+				ok = false;
+				break;
+			}
+
+			if (!ok) {
+				LOG_ERROR("Snapshot record(type:%u, key:%s) is invalid", type, utils::String::BinToHexString(key).c_str());
+				return false;
+			}
+		}
+
+		if (ret < 0 || !finish_account()) {
+			return false;
+		}
+
+		if (!has_validators || !has_fees) {
+			LOG_ERROR("Snapshot has no validators or fees");
+			return false;
+		}
+
+		tree.UpdateHash();
+		if (tree.GetRootHash() != header.account_tree_hash()) {
+			LOG_ERROR("Imported account tree hash(%s) does not match ledger account_tree_hash(%s), clean it up with --dropdb",
+				utils::String::Bin4ToHexString(tree.GetRootHash()).c_str(),
+				utils::String::Bin4ToHexString(header.account_tree_hash()).c_str());
+			return false;
+		}
+
+		//The ledger db goes first, a node starts from an account db only once it has the ledger seq
+		WRITE_BATCH ledger_batch;
+		ledger_batch.Put(General::KEY_SEQ_KEY_VERSION, utils::String::ToString(General::SEQ_KEY_VERSION));
+		ledger_batch.Put(General::KEY_LEDGER_SEQ, utils::String::ToString(header.seq()));
+		ledger_batch.Put(ComposeSeqKey(General::LEDGER_PREFIX, header.seq()), str_header);
+		ledger_batch.Put(ComposeSeqKey(General::CONSENSUS_VALUE_PREFIX, header.seq()), str_consensus);
+		if (!ledger_db->WriteBatch(ledger_batch)) {
+			LOG_ERROR("Failed to write ledger db, error(%s)", ledger_db->error_desc().c_str());
+			return false;
+		}
+
+		batch->Put(General::LAST_PROOF, proof);
+		if (!statistics.empty()) {
+			batch->Put(General::STATISTICS, statistics);
+		}
+		batch->Put(General::KEY_LEDGER_SEQ, utils::String::ToString(header.seq()));
+		if (!account_db->WriteBatch(*batch)) {
+			LOG_ERROR("Failed to write account db, error(%s)", account_db->error_desc().c_str());
+			return false;
+		}
+
+		LOG_INFO("Imported snapshot of ledger(" FMT_I64 ") from %s: " FMT_I64 " accounts, account tree hash(%s)",
+			header.seq(), path.c_str(), account_count, utils::String::Bin4ToHexString(header.account_tree_hash()).c_str());
+		return true;
+	}
+}
@@ -0,0 +1,23 @@
+#ifndef SNAPSHOT_H_
+#define SNAPSHOT_H_
+
+#include <utils/headers.h>
+
+namespace rexx {
+
+	//A snapshot file holds the state of one closed ledger, so that a new node can start from it
+	//instead of replaying the whole chain. Accounts are written in trie key order, each followed by
+	//the records of its asset and metadata tries. Records are packed into zlib chunks which carry
+	//the hash of their records, and the file ends with a hash over the header and all the chunk hashes.
+	class Snapshot {
+	public:
+		//Export the state of the last closed ledger, seq 0 means the last closed one whatever it is
+		static bool Export(const std::string &path, int64_t seq);
+
+		//Import into an empty database. The tries are rebuilt from the records, and the node starts
+		//only if their root hashes match the ledger header of the snapshot.
+		static bool Import(const std::string &path);
+	};
+}
+
+#endif
@@ -0,0 +1,150 @@
+#include <common/general.h>
+#include "sync_buffer.h"
+
+namespace rexx {
+
+	SyncBuffer::SyncBuffer() :
+		capacity_(0),
+		received_count_(0),
+		verified_count_(0),
+		taken_count_(0),
+		verify_time_(0) {}
+
+	SyncBuffer::~SyncBuffer() {}
+
+	bool SyncBuffer::Initialize(size_t thread_count, size_t capacity, const VerifiedCallback &callback) {
+		capacity_ = capacity;
+		callback_ = callback;
+		return pool_.Initialize("sync", thread_count);
+	}
+
+	bool SyncBuffer::Exit() {
+		return pool_.Exit();
+	}
+
+	size_t SyncBuffer::Add(const protocol::Ledgers &ledgers, int64_t closed_seq, int64_t peer_id) {
+		std::vector<ItemPointer> added;
+		do {
+			utils::MutexGuard guard(lock_);
+			for (int i = 0; i < ledgers.values_size(); i++) {
+				int64_t seq = ledgers.values(i).ledger_seq();
+				if (seq <= closed_seq || seq > closed_seq + (int64_t)capacity_ || items_.find(seq) != items_.end()) {
+					continue;
+				}
+
+				ItemPointer item = std::make_shared<Item>();
+				item->value_ = ledgers.values(i);
+				item->peer_id_ = peer_id;
+				//The proof of a value is carried by the next value, the last one by the message
+				item->proof_ = i < ledgers.values_size() - 1 ? ledgers.values(i + 1).previous_proof() : ledgers.proof();
+				items_[seq] = item;
+				added.push_back(item);
+			}
+			received_count_ += added.size();
+		} while (false);
+
+		for (size_t i = 0; i < added.size(); i++) {
+			ItemPointer item = added[i];
+			pool_.Post([this, item]() {
+				Verify(item);
+			});
+		}
+		return added.size();
+	}
+
+	void SyncBuffer::Verify(ItemPointer item) {
+		int64_t begin_time = utils::Timestamp::HighResolution();
+		std::string hash = HashWrapper::Crypto(item->value_.SerializeAsString());
+		std::vector<TransactionFrm::pointer> tx_frms;
+		for (int i = 0; i < item->value_.txset().txs_size(); i++) {
+			tx_frms.push_back(std::make_shared<TransactionFrm>(item->value_.txset().txs(i), false));
+		}
+		TransactionFrm::VerifySignatures(tx_frms, true);
+
+		do {
+			utils::MutexGuard guard(lock_);
+			item->hash_ = hash;
+			item->tx_frms_.swap(tx_frms);
+			item->verified_ = true;
+			verified_count_++;
+			verify_time_ += utils::Timestamp::HighResolution() - begin_time;
+		} while (false);
+
+		if (callback_) {
+			callback_();
+		}
+	}
+
+	bool SyncBuffer::Contains(int64_t seq) {
+		utils::MutexGuard guard(lock_);
+		return items_.find(seq) != items_.end();
+	}
+
+	bool SyncBuffer::Take(int64_t seq, protocol::ConsensusValue &value, std::string &proof, int64_t &peer_id) {
+		utils::MutexGuard guard(lock_);
+
+		//Values at or below seq are closed or useless now
+		while (!items_.empty() && items_.begin()->first < seq) {
+			items_.erase(items_.begin());
+		}
+
+		auto iter = items_.find(seq);
+		if (iter == items_.end() || !iter->second->verified_) {
+			return false;
+		}
+
+		value.Swap(&iter->second->value_);
+		proof.swap(iter->second->proof_);
+		peer_id = iter->second->peer_id_;
+		taken_hash_ = iter->second->hash_;
+		taken_tx_frms_.swap(iter->second->tx_frms_);
+		items_.erase(iter);
+		taken_count_++;
+		return true;
+	}
+
+	bool SyncBuffer::TakeTransactions(const std::string &consensus_hash, std::vector<TransactionFrm::pointer> &tx_frms) {
+		utils::MutexGuard guard(lock_);
+		if (taken_hash_.empty() || taken_hash_ != consensus_hash) {
+			return false;
+		}
+
+		tx_frms.swap(taken_tx_frms_);
+		taken_tx_frms_.clear();
+		taken_hash_.clear();
+		return true;
+	}
+
+	void SyncBuffer::Clear() {
+		utils::MutexGuard guard(lock_);
+		items_.clear();
+		taken_hash_.clear();
+		taken_tx_frms_.clear();
+	}
+
+	size_t SyncBuffer::Size() {
+		utils::MutexGuard guard(lock_);
+		return items_.size();
+	}
+
+	void SyncBuffer::GetModuleStatus(Json::Value &data) {
+		utils::MutexGuard guard(lock_);
+		size_t verified_size = 0;
+		for (auto iter = items_.begin(); iter != items_.end(); iter++) {
+			if (iter->second->verified_) {
+				verified_size++;
+			}
+		}
+		data["buffered"] = (Json::UInt64)items_.size();
+		data["buffered_verified"] = (Json::UInt64)verified_size;
+		if (!items_.empty()) {
+			data["buffered_begin"] = (Json::Int64)items_.begin()->first;
+			data["buffered_end"] = (Json::Int64)items_.rbegin()->first;
+		}
+		data["received_count"] = (Json::Int64)received_count_;
+		data["verified_count"] = (Json::Int64)verified_count_;
+		data["taken_count"] = (Json::Int64)taken_count_;
+		data["verify_time"] = (Json::Int64)verify_time_;
+		data["verify_pending"] = (Json::Int64)pool_.GetPendingCount();
+	}
+}
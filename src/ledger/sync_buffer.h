@@ -0,0 +1,66 @@
+#ifndef SYNC_BUFFER_H_
+#define SYNC_BUFFER_H_
+
+#include <map>
+#include <utils/headers.h>
+#include <common/worker_pool.h>
+#include <proto/cpp/overlay.pb.h>
+#include "transaction_frm.h"
+
+namespace rexx {
+
+	//Ledgers received while catching up, kept in sequence order. The transaction signatures of each
+	//consensus value are verified on worker threads, so a value is ready to execute once its turn comes.
+	class SyncBuffer {
+	public:
+		typedef std::function<void()> VerifiedCallback;
+
+		SyncBuffer();
+		~SyncBuffer();
+
+		bool Initialize(size_t thread_count, size_t capacity, const VerifiedCallback &callback);
+		bool Exit();
+
+		//Add the values of a ledgers message. Values closed already, buffered already or beyond the capacity are ignored.
+		size_t Add(const protocol::Ledgers &ledgers, int64_t closed_seq, int64_t peer_id);
+		bool Contains(int64_t seq);
+		//Take the value of seq once its signatures are verified, peer_id is the peer it came from
+		bool Take(int64_t seq, protocol::ConsensusValue &value, std::string &proof, int64_t &peer_id);
+		//Transactions of the last taken value, keyed by its consensus value hash
+		bool TakeTransactions(const std::string &consensus_hash, std::vector<TransactionFrm::pointer> &tx_frms);
+		void Clear();
+		size_t Size();
+
+		void GetModuleStatus(Json::Value &data);
+
+	private:
+		struct Item {
+			protocol::ConsensusValue value_;
+			std::string proof_;
+			std::string hash_;
+			int64_t peer_id_;
+			bool verified_;
+			std::vector<TransactionFrm::pointer> tx_frms_;
+			Item() : peer_id_(0), verified_(false) {}
+		};
+		typedef std::shared_ptr<Item> ItemPointer;
+
+		void Verify(ItemPointer item);
+
+		WorkerPool pool_;
+		size_t capacity_;
+		VerifiedCallback callback_;
+
+		utils::Mutex lock_;
+		std::map<int64_t, ItemPointer> items_;
+		std::string taken_hash_;
+		std::vector<TransactionFrm::pointer> taken_tx_frms_;
+
+		int64_t received_count_;
+		int64_t verified_count_;
+		int64_t taken_count_;
+		int64_t verify_time_;
+	};
+}
+
+#endif
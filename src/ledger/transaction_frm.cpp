@@ -1,6 +1,7 @@
 ﻿
 #include <utils/crypto.h>
 #include <common/storage.h>
+#include <common/signature_verifier.h>
 #include <common/pb2json.h>
 #include <main/configure.h>
 #include <ledger/ledger_manager.h>
@@ -35,7 +36,7 @@ namespace rexx {
 	}
 
 
-	TransactionFrm::TransactionFrm(const protocol::TransactionEnv &env) :
+	TransactionFrm::TransactionFrm(const protocol::TransactionEnv &env, bool verify_signature) :
 		apply_time_(0),
 		ledger_seq_(0),
 		result_(),
@@ -52,7 +53,36 @@ namespace rexx {
 		contract_stack_max_vaule_(0),
 		enable_check_(false), apply_start_time_(0), apply_use_time_(0),
 		incoming_time_(utils::Timestamp::HighResolution()) {
-		Initialize();
+		Initialize(verify_signature);
+		utils::AtomicInc(&rexx::General::tx_new_count);
+	}
+
+	TransactionFrm::TransactionFrm(const TransactionFrm &tx) :
+		involved_accounts_(tx.involved_accounts_),
+		instructions_(tx.instructions_),
+		environment_(tx.environment_),
+		apply_time_(tx.apply_time_),
+		ledger_seq_(tx.ledger_seq_),
+		result_(tx.result_),
+		processing_operation_(tx.processing_operation_),
+		ledger_(tx.ledger_),
+		transaction_env_(tx.transaction_env_),
+		hash_(tx.hash_),
+		full_hash_(tx.full_hash_),
+		data_(tx.data_),
+		full_data_(tx.full_data_),
+		valid_signature_(tx.valid_signature_),
+		incoming_time_(tx.incoming_time_),
+		actual_gas_(tx.actual_gas_),
+		actual_gas_for_query_(tx.actual_gas_for_query_),
+		max_end_time_(tx.max_end_time_),
+		contract_step_(tx.contract_step_),
+		contract_memory_usage_(tx.contract_memory_usage_),
+		contract_stack_max_vaule_(tx.contract_stack_max_vaule_),
+		contract_stack_usage_(tx.contract_stack_usage_),
+		enable_check_(tx.enable_check_),
+		apply_start_time_(tx.apply_start_time_),
+		apply_use_time_(tx.apply_use_time_) {
 		utils::AtomicInc(&rexx::General::tx_new_count);
 	}
 
@@ -78,13 +108,17 @@ namespace rexx {
 		result["hash"] = utils::String::BinToHexString(hash_);
 	}
 
-	void TransactionFrm::Initialize() {
+	void TransactionFrm::Initialize(bool verify_signature) {
 		const protocol::Transaction &tran = transaction_env_.transaction();
 		data_ = tran.SerializeAsString();
 		hash_ = HashWrapper::Crypto(data_);
 		full_data_ = transaction_env_.SerializeAsString();
 		full_hash_ = HashWrapper::Crypto(full_data_);
 
+		if (!verify_signature) {
+			return;
+		}
+
 		for (int32_t i = 0; i < transaction_env_.signatures_size(); i++) {
 			const protocol::Signature &signature = transaction_env_.signatures(i);
 			PublicKey pubkey(signature.public_key());
@@ -101,6 +135,49 @@ namespace rexx {
 		}
 	}
 
+	void TransactionFrm::GetSignatureItems(std::vector<SignatureItem> &items) const {
+		for (int32_t i = 0; i < transaction_env_.signatures_size(); i++) {
+			const protocol::Signature &signature = transaction_env_.signatures(i);
+			items.push_back(SignatureItem(data_, signature.sign_data(), signature.public_key()));
+		}
+	}
+
+	void TransactionFrm::SetSignatureResult(const std::vector<SignatureItem> &items, size_t begin) {
+		for (int32_t i = 0; i < transaction_env_.signatures_size(); i++) {
+			const SignatureItem &item = items[begin + i];
+			if (!item.valid_) {
+				LOG_ERROR("Invalid signature data(%s)", utils::String::BinToHexString(transaction_env_.signatures(i).SerializeAsString()).c_str());
+				continue;
+			}
+
+			PublicKey pubkey(item.public_key_);
+			valid_signature_.insert(pubkey.GetEncAddress());
+		}
+	}
+
+	void TransactionFrm::VerifySignatures(const std::vector<TransactionFrm::pointer> &txs, bool strict) {
+		std::vector<SignatureItem> items;
+		for (size_t i = 0; i < txs.size(); i++) {
+			txs[i]->GetSignatureItems(items);
+		}
+
+		SignatureVerifier *verifier = SignatureVerifier::GetInstance();
+		if (verifier) {
+			verifier->Verify(items, strict);
+		}
+		else {
+			for (size_t i = 0; i < items.size(); i++) {
+				items[i].valid_ = PublicKey::Verify(items[i].data_, items[i].signature_, items[i].public_key_);
+			}
+		}
+
+		size_t begin = 0;
+		for (size_t i = 0; i < txs.size(); i++) {
+			txs[i]->SetSignatureResult(items, begin);
+			begin += txs[i]->GetTransactionEnv().signatures_size();
+		}
+	}
+
 	std::string TransactionFrm::GetContentHash() const {
 		return hash_;
 	}
@@ -645,7 +722,7 @@ namespace rexx {
 	}
 
 	bool TransactionFrm::SignerHashPriv(AccountFrm::pointer account_ptr, int32_t type) const {
-		const protocol::AccountPrivilege &priv = account_ptr->GetProtoAccount().priv();
+		const protocol::AccountPrivilege &priv = account_ptr->GetConstProtoAccount().priv();
 		int64_t threshold = priv.thresholds().tx_threshold();
 		int64_t type_threshold = account_ptr->GetTypeThreshold((protocol::Operation::Type)type);
 		if (type_threshold > 0) {
@@ -732,7 +809,7 @@ namespace rexx {
 		source_account->NonceIncrease();
 	}
 
-	bool TransactionFrm::Apply(LedgerFrm* ledger_frm, std::shared_ptr<Environment> parent, bool bool_contract) {
+	bool TransactionFrm::Apply(LedgerFrm* ledger_frm, std::shared_ptr<Environment> parent, bool bool_contract, TransactionFrm::pointer bottom_tx) {
 		ledger_ = ledger_frm;
 
 		if (parent->useAtomMap_)
@@ -740,7 +817,7 @@ namespace rexx {
 		else
 			environment_ = std::make_shared<Environment>(parent.get());
 
-		bool ret = TransactionFrm::AddActualFee(ledger_frm->lpledger_context_->GetBottomTx(), this);
+		bool ret = TransactionFrm::AddActualFee(bottom_tx ? bottom_tx : ledger_frm->lpledger_context_->GetBottomTx(), this);
 		if (!ret) return ret;
 
 		bool bSucess = true;
@@ -4,6 +4,7 @@
 
 #include <unordered_map>
 #include <utils/common.h>
+#include <common/private_key.h>
 #include <common/general.h>
 #include <ledger/account.h>
 #include <overlay/peer.h>
@@ -26,7 +27,10 @@ namespace rexx {
 	public:
 		//Valid only when the transaction belongs to a txset.
 		TransactionFrm();
-		TransactionFrm(const protocol::TransactionEnv &env);
+		//Pass verify_signature false to check the signatures later by VerifySignatures or SetSignatureResult.
+		TransactionFrm(const protocol::TransactionEnv &env, bool verify_signature = true);
+		//Copies the transaction and its apply state, a copy is executed speculatively by the parallel executor
+		TransactionFrm(const TransactionFrm &tx);
 		
 		virtual ~TransactionFrm();
 		
@@ -53,13 +57,18 @@ namespace rexx {
 
 		Result GetResult() const;
 
-		void Initialize();
+		void Initialize(bool verify_signature = true);
+
+		void GetSignatureItems(std::vector<SignatureItem> &items) const;
+		void SetSignatureResult(const std::vector<SignatureItem> &items, size_t begin);
+		static void VerifySignatures(const std::vector<TransactionFrm::pointer> &txs, bool strict);
 
 		uint32_t LoadFromDb(const std::string &hash);
 
 		bool CheckTimeout(int64_t expire_time);
 		void NonceIncrease(LedgerFrm* ledger_frm, std::shared_ptr<Environment> env);
-		bool Apply(LedgerFrm* ledger_frm, std::shared_ptr<Environment> env, bool bool_contract = false);
+		//The gas is added to bottom_tx, or to the bottom transaction of the ledger context if it is null
+		bool Apply(LedgerFrm* ledger_frm, std::shared_ptr<Environment> env, bool bool_contract = false, TransactionFrm::pointer bottom_tx = nullptr);
 		bool ApplyExpr(const std::string &code, const std::string &log_prefix);
 
 		protocol::TransactionEnv &GetProtoTxEnv() {
@@ -1,6 +1,7 @@
 
 #include <utils/logger.h>
 #include "utils/strings.h"
+#include <common/worker_pool.h>
 #include "trie.h"
 
 namespace rexx{
@@ -165,7 +166,7 @@ namespace rexx{
 		return location + key;
 	}
 
-	protocol::Child Trie::update_hash(NodeFrm::POINTER node){
+	protocol::Child Trie::update_hash(NodeFrm::POINTER node, StorageOperationList *operations){
 
 		int branch_count = 0;
 		int onlybranch = -1;
@@ -181,13 +182,13 @@ namespace rexx{
 				this_child->set_sublocation(node->location_);
 				this_child->set_hash(HashCrypto(*(node->leaf_)));
 				this_child->set_childtype(protocol::LEAF);
-				StorageSaveLeaf(node);
+				Storage(SAVE_LEAF, node, operations);
 			}
 		}
 		else{
 			protocol::Child* ch = node->info_.mutable_children(16);
 			ch->Clear();
-			StorageDeleteLeaf(node);
+			Storage(DELETE_LEAF, node, operations);
 		}
 
 		if (node->info_.children(16).childtype() != protocol::CHILDTYPE::NONE){
@@ -199,7 +200,7 @@ namespace rexx{
 		for (int i = 0; i < 16; i++){
 			NodeFrm::POINTER child = node->children_[i];
 			if ((child != nullptr) && (child->modified_)){
-				protocol::Child childresult = update_hash(child);
+				protocol::Child childresult = update_hash(child, operations);
 				node->info_.mutable_children(i)->CopyFrom(childresult);
 			}
 
@@ -221,16 +222,16 @@ namespace rexx{
 		result.set_count(children_count);
 #endif		
 		if (branch_count == 0 && node->location_ != rootl){
-			StorageDeleteNode(node);
+			Storage(DELETE_NODE, node, operations);
 			//node->indb_ = false;
 		}
 		else if (branch_count == 1 && node->location_ != rootl){
-			StorageDeleteNode(node);
+			Storage(DELETE_NODE, node, operations);
 			//node->indb_ = false;
 			result.CopyFrom(node->info_.children(onlybranch));
 		}
 		else {
-			StorageSaveNode(node);
+			Storage(SAVE_NODE, node, operations);
 			result.set_hash(HashCrypto(node->info_.SerializeAsString()));
 			result.set_sublocation(node->location_);
 			result.set_childtype(protocol::CHILDTYPE::INNER);
@@ -242,6 +243,49 @@ namespace rexx{
 		return result;
 	}
 
+	void Trie::Storage(StorageAction action, NodeFrm::POINTER node, StorageOperationList *operations){
+		if (operations != nullptr){
+			StorageOperation operation;
+			operation.action_ = action;
+			operation.node_ = node;
+			operations->push_back(operation);
+			return;
+		}
+
+		switch (action)
+		{
+		case SAVE_NODE:
+			StorageSaveNode(node);
+			break;
+		case SAVE_LEAF:
+			StorageSaveLeaf(node);
+			break;
+		case DELETE_NODE:
+			StorageDeleteNode(node);
+			break;
+		case DELETE_LEAF:
+			StorageDeleteLeaf(node);
+			break;
+		}
+	}
+
+	//Collect the modified nodes "depth" levels below node, walking only through modified nodes like update_hash does
+	void Trie::CollectModified(NodeFrm::POINTER node, int depth, std::vector<std::pair<NodeFrm::POINTER, int> > &nodes){
+		for (int i = 0; i < 16; i++){
+			NodeFrm::POINTER child = node->children_[i];
+			if ((child == nullptr) || (!child->modified_)){
+				continue;
+			}
+
+			if (depth <= 1){
+				nodes.push_back(std::make_pair(node, i));
+			}
+			else{
+				CollectModified(child, depth - 1, nodes);
+			}
+		}
+	}
+
 	bool Trie::SetItem(NodeFrm::POINTER node, const Location& location, const std::string &data, int depth){
 
 		node->modified_ = true;
@@ -421,6 +465,42 @@ namespace rexx{
 		root_hash_ = update_hash(root_).hash();
 	}
 
+	void Trie::UpdateHash(WorkerPool *pool){
+		//The first two levels give up to 256 independent subtrees
+		std::vector<std::pair<NodeFrm::POINTER, int> > subtrees;
+		if (pool != nullptr && pool->Size() > 1){
+			CollectModified(root_, 2, subtrees);
+		}
+
+		if (subtrees.size() < 2){
+			UpdateHash();
+			return;
+		}
+
+		std::vector<protocol::Child> results(subtrees.size());
+		std::vector<StorageOperationList> operations(subtrees.size());
+		std::vector<WorkerPool::Task> tasks;
+		for (size_t i = 0; i < subtrees.size(); i++){
+			NodeFrm::POINTER child = subtrees[i].first->children_[subtrees[i].second];
+			protocol::Child *result = &results[i];
+			StorageOperationList *child_operations = &operations[i];
+			tasks.push_back([this, child, result, child_operations](){
+				*result = update_hash(child, child_operations);
+			});
+		}
+		pool->RunAndWait(tasks);
+
+		//The subtrees are no longer modified, so the serial pass below takes their results from the parents
+		for (size_t i = 0; i < subtrees.size(); i++){
+			subtrees[i].first->info_.mutable_children(subtrees[i].second)->CopyFrom(results[i]);
+			for (size_t j = 0; j < operations[i].size(); j++){
+				Storage(operations[i][j].action_, operations[i][j].node_, nullptr);
+			}
+		}
+
+		root_hash_ = update_hash(root_).hash();
+	}
+
 	bool Trie::Delete(const std::string& key){
 		Location location = Key2Location(key);
 		return DeleteItem(root_, location);
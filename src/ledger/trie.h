@@ -6,6 +6,7 @@
 #include "proto/cpp/merkeltrie.pb.h"
 
 namespace rexx{
+	class WorkerPool;
 	typedef std::string Location;
 	typedef std::string HASH;
 
@@ -35,10 +36,26 @@ namespace rexx{
 
 	class Trie
 	{
+		enum StorageAction {
+			SAVE_NODE,
+			SAVE_LEAF,
+			DELETE_NODE,
+			DELETE_LEAF
+		};
+
+		struct StorageOperation {
+			StorageAction action_;
+			NodeFrm::POINTER node_;
+		};
+		typedef std::vector<StorageOperation> StorageOperationList;
 
 		bool SetItem(NodeFrm::POINTER node, const Location &key, const std::string &value, int depth);
 		bool DeleteItem(NodeFrm::POINTER node, const Location& key);
-		protocol::Child update_hash(NodeFrm::POINTER node);
+
+		//Storage calls are queued in operations when it is not null, so that subtrees can be hashed on other threads
+		protocol::Child update_hash(NodeFrm::POINTER node, StorageOperationList *operations = nullptr);
+		void Storage(StorageAction action, NodeFrm::POINTER node, StorageOperationList *operations);
+		void CollectModified(NodeFrm::POINTER node, int depth, std::vector<std::pair<NodeFrm::POINTER, int> > &nodes);
 
 		void Release(NodeFrm::POINTER node, int depth);
 		
@@ -88,6 +105,9 @@ namespace rexx{
 
 		void UpdateHash();
 
+		//Hash the modified subtrees under the top levels on the pool, the root hash is the same as UpdateHash()
+		void UpdateHash(WorkerPool *pool);
+
 		void FreeMemory(int depth);
 	
 		protocol::Node GetNode(const Location& key);
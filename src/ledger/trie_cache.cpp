@@ -0,0 +1,122 @@
+#include "trie_cache.h"
+
+namespace rexx {
+
+	TrieCache::TrieCache() :
+		capacity_(100000),
+		record_count_(0),
+		version_(0),
+		hit_count_(0),
+		miss_count_(0),
+		evict_count_(0),
+		invalidate_count_(0) {}
+
+	TrieCache::~TrieCache() {}
+
+	void TrieCache::SetCapacity(size_t capacity) {
+		utils::MutexGuard guard(lock_);
+		capacity_ = capacity;
+		Evict();
+	}
+
+	int64_t TrieCache::GetVersion() {
+		utils::MutexGuard guard(lock_);
+		return version_;
+	}
+
+	bool TrieCache::Get(const std::string &prefix, const std::string &key, std::string &value, bool &exist) {
+		utils::MutexGuard guard(lock_);
+		auto iter = entries_.find(prefix);
+		if (iter == entries_.end()) {
+			miss_count_++;
+			return false;
+		}
+
+		auto record = iter->second.records_.find(key);
+		if (record == iter->second.records_.end()) {
+			miss_count_++;
+			return false;
+		}
+
+		lru_.splice(lru_.begin(), lru_, iter->second.lru_);
+		exist = record->second.exist_;
+		if (exist) {
+			value = record->second.value_;
+		}
+		hit_count_++;
+		return true;
+	}
+
+	void TrieCache::Put(const std::string &prefix, const std::string &key, const std::string &value, bool exist, int64_t version) {
+		utils::MutexGuard guard(lock_);
+		if (capacity_ == 0 || version != version_) {
+			return;
+		}
+
+		auto iter = entries_.find(prefix);
+		if (iter == entries_.end()) {
+			lru_.push_front(prefix);
+			iter = entries_.insert(std::make_pair(prefix, Entry())).first;
+			iter->second.lru_ = lru_.begin();
+		}
+		else {
+			lru_.splice(lru_.begin(), lru_, iter->second.lru_);
+		}
+
+		size_t record_size = iter->second.records_.size();
+		Record &record = iter->second.records_[key];
+		record_count_ += iter->second.records_.size() - record_size;
+		record.exist_ = exist;
+		record.value_ = exist ? value : "";
+		Evict();
+	}
+
+	void TrieCache::MarkDirty(const std::string &prefix) {
+		utils::MutexGuard guard(lock_);
+		dirty_.insert(prefix);
+	}
+
+	void TrieCache::InvalidateDirty() {
+		utils::MutexGuard guard(lock_);
+		if (dirty_.empty()) {
+			return;
+		}
+
+		for (auto iter = dirty_.begin(); iter != dirty_.end(); iter++) {
+			Erase(*iter);
+		}
+		invalidate_count_ += dirty_.size();
+		dirty_.clear();
+		version_++;
+	}
+
+	void TrieCache::Evict() {
+		//Keep the most recently used trie even if it alone exceeds the capacity
+		while (record_count_ > capacity_ && lru_.size() > 1) {
+			Erase(lru_.back());
+			evict_count_++;
+		}
+	}
+
+	void TrieCache::Erase(const std::string &prefix) {
+		auto iter = entries_.find(prefix);
+		if (iter == entries_.end()) {
+			return;
+		}
+
+		record_count_ -= iter->second.records_.size();
+		lru_.erase(iter->second.lru_);
+		entries_.erase(iter);
+	}
+
+	void TrieCache::GetModuleStatus(Json::Value &data) {
+		utils::MutexGuard guard(lock_);
+		data["capacity"] = (Json::UInt64)capacity_;
+		data["trie_count"] = (Json::UInt64)entries_.size();
+		data["record_count"] = (Json::UInt64)record_count_;
+		data["hit_count"] = (Json::Int64)hit_count_;
+		data["miss_count"] = (Json::Int64)miss_count_;
+		data["evict_count"] = (Json::Int64)evict_count_;
+		data["invalidate_count"] = (Json::Int64)invalidate_count_;
+	}
+}
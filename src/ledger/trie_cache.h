@@ -0,0 +1,61 @@
+#ifndef TRIE_CACHE_H_
+#define TRIE_CACHE_H_
+
+#include <list>
+#include <unordered_map>
+#include <utils/headers.h>
+#include <json/json.h>
+
+namespace rexx {
+
+	//LRU cache of the records read from the account asset and metadata tries.
+	//Records are grouped by trie prefix, so all the records of one account trie are evicted
+	//or invalidated together. A missing record is cached as well.
+	class TrieCache {
+	public:
+		TrieCache();
+		~TrieCache();
+
+		void SetCapacity(size_t capacity);
+
+		//Take the version before reading the database, Put drops the record if an invalidation happened in between
+		int64_t GetVersion();
+		bool Get(const std::string &prefix, const std::string &key, std::string &value, bool &exist);
+		void Put(const std::string &prefix, const std::string &key, const std::string &value, bool exist, int64_t version);
+
+		//A trie with this prefix has written to a batch, drop it once the batch reaches the database
+		void MarkDirty(const std::string &prefix);
+		void InvalidateDirty();
+
+		void GetModuleStatus(Json::Value &data);
+
+	private:
+		struct Record {
+			bool exist_;
+			std::string value_;
+		};
+
+		struct Entry {
+			std::unordered_map<std::string, Record> records_;
+			std::list<std::string>::iterator lru_;
+		};
+
+		void Evict();
+		void Erase(const std::string &prefix);
+
+		utils::Mutex lock_;
+		std::unordered_map<std::string, Entry> entries_;
+		std::list<std::string> lru_;
+		std::set<std::string> dirty_;
+		size_t capacity_;
+		size_t record_count_;
+		int64_t version_;
+
+		int64_t hit_count_;
+		int64_t miss_count_;
+		int64_t evict_count_;
+		int64_t invalidate_count_;
+	};
+}
+
+#endif
@@ -20,7 +20,18 @@ namespace rexx {
 	P2pNetwork::~P2pNetwork() {}
 
 	P2pConfigure::P2pConfigure() :
-		network_id_(1){}
+		network_id_(1),
+		admission_thread_count_(0),
+		admission_queue_limit_(10240),
+		compact_pre_prepare_(true),
+		relay_inventory_(true),
+		relay_interval_(100),
+		compression_enabled_(true),
+		compression_min_size_(1024),
+		batch_enabled_(true),
+		batch_message_size_(1024),
+		batch_max_size_(64 * 1024),
+		batch_interval_(5){}
 
 	P2pConfigure::~P2pConfigure() {}
 
@@ -28,6 +39,17 @@ namespace rexx {
 		Configure::GetValue(value, "node_private_key", node_private_key_);
 		Configure::GetValue(value, "network_id", network_id_);		
 		consensus_network_configure_.Load(value["consensus_network"]);
+		Configure::GetValue(value["admission"], "thread_count", admission_thread_count_);
+		Configure::GetValue(value["admission"], "queue_limit", admission_queue_limit_);
+		Configure::GetValue(value, "compact_pre_prepare", compact_pre_prepare_);
+		Configure::GetValue(value["relay"], "inventory", relay_inventory_);
+		Configure::GetValue(value["relay"], "interval", relay_interval_);
+		Configure::GetValue(value["compression"], "enabled", compression_enabled_);
+		Configure::GetValue(value["compression"], "min_size", compression_min_size_);
+		Configure::GetValue(value["batch"], "enabled", batch_enabled_);
+		Configure::GetValue(value["batch"], "message_size", batch_message_size_);
+		Configure::GetValue(value["batch"], "max_size", batch_max_size_);
+		Configure::GetValue(value["batch"], "interval", batch_interval_);
 		if (node_private_key_.empty()){
 			PrivateKey priv_key(SIGNTYPE_ED25519);
 			node_private_key_ = priv_key.GetEncPrivateKey();
@@ -108,6 +130,23 @@ namespace rexx {
 		hash_type_ = 0; // 0 : SHA256, 1 :SM2
 		queue_limit_ = 10240;
 		queue_per_account_txs_limit_ = 64;
+		verify_batch_size_ = 64;
+		verify_thread_count_ = 0;
+		verify_cache_size_ = 10000;
+		trie_cache_size_ = 100000;
+		hash_thread_count_ = 0;
+		contract_isolate_pool_size_ = 16;
+		contract_code_cache_size_ = 1000;
+		contract_query_cache_size_ = 1000;
+		sync_windows_ = 4;
+		sync_thread_count_ = 2;
+		context_thread_count_ = 2;
+		context_test_thread_count_ = 4;
+		context_test_queue_limit_ = 64;
+		parallel_thread_count_ = 0;
+		parallel_batch_size_ = 256;
+		parallel_verify_ = false;
+		tx_index_ = false;
 	}
 
 	LedgerConfigure::~LedgerConfigure() {
@@ -124,10 +163,28 @@ namespace rexx {
 		Configure::GetValue(value, "max_trans_in_memory", max_trans_in_memory_);
 		Configure::GetValue(value, "hardfork_points", hardfork_points_);
 		Configure::GetValue(value, "use_atom_map", use_atom_map_);
+		Configure::GetValue(value, "tx_index", tx_index_);
 
 		Configure::GetValue(value["tx_pool"], "queue_limit", queue_limit_);
         Configure::GetValue(value["tx_pool"], "queue_per_account_txs_limit", queue_per_account_txs_limit_);
 
+		Configure::GetValue(value["signature_verifier"], "batch_size", verify_batch_size_);
+		Configure::GetValue(value["signature_verifier"], "thread_count", verify_thread_count_);
+		Configure::GetValue(value["signature_verifier"], "cache_size", verify_cache_size_);
+		Configure::GetValue(value, "trie_cache_size", trie_cache_size_);
+		Configure::GetValue(value, "hash_thread_count", hash_thread_count_);
+		Configure::GetValue(value["contract"], "isolate_pool_size", contract_isolate_pool_size_);
+		Configure::GetValue(value["contract"], "code_cache_size", contract_code_cache_size_);
+		Configure::GetValue(value["contract"], "query_cache_size", contract_query_cache_size_);
+		Configure::GetValue(value["sync"], "windows", sync_windows_);
+		Configure::GetValue(value["sync"], "thread_count", sync_thread_count_);
+		Configure::GetValue(value["context"], "thread_count", context_thread_count_);
+		Configure::GetValue(value["context"], "test_thread_count", context_test_thread_count_);
+		Configure::GetValue(value["context"], "test_queue_limit", context_test_queue_limit_);
+		Configure::GetValue(value["parallel"], "thread_count", parallel_thread_count_);
+		Configure::GetValue(value["parallel"], "batch_size", parallel_batch_size_);
+		Configure::GetValue(value["parallel"], "verify", parallel_verify_);
+
 		if (validation_privatekey_.empty()) {
 			PrivateKey tmp_priv(SIGNTYPE_ED25519);
 			validation_privatekey_ = tmp_priv.GetEncPrivateKey();
@@ -200,7 +257,9 @@ namespace rexx {
 			return false;
 		}
 
-		db_configure_.Load(values["db"]);
+		if (!db_configure_.Load(values["db"])) {
+			return false;
+		}
 		logger_configure_.Load(values["logger"]);
 		p2p_configure_.Load(values["p2p"]);
 		webserver_configure_.Load(values["webserver"]);
@@ -28,6 +28,17 @@ namespace rexx {
 		std::string node_private_key_;
 		int64_t network_id_;
 		P2pNetwork consensus_network_configure_;
+		uint32_t admission_thread_count_; //0 means the number of cpu cores
+		uint32_t admission_queue_limit_; //transactions from peers waiting for admission, more are dropped
+		bool compact_pre_prepare_; //send pre-prepares with transaction hashes to the peers supporting it
+		bool relay_inventory_; //announce transactions by hash to the peers supporting it
+		int64_t relay_interval_; //millisecond, announcements to a peer are batched within it
+		bool compression_enabled_; //zlib compress the frames to the peers accepting it
+		uint32_t compression_min_size_; //frames below this size are sent as they are
+		bool batch_enabled_; //coalesce small messages into one frame for the peers accepting it
+		uint32_t batch_message_size_; //messages below this size are coalesced
+		uint32_t batch_max_size_; //a batch reaching this size is sent at once
+		int64_t batch_interval_; //millisecond, a batch is sent at the latest after it
 
 		bool Load(const Json::Value &value);
 	};
@@ -74,8 +85,25 @@ namespace rexx {
 		uint32_t max_apply_ledger_per_round_;
 		uint32_t queue_limit_;
 		uint32_t queue_per_account_txs_limit_;
+		uint32_t verify_batch_size_;
+		uint32_t verify_thread_count_; //0 means the number of cpu cores
+		uint32_t verify_cache_size_; //verified consensus signatures remembered, 0 disables the cache
+		uint32_t trie_cache_size_; //records of account asset and metadata tries kept in memory
+		uint32_t hash_thread_count_; //threads hashing the account tree, 0 means the number of cpu cores, 1 hashes serially
+		uint32_t contract_isolate_pool_size_; //idle V8 isolates kept for reuse
+		uint32_t contract_code_cache_size_; //compiled contract scripts kept in memory
+		uint32_t contract_query_cache_size_; //results of contract queries of the api kept until the ledger closes
+		uint32_t sync_windows_; //windows of max_ledger_per_message ledgers requested from peers at the same time while catching up
+		uint32_t sync_thread_count_; //threads verifying the received ledgers ahead of execution
+		uint32_t context_thread_count_; //threads executing the consensus values before they are proposed or voted
+		uint32_t context_test_thread_count_; //threads executing the contract and transaction tests of the api
+		uint32_t context_test_queue_limit_; //tests waiting for a thread, more are rejected, 0 means no limit
+		uint32_t parallel_thread_count_; //threads executing payments speculatively, 0 applies every transaction serially
+		uint32_t parallel_batch_size_; //most transactions executed speculatively at a time
+		bool parallel_verify_; //also execute each speculative run serially and compare, the executor turns itself off on a mismatch
 		utils::StringList hardfork_points_;
 		bool use_atom_map_;
+		bool tx_index_; //index the transactions by account address for the transaction history api
 		bool Load(const Json::Value &value);
 	};
 
@@ -5,6 +5,7 @@
 #include <common/private_key.h>
 #include <common/argument.h>
 #include <common/daemon.h>
+#include <common/signature_verifier.h>
 #include <overlay/peer_manager.h>
 #include <ledger/ledger_manager.h>
 #include <consensus/consensus_manager.h>
@@ -13,6 +14,7 @@
 #include <api/websocket_server.h>
 #include <api/console.h>
 #include <ledger/contract_manager.h>
+#include <ledger/snapshot.h>
 #include <monitor/monitor_manager.h>
 #include "configure.h"
 
@@ -51,11 +53,13 @@ int main(int argc, char *argv[]){
 
 	utils::Daemon::InitInstance();
 	utils::net::Initialize();
+	utils::OpenSslLock::Initialize();
 	utils::Timer::InitInstance();
 	rexx::Configure::InitInstance();
 	rexx::Storage::InitInstance();
 	rexx::Global::InitInstance();
 	rexx::SlowTimer::InitInstance();
+	rexx::SignatureVerifier::InitInstance();
 	utils::Logger::InitInstance();
 	rexx::Console::InitInstance();
 	rexx::PeerManager::InitInstance();
@@ -120,6 +124,10 @@ int main(int argc, char *argv[]){
 			break;
 		}
 		object_exit.Push(std::bind(&utils::Logger::Exit, &logger));
+		if (logger_config.async_ && !logger.StartAsync(logger_config.async_ring_size_, (utils::LogOverflow)logger_config.async_overflow_)) {
+			LOG_STD_ERR("Failed to start async logger");
+			break;
+		}
 		LOG_INFO("Initialized daemon successfully");
 		LOG_INFO("Loaded configure successfully");
 		LOG_INFO("Initialized logger successfully");
@@ -166,6 +174,38 @@ int main(int argc, char *argv[]){
 			return 1;
 		}
 
+		if (arg.upgrade_ledger_db_) {
+			if (!rexx::LedgerManager::UpgradeSeqKeys()) {
+				LOG_ERROR("Failed to upgrade the ledger db");
+				return -1;
+			}
+			return 1;
+		}
+
+		if (arg.backfill_tx_index_) {
+			if (!rexx::LedgerManager::BackfillAccountTxIndex()) {
+				LOG_ERROR("Failed to backfill the account transaction index");
+				return -1;
+			}
+			return 1;
+		}
+
+		if (arg.snapshot_export_) {
+			if (!rexx::Snapshot::Export(arg.snapshot_path_, arg.snapshot_seq_)) {
+				LOG_ERROR("Failed to export snapshot");
+				return -1;
+			}
+			return 1;
+		}
+
+		if (arg.snapshot_import_) {
+			if (!rexx::Snapshot::Import(arg.snapshot_path_)) {
+				LOG_ERROR("Failed to import snapshot");
+				return -1;
+			}
+			return 1;
+		}
+
 		rexx::Global &global = rexx::Global::Instance();
 		if (!rexx::g_enable_ || !global.Initialize()){
 			LOG_ERROR_ERRNO("Failed to initialize global variable", STD_ERR_CODE, STD_ERR_DESC);
@@ -174,6 +214,15 @@ int main(int argc, char *argv[]){
 		object_exit.Push(std::bind(&rexx::Global::Exit, &global));
 		LOG_INFO("Initialized global module successfully");
 
+		const rexx::LedgerConfigure &ledger_config = rexx::Configure::Instance().ledger_configure_;
+		rexx::SignatureVerifier &verifier = rexx::SignatureVerifier::Instance();
+		if (!rexx::g_enable_ || !verifier.Initialize(ledger_config.verify_batch_size_, ledger_config.verify_thread_count_, ledger_config.verify_cache_size_)) {
+			LOG_ERROR("Failed to initialize signature verifier");
+			break;
+		}
+		object_exit.Push(std::bind(&rexx::SignatureVerifier::Exit, &verifier));
+		LOG_INFO("Initialized signature verifier successfully");
+
 		//Consensus manager must be initialized before ledger manager and glue manager
 		rexx::ConsensusManager &consensus_manager = rexx::ConsensusManager::Instance();
 		if (!rexx::g_enable_ || !consensus_manager.Initialize(rexx::Configure::Instance().ledger_configure_.validation_type_)) {
@@ -260,6 +309,7 @@ int main(int argc, char *argv[]){
 
 	rexx::ContractManager::ExitInstance();
 	rexx::SlowTimer::ExitInstance();
+	rexx::SignatureVerifier::ExitInstance();
 	rexx::GlueManager::ExitInstance();
 	rexx::LedgerManager::ExitInstance();
 	rexx::PeerManager::ExitInstance();
@@ -5,7 +5,7 @@
 #include "broadcast.h"
 
 namespace rexx{
-	BroadcastRecord::BroadcastRecord(int64_t type, const std::string &data, int64_t peer_id) {
+	BroadcastRecord::BroadcastRecord(int64_t type, int64_t peer_id) {
 		type_ = type;
 		peers_.insert(peer_id);
 		time_stamp_ = utils::Timestamp::HighResolution();
@@ -19,11 +19,14 @@ namespace rexx{
 	Broadcast::~Broadcast(){}
 
 	bool Broadcast::Add(int64_t type, const std::string &data, int64_t peer_id) {
-		std::string hash = HashWrapper::Crypto(data);
+		return AddHash(type, HashWrapper::Crypto(data), peer_id);
+	}
+
+	bool Broadcast::AddHash(int64_t type, const std::string &hash, int64_t peer_id) {
 		utils::MutexGuard guard(mutex_msg_sending_);
 		BroadcastRecordMap::iterator result = records_.find(hash);
 		if (result == records_.end()){ // We have never seen this message
-			BroadcastRecord::pointer record = std::make_shared<BroadcastRecord>(type, data, peer_id);
+			BroadcastRecord::pointer record = std::make_shared<BroadcastRecord>(type, peer_id);
 			records_[hash] = record;
 			records_couple_[record->time_stamp_] = hash;
 			return true;
@@ -37,26 +40,32 @@ namespace rexx{
 	}
 
 	bool Broadcast::IsQueued(int64_t type, const std::string &data) {
-		std::string hash = HashWrapper::Crypto(data);
+		return IsHashQueued(HashWrapper::Crypto(data));
+	}
+
+	bool Broadcast::IsHashQueued(const std::string &hash) {
 		utils::MutexGuard guard(mutex_msg_sending_);
 		BroadcastRecordMap::iterator result = records_.find(hash);
 		return result != records_.end();
 	}
 
 	void Broadcast::Send(int64_t type, const std::string &data) {
-		std::string hash = HashWrapper::Crypto(data);
+		Send(type, data, HashWrapper::Crypto(data));
+	}
+
+	void Broadcast::Send(int64_t type, const std::string &data, const std::string &hash) {
 		utils::MutexGuard guard(mutex_msg_sending_);
 		BroadcastRecordMap::iterator result = records_.find(hash);
 		if (result == records_.end()){ // No one has sent us this message
 			BroadcastRecord::pointer record = std::make_shared<BroadcastRecord>(
-				type, data, 0);
+				type, 0);
 
 			records_[hash] = record;
 			records_couple_[record->time_stamp_] = hash;
 			std::set<int64_t> peer_ids = driver_->GetActivePeerIds();
 			for (const auto peer_id : peer_ids)
 			{
-				driver_->SendRequest(peer_id, type, data);
+				driver_->SendBroadcast(peer_id, type, data, hash);
 				record->peers_.insert(peer_id);
 			}
 		}
@@ -65,7 +74,7 @@ namespace rexx{
 			for (const auto peer : driver_->GetActivePeerIds()){
 				if (peersTold.find(peer) == peersTold.end())
 				{
-					driver_->SendRequest(peer, type, data);
+					driver_->SendBroadcast(peer, type, data, hash);
 					result->second->peers_.insert(peer);
 				}
 			}
@@ -13,13 +13,18 @@ namespace rexx{
 		//Virtual bool SendMessage(int64_t peer_id, WsMessagePointer msg) = 0;
 		virtual bool SendRequest(int64_t peer_id, int64_t type, const std::string &data) = 0;
 		virtual std::set<int64_t> GetActivePeerIds() = 0;
+
+		//Send a broadcast message to a peer, the driver may announce it by its hash instead
+		virtual bool SendBroadcast(int64_t peer_id, int64_t type, const std::string &data, const std::string &hash) {
+			return SendRequest(peer_id, type, data);
+		}
 	};
 
 	class BroadcastRecord{
 	public:
 		typedef std::shared_ptr<BroadcastRecord> pointer;
 
-		BroadcastRecord(int64_t type, const std::string &data, int64_t);
+		BroadcastRecord(int64_t type, int64_t peer_id);
 		~BroadcastRecord();
 
 		int64_t type_;
@@ -44,6 +49,11 @@ namespace rexx{
 		bool Add(int64_t type, const std::string &data, int64_t peer_id);
 		void Send(int64_t type, const std::string &data);
 		bool IsQueued(int64_t type, const std::string &data);
+
+		//The same with the hash of the data known already
+		bool AddHash(int64_t type, const std::string &hash, int64_t peer_id);
+		void Send(int64_t type, const std::string &data, const std::string &hash);
+		bool IsHashQueued(const std::string &hash);
 		void OnTimer();
 		size_t GetRecordSize() const { return records_.size(); };
 	};
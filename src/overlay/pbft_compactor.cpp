@@ -0,0 +1,242 @@
+
+#include <utils/logger.h>
+#include <utils/timestamp.h>
+#include <common/general.h>
+#include <glue/glue_manager.h>
+
+#include "pbft_compactor.h"
+
+namespace rexx {
+
+	//Values kept to serve the peers rebuilding them, and how long a compact message waits for its transactions
+	static const size_t COMPACT_VALUE_CACHE_SIZE = 16;
+	static const int64_t COMPACT_PENDING_TIMEOUT = 30 * utils::MICRO_UNITS_PER_SEC;
+
+	PbftCompactor::PbftCompactor() :
+		last_compacted_(false),
+		compacted_count_(0),
+		rebuilt_count_(0),
+		fetched_tx_count_(0) {}
+
+	PbftCompactor::~PbftCompactor() {}
+
+	bool PbftCompactor::Compact(const std::string &data, std::string &compact_data) {
+		utils::MutexGuard guard(lock_);
+		if (data == last_data_) {
+			compact_data = last_compact_data_;
+			return last_compacted_;
+		}
+
+		last_data_ = data;
+		last_compact_data_.clear();
+		last_compacted_ = false;
+
+		protocol::PbftEnv env;
+		if (!env.ParseFromString(data) || env.pbft().type() != protocol::PBFT_TYPE_PREPREPARE) {
+			return false;
+		}
+
+		const protocol::PbftPrePrepare &pre_prepare = env.pbft().pre_prepare();
+		protocol::ConsensusValue value;
+		if (!value.ParseFromString(pre_prepare.value()) || value.txset().txs_size() == 0) {
+			return false;
+		}
+
+		protocol::PbftCompactEnv compact;
+		for (int32_t i = 0; i < value.txset().txs_size(); i++) {
+			compact.add_tx_hashes(HashWrapper::Crypto(value.txset().txs(i).transaction().SerializeAsString()));
+		}
+		Record(pre_prepare.value_digest(), value);
+
+		value.clear_txset();
+		*compact.mutable_env() = env;
+		compact.mutable_env()->mutable_pbft()->mutable_pre_prepare()->set_value(value.SerializeAsString());
+
+		last_compact_data_ = compact.SerializeAsString();
+		last_compacted_ = true;
+		compacted_count_++;
+		compact_data = last_compact_data_;
+		return true;
+	}
+
+	bool PbftCompactor::Rebuild(const protocol::PbftCompactEnv &compact, std::string &data, protocol::GetPbftTxs &request) {
+		return Rebuild(compact, TxEnvMap(), data, request);
+	}
+
+	bool PbftCompactor::Rebuild(const protocol::PbftCompactEnv &compact, const TxEnvMap &fetched, std::string &data, protocol::GetPbftTxs &request) {
+		const protocol::PbftPrePrepare &pre_prepare = compact.env().pbft().pre_prepare();
+		request.Clear();
+		request.set_value_digest(pre_prepare.value_digest());
+
+		protocol::ConsensusValue value;
+		if (!value.ParseFromString(pre_prepare.value())) {
+			LOG_ERROR("Failed to parse the value of the compact pre-prepare");
+			return false;
+		}
+
+		protocol::TransactionEnvSet *txset = value.mutable_txset();
+		for (int32_t i = 0; i < compact.tx_hashes_size(); i++) {
+			TxEnvMap::const_iterator iter = fetched.find(i);
+			if (iter != fetched.end()) {
+				*txset->add_txs() = *iter->second;
+				continue;
+			}
+
+			TransactionFrm::pointer tx;
+			if (GlueManager::Instance().QueryTransactionCache(compact.tx_hashes(i), tx)) {
+				*txset->add_txs() = tx->GetTransactionEnv();
+			}
+			else {
+				request.add_indexes(i);
+			}
+		}
+
+		if (request.indexes_size() > 0) {
+			return false;
+		}
+
+		std::string value_data = value.SerializeAsString();
+		if (HashWrapper::Crypto(value_data) != pre_prepare.value_digest()) {
+			//The pool may hold a transaction with other signatures than the proposed one, fetch every envelope
+			for (int32_t i = 0; i < compact.tx_hashes_size(); i++) {
+				if (fetched.find(i) == fetched.end()) {
+					request.add_indexes(i);
+				}
+			}
+
+			LOG_WARN("The rebuilt value does not match the digest(%s), %d transactions to fetch",
+				utils::String::Bin4ToHexString(pre_prepare.value_digest()).c_str(), request.indexes_size());
+			return false;
+		}
+
+		protocol::PbftEnv env = compact.env();
+		env.mutable_pbft()->mutable_pre_prepare()->set_value(value_data);
+		data = env.SerializeAsString();
+
+		utils::MutexGuard guard(lock_);
+		Record(pre_prepare.value_digest(), value);
+		rebuilt_count_++;
+		return true;
+	}
+
+	bool PbftCompactor::AddPending(const protocol::PbftCompactEnv &compact, const std::string &compact_hash, int64_t peer_id) {
+		utils::MutexGuard guard(lock_);
+		const std::string &value_digest = compact.env().pbft().pre_prepare().value_digest();
+		if (pending_.find(value_digest) != pending_.end()) {
+			return false;
+		}
+
+		Pending &pending = pending_[value_digest];
+		pending.compact_ = compact;
+		pending.compact_hash_ = compact_hash;
+		pending.peer_id_ = peer_id;
+		pending.time_ = utils::Timestamp::HighResolution();
+		return true;
+	}
+
+	bool PbftCompactor::OnTransactions(const protocol::PbftTxs &txs, std::string &data, std::string &compact_hash, int64_t &peer_id, protocol::GetPbftTxs &request) {
+		request.Clear();
+		Pending pending;
+		do {
+			utils::MutexGuard guard(lock_);
+			std::map<std::string, Pending>::iterator iter = pending_.find(txs.value_digest());
+			if (iter == pending_.end()) {
+				return false;
+			}
+
+			pending = iter->second;
+			pending_.erase(iter);
+			fetched_tx_count_ += txs.txs_size();
+		} while (false);
+
+		if (txs.indexes_size() != txs.txs_size()) {
+			LOG_ERROR("Failed to rebuild the pre-prepare, got %d transactions for %d indexes", txs.txs_size(), txs.indexes_size());
+			return false;
+		}
+
+		for (int32_t i = 0; i < txs.indexes_size(); i++) {
+			pending.fetched_[txs.indexes(i)] = txs.txs(i);
+		}
+
+		TxEnvMap fetched;
+		for (std::map<int32_t, protocol::TransactionEnv>::const_iterator iter = pending.fetched_.begin(); iter != pending.fetched_.end(); iter++) {
+			fetched[iter->first] = &iter->second;
+		}
+
+		peer_id = pending.peer_id_;
+		compact_hash = pending.compact_hash_;
+		if (Rebuild(pending.compact_, fetched, data, request)) {
+			return true;
+		}
+
+		if (request.indexes_size() == 0) {
+			LOG_ERROR("Failed to rebuild the pre-prepare(%s) with every transaction from peer(" FMT_I64 ")",
+				utils::String::Bin4ToHexString(txs.value_digest()).c_str(), pending.peer_id_);
+			return false;
+		}
+
+		//Every round fetches more of the transactions, so this ends with the whole value fetched at last
+		LOG_WARN("Fetching %d more transactions of the pre-prepare(%s) from peer(" FMT_I64 ")",
+			request.indexes_size(), utils::String::Bin4ToHexString(txs.value_digest()).c_str(), pending.peer_id_);
+		utils::MutexGuard guard(lock_);
+		pending.time_ = utils::Timestamp::HighResolution();
+		pending_[txs.value_digest()] = pending;
+		return false;
+	}
+
+	bool PbftCompactor::GetTransactions(const protocol::GetPbftTxs &request, protocol::PbftTxs &response) {
+		utils::MutexGuard guard(lock_);
+		std::map<std::string, protocol::ConsensusValue>::const_iterator iter = values_.find(request.value_digest());
+		if (iter == values_.end()) {
+			return false;
+		}
+
+		const protocol::TransactionEnvSet &txset = iter->second.txset();
+		response.set_value_digest(request.value_digest());
+		for (int32_t i = 0; i < request.indexes_size(); i++) {
+			int32_t index = request.indexes(i);
+			if (index >= 0 && index < txset.txs_size()) {
+				response.add_indexes(index);
+				*response.add_txs() = txset.txs(index);
+			}
+		}
+
+		return true;
+	}
+
+	void PbftCompactor::Record(const std::string &value_digest, const protocol::ConsensusValue &value) {
+		if (values_.find(value_digest) != values_.end()) {
+			return;
+		}
+
+		values_[value_digest] = value;
+		value_digests_.push_back(value_digest);
+		while (value_digests_.size() > COMPACT_VALUE_CACHE_SIZE) {
+			values_.erase(value_digests_.front());
+			value_digests_.pop_front();
+		}
+	}
+
+	void PbftCompactor::OnTimer(int64_t current_time) {
+		utils::MutexGuard guard(lock_);
+		for (std::map<std::string, Pending>::iterator iter = pending_.begin(); iter != pending_.end();) {
+			if (iter->second.time_ + COMPACT_PENDING_TIMEOUT < current_time) {
+				LOG_WARN("Dropped the compact pre-prepare(%s), the transactions from peer(" FMT_I64 ") did not arrive",
+					utils::String::Bin4ToHexString(iter->first).c_str(), iter->second.peer_id_);
+				pending_.erase(iter++);
+			}
+			else {
+				iter++;
+			}
+		}
+	}
+
+	void PbftCompactor::GetModuleStatus(Json::Value &data) {
+		utils::MutexGuard guard(lock_);
+		data["compacted_count"] = (Json::Int64)compacted_count_;
+		data["rebuilt_count"] = (Json::Int64)rebuilt_count_;
+		data["fetched_tx_count"] = (Json::Int64)fetched_tx_count_;
+		data["pending_count"] = (Json::UInt64)pending_.size();
+		data["value_cache_size"] = (Json::UInt64)values_.size();
+	}
+}
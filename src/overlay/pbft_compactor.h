@@ -0,0 +1,73 @@
+#ifndef PBFT_COMPACTOR_H_
+#define PBFT_COMPACTOR_H_
+
+#include <utils/headers.h>
+#include <json/value.h>
+#include <proto/cpp/overlay.pb.h>
+
+namespace rexx {
+
+	//Converts pre-prepares between the full form and the compact form, in which the transactions of the
+	//value are replaced by their content hashes. A receiver rebuilds the value from its transaction pool
+	//and fetches the transactions it lacks from the sending peer, the rebuilt value must match the digest
+	//signed by the leader, so the consensus module only ever sees the original message.
+	class PbftCompactor {
+	public:
+		PbftCompactor();
+		~PbftCompactor();
+
+		//False if the message is not a pre-prepare carrying transactions
+		bool Compact(const std::string &data, std::string &compact_data);
+
+		//Rebuild the pre-prepare from the transaction pool, false with the indexes to fetch if some are not found
+		bool Rebuild(const protocol::PbftCompactEnv &compact, std::string &data, protocol::GetPbftTxs &request);
+
+		//Keep the compact message, whose hash is compact_hash, until the transactions requested from the peer arrive.
+		//False if the value is already waiting for them.
+		bool AddPending(const protocol::PbftCompactEnv &compact, const std::string &compact_hash, int64_t peer_id);
+
+		//Rebuild a pending pre-prepare with the transactions received from the peer. If the value still does not
+		//match, the compact message is kept pending and false returns the request for the rest of the transactions.
+		bool OnTransactions(const protocol::PbftTxs &txs, std::string &data, std::string &compact_hash, int64_t &peer_id, protocol::GetPbftTxs &request);
+
+		//Serve a peer rebuilding a value this node compacted or rebuilt
+		bool GetTransactions(const protocol::GetPbftTxs &request, protocol::PbftTxs &response);
+
+		void OnTimer(int64_t current_time);
+		void GetModuleStatus(Json::Value &data);
+
+	private:
+		struct Pending {
+			protocol::PbftCompactEnv compact_;
+			std::string compact_hash_;
+			std::map<int32_t, protocol::TransactionEnv> fetched_; //the transactions received so far, by index
+			int64_t peer_id_;
+			int64_t time_;
+		};
+
+		typedef std::map<int32_t, const protocol::TransactionEnv *> TxEnvMap;
+
+		bool Rebuild(const protocol::PbftCompactEnv &compact, const TxEnvMap &fetched, std::string &data, protocol::GetPbftTxs &request);
+		void Record(const std::string &value_digest, const protocol::ConsensusValue &value);
+
+		utils::Mutex lock_;
+
+		//The last compacted message, a broadcast compacts the same message for every peer
+		std::string last_data_;
+		std::string last_compact_data_;
+		bool last_compacted_;
+
+		//Full values recently compacted or rebuilt, by value digest
+		std::map<std::string, protocol::ConsensusValue> values_;
+		std::list<std::string> value_digests_;
+
+		//Compact messages waiting for transactions, by value digest
+		std::map<std::string, Pending> pending_;
+
+		int64_t compacted_count_;
+		int64_t rebuilt_count_;
+		int64_t fetched_tx_count_;
+	};
+}
+
+#endif
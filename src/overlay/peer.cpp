@@ -52,7 +52,8 @@ namespace rexx {
 		active_time_ = current_time;
 	}
 
-	bool Peer::SendHello(int32_t listen_port, const std::string &node_address, const int64_t &network_id, const std::string &node_rand, std::error_code &ec) {
+	bool Peer::SendHello(int32_t listen_port, const std::string &node_address, const int64_t &network_id, const std::string &node_rand,
+		bool compression, bool batch, std::error_code &ec) {
 		protocol::Hello hello;
 
 		hello.set_ledger_version(General::LEDGER_VERSION);
@@ -62,6 +63,8 @@ namespace rexx {
 		hello.set_node_address(node_address);
 		hello.set_node_rand(node_rand);
 		hello.set_network_id(network_id);
+		hello.set_compression(compression);
+		hello.set_batch(batch);
 		return SendRequest(protocol::OVERLAY_MSGTYPE_HELLO, hello.SerializeAsString(), ec);
 	}
 
@@ -78,6 +81,10 @@ namespace rexx {
 		return delay_;
 	}
 
+	int64_t Peer::GetPeerOverlayVersion() const {
+		return peer_overlay_version_;
+	}
+
 	bool Peer::OnNetworkTimer(int64_t current_time) {
 		if (!IsActive() && current_time - connect_start_time_ > 10 * utils::MICRO_UNITS_PER_SEC) {
 			LOG_ERROR("Failed to check peer active, (%s) timeout", GetPeerAddress().ToIpPort().c_str());
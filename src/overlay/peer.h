@@ -40,11 +40,13 @@ namespace rexx {
 		std::string GetPeerNodeAddress() const;
 		int64_t GetActiveTime() const;
 		int64_t GetDelay() const;
+		int64_t GetPeerOverlayVersion() const;
 
 		bool SendPeers(const protocol::Peers &db_peers, std::error_code &ec);
 		void SetPeerInfo(const protocol::Hello &hello);
 		void SetActiveTime(int64_t current_time);
-		bool SendHello(int32_t listen_port, const std::string &node_address, const int64_t &network_id, const std::string &node_rand, std::error_code &ec);
+		bool SendHello(int32_t listen_port, const std::string &node_address, const int64_t &network_id, const std::string &node_rand,
+			bool compression, bool batch, std::error_code &ec);
 
 		virtual void ToJson(Json::Value &status) const;
 		virtual bool OnNetworkTimer(int64_t current_time);
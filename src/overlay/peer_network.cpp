@@ -4,6 +4,7 @@
 #include <common/general.h>
 #include <common/storage.h>
 #include <common/private_key.h>
+#include <common/signature_verifier.h>
 #include <main/configure.h>
 #include <glue/glue_manager.h>
 #include <proto/cpp/overlay.pb.h>
@@ -17,7 +18,10 @@ namespace rexx {
 		context_(asio::ssl::context::tlsv12),
 		cert_enabled_(false),
 		cert_is_valid_(false),
-		broadcast_(this) {
+		broadcast_(this),
+		tx_relay_(this),
+		compact_pre_prepare_(false),
+		admission_queue_limit_(0) {
 		check_interval_ = 5 * utils::MICRO_UNITS_PER_SEC;
 		dns_seed_inited_ = false; 
 		total_peers_count_ = 0;
@@ -29,10 +33,15 @@ namespace rexx {
 		request_methods_[protocol::OVERLAY_MSGTYPE_LEDGERS] = std::bind(&PeerNetwork::OnMethodGetLedgers, this, std::placeholders::_1, std::placeholders::_2);
 		request_methods_[protocol::OVERLAY_MSGTYPE_PBFT] = std::bind(&PeerNetwork::OnMethodPbft, this, std::placeholders::_1, std::placeholders::_2);
 		request_methods_[protocol::OVERLAY_MSGTYPE_LEDGER_UPGRADE_NOTIFY] = std::bind(&PeerNetwork::OnMethodLedgerUpNotify, this, std::placeholders::_1, std::placeholders::_2);
+		request_methods_[protocol::OVERLAY_MSGTYPE_PBFT_COMPACT] = std::bind(&PeerNetwork::OnMethodPbftCompact, this, std::placeholders::_1, std::placeholders::_2);
+		request_methods_[protocol::OVERLAY_MSGTYPE_PBFT_TXS] = std::bind(&PeerNetwork::OnMethodGetPbftTxs, this, std::placeholders::_1, std::placeholders::_2);
+		request_methods_[protocol::OVERLAY_MSGTYPE_TX_INV] = std::bind(&PeerNetwork::OnMethodTxInv, this, std::placeholders::_1, std::placeholders::_2);
+		request_methods_[protocol::OVERLAY_MSGTYPE_GET_TXS] = std::bind(&PeerNetwork::OnMethodGetTxs, this, std::placeholders::_1, std::placeholders::_2);
 
 
 		response_methods_[protocol::OVERLAY_MSGTYPE_LEDGERS] = std::bind(&PeerNetwork::OnMethodLedgers, this, std::placeholders::_1, std::placeholders::_2);
 		response_methods_[protocol::OVERLAY_MSGTYPE_HELLO] = std::bind(&PeerNetwork::OnMethodHelloResponse, this, std::placeholders::_1, std::placeholders::_2);
+		response_methods_[protocol::OVERLAY_MSGTYPE_PBFT_TXS] = std::bind(&PeerNetwork::OnMethodPbftTxs, this, std::placeholders::_1, std::placeholders::_2);
 		last_update_peercache_time_ = 0;
 	}
 
@@ -53,6 +62,27 @@ namespace rexx {
 				break;
 			}
 			network_id_ = Configure::Instance().p2p_configure_.network_id_;
+
+			const P2pConfigure &p2p_configure = Configure::Instance().p2p_configure_;
+			uint32_t admission_threads = p2p_configure.admission_thread_count_;
+			if (admission_threads == 0) {
+				admission_threads = utils::System::GetCpuCoreCount();
+			}
+			admission_queue_limit_ = p2p_configure.admission_queue_limit_;
+			compact_pre_prepare_ = p2p_configure.compact_pre_prepare_;
+			tx_relay_.Initialize(p2p_configure.relay_inventory_, p2p_configure.relay_interval_);
+
+			frame_parameter_.compression_ = p2p_configure.compression_enabled_;
+			frame_parameter_.compression_min_size_ = p2p_configure.compression_min_size_;
+			frame_parameter_.batch_ = p2p_configure.batch_enabled_;
+			frame_parameter_.batch_message_size_ = p2p_configure.batch_message_size_;
+			frame_parameter_.batch_max_size_ = p2p_configure.batch_max_size_;
+			frame_parameter_.batch_interval_ = p2p_configure.batch_interval_ * utils::MICRO_UNITS_PER_MILLI;
+			frame_batch_ = frame_parameter_.batch_;
+			if (!admission_pool_.Initialize("admission", admission_threads)) {
+				LOG_ERROR("Failed to initialize the transaction admission pool");
+				break;
+			}
 			node_rand_ = utils::String::Format("node-rand-" FMT_I64 "-%d", utils::Timestamp::HighResolution(), rand() * rand());
 
 			TimerNotify::RegisterModule(this);
@@ -65,6 +95,7 @@ namespace rexx {
 
 	bool PeerNetwork::Exit() {
 		//Join and wait
+		admission_pool_.Exit();
 		LOG_INFO("Exited peer netwrok ok.");
 
 		return true;
@@ -173,11 +204,17 @@ namespace rexx {
 			LOG_INFO("Received a hello message, peer(%s) is active", peer->GetRemoteAddress().ToIpPort().c_str());
 			peer->SetActiveTime(utils::Timestamp::HighResolution());
 
+			FrameParameter frame_parameter = frame_parameter_;
+			frame_parameter.compression_ = frame_parameter_.compression_ && hello.compression();
+			frame_parameter.batch_ = frame_parameter_.batch_ && hello.batch();
+			peer->SetFrameParameter(frame_parameter);
+
 			if (peer->InBound()) {
 				const P2pNetwork &p2p_configure = rexx::Configure::Instance().p2p_configure_.consensus_network_configure_;
 
 				std::error_code ec;
-				peer->SendHello(p2p_configure.listen_port_, peer_node_address_, network_id_, node_rand_, last_ec_);
+				peer->SendHello(p2p_configure.listen_port_, peer_node_address_, network_id_, node_rand_,
+					frame_parameter_.compression_, frame_parameter_.batch_, last_ec_);
 
 				//Create
 				if (total_peers_count_ < General::PEER_DB_COUNT) CreatePeerIfNotExist(peer->GetRemoteAddress());
@@ -220,11 +257,6 @@ namespace rexx {
 			return false;
 		}
 
-		if (broadcast_.IsQueued(protocol::OVERLAY_MSGTYPE_TRANSACTION, message.data())) {
-			LOG_TRACE("Failed to process the peer transaction message.The transaction has been broadcast, from connection id (" FMT_I64 ")", conn_id);
-			return true;
-		}
-
 		//if (ReceiveBroadcastMsg(protocol::OVERLAY_MSGTYPE_TRANSACTION, message.data(), conn_id)) {
 		protocol::TransactionEnv tran;
 		if (!tran.ParseFromString(message.data())) {
@@ -232,19 +264,83 @@ namespace rexx {
 			return false;
 		}
 
-		TransactionFrm::pointer tran_ptr = std::make_shared<TransactionFrm>(tran);
-		//Switch to main thread
-		Global::Instance().GetIoService().post([tran_ptr, message, this, conn_id]() {
-			Result ig_err;
-			if (GlueManager::Instance().OnTransaction(tran_ptr, ig_err)) {
-				ReceiveBroadcastMsg(protocol::OVERLAY_MSGTYPE_TRANSACTION, message.data(), conn_id);
-				BroadcastMsg(message.type(), message.data());
-			}
+		//The broadcast queue is keyed by the envelope hash the transaction computes anyway
+		TransactionFrm::pointer tran_ptr = std::make_shared<TransactionFrm>(tran, false);
+		std::set<int64_t> announcers;
+		tx_relay_.OnReceived(tran_ptr->GetFullHash(), announcers);
+		if (broadcast_.IsHashQueued(tran_ptr->GetFullHash())) {
+			tx_relay_.OnDuplicate();
+			LOG_TRACE("Failed to process the peer transaction message.The transaction has been broadcast, from connection id (" FMT_I64 ")", conn_id);
+			return true;
+		}
+
+		//Drop the transaction when the admission pipeline is full, the peer will broadcast it again
+		if (admission_pending_.value() >= (int64_t)admission_queue_limit_) {
+			admission_dropped_.Inc();
+			LOG_TRACE("Dropped the peer transaction from connection id (" FMT_I64 "), " FMT_I64 " transactions are waiting for admission",
+				conn_id, admission_pending_.value());
+			return true;
+		}
+
+		TransactionFrm::pointer exist_tran;
+		if (GlueManager::Instance().QueryTransactionCache(tran_ptr->GetContentHash(), exist_tran)) {
+			LOG_TRACE("Received duplicate transaction from connection id (" FMT_I64 ")", conn_id);
+			return true;
+		}
+
+		//Verify the signatures together with other incoming transactions, then check and import on the admission pool
+		admission_pending_.Inc();
+		std::vector<SignatureItem> items;
+		tran_ptr->GetSignatureItems(items);
+		SignatureVerifier::Instance().AsyncVerify(items, [tran_ptr, announcers, this, conn_id](std::vector<SignatureItem> &verified_items) {
+			tran_ptr->SetSignatureResult(verified_items, 0);
+
+			admission_pool_.Post([tran_ptr, announcers, this, conn_id]() {
+				Result ig_err;
+				if (GlueManager::Instance().OnTransaction(tran_ptr, ig_err)) {
+					//Neither the sender nor the peers which announced the transaction need it again
+					const std::string &hash = tran_ptr->GetFullHash();
+					broadcast_.AddHash(protocol::OVERLAY_MSGTYPE_TRANSACTION, hash, conn_id);
+					for (auto iter = announcers.begin(); iter != announcers.end(); iter++) {
+						broadcast_.AddHash(protocol::OVERLAY_MSGTYPE_TRANSACTION, hash, *iter);
+					}
+					broadcast_.Send(protocol::OVERLAY_MSGTYPE_TRANSACTION, tran_ptr->GetFullData(), hash);
+				}
+				admission_pending_.Dec();
+			});
 		});
 
 		return true;
 	}
 
+	bool PeerNetwork::OnMethodTxInv(protocol::WsMessage &message, int64_t conn_id) {
+		protocol::TransactionInv inv;
+		if (!inv.ParseFromString(message.data())) {
+			LOG_ERROR("Failed to parse the transaction inventory from connection id(" FMT_I64 ")", conn_id);
+			return false;
+		}
+
+		tx_relay_.OnInventory(conn_id, inv, [this](const std::string &hash) {
+			return broadcast_.IsHashQueued(hash);
+		});
+		return true;
+	}
+
+	bool PeerNetwork::OnMethodGetTxs(protocol::WsMessage &message, int64_t conn_id) {
+		protocol::TransactionInv request;
+		if (!request.ParseFromString(message.data())) {
+			LOG_ERROR("Failed to parse the transaction request from connection id(" FMT_I64 ")", conn_id);
+			return false;
+		}
+
+		std::vector<std::string> bodies;
+		tx_relay_.GetBodies(request, bodies);
+		for (size_t i = 0; i < bodies.size(); i++) {
+			SendRequest(conn_id, protocol::OVERLAY_MSGTYPE_TRANSACTION, bodies[i]);
+		}
+		return true;
+	}
+
 	bool PeerNetwork::OnMethodGetLedgers(protocol::WsMessage &message, int64_t conn_id) {
 		protocol::GetLedgers getledgers;
 		getledgers.ParseFromString(message.data());
@@ -282,8 +378,12 @@ namespace rexx {
 			return false;
 		}
 
+		return OnPbft(message.data(), conn_id);
+	}
+
+	bool PeerNetwork::OnPbft(const std::string &data, int64_t conn_id) {
 		protocol::PbftEnv env;
-		env.ParseFromString(message.data());
+		env.ParseFromString(data);
 		if (!env.has_pbft()) {
 			LOG_ERROR("Failed to process the peer pbft message.Pbft env is not initialized");
 			return false;
@@ -302,17 +402,17 @@ namespace rexx {
 			hash.c_str(), msg.GetNodeAddress(), msg.GetSeq(),
 			PbftDesc::GetMessageTypeDesc(msg.GetPbft().pbft().type()), msg.GetSize());
 
-		if (broadcast_.IsQueued(protocol::OVERLAY_MSGTYPE_PBFT, message.data())) {
+		if (broadcast_.IsQueued(protocol::OVERLAY_MSGTYPE_PBFT, data)) {
 			LOG_TRACE("Duplicate consensus transaction in the broadcast queue.Received from connection id(" FMT_I64 ")", conn_id);
 			return true;
 		}
 
 		//Switch to main thread
-		Global::Instance().GetIoService().post([msg, message, hash, this, conn_id]() {
+		Global::Instance().GetIoService().post([msg, data, hash, this, conn_id]() {
 				LOG_TRACE("Pbft hash(%s) would be processed", hash.c_str());
 				if (GlueManager::Instance().OnConsensus(msg)) {
-					ReceiveBroadcastMsg(protocol::OVERLAY_MSGTYPE_PBFT, message.data(), conn_id);
-					BroadcastMsg(protocol::OVERLAY_MSGTYPE_PBFT, message.data());
+					ReceiveBroadcastMsg(protocol::OVERLAY_MSGTYPE_PBFT, data, conn_id);
+					BroadcastMsg(protocol::OVERLAY_MSGTYPE_PBFT, data);
 				}
 				else {
 					LOG_TRACE("Failed to deal with pbft consensus, which hash is(%s)  ", hash.c_str());
@@ -322,6 +422,86 @@ namespace rexx {
 		return true;
 	}
 
+	bool PeerNetwork::OnMethodPbftCompact(protocol::WsMessage &message, int64_t conn_id) {
+		if (message.data().size() > General::TXSET_LIMIT_SIZE + 2 * utils::BYTES_PER_MEGA) {
+			LOG_ERROR("Failed to process the compact pbft message.Data size(" FMT_SIZE ") is too large", message.data().size());
+			return false;
+		}
+
+		protocol::PbftCompactEnv compact;
+		if (!compact.ParseFromString(message.data()) || compact.env().pbft().type() != protocol::PBFT_TYPE_PREPREPARE) {
+			LOG_ERROR("Failed to process the compact pbft message.It is not a pre-prepare");
+			return false;
+		}
+
+		//Every peer relays the same compact message, rebuild it once
+		std::string compact_hash = HashWrapper::Crypto(message.data());
+		if (broadcast_.IsHashQueued(compact_hash)) {
+			LOG_TRACE("Duplicate compact pre-prepare in the broadcast queue.Received from connection id(" FMT_I64 ")", conn_id);
+			return true;
+		}
+
+		//Rebuild the original message and process it as received, ask the peer for the transactions not in the pool
+		std::string data;
+		protocol::GetPbftTxs request;
+		if (pbft_compactor_.Rebuild(compact, data, request)) {
+			broadcast_.AddHash(protocol::OVERLAY_MSGTYPE_PBFT_COMPACT, compact_hash, conn_id);
+			return OnPbft(data, conn_id);
+		}
+
+		if (request.indexes_size() > 0 && pbft_compactor_.AddPending(compact, compact_hash, conn_id)) {
+			LOG_TRACE("Fetching %d of %d transactions of the compact pre-prepare from connection id(" FMT_I64 ")",
+				request.indexes_size(), compact.tx_hashes_size(), conn_id);
+			SendRequest(conn_id, protocol::OVERLAY_MSGTYPE_PBFT_TXS, request.SerializeAsString());
+		}
+		return true;
+	}
+
+	bool PeerNetwork::OnMethodGetPbftTxs(protocol::WsMessage &message, int64_t conn_id) {
+		protocol::GetPbftTxs request;
+		if (!request.ParseFromString(message.data())) {
+			LOG_ERROR("Failed to parse the pbft transactions request");
+			return false;
+		}
+
+		protocol::PbftTxs response;
+		if (!pbft_compactor_.GetTransactions(request, response)) {
+			LOG_TRACE("The value(%s) requested by connection id(" FMT_I64 ") is not cached",
+				utils::String::Bin4ToHexString(request.value_digest()).c_str(), conn_id);
+			return true;
+		}
+
+		utils::MutexGuard guard(conns_list_lock_);
+		Peer *peer = (Peer *)GetConnection(conn_id);
+		if (peer && peer->IsActive()) {
+			std::error_code ignore_ec;
+			peer->SendResponse(message, response.SerializeAsString(), ignore_ec);
+		}
+		return true;
+	}
+
+	bool PeerNetwork::OnMethodPbftTxs(protocol::WsMessage &message, int64_t conn_id) {
+		protocol::PbftTxs txs;
+		if (!txs.ParseFromString(message.data())) {
+			LOG_ERROR("Failed to parse the pbft transactions response");
+			return false;
+		}
+
+		std::string data;
+		std::string compact_hash;
+		int64_t peer_id = 0;
+		protocol::GetPbftTxs request;
+		if (pbft_compactor_.OnTransactions(txs, data, compact_hash, peer_id, request)) {
+			broadcast_.AddHash(protocol::OVERLAY_MSGTYPE_PBFT_COMPACT, compact_hash, peer_id);
+			return OnPbft(data, peer_id);
+		}
+
+		if (request.indexes_size() > 0) {
+			SendRequest(peer_id, protocol::OVERLAY_MSGTYPE_PBFT_TXS, request.SerializeAsString());
+		}
+		return true;
+	}
+
 	bool PeerNetwork::OnMethodLedgerUpNotify(protocol::WsMessage &message, int64_t conn_id) {
 		protocol::LedgerUpgradeNotify notify;
 		if (!notify.ParseFromString(message.data())) {
@@ -351,7 +531,8 @@ namespace rexx {
 		if (connections_.size() < total_connection) {
 			if (!conn->InBound()) {
 				Peer *peer = (Peer *)conn;
-				peer->SendHello(p2p_configure.listen_port_, peer_node_address_, network_id_, node_rand_, last_ec_);
+				peer->SendHello(p2p_configure.listen_port_, peer_node_address_, network_id_, node_rand_,
+					frame_parameter_.compression_, frame_parameter_.batch_, last_ec_);
 			}
 			return true;
 		} else{
@@ -761,6 +942,7 @@ namespace rexx {
 		CleanNotActivePeers();
 
 		broadcast_.OnTimer();
+		pbft_compactor_.OnTimer(current_time);
 	}
 
 	void PeerNetwork::AddReceivedPeers(const utils::StringMap &item) {
@@ -780,16 +962,39 @@ namespace rexx {
 		utils::MutexGuard guard(conns_list_lock_);
 		Peer *peer = (Peer *)GetConnection(peer_id);
 		if (peer && peer->IsActive()) {
-			return peer->SendByteMessage(message->SerializeAsString(), last_ec_);
+			//Framed like every other message, so large replies such as ledgers get compressed
+			return peer->SendWsMessage(*message, last_ec_);
 		}
 
 		return false;
 	}
 
+	bool PeerNetwork::SendBroadcast(int64_t peer_id, int64_t type, const std::string &data, const std::string &hash) {
+		bool announce = false;
+		if (type == protocol::OVERLAY_MSGTYPE_TRANSACTION && tx_relay_.IsEnabled()) {
+			utils::MutexGuard guard(conns_list_lock_);
+			Peer *peer = (Peer *)GetConnection(peer_id);
+			announce = peer && peer->IsActive() && peer->GetPeerOverlayVersion() >= General::OVERLAY_TX_INV_VERSION;
+		}
+
+		if (announce) {
+			tx_relay_.Announce(peer_id, hash, data);
+			return true;
+		}
+		return SendRequest(peer_id, type, data);
+	}
+
 	bool PeerNetwork::SendRequest(int64_t peer_id, int64_t type, const std::string &data) {
+		std::string compact_data;
+		bool compacted = compact_pre_prepare_ && type == protocol::OVERLAY_MSGTYPE_PBFT &&
+			pbft_compactor_.Compact(data, compact_data);
+
 		utils::MutexGuard guard(conns_list_lock_);
 		Peer *peer = (Peer *)GetConnection(peer_id);
 		if (peer && peer->IsActive()) {
+			if (compacted && peer->GetPeerOverlayVersion() >= General::OVERLAY_COMPACT_PBFT_VERSION) {
+				return peer->SendRequest(protocol::OVERLAY_MSGTYPE_PBFT_COMPACT, compact_data, last_ec_);
+			}
 			return peer->SendRequest(type, data, last_ec_);
 		}
 
@@ -830,6 +1035,11 @@ namespace rexx {
 		data["peer_cache_size"] = (Json::UInt64)db_peer_cache_.peers_size();
 		data["recv_peerlist_size"] = (Json::UInt64)received_peer_list_.size();
 		data["broad_record_size"] = (Json::UInt64)broadcast_.GetRecordSize();
+		data["admission_threads"] = (Json::UInt64)admission_pool_.Size();
+		data["admission_pending"] = (Json::Int64)admission_pending_.value();
+		data["admission_dropped"] = (Json::Int64)admission_dropped_.value();
+		pbft_compactor_.GetModuleStatus(data["compact_pbft"]);
+		tx_relay_.GetModuleStatus(data["tx_relay"]);
 		int active_size = 0;
 		Json::Value peers;
 		do {
@@ -7,8 +7,11 @@
 #include <common/general.h>
 #include <common/private_key.h>
 #include <common/network.h>
+#include <common/worker_pool.h>
 #include "peer.h"
 #include "broadcast.h"
+#include "pbft_compactor.h"
+#include "tx_relay.h"
 
 namespace rexx {
 
@@ -35,6 +38,21 @@ namespace rexx {
 
 		Broadcast broadcast_;
 
+		//Transactions are announced by hash to the peers supporting it
+		TxRelay tx_relay_;
+
+		//Pre-prepares are sent with transaction hashes to the peers supporting it
+		PbftCompactor pbft_compactor_;
+		bool compact_pre_prepare_;
+		FrameParameter frame_parameter_; //the local frame options, enabled toward a peer accepting them in its hello
+
+		//Transactions from peers are checked and imported on this pool, so the main io_service
+		//stays free for consensus and ledger messages
+		WorkerPool admission_pool_;
+		uint32_t admission_queue_limit_;
+		utils::AtomicInt64 admission_pending_;
+		utils::AtomicInt64 admission_dropped_;
+
 		// cert is enable or unable
 		bool cert_enabled_;
 
@@ -61,9 +79,15 @@ namespace rexx {
 		bool OnMethodHello(protocol::WsMessage &message, int64_t conn_id);
 		bool OnMethodPeers(protocol::WsMessage &message, int64_t conn_id);
 		bool OnMethodTransaction(protocol::WsMessage &message, int64_t conn_id);
+		bool OnMethodTxInv(protocol::WsMessage &message, int64_t conn_id);
+		bool OnMethodGetTxs(protocol::WsMessage &message, int64_t conn_id);
 		bool OnMethodGetLedgers(protocol::WsMessage &message, int64_t conn_id);
 		bool OnMethodLedgers(protocol::WsMessage &message, int64_t conn_id);
 		bool OnMethodPbft(protocol::WsMessage &message, int64_t conn_id);
+		bool OnMethodPbftCompact(protocol::WsMessage &message, int64_t conn_id);
+		bool OnMethodGetPbftTxs(protocol::WsMessage &message, int64_t conn_id);
+		bool OnMethodPbftTxs(protocol::WsMessage &message, int64_t conn_id);
+		bool OnPbft(const std::string &data, int64_t conn_id);
 		bool OnMethodLedgerUpNotify(protocol::WsMessage &message, int64_t conn_id);
 		bool OnMethodHelloResponse(protocol::WsMessage &message, int64_t conn_id);
 
@@ -97,6 +121,7 @@ namespace rexx {
 
 		virtual bool SendMsgToPeer(int64_t peer_id, WsMessagePointer msg);
 		virtual bool SendRequest(int64_t peer_id, int64_t type, const std::string &data);
+		virtual bool SendBroadcast(int64_t peer_id, int64_t type, const std::string &data, const std::string &hash) override;
 		virtual std::set<int64_t> GetActivePeerIds();
 
 		bool NodeExist(std::string node_address, int64_t peer_id);
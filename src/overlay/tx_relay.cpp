@@ -0,0 +1,200 @@
+
+#include <utils/logger.h>
+#include <utils/timestamp.h>
+
+#include "tx_relay.h"
+
+namespace rexx {
+
+	//Hashes per inventory message, how long a requested body may take, and how long bodies and requests are kept
+	static const size_t RELAY_INV_LIMIT = 1000;
+	static const int64_t RELAY_REQUEST_TIMEOUT = 2 * utils::MICRO_UNITS_PER_SEC;
+	static const int64_t RELAY_KEEP_TIME = 60 * utils::MICRO_UNITS_PER_SEC;
+
+	TxRelay::TxRelay(IBroadcastDriver *driver) :
+		driver_(driver),
+		enabled_(false),
+		inv_sent_count_(0),
+		inv_received_count_(0),
+		inv_duplicate_count_(0),
+		requested_count_(0),
+		served_count_(0),
+		duplicate_count_(0),
+		bytes_saved_(0) {
+		timer_name_ = "Transaction Relay";
+	}
+
+	TxRelay::~TxRelay() {}
+
+	bool TxRelay::Initialize(bool enabled, int64_t interval) {
+		enabled_ = enabled;
+		check_interval_ = (interval > 0 ? interval : 1) * utils::MICRO_UNITS_PER_MILLI;
+		TimerNotify::RegisterModule(this);
+		return true;
+	}
+
+	bool TxRelay::IsEnabled() const {
+		return enabled_;
+	}
+
+	void TxRelay::Announce(int64_t peer_id, const std::string &hash, const std::string &data) {
+		utils::MutexGuard guard(lock_);
+		Body &body = bodies_[hash];
+		if (body.data_.empty()) {
+			body.data_ = data;
+			body.time_ = utils::Timestamp::HighResolution();
+		}
+
+		announcements_[peer_id].push_back(hash);
+		bytes_saved_ += (int64_t)data.size() - (int64_t)hash.size();
+	}
+
+	void TxRelay::OnInventory(int64_t peer_id, const protocol::TransactionInv &inv, const std::function<bool(const std::string &hash)> &is_known) {
+		//Checked before taking the lock, the broadcast queue calls into the relay with its own lock held
+		std::vector<bool> known;
+		for (int32_t i = 0; i < inv.hashes_size(); i++) {
+			known.push_back(is_known(inv.hashes(i)));
+		}
+
+		protocol::TransactionInv request;
+		do {
+			utils::MutexGuard guard(lock_);
+			inv_received_count_ += inv.hashes_size();
+			int64_t now = utils::Timestamp::HighResolution();
+			for (int32_t i = 0; i < inv.hashes_size(); i++) {
+				const std::string &hash = inv.hashes(i);
+				std::map<std::string, Request>::iterator iter = requests_.find(hash);
+				if (iter != requests_.end()) {
+					iter->second.announcers_.insert(peer_id);
+					inv_duplicate_count_++;
+					continue;
+				}
+
+				Request &item = requests_[hash];
+				item.announcers_.insert(peer_id);
+				item.time_ = now;
+				if (known[i]) {
+					item.peer_id_ = 0;
+					inv_duplicate_count_++;
+					continue;
+				}
+
+				item.peer_id_ = peer_id;
+				request.add_hashes(hash);
+			}
+			requested_count_ += request.hashes_size();
+		} while (false);
+
+		if (request.hashes_size() > 0) {
+			driver_->SendRequest(peer_id, protocol::OVERLAY_MSGTYPE_GET_TXS, request.SerializeAsString());
+		}
+	}
+
+	void TxRelay::OnReceived(const std::string &hash, std::set<int64_t> &announcers) {
+		utils::MutexGuard guard(lock_);
+		std::map<std::string, Request>::iterator iter = requests_.find(hash);
+		if (iter == requests_.end()) {
+			Request &item = requests_[hash];
+			item.peer_id_ = 0;
+			item.time_ = utils::Timestamp::HighResolution();
+			return;
+		}
+
+		iter->second.peer_id_ = 0;
+		announcers = iter->second.announcers_;
+	}
+
+	void TxRelay::OnDuplicate() {
+		utils::MutexGuard guard(lock_);
+		duplicate_count_++;
+	}
+
+	void TxRelay::GetBodies(const protocol::TransactionInv &request, std::vector<std::string> &bodies) {
+		utils::MutexGuard guard(lock_);
+		for (int32_t i = 0; i < request.hashes_size(); i++) {
+			std::map<std::string, Body>::const_iterator iter = bodies_.find(request.hashes(i));
+			if (iter != bodies_.end()) {
+				bodies.push_back(iter->second.data_);
+				bytes_saved_ -= (int64_t)iter->second.data_.size();
+				served_count_++;
+			}
+		}
+	}
+
+	void TxRelay::OnTimer(int64_t current_time) {
+		std::map<int64_t, std::vector<std::string>> inventories;
+		std::map<int64_t, std::vector<std::string>> retries;
+		do {
+			utils::MutexGuard guard(lock_);
+			inventories.swap(announcements_);
+			for (auto iter = inventories.begin(); iter != inventories.end(); iter++) {
+				inv_sent_count_ += iter->second.size();
+			}
+
+			for (auto iter = bodies_.begin(); iter != bodies_.end();) {
+				if (iter->second.time_ + RELAY_KEEP_TIME < current_time) {
+					bodies_.erase(iter++);
+				}
+				else {
+					iter++;
+				}
+			}
+
+			//Ask the next announcer for a body the requested peer did not send
+			for (auto iter = requests_.begin(); iter != requests_.end();) {
+				Request &item = iter->second;
+				if (item.peer_id_ == 0 || item.time_ + RELAY_REQUEST_TIMEOUT >= current_time) {
+					if (item.time_ + RELAY_KEEP_TIME < current_time) {
+						requests_.erase(iter++);
+					}
+					else {
+						iter++;
+					}
+					continue;
+				}
+
+				item.announcers_.erase(item.peer_id_);
+				if (item.announcers_.empty()) {
+					requests_.erase(iter++);
+					continue;
+				}
+
+				item.peer_id_ = *item.announcers_.begin();
+				item.time_ = current_time;
+				retries[item.peer_id_].push_back(iter->first);
+				requested_count_++;
+				iter++;
+			}
+		} while (false);
+
+		SendInventories(inventories, protocol::OVERLAY_MSGTYPE_TX_INV);
+		SendInventories(retries, protocol::OVERLAY_MSGTYPE_GET_TXS);
+	}
+
+	void TxRelay::SendInventories(std::map<int64_t, std::vector<std::string>> &inventories, int64_t type) {
+		for (auto iter = inventories.begin(); iter != inventories.end(); iter++) {
+			const std::vector<std::string> &hashes = iter->second;
+			for (size_t begin = 0; begin < hashes.size(); begin += RELAY_INV_LIMIT) {
+				protocol::TransactionInv inv;
+				for (size_t i = begin; i < hashes.size() && i < begin + RELAY_INV_LIMIT; i++) {
+					inv.add_hashes(hashes[i]);
+				}
+				driver_->SendRequest(iter->first, type, inv.SerializeAsString());
+			}
+		}
+	}
+
+	void TxRelay::GetModuleStatus(Json::Value &data) {
+		utils::MutexGuard guard(lock_);
+		data["enabled"] = enabled_;
+		data["inv_sent_count"] = (Json::Int64)inv_sent_count_;
+		data["inv_received_count"] = (Json::Int64)inv_received_count_;
+		data["inv_duplicate_count"] = (Json::Int64)inv_duplicate_count_;
+		data["requested_count"] = (Json::Int64)requested_count_;
+		data["served_count"] = (Json::Int64)served_count_;
+		data["duplicate_count"] = (Json::Int64)duplicate_count_;
+		data["bytes_saved"] = (Json::Int64)bytes_saved_;
+		data["body_cache_size"] = (Json::UInt64)bodies_.size();
+		data["request_size"] = (Json::UInt64)requests_.size();
+	}
+}
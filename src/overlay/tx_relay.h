@@ -0,0 +1,74 @@
+#ifndef TX_RELAY_H_
+#define TX_RELAY_H_
+
+#include <utils/headers.h>
+#include <json/value.h>
+#include <common/general.h>
+#include <proto/cpp/overlay.pb.h>
+#include "broadcast.h"
+
+namespace rexx {
+
+	//Relays transactions by inventory. A transaction broadcast to a peer supporting it is announced by the hash
+	//of its envelope, the announcements to a peer are batched on a short timer, and the peer requests only the
+	//bodies it does not know. A body requested from a peer which does not answer is requested from the next
+	//peer which announced it.
+	class TxRelay : public TimerNotify {
+	public:
+		TxRelay(IBroadcastDriver *driver);
+		~TxRelay();
+
+		//interval is the batching window of the announcements in milliseconds
+		bool Initialize(bool enabled, int64_t interval);
+		bool IsEnabled() const;
+
+		//Queue the announcement of a transaction to a peer, and keep the body to serve the request
+		void Announce(int64_t peer_id, const std::string &hash, const std::string &data);
+
+		//Request the announced transactions which are neither known nor requested from another peer
+		void OnInventory(int64_t peer_id, const protocol::TransactionInv &inv, const std::function<bool(const std::string &hash)> &is_known);
+
+		//A transaction body arrived, the peers which announced it are returned as they already have it
+		void OnReceived(const std::string &hash, std::set<int64_t> &announcers);
+		void OnDuplicate();
+
+		//The bodies kept for the requested hashes
+		void GetBodies(const protocol::TransactionInv &request, std::vector<std::string> &bodies);
+
+		virtual void OnTimer(int64_t current_time) override;
+		virtual void OnSlowTimer(int64_t current_time) override {};
+		void GetModuleStatus(Json::Value &data);
+
+	private:
+		struct Body {
+			std::string data_;
+			int64_t time_;
+		};
+
+		struct Request {
+			std::set<int64_t> announcers_;
+			int64_t peer_id_; //the peer the body is requested from, 0 once it is received
+			int64_t time_;
+		};
+
+		void SendInventories(std::map<int64_t, std::vector<std::string>> &inventories, int64_t type);
+
+		IBroadcastDriver *driver_;
+		bool enabled_;
+
+		utils::Mutex lock_;
+		std::map<int64_t, std::vector<std::string>> announcements_; //by peer
+		std::map<std::string, Body> bodies_; //announced bodies by hash
+		std::map<std::string, Request> requests_; //announced to this node by hash
+
+		int64_t inv_sent_count_;
+		int64_t inv_received_count_;
+		int64_t inv_duplicate_count_;
+		int64_t requested_count_;
+		int64_t served_count_;
+		int64_t duplicate_count_;
+		int64_t bytes_saved_;
+	};
+}
+
+#endif
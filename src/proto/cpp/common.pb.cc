@@ -32,6 +32,9 @@ const ::google::protobuf::internal::GeneratedMessageReflection*
 const ::google::protobuf::Descriptor* WsMessage_descriptor_ = NULL;
 const ::google::protobuf::internal::GeneratedMessageReflection*
   WsMessage_reflection_ = NULL;
+const ::google::protobuf::Descriptor* WsMessageBatch_descriptor_ = NULL;
+const ::google::protobuf::internal::GeneratedMessageReflection*
+  WsMessageBatch_reflection_ = NULL;
 const ::google::protobuf::Descriptor* Ping_descriptor_ = NULL;
 const ::google::protobuf::internal::GeneratedMessageReflection*
   Ping_reflection_ = NULL;
@@ -100,11 +103,14 @@ void protobuf_AssignDesc_common_2eproto() {
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(LedgerUpgrade, _internal_metadata_),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(LedgerUpgrade, _is_default_instance_));
   WsMessage_descriptor_ = file->message_type(3);
-  static const int WsMessage_offsets_[4] = {
+  static const int WsMessage_offsets_[7] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WsMessage, type_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WsMessage, request_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WsMessage, sequence_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WsMessage, data_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WsMessage, compression_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WsMessage, raw_size_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WsMessage, batch_),
   };
   WsMessage_reflection_ =
     ::google::protobuf::internal::GeneratedMessageReflection::NewGeneratedMessageReflection(
@@ -117,7 +123,22 @@ void protobuf_AssignDesc_common_2eproto() {
       sizeof(WsMessage),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WsMessage, _internal_metadata_),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WsMessage, _is_default_instance_));
-  Ping_descriptor_ = file->message_type(4);
+  WsMessageBatch_descriptor_ = file->message_type(4);
+  static const int WsMessageBatch_offsets_[1] = {
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WsMessageBatch, messages_),
+  };
+  WsMessageBatch_reflection_ =
+    ::google::protobuf::internal::GeneratedMessageReflection::NewGeneratedMessageReflection(
+      WsMessageBatch_descriptor_,
+      WsMessageBatch::default_instance_,
+      WsMessageBatch_offsets_,
+      -1,
+      -1,
+      -1,
+      sizeof(WsMessageBatch),
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WsMessageBatch, _internal_metadata_),
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(WsMessageBatch, _is_default_instance_));
+  Ping_descriptor_ = file->message_type(5);
   static const int Ping_offsets_[1] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Ping, nonce_),
   };
@@ -132,7 +153,7 @@ void protobuf_AssignDesc_common_2eproto() {
       sizeof(Ping),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Ping, _internal_metadata_),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Ping, _is_default_instance_));
-  Pong_descriptor_ = file->message_type(5);
+  Pong_descriptor_ = file->message_type(6);
   static const int Pong_offsets_[1] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Pong, nonce_),
   };
@@ -169,6 +190,8 @@ void protobuf_RegisterTypes(const ::std::string&) {
       LedgerUpgrade_descriptor_, &LedgerUpgrade::default_instance());
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
       WsMessage_descriptor_, &WsMessage::default_instance());
+  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
+      WsMessageBatch_descriptor_, &WsMessageBatch::default_instance());
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
       Ping_descriptor_, &Ping::default_instance());
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
@@ -186,6 +209,8 @@ void protobuf_ShutdownFile_common_2eproto() {
   delete LedgerUpgrade_reflection_;
   delete WsMessage::default_instance_;
   delete WsMessage_reflection_;
+  delete WsMessageBatch::default_instance_;
+  delete WsMessageBatch_reflection_;
   delete Ping::default_instance_;
   delete Ping_reflection_;
   delete Pong::default_instance_;
@@ -205,53 +230,58 @@ void protobuf_AddDesc_common_2eproto() {
     "\"2\n\tSignature\022\022\n\npublic_key\030\001 \001(\t\022\021\n\tsig"
     "n_data\030\002 \001(\014\"B\n\rLedgerUpgrade\022\032\n\022new_led"
     "ger_version\030\001 \001(\003\022\025\n\rnew_validator\030\002 \001(\t"
-    "\"J\n\tWsMessage\022\014\n\004type\030\001 \001(\003\022\017\n\007request\030\002"
-    " \001(\010\022\020\n\010sequence\030\003 \001(\003\022\014\n\004data\030\004 \001(\014\"\025\n\004"
-    "Ping\022\r\n\005nonce\030\001 \001(\003\"\025\n\004Pong\022\r\n\005nonce\030\001 \001"
-    "(\003*\317\t\n\tERRORCODE\022\023\n\017ERRCODE_SUCCESS\020\000\022\032\n"
-    "\026ERRCODE_INTERNAL_ERROR\020\001\022\035\n\031ERRCODE_INV"
-    "ALID_PARAMETER\020\002\022\031\n\025ERRCODE_ALREADY_EXIS"
-    "T\020\003\022\025\n\021ERRCODE_NOT_EXIST\020\004\022\026\n\022ERRCODE_TX"
-    "_TIMEOUT\020\005\022\031\n\025ERRCODE_ACCESS_DENIED\020\006\022\031\n"
-    "\025ERRCODE_MATH_OVERFLOW\020\007\022\'\n#ERRCODE_EXPR"
-    "_CONDITION_RESULT_FALSE\020\024\022\'\n#ERRCODE_EXP"
-    "R_CONDITION_SYNTAX_ERROR\020\025\022\032\n\026ERRCODE_IN"
-    "VALID_PUBKEY\020Z\022\032\n\026ERRCODE_INVALID_PRIKEY"
-    "\020[\022\031\n\025ERRCODE_ASSET_INVALID\020\\\022\035\n\031ERRCODE"
-    "_INVALID_SIGNATURE\020]\022\033\n\027ERRCODE_INVALID_"
-    "ADDRESS\020^\022\036\n\032ERRCODE_MISSING_OPERATIONS\020"
-    "a\022\037\n\033ERRCODE_TOO_MANY_OPERATIONS\020b\022\030\n\024ER"
-    "RCODE_BAD_SEQUENCE\020c\022\037\n\033ERRCODE_ACCOUNT_"
-    "LOW_RESERVE\020d\022$\n ERRCODE_ACCOUNT_SOURCED"
-    "EST_EQUAL\020e\022\036\n\032ERRCODE_ACCOUNT_DEST_EXIS"
-    "T\020f\022\035\n\031ERRCODE_ACCOUNT_NOT_EXIST\020g\022%\n!ER"
-    "RCODE_ACCOUNT_ASSET_LOW_RESERVE\020h\022*\n&ERR"
-    "CODE_ACCOUNT_ASSET_AMOUNT_TOO_LARGE\020i\022$\n"
-    " ERRCODE_ACCOUNT_INIT_LOW_RESERVE\020j\022\032\n\026E"
-    "RRCODE_FEE_NOT_ENOUGH\020o\022\027\n\023ERRCODE_FEE_I"
-    "NVALID\020p\022\032\n\026ERRCODE_OUT_OF_TXCACHE\020r\022\034\n\030"
-    "ERRCODE_WEIGHT_NOT_VALID\020x\022\037\n\033ERRCODE_TH"
-    "RESHOLD_NOT_VALID\020y\022 \n\033ERRCODE_INVALID_D"
-    "ATAVERSION\020\220\001\022\034\n\027ERRCODE_TX_SIZE_TOO_BIG"
-    "\020\222\001\022\"\n\035ERRCODE_CONTRACT_EXECUTE_FAIL\020\227\001\022"
-    "\"\n\035ERRCODE_CONTRACT_SYNTAX_ERROR\020\230\001\022(\n#E"
-    "RRCODE_CONTRACT_TOO_MANY_RECURSION\020\231\001\022+\n"
-    "&ERRCODE_CONTRACT_TOO_MANY_TRANSACTIONS\020"
-    "\232\001\022%\n ERRCODE_CONTRACT_EXECUTE_EXPIRED\020\233"
-    "\001\022!\n\034ERRCODE_TX_INSERT_QUEUE_FAIL\020\240\001B\"\n "
-    "io.rexx.sdk.core.extend.protobufb\006proto3", 1600);
+    "\"\200\001\n\tWsMessage\022\014\n\004type\030\001 \001(\003\022\017\n\007request\030"
+    "\002 \001(\010\022\020\n\010sequence\030\003 \001(\003\022\014\n\004data\030\004 \001(\014\022\023\n"
+    "\013compression\030\005 \001(\003\022\020\n\010raw_size\030\006 \001(\003\022\r\n\005"
+    "batch\030\007 \001(\010\"7\n\016WsMessageBatch\022%\n\010message"
+    "s\030\001 \003(\0132\023.protocol.WsMessage\"\025\n\004Ping\022\r\n\005"
+    "nonce\030\001 \001(\003\"\025\n\004Pong\022\r\n\005nonce\030\001 \001(\003*\317\t\n\tE"
+    "RRORCODE\022\023\n\017ERRCODE_SUCCESS\020\000\022\032\n\026ERRCODE"
+    "_INTERNAL_ERROR\020\001\022\035\n\031ERRCODE_INVALID_PAR"
+    "AMETER\020\002\022\031\n\025ERRCODE_ALREADY_EXIST\020\003\022\025\n\021E"
+    "RRCODE_NOT_EXIST\020\004\022\026\n\022ERRCODE_TX_TIMEOUT"
+    "\020\005\022\031\n\025ERRCODE_ACCESS_DENIED\020\006\022\031\n\025ERRCODE"
+    "_MATH_OVERFLOW\020\007\022\'\n#ERRCODE_EXPR_CONDITI"
+    "ON_RESULT_FALSE\020\024\022\'\n#ERRCODE_EXPR_CONDIT"
+    "ION_SYNTAX_ERROR\020\025\022\032\n\026ERRCODE_INVALID_PU"
+    "BKEY\020Z\022\032\n\026ERRCODE_INVALID_PRIKEY\020[\022\031\n\025ER"
+    "RCODE_ASSET_INVALID\020\\\022\035\n\031ERRCODE_INVALID"
+    "_SIGNATURE\020]\022\033\n\027ERRCODE_INVALID_ADDRESS\020"
+    "^\022\036\n\032ERRCODE_MISSING_OPERATIONS\020a\022\037\n\033ERR"
+    "CODE_TOO_MANY_OPERATIONS\020b\022\030\n\024ERRCODE_BA"
+    "D_SEQUENCE\020c\022\037\n\033ERRCODE_ACCOUNT_LOW_RESE"
+    "RVE\020d\022$\n ERRCODE_ACCOUNT_SOURCEDEST_EQUA"
+    "L\020e\022\036\n\032ERRCODE_ACCOUNT_DEST_EXIST\020f\022\035\n\031E"
+    "RRCODE_ACCOUNT_NOT_EXIST\020g\022%\n!ERRCODE_AC"
+    "COUNT_ASSET_LOW_RESERVE\020h\022*\n&ERRCODE_ACC"
+    "OUNT_ASSET_AMOUNT_TOO_LARGE\020i\022$\n ERRCODE"
+    "_ACCOUNT_INIT_LOW_RESERVE\020j\022\032\n\026ERRCODE_F"
+    "EE_NOT_ENOUGH\020o\022\027\n\023ERRCODE_FEE_INVALID\020p"
+    "\022\032\n\026ERRCODE_OUT_OF_TXCACHE\020r\022\034\n\030ERRCODE_"
+    "WEIGHT_NOT_VALID\020x\022\037\n\033ERRCODE_THRESHOLD_"
+    "NOT_VALID\020y\022 \n\033ERRCODE_INVALID_DATAVERSI"
+    "ON\020\220\001\022\034\n\027ERRCODE_TX_SIZE_TOO_BIG\020\222\001\022\"\n\035E"
+    "RRCODE_CONTRACT_EXECUTE_FAIL\020\227\001\022\"\n\035ERRCO"
+    "DE_CONTRACT_SYNTAX_ERROR\020\230\001\022(\n#ERRCODE_C"
+    "ONTRACT_TOO_MANY_RECURSION\020\231\001\022+\n&ERRCODE"
+    "_CONTRACT_TOO_MANY_TRANSACTIONS\020\232\001\022%\n ER"
+    "RCODE_CONTRACT_EXECUTE_EXPIRED\020\233\001\022!\n\034ERR"
+    "CODE_TX_INSERT_QUEUE_FAIL\020\240\001B\"\n io.rexx."
+    "sdk.core.extend.protobufb\006proto3", 1712);
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedFile(
     "common.proto", &protobuf_RegisterTypes);
   KeyPair::default_instance_ = new KeyPair();
   Signature::default_instance_ = new Signature();
   LedgerUpgrade::default_instance_ = new LedgerUpgrade();
   WsMessage::default_instance_ = new WsMessage();
+  WsMessageBatch::default_instance_ = new WsMessageBatch();
   Ping::default_instance_ = new Ping();
   Pong::default_instance_ = new Pong();
   KeyPair::default_instance_->InitAsDefaultInstance();
   Signature::default_instance_->InitAsDefaultInstance();
   LedgerUpgrade::default_instance_->InitAsDefaultInstance();
   WsMessage::default_instance_->InitAsDefaultInstance();
+  WsMessageBatch::default_instance_->InitAsDefaultInstance();
   Ping::default_instance_->InitAsDefaultInstance();
   Pong::default_instance_->InitAsDefaultInstance();
   ::google::protobuf::internal::OnShutdown(&protobuf_ShutdownFile_common_2eproto);
@@ -1463,6 +1493,9 @@ const int WsMessage::kTypeFieldNumber;
 const int WsMessage::kRequestFieldNumber;
 const int WsMessage::kSequenceFieldNumber;
 const int WsMessage::kDataFieldNumber;
+const int WsMessage::kCompressionFieldNumber;
+const int WsMessage::kRawSizeFieldNumber;
+const int WsMessage::kBatchFieldNumber;
 #endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
 
 WsMessage::WsMessage()
@@ -1491,6 +1524,9 @@ void WsMessage::SharedCtor() {
   request_ = false;
   sequence_ = GOOGLE_LONGLONG(0);
   data_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  compression_ = GOOGLE_LONGLONG(0);
+  raw_size_ = GOOGLE_LONGLONG(0);
+  batch_ = false;
 }
 
 WsMessage::~WsMessage() {
@@ -1548,7 +1584,7 @@ void WsMessage::Clear() {
 } while (0)
 
   ZR_(type_, sequence_);
-  request_ = false;
+  ZR_(compression_, batch_);
   data_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
 
 #undef ZR_HELPER_
@@ -1619,6 +1655,51 @@ bool WsMessage::MergePartialFromCodedStream(
         } else {
           goto handle_unusual;
         }
+        if (input->ExpectTag(40)) goto parse_compression;
+        break;
+      }
+
+      // optional int64 compression = 5;
+      case 5: {
+        if (tag == 40) {
+         parse_compression:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::int64, ::google::protobuf::internal::WireFormatLite::TYPE_INT64>(
+                 input, &compression_)));
+
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(48)) goto parse_raw_size;
+        break;
+      }
+
+      // optional int64 raw_size = 6;
+      case 6: {
+        if (tag == 48) {
+         parse_raw_size:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::int64, ::google::protobuf::internal::WireFormatLite::TYPE_INT64>(
+                 input, &raw_size_)));
+
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(56)) goto parse_batch;
+        break;
+      }
+
+      // optional bool batch = 7;
+      case 7: {
+        if (tag == 56) {
+         parse_batch:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   bool, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL>(
+                 input, &batch_)));
+
+        } else {
+          goto handle_unusual;
+        }
         if (input->ExpectAtEnd()) goto success;
         break;
       }
@@ -1668,6 +1749,21 @@ void WsMessage::SerializeWithCachedSizes(
       4, this->data(), output);
   }
 
+  // optional int64 compression = 5;
+  if (this->compression() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteInt64(5, this->compression(), output);
+  }
+
+  // optional int64 raw_size = 6;
+  if (this->raw_size() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteInt64(6, this->raw_size(), output);
+  }
+
+  // optional bool batch = 7;
+  if (this->batch() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteBool(7, this->batch(), output);
+  }
+
   // @@protoc_insertion_point(serialize_end:protocol.WsMessage)
 }
 
@@ -1696,6 +1792,21 @@ void WsMessage::SerializeWithCachedSizes(
         4, this->data(), target);
   }
 
+  // optional int64 compression = 5;
+  if (this->compression() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteInt64ToArray(5, this->compression(), target);
+  }
+
+  // optional int64 raw_size = 6;
+  if (this->raw_size() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteInt64ToArray(6, this->raw_size(), target);
+  }
+
+  // optional bool batch = 7;
+  if (this->batch() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteBoolToArray(7, this->batch(), target);
+  }
+
   // @@protoc_insertion_point(serialize_to_array_end:protocol.WsMessage)
   return target;
 }
@@ -1730,6 +1841,25 @@ int WsMessage::ByteSize() const {
         this->data());
   }
 
+  // optional int64 compression = 5;
+  if (this->compression() != 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::Int64Size(
+        this->compression());
+  }
+
+  // optional int64 raw_size = 6;
+  if (this->raw_size() != 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::Int64Size(
+        this->raw_size());
+  }
+
+  // optional bool batch = 7;
+  if (this->batch() != 0) {
+    total_size += 1 + 1;
+  }
+
   GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
   _cached_size_ = total_size;
   GOOGLE_SAFE_CONCURRENT_WRITES_END();
@@ -1771,6 +1901,15 @@ void WsMessage::MergeFrom(const WsMessage& from) {
 
     data_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.data_);
   }
+  if (from.compression() != 0) {
+    set_compression(from.compression());
+  }
+  if (from.raw_size() != 0) {
+    set_raw_size(from.raw_size());
+  }
+  if (from.batch() != 0) {
+    set_batch(from.batch());
+  }
 }
 
 void WsMessage::CopyFrom(const ::google::protobuf::Message& from) {
@@ -1801,6 +1940,9 @@ void WsMessage::InternalSwap(WsMessage* other) {
   std::swap(request_, other->request_);
   std::swap(sequence_, other->sequence_);
   data_.Swap(&other->data_);
+  std::swap(compression_, other->compression_);
+  std::swap(raw_size_, other->raw_size_);
+  std::swap(batch_, other->batch_);
   _internal_metadata_.Swap(&other->_internal_metadata_);
   std::swap(_cached_size_, other->_cached_size_);
 }
@@ -1902,6 +2044,305 @@ void WsMessage::clear_data() {
   // @@protoc_insertion_point(field_set_allocated:protocol.WsMessage.data)
 }
 
+// optional int64 compression = 5;
+void WsMessage::clear_compression() {
+  compression_ = GOOGLE_LONGLONG(0);
+}
+ ::google::protobuf::int64 WsMessage::compression() const {
+  // @@protoc_insertion_point(field_get:protocol.WsMessage.compression)
+  return compression_;
+}
+ void WsMessage::set_compression(::google::protobuf::int64 value) {
+  
+  compression_ = value;
+  // @@protoc_insertion_point(field_set:protocol.WsMessage.compression)
+}
+
+// optional int64 raw_size = 6;
+void WsMessage::clear_raw_size() {
+  raw_size_ = GOOGLE_LONGLONG(0);
+}
+ ::google::protobuf::int64 WsMessage::raw_size() const {
+  // @@protoc_insertion_point(field_get:protocol.WsMessage.raw_size)
+  return raw_size_;
+}
+ void WsMessage::set_raw_size(::google::protobuf::int64 value) {
+  
+  raw_size_ = value;
+  // @@protoc_insertion_point(field_set:protocol.WsMessage.raw_size)
+}
+
+// optional bool batch = 7;
+void WsMessage::clear_batch() {
+  batch_ = false;
+}
+ bool WsMessage::batch() const {
+  // @@protoc_insertion_point(field_get:protocol.WsMessage.batch)
+  return batch_;
+}
+ void WsMessage::set_batch(bool value) {
+  
+  batch_ = value;
+  // @@protoc_insertion_point(field_set:protocol.WsMessage.batch)
+}
+
+#endif  // PROTOBUF_INLINE_NOT_IN_HEADERS
+
+// ===================================================================
+
+#if !defined(_MSC_VER) || _MSC_VER >= 1900
+const int WsMessageBatch::kMessagesFieldNumber;
+#endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
+
+WsMessageBatch::WsMessageBatch()
+  : ::google::protobuf::Message(), _internal_metadata_(NULL) {
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:protocol.WsMessageBatch)
+}
+
+void WsMessageBatch::InitAsDefaultInstance() {
+  _is_default_instance_ = true;
+}
+
+WsMessageBatch::WsMessageBatch(const WsMessageBatch& from)
+  : ::google::protobuf::Message(),
+    _internal_metadata_(NULL) {
+  SharedCtor();
+  MergeFrom(from);
+  // @@protoc_insertion_point(copy_constructor:protocol.WsMessageBatch)
+}
+
+void WsMessageBatch::SharedCtor() {
+    _is_default_instance_ = false;
+  _cached_size_ = 0;
+}
+
+WsMessageBatch::~WsMessageBatch() {
+  // @@protoc_insertion_point(destructor:protocol.WsMessageBatch)
+  SharedDtor();
+}
+
+void WsMessageBatch::SharedDtor() {
+  if (this != default_instance_) {
+  }
+}
+
+void WsMessageBatch::SetCachedSize(int size) const {
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+}
+const ::google::protobuf::Descriptor* WsMessageBatch::descriptor() {
+  protobuf_AssignDescriptorsOnce();
+  return WsMessageBatch_descriptor_;
+}
+
+const WsMessageBatch& WsMessageBatch::default_instance() {
+  if (default_instance_ == NULL) protobuf_AddDesc_common_2eproto();
+  return *default_instance_;
+}
+
+WsMessageBatch* WsMessageBatch::default_instance_ = NULL;
+
+WsMessageBatch* WsMessageBatch::New(::google::protobuf::Arena* arena) const {
+  WsMessageBatch* n = new WsMessageBatch;
+  if (arena != NULL) {
+    arena->Own(n);
+  }
+  return n;
+}
+
+void WsMessageBatch::Clear() {
+// @@protoc_insertion_point(message_clear_start:protocol.WsMessageBatch)
+  messages_.Clear();
+}
+
+bool WsMessageBatch::MergePartialFromCodedStream(
+    ::google::protobuf::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!GOOGLE_PREDICT_TRUE(EXPRESSION)) goto failure
+  ::google::protobuf::uint32 tag;
+  // @@protoc_insertion_point(parse_start:protocol.WsMessageBatch)
+  for (;;) {
+    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
+    tag = p.first;
+    if (!p.second) goto handle_unusual;
+    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // repeated .protocol.WsMessage messages = 1;
+      case 1: {
+        if (tag == 10) {
+          DO_(input->IncrementRecursionDepth());
+         parse_loop_messages:
+          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtualNoRecursionDepth(
+                input, add_messages()));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(10)) goto parse_loop_messages;
+        input->UnsafeDecrementRecursionDepth();
+        if (input->ExpectAtEnd()) goto success;
+        break;
+      }
+
+      default: {
+      handle_unusual:
+        if (tag == 0 ||
+            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
+          goto success;
+        }
+        DO_(::google::protobuf::internal::WireFormatLite::SkipField(input, tag));
+        break;
+      }
+    }
+  }
+success:
+  // @@protoc_insertion_point(parse_success:protocol.WsMessageBatch)
+  return true;
+failure:
+  // @@protoc_insertion_point(parse_failure:protocol.WsMessageBatch)
+  return false;
+#undef DO_
+}
+
+void WsMessageBatch::SerializeWithCachedSizes(
+    ::google::protobuf::io::CodedOutputStream* output) const {
+  // @@protoc_insertion_point(serialize_start:protocol.WsMessageBatch)
+  // repeated .protocol.WsMessage messages = 1;
+  for (unsigned int i = 0, n = this->messages_size(); i < n; i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
+      1, this->messages(i), output);
+  }
+
+  // @@protoc_insertion_point(serialize_end:protocol.WsMessageBatch)
+}
+
+::google::protobuf::uint8* WsMessageBatch::InternalSerializeWithCachedSizesToArray(
+    bool deterministic, ::google::protobuf::uint8* target) const {
+  // @@protoc_insertion_point(serialize_to_array_start:protocol.WsMessageBatch)
+  // repeated .protocol.WsMessage messages = 1;
+  for (unsigned int i = 0, n = this->messages_size(); i < n; i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      InternalWriteMessageNoVirtualToArray(
+        1, this->messages(i), false, target);
+  }
+
+  // @@protoc_insertion_point(serialize_to_array_end:protocol.WsMessageBatch)
+  return target;
+}
+
+int WsMessageBatch::ByteSize() const {
+// @@protoc_insertion_point(message_byte_size_start:protocol.WsMessageBatch)
+  int total_size = 0;
+
+  // repeated .protocol.WsMessage messages = 1;
+  total_size += 1 * this->messages_size();
+  for (int i = 0; i < this->messages_size(); i++) {
+    total_size +=
+      ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
+        this->messages(i));
+  }
+
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = total_size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+  return total_size;
+}
+
+void WsMessageBatch::MergeFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:protocol.WsMessageBatch)
+  if (GOOGLE_PREDICT_FALSE(&from == this)) {
+    ::google::protobuf::internal::MergeFromFail(__FILE__, __LINE__);
+  }
+  const WsMessageBatch* source = 
+      ::google::protobuf::internal::DynamicCastToGenerated<const WsMessageBatch>(
+          &from);
+  if (source == NULL) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:protocol.WsMessageBatch)
+    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:protocol.WsMessageBatch)
+    MergeFrom(*source);
+  }
+}
+
+void WsMessageBatch::MergeFrom(const WsMessageBatch& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:protocol.WsMessageBatch)
+  if (GOOGLE_PREDICT_FALSE(&from == this)) {
+    ::google::protobuf::internal::MergeFromFail(__FILE__, __LINE__);
+  }
+  messages_.MergeFrom(from.messages_);
+}
+
+void WsMessageBatch::CopyFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:protocol.WsMessageBatch)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void WsMessageBatch::CopyFrom(const WsMessageBatch& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:protocol.WsMessageBatch)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool WsMessageBatch::IsInitialized() const {
+
+  return true;
+}
+
+void WsMessageBatch::Swap(WsMessageBatch* other) {
+  if (other == this) return;
+  InternalSwap(other);
+}
+void WsMessageBatch::InternalSwap(WsMessageBatch* other) {
+  messages_.UnsafeArenaSwap(&other->messages_);
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+  std::swap(_cached_size_, other->_cached_size_);
+}
+
+::google::protobuf::Metadata WsMessageBatch::GetMetadata() const {
+  protobuf_AssignDescriptorsOnce();
+  ::google::protobuf::Metadata metadata;
+  metadata.descriptor = WsMessageBatch_descriptor_;
+  metadata.reflection = WsMessageBatch_reflection_;
+  return metadata;
+}
+
+#if PROTOBUF_INLINE_NOT_IN_HEADERS
+// WsMessageBatch
+
+// repeated .protocol.WsMessage messages = 1;
+int WsMessageBatch::messages_size() const {
+  return messages_.size();
+}
+void WsMessageBatch::clear_messages() {
+  messages_.Clear();
+}
+const ::protocol::WsMessage& WsMessageBatch::messages(int index) const {
+  // @@protoc_insertion_point(field_get:protocol.WsMessageBatch.messages)
+  return messages_.Get(index);
+}
+::protocol::WsMessage* WsMessageBatch::mutable_messages(int index) {
+  // @@protoc_insertion_point(field_mutable:protocol.WsMessageBatch.messages)
+  return messages_.Mutable(index);
+}
+::protocol::WsMessage* WsMessageBatch::add_messages() {
+  // @@protoc_insertion_point(field_add:protocol.WsMessageBatch.messages)
+  return messages_.Add();
+}
+::google::protobuf::RepeatedPtrField< ::protocol::WsMessage >*
+WsMessageBatch::mutable_messages() {
+  // @@protoc_insertion_point(field_mutable_list:protocol.WsMessageBatch.messages)
+  return &messages_;
+}
+const ::google::protobuf::RepeatedPtrField< ::protocol::WsMessage >&
+WsMessageBatch::messages() const {
+  // @@protoc_insertion_point(field_list:protocol.WsMessageBatch.messages)
+  return messages_;
+}
+
 #endif  // PROTOBUF_INLINE_NOT_IN_HEADERS
 
 // ===================================================================
@@ -42,6 +42,7 @@ class Ping;
 class Pong;
 class Signature;
 class WsMessage;
+class WsMessageBatch;
 
 enum ERRORCODE {
   ERRCODE_SUCCESS = 0,
@@ -490,6 +491,24 @@ class WsMessage : public ::google::protobuf::Message /* @@protoc_insertion_point
   ::std::string* release_data();
   void set_allocated_data(::std::string* data);
 
+  // optional int64 compression = 5;
+  void clear_compression();
+  static const int kCompressionFieldNumber = 5;
+  ::google::protobuf::int64 compression() const;
+  void set_compression(::google::protobuf::int64 value);
+
+  // optional int64 raw_size = 6;
+  void clear_raw_size();
+  static const int kRawSizeFieldNumber = 6;
+  ::google::protobuf::int64 raw_size() const;
+  void set_raw_size(::google::protobuf::int64 value);
+
+  // optional bool batch = 7;
+  void clear_batch();
+  static const int kBatchFieldNumber = 7;
+  bool batch() const;
+  void set_batch(bool value);
+
   // @@protoc_insertion_point(class_scope:protocol.WsMessage)
  private:
 
@@ -498,7 +517,10 @@ class WsMessage : public ::google::protobuf::Message /* @@protoc_insertion_point
   ::google::protobuf::int64 type_;
   ::google::protobuf::int64 sequence_;
   ::google::protobuf::internal::ArenaStringPtr data_;
+  ::google::protobuf::int64 compression_;
+  ::google::protobuf::int64 raw_size_;
   bool request_;
+  bool batch_;
   mutable int _cached_size_;
   friend void  protobuf_AddDesc_common_2eproto();
   friend void protobuf_AssignDesc_common_2eproto();
@@ -509,6 +531,94 @@ class WsMessage : public ::google::protobuf::Message /* @@protoc_insertion_point
 };
 // -------------------------------------------------------------------
 
+class WsMessageBatch : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:protocol.WsMessageBatch) */ {
+ public:
+  WsMessageBatch();
+  virtual ~WsMessageBatch();
+
+  WsMessageBatch(const WsMessageBatch& from);
+
+  inline WsMessageBatch& operator=(const WsMessageBatch& from) {
+    CopyFrom(from);
+    return *this;
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor();
+  static const WsMessageBatch& default_instance();
+
+  void Swap(WsMessageBatch* other);
+
+  // implements Message ----------------------------------------------
+
+  inline WsMessageBatch* New() const { return New(NULL); }
+
+  WsMessageBatch* New(::google::protobuf::Arena* arena) const;
+  void CopyFrom(const ::google::protobuf::Message& from);
+  void MergeFrom(const ::google::protobuf::Message& from);
+  void CopyFrom(const WsMessageBatch& from);
+  void MergeFrom(const WsMessageBatch& from);
+  void Clear();
+  bool IsInitialized() const;
+
+  int ByteSize() const;
+  bool MergePartialFromCodedStream(
+      ::google::protobuf::io::CodedInputStream* input);
+  void SerializeWithCachedSizes(
+      ::google::protobuf::io::CodedOutputStream* output) const;
+  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
+      bool deterministic, ::google::protobuf::uint8* output) const;
+  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const {
+    return InternalSerializeWithCachedSizesToArray(false, output);
+  }
+  int GetCachedSize() const { return _cached_size_; }
+  private:
+  void SharedCtor();
+  void SharedDtor();
+  void SetCachedSize(int size) const;
+  void InternalSwap(WsMessageBatch* other);
+  private:
+  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
+    return _internal_metadata_.arena();
+  }
+  inline void* MaybeArenaPtr() const {
+    return _internal_metadata_.raw_arena_ptr();
+  }
+  public:
+
+  ::google::protobuf::Metadata GetMetadata() const;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // repeated .protocol.WsMessage messages = 1;
+  int messages_size() const;
+  void clear_messages();
+  static const int kMessagesFieldNumber = 1;
+  const ::protocol::WsMessage& messages(int index) const;
+  ::protocol::WsMessage* mutable_messages(int index);
+  ::protocol::WsMessage* add_messages();
+  ::google::protobuf::RepeatedPtrField< ::protocol::WsMessage >*
+      mutable_messages();
+  const ::google::protobuf::RepeatedPtrField< ::protocol::WsMessage >&
+      messages() const;
+
+  // @@protoc_insertion_point(class_scope:protocol.WsMessageBatch)
+ private:
+
+  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
+  bool _is_default_instance_;
+  ::google::protobuf::RepeatedPtrField< ::protocol::WsMessage > messages_;
+  mutable int _cached_size_;
+  friend void  protobuf_AddDesc_common_2eproto();
+  friend void protobuf_AssignDesc_common_2eproto();
+  friend void protobuf_ShutdownFile_common_2eproto();
+
+  void InitAsDefaultInstance();
+  static WsMessageBatch* default_instance_;
+};
+// -------------------------------------------------------------------
+
 class Ping : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:protocol.Ping) */ {
  public:
   Ping();
@@ -1025,6 +1135,82 @@ inline void WsMessage::set_allocated_data(::std::string* data) {
   // @@protoc_insertion_point(field_set_allocated:protocol.WsMessage.data)
 }
 
+// optional int64 compression = 5;
+inline void WsMessage::clear_compression() {
+  compression_ = GOOGLE_LONGLONG(0);
+}
+inline ::google::protobuf::int64 WsMessage::compression() const {
+  // @@protoc_insertion_point(field_get:protocol.WsMessage.compression)
+  return compression_;
+}
+inline void WsMessage::set_compression(::google::protobuf::int64 value) {
+  
+  compression_ = value;
+  // @@protoc_insertion_point(field_set:protocol.WsMessage.compression)
+}
+
+// optional int64 raw_size = 6;
+inline void WsMessage::clear_raw_size() {
+  raw_size_ = GOOGLE_LONGLONG(0);
+}
+inline ::google::protobuf::int64 WsMessage::raw_size() const {
+  // @@protoc_insertion_point(field_get:protocol.WsMessage.raw_size)
+  return raw_size_;
+}
+inline void WsMessage::set_raw_size(::google::protobuf::int64 value) {
+  
+  raw_size_ = value;
+  // @@protoc_insertion_point(field_set:protocol.WsMessage.raw_size)
+}
+
+// optional bool batch = 7;
+inline void WsMessage::clear_batch() {
+  batch_ = false;
+}
+inline bool WsMessage::batch() const {
+  // @@protoc_insertion_point(field_get:protocol.WsMessage.batch)
+  return batch_;
+}
+inline void WsMessage::set_batch(bool value) {
+  
+  batch_ = value;
+  // @@protoc_insertion_point(field_set:protocol.WsMessage.batch)
+}
+
+// -------------------------------------------------------------------
+
+// WsMessageBatch
+
+// repeated .protocol.WsMessage messages = 1;
+inline int WsMessageBatch::messages_size() const {
+  return messages_.size();
+}
+inline void WsMessageBatch::clear_messages() {
+  messages_.Clear();
+}
+inline const ::protocol::WsMessage& WsMessageBatch::messages(int index) const {
+  // @@protoc_insertion_point(field_get:protocol.WsMessageBatch.messages)
+  return messages_.Get(index);
+}
+inline ::protocol::WsMessage* WsMessageBatch::mutable_messages(int index) {
+  // @@protoc_insertion_point(field_mutable:protocol.WsMessageBatch.messages)
+  return messages_.Mutable(index);
+}
+inline ::protocol::WsMessage* WsMessageBatch::add_messages() {
+  // @@protoc_insertion_point(field_add:protocol.WsMessageBatch.messages)
+  return messages_.Add();
+}
+inline ::google::protobuf::RepeatedPtrField< ::protocol::WsMessage >*
+WsMessageBatch::mutable_messages() {
+  // @@protoc_insertion_point(field_mutable_list:protocol.WsMessageBatch.messages)
+  return &messages_;
+}
+inline const ::google::protobuf::RepeatedPtrField< ::protocol::WsMessage >&
+WsMessageBatch::messages() const {
+  // @@protoc_insertion_point(field_list:protocol.WsMessageBatch.messages)
+  return messages_;
+}
+
 // -------------------------------------------------------------------
 
 // Ping
@@ -1072,6 +1258,8 @@ inline void Pong::set_nonce(::google::protobuf::int64 value) {
 
 // -------------------------------------------------------------------
 
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
@@ -45,6 +45,18 @@ const ::google::protobuf::internal::GeneratedMessageReflection*
 const ::google::protobuf::Descriptor* LedgerUpgradeNotify_descriptor_ = NULL;
 const ::google::protobuf::internal::GeneratedMessageReflection*
   LedgerUpgradeNotify_reflection_ = NULL;
+const ::google::protobuf::Descriptor* PbftCompactEnv_descriptor_ = NULL;
+const ::google::protobuf::internal::GeneratedMessageReflection*
+  PbftCompactEnv_reflection_ = NULL;
+const ::google::protobuf::Descriptor* GetPbftTxs_descriptor_ = NULL;
+const ::google::protobuf::internal::GeneratedMessageReflection*
+  GetPbftTxs_reflection_ = NULL;
+const ::google::protobuf::Descriptor* PbftTxs_descriptor_ = NULL;
+const ::google::protobuf::internal::GeneratedMessageReflection*
+  PbftTxs_reflection_ = NULL;
+const ::google::protobuf::Descriptor* TransactionInv_descriptor_ = NULL;
+const ::google::protobuf::internal::GeneratedMessageReflection*
+  TransactionInv_reflection_ = NULL;
 const ::google::protobuf::Descriptor* EntryList_descriptor_ = NULL;
 const ::google::protobuf::internal::GeneratedMessageReflection*
   EntryList_reflection_ = NULL;
@@ -81,7 +93,7 @@ void protobuf_AssignDesc_overlay_2eproto() {
       "overlay.proto");
   GOOGLE_CHECK(file != NULL);
   Hello_descriptor_ = file->message_type(0);
-  static const int Hello_offsets_[7] = {
+  static const int Hello_offsets_[9] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Hello, network_id_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Hello, ledger_version_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Hello, overlay_version_),
@@ -89,6 +101,8 @@ void protobuf_AssignDesc_overlay_2eproto() {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Hello, listening_port_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Hello, node_address_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Hello, node_rand_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Hello, compression_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Hello, batch_),
   };
   Hello_reflection_ =
     ::google::protobuf::internal::GeneratedMessageReflection::NewGeneratedMessageReflection(
@@ -221,7 +235,71 @@ void protobuf_AssignDesc_overlay_2eproto() {
       sizeof(LedgerUpgradeNotify),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(LedgerUpgradeNotify, _internal_metadata_),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(LedgerUpgradeNotify, _is_default_instance_));
-  EntryList_descriptor_ = file->message_type(8);
+  PbftCompactEnv_descriptor_ = file->message_type(8);
+  static const int PbftCompactEnv_offsets_[2] = {
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PbftCompactEnv, env_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PbftCompactEnv, tx_hashes_),
+  };
+  PbftCompactEnv_reflection_ =
+    ::google::protobuf::internal::GeneratedMessageReflection::NewGeneratedMessageReflection(
+      PbftCompactEnv_descriptor_,
+      PbftCompactEnv::default_instance_,
+      PbftCompactEnv_offsets_,
+      -1,
+      -1,
+      -1,
+      sizeof(PbftCompactEnv),
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PbftCompactEnv, _internal_metadata_),
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PbftCompactEnv, _is_default_instance_));
+  GetPbftTxs_descriptor_ = file->message_type(9);
+  static const int GetPbftTxs_offsets_[2] = {
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(GetPbftTxs, value_digest_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(GetPbftTxs, indexes_),
+  };
+  GetPbftTxs_reflection_ =
+    ::google::protobuf::internal::GeneratedMessageReflection::NewGeneratedMessageReflection(
+      GetPbftTxs_descriptor_,
+      GetPbftTxs::default_instance_,
+      GetPbftTxs_offsets_,
+      -1,
+      -1,
+      -1,
+      sizeof(GetPbftTxs),
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(GetPbftTxs, _internal_metadata_),
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(GetPbftTxs, _is_default_instance_));
+  PbftTxs_descriptor_ = file->message_type(10);
+  static const int PbftTxs_offsets_[3] = {
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PbftTxs, value_digest_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PbftTxs, indexes_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PbftTxs, txs_),
+  };
+  PbftTxs_reflection_ =
+    ::google::protobuf::internal::GeneratedMessageReflection::NewGeneratedMessageReflection(
+      PbftTxs_descriptor_,
+      PbftTxs::default_instance_,
+      PbftTxs_offsets_,
+      -1,
+      -1,
+      -1,
+      sizeof(PbftTxs),
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PbftTxs, _internal_metadata_),
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PbftTxs, _is_default_instance_));
+  TransactionInv_descriptor_ = file->message_type(11);
+  static const int TransactionInv_offsets_[1] = {
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TransactionInv, hashes_),
+  };
+  TransactionInv_reflection_ =
+    ::google::protobuf::internal::GeneratedMessageReflection::NewGeneratedMessageReflection(
+      TransactionInv_descriptor_,
+      TransactionInv::default_instance_,
+      TransactionInv_offsets_,
+      -1,
+      -1,
+      -1,
+      sizeof(TransactionInv),
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TransactionInv, _internal_metadata_),
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TransactionInv, _is_default_instance_));
+  EntryList_descriptor_ = file->message_type(12);
   static const int EntryList_offsets_[1] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(EntryList, entry_),
   };
@@ -236,7 +314,7 @@ void protobuf_AssignDesc_overlay_2eproto() {
       sizeof(EntryList),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(EntryList, _internal_metadata_),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(EntryList, _is_default_instance_));
-  ChainHello_descriptor_ = file->message_type(9);
+  ChainHello_descriptor_ = file->message_type(13);
   static const int ChainHello_offsets_[2] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainHello, api_list_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainHello, timestamp_),
@@ -252,7 +330,7 @@ void protobuf_AssignDesc_overlay_2eproto() {
       sizeof(ChainHello),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainHello, _internal_metadata_),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainHello, _is_default_instance_));
-  ChainStatus_descriptor_ = file->message_type(10);
+  ChainStatus_descriptor_ = file->message_type(14);
   static const int ChainStatus_offsets_[5] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainStatus, self_addr_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainStatus, ledger_version_),
@@ -271,7 +349,7 @@ void protobuf_AssignDesc_overlay_2eproto() {
       sizeof(ChainStatus),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainStatus, _internal_metadata_),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainStatus, _is_default_instance_));
-  ChainPeerMessage_descriptor_ = file->message_type(11);
+  ChainPeerMessage_descriptor_ = file->message_type(15);
   static const int ChainPeerMessage_offsets_[3] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainPeerMessage, src_peer_addr_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainPeerMessage, des_peer_addrs_),
@@ -288,7 +366,7 @@ void protobuf_AssignDesc_overlay_2eproto() {
       sizeof(ChainPeerMessage),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainPeerMessage, _internal_metadata_),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainPeerMessage, _is_default_instance_));
-  ChainSubscribeTx_descriptor_ = file->message_type(12);
+  ChainSubscribeTx_descriptor_ = file->message_type(16);
   static const int ChainSubscribeTx_offsets_[1] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainSubscribeTx, address_),
   };
@@ -303,7 +381,7 @@ void protobuf_AssignDesc_overlay_2eproto() {
       sizeof(ChainSubscribeTx),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainSubscribeTx, _internal_metadata_),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainSubscribeTx, _is_default_instance_));
-  ChainResponse_descriptor_ = file->message_type(13);
+  ChainResponse_descriptor_ = file->message_type(17);
   static const int ChainResponse_offsets_[2] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainResponse, error_code_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainResponse, error_desc_),
@@ -319,7 +397,7 @@ void protobuf_AssignDesc_overlay_2eproto() {
       sizeof(ChainResponse),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainResponse, _internal_metadata_),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainResponse, _is_default_instance_));
-  ChainTxStatus_descriptor_ = file->message_type(14);
+  ChainTxStatus_descriptor_ = file->message_type(18);
   static const int ChainTxStatus_offsets_[9] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainTxStatus, status_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainTxStatus, tx_hash_),
@@ -374,6 +452,14 @@ void protobuf_RegisterTypes(const ::std::string&) {
       DontHave_descriptor_, &DontHave::default_instance());
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
       LedgerUpgradeNotify_descriptor_, &LedgerUpgradeNotify::default_instance());
+  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
+      PbftCompactEnv_descriptor_, &PbftCompactEnv::default_instance());
+  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
+      GetPbftTxs_descriptor_, &GetPbftTxs::default_instance());
+  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
+      PbftTxs_descriptor_, &PbftTxs::default_instance());
+  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
+      TransactionInv_descriptor_, &TransactionInv::default_instance());
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
       EntryList_descriptor_, &EntryList::default_instance());
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
@@ -409,6 +495,14 @@ void protobuf_ShutdownFile_overlay_2eproto() {
   delete DontHave_reflection_;
   delete LedgerUpgradeNotify::default_instance_;
   delete LedgerUpgradeNotify_reflection_;
+  delete PbftCompactEnv::default_instance_;
+  delete PbftCompactEnv_reflection_;
+  delete GetPbftTxs::default_instance_;
+  delete GetPbftTxs_reflection_;
+  delete PbftTxs::default_instance_;
+  delete PbftTxs_reflection_;
+  delete TransactionInv::default_instance_;
+  delete TransactionInv_reflection_;
   delete EntryList::default_instance_;
   delete EntryList_reflection_;
   delete ChainHello::default_instance_;
@@ -434,63 +528,74 @@ void protobuf_AddDesc_overlay_2eproto() {
 
   ::protocol::protobuf_AddDesc_common_2eproto();
   ::protocol::protobuf_AddDesc_chain_2eproto();
+  ::protocol::protobuf_AddDesc_consensus_2eproto();
   ::google::protobuf::DescriptorPool::InternalAddGeneratedFile(
     "\n\roverlay.proto\022\010protocol\032\014common.proto\032"
-    "\013chain.proto\"\243\001\n\005Hello\022\022\n\nnetwork_id\030\001 \001"
-    "(\003\022\026\n\016ledger_version\030\002 \001(\003\022\027\n\017overlay_ve"
-    "rsion\030\003 \001(\003\022\024\n\014rexx_version\030\004 \001(\t\022\026\n\016lis"
-    "tening_port\030\005 \001(\003\022\024\n\014node_address\030\006 \001(\t\022"
-    "\021\n\tnode_rand\030\007 \001(\t\"L\n\rHelloResponse\022\'\n\ne"
-    "rror_code\030\001 \001(\0162\023.protocol.ERRORCODE\022\022\n\n"
-    "error_desc\030\002 \001(\t\"}\n\004Peer\022\n\n\002ip\030\001 \001(\t\022\014\n\004"
-    "port\030\002 \001(\003\022\024\n\014num_failures\030\003 \001(\003\022\031\n\021next"
-    "_attempt_time\030\004 \001(\003\022\023\n\013active_time\030\005 \001(\003"
-    "\022\025\n\rconnection_id\030\006 \001(\003\"&\n\005Peers\022\035\n\005peer"
-    "s\030\001 \003(\0132\016.protocol.Peer\";\n\nGetLedgers\022\r\n"
-    "\005begin\030\001 \001(\003\022\013\n\003end\030\002 \001(\003\022\021\n\ttimestamp\030\003"
-    " \001(\003\"\337\001\n\007Ledgers\022(\n\006values\030\001 \003(\0132\030.proto"
-    "col.ConsensusValue\022-\n\tsync_code\030\002 \001(\0162\032."
-    "protocol.Ledgers.SyncCode\022\017\n\007max_seq\030\003 \001"
-    "(\003\022\r\n\005proof\030\004 \001(\014\"[\n\010SyncCode\022\006\n\002OK\020\000\022\017\n"
-    "\013OUT_OF_SYNC\020\001\022\022\n\016OUT_OF_LEDGERS\020\002\022\010\n\004BU"
-    "SY\020\003\022\n\n\006REFUSE\020\004\022\014\n\010INTERNAL\020\005\"&\n\010DontHa"
-    "ve\022\014\n\004type\030\001 \001(\003\022\014\n\004hash\030\002 \001(\014\"v\n\023Ledger"
-    "UpgradeNotify\022\r\n\005nonce\030\001 \001(\003\022(\n\007upgrade\030"
-    "\002 \001(\0132\027.protocol.LedgerUpgrade\022&\n\tsignat"
-    "ure\030\003 \001(\0132\023.protocol.Signature\"\032\n\tEntryL"
-    "ist\022\r\n\005entry\030\001 \003(\014\"M\n\nChainHello\022,\n\010api_"
-    "list\030\001 \003(\0162\032.protocol.ChainMessageType\022\021"
-    "\n\ttimestamp\030\002 \001(\003\"z\n\013ChainStatus\022\021\n\tself"
-    "_addr\030\001 \001(\t\022\026\n\016ledger_version\030\002 \001(\003\022\027\n\017m"
-    "onitor_version\030\003 \001(\003\022\024\n\014rexx_version\030\004 \001"
-    "(\t\022\021\n\ttimestamp\030\005 \001(\003\"O\n\020ChainPeerMessag"
-    "e\022\025\n\rsrc_peer_addr\030\001 \001(\t\022\026\n\016des_peer_add"
-    "rs\030\002 \003(\t\022\014\n\004data\030\003 \001(\014\"#\n\020ChainSubscribe"
-    "Tx\022\017\n\007address\030\001 \003(\t\"7\n\rChainResponse\022\022\n\n"
-    "error_code\030\001 \001(\005\022\022\n\nerror_desc\030\002 \001(\t\"\325\002\n"
-    "\rChainTxStatus\0220\n\006status\030\001 \001(\0162 .protoco"
-    "l.ChainTxStatus.TxStatus\022\017\n\007tx_hash\030\002 \001("
-    "\t\022\026\n\016source_address\030\003 \001(\t\022\032\n\022source_acco"
-    "unt_seq\030\004 \001(\003\022\022\n\nledger_seq\030\005 \001(\003\022\027\n\017new"
-    "_account_seq\030\006 \001(\003\022\'\n\nerror_code\030\007 \001(\0162\023"
-    ".protocol.ERRORCODE\022\022\n\nerror_desc\030\010 \001(\t\022"
-    "\021\n\ttimestamp\030\t \001(\003\"P\n\010TxStatus\022\r\n\tUNDEFI"
-    "NED\020\000\022\r\n\tCONFIRMED\020\001\022\013\n\007PENDING\020\002\022\014\n\010COM"
-    "PLETE\020\003\022\013\n\007FAILURE\020\004*\203\002\n\024OVERLAY_MESSAGE"
-    "_TYPE\022\030\n\024OVERLAY_MSGTYPE_NONE\020\000\022\030\n\024OVERL"
-    "AY_MSGTYPE_PING\020\001\022\031\n\025OVERLAY_MSGTYPE_HEL"
-    "LO\020\002\022\031\n\025OVERLAY_MSGTYPE_PEERS\020\003\022\037\n\033OVERL"
-    "AY_MSGTYPE_TRANSACTION\020\004\022\033\n\027OVERLAY_MSGT"
-    "YPE_LEDGERS\020\005\022\030\n\024OVERLAY_MSGTYPE_PBFT\020\006\022"
-    ")\n%OVERLAY_MSGTYPE_LEDGER_UPGRADE_NOTIFY"
-    "\020\007*\372\001\n\020ChainMessageType\022\023\n\017CHAIN_TYPE_NO"
-    "NE\020\000\022\017\n\013CHAIN_HELLO\020\n\022\023\n\017CHAIN_TX_STATUS"
-    "\020\013\022\025\n\021CHAIN_PEER_ONLINE\020\014\022\026\n\022CHAIN_PEER_"
-    "OFFLINE\020\r\022\026\n\022CHAIN_PEER_MESSAGE\020\016\022\033\n\027CHA"
-    "IN_SUBMITTRANSACTION\020\017\022\027\n\023CHAIN_LEDGER_H"
-    "EADER\020\020\022\026\n\022CHAIN_SUBSCRIBE_TX\020\021\022\026\n\022CHAIN"
-    "_TX_ENV_STORE\020\022B\"\n io.rexx.sdk.core.exte"
-    "nd.protobufb\006proto3", 2219);
+    "\013chain.proto\032\017consensus.proto\"\307\001\n\005Hello\022"
+    "\022\n\nnetwork_id\030\001 \001(\003\022\026\n\016ledger_version\030\002 "
+    "\001(\003\022\027\n\017overlay_version\030\003 \001(\003\022\024\n\014rexx_ver"
+    "sion\030\004 \001(\t\022\026\n\016listening_port\030\005 \001(\003\022\024\n\014no"
+    "de_address\030\006 \001(\t\022\021\n\tnode_rand\030\007 \001(\t\022\023\n\013c"
+    "ompression\030\010 \001(\010\022\r\n\005batch\030\t \001(\010\"L\n\rHello"
+    "Response\022\'\n\nerror_code\030\001 \001(\0162\023.protocol."
+    "ERRORCODE\022\022\n\nerror_desc\030\002 \001(\t\"}\n\004Peer\022\n\n"
+    "\002ip\030\001 \001(\t\022\014\n\004port\030\002 \001(\003\022\024\n\014num_failures\030"
+    "\003 \001(\003\022\031\n\021next_attempt_time\030\004 \001(\003\022\023\n\013acti"
+    "ve_time\030\005 \001(\003\022\025\n\rconnection_id\030\006 \001(\003\"&\n\005"
+    "Peers\022\035\n\005peers\030\001 \003(\0132\016.protocol.Peer\";\n\n"
+    "GetLedgers\022\r\n\005begin\030\001 \001(\003\022\013\n\003end\030\002 \001(\003\022\021"
+    "\n\ttimestamp\030\003 \001(\003\"\337\001\n\007Ledgers\022(\n\006values\030"
+    "\001 \003(\0132\030.protocol.ConsensusValue\022-\n\tsync_"
+    "code\030\002 \001(\0162\032.protocol.Ledgers.SyncCode\022\017"
+    "\n\007max_seq\030\003 \001(\003\022\r\n\005proof\030\004 \001(\014\"[\n\010SyncCo"
+    "de\022\006\n\002OK\020\000\022\017\n\013OUT_OF_SYNC\020\001\022\022\n\016OUT_OF_LE"
+    "DGERS\020\002\022\010\n\004BUSY\020\003\022\n\n\006REFUSE\020\004\022\014\n\010INTERNA"
+    "L\020\005\"&\n\010DontHave\022\014\n\004type\030\001 \001(\003\022\014\n\004hash\030\002 "
+    "\001(\014\"v\n\023LedgerUpgradeNotify\022\r\n\005nonce\030\001 \001("
+    "\003\022(\n\007upgrade\030\002 \001(\0132\027.protocol.LedgerUpgr"
+    "ade\022&\n\tsignature\030\003 \001(\0132\023.protocol.Signat"
+    "ure\"C\n\016PbftCompactEnv\022\036\n\003env\030\001 \001(\0132\021.pro"
+    "tocol.PbftEnv\022\021\n\ttx_hashes\030\002 \003(\014\"3\n\nGetP"
+    "bftTxs\022\024\n\014value_digest\030\001 \001(\014\022\017\n\007indexes\030"
+    "\002 \003(\005\"W\n\007PbftTxs\022\024\n\014value_digest\030\001 \001(\014\022\017"
+    "\n\007indexes\030\002 \003(\005\022%\n\003txs\030\003 \003(\0132\030.protocol."
+    "TransactionEnv\" \n\016TransactionInv\022\016\n\006hash"
+    "es\030\001 \003(\014\"\032\n\tEntryList\022\r\n\005entry\030\001 \003(\014\"M\n\n"
+    "ChainHello\022,\n\010api_list\030\001 \003(\0162\032.protocol."
+    "ChainMessageType\022\021\n\ttimestamp\030\002 \001(\003\"z\n\013C"
+    "hainStatus\022\021\n\tself_addr\030\001 \001(\t\022\026\n\016ledger_"
+    "version\030\002 \001(\003\022\027\n\017monitor_version\030\003 \001(\003\022\024"
+    "\n\014rexx_version\030\004 \001(\t\022\021\n\ttimestamp\030\005 \001(\003\""
+    "O\n\020ChainPeerMessage\022\025\n\rsrc_peer_addr\030\001 \001"
+    "(\t\022\026\n\016des_peer_addrs\030\002 \003(\t\022\014\n\004data\030\003 \001(\014"
+    "\"#\n\020ChainSubscribeTx\022\017\n\007address\030\001 \003(\t\"7\n"
+    "\rChainResponse\022\022\n\nerror_code\030\001 \001(\005\022\022\n\ner"
+    "ror_desc\030\002 \001(\t\"\325\002\n\rChainTxStatus\0220\n\006stat"
+    "us\030\001 \001(\0162 .protocol.ChainTxStatus.TxStat"
+    "us\022\017\n\007tx_hash\030\002 \001(\t\022\026\n\016source_address\030\003 "
+    "\001(\t\022\032\n\022source_account_seq\030\004 \001(\003\022\022\n\nledge"
+    "r_seq\030\005 \001(\003\022\027\n\017new_account_seq\030\006 \001(\003\022\'\n\n"
+    "error_code\030\007 \001(\0162\023.protocol.ERRORCODE\022\022\n"
+    "\nerror_desc\030\010 \001(\t\022\021\n\ttimestamp\030\t \001(\003\"P\n\010"
+    "TxStatus\022\r\n\tUNDEFINED\020\000\022\r\n\tCONFIRMED\020\001\022\013"
+    "\n\007PENDING\020\002\022\014\n\010COMPLETE\020\003\022\013\n\007FAILURE\020\004*\374"
+    "\002\n\024OVERLAY_MESSAGE_TYPE\022\030\n\024OVERLAY_MSGTY"
+    "PE_NONE\020\000\022\030\n\024OVERLAY_MSGTYPE_PING\020\001\022\031\n\025O"
+    "VERLAY_MSGTYPE_HELLO\020\002\022\031\n\025OVERLAY_MSGTYP"
+    "E_PEERS\020\003\022\037\n\033OVERLAY_MSGTYPE_TRANSACTION"
+    "\020\004\022\033\n\027OVERLAY_MSGTYPE_LEDGERS\020\005\022\030\n\024OVERL"
+    "AY_MSGTYPE_PBFT\020\006\022)\n%OVERLAY_MSGTYPE_LED"
+    "GER_UPGRADE_NOTIFY\020\007\022 \n\034OVERLAY_MSGTYPE_"
+    "PBFT_COMPACT\020\010\022\034\n\030OVERLAY_MSGTYPE_PBFT_T"
+    "XS\020\t\022\032\n\026OVERLAY_MSGTYPE_TX_INV\020\n\022\033\n\027OVER"
+    "LAY_MSGTYPE_GET_TXS\020\013*\372\001\n\020ChainMessageTy"
+    "pe\022\023\n\017CHAIN_TYPE_NONE\020\000\022\017\n\013CHAIN_HELLO\020\n"
+    "\022\023\n\017CHAIN_TX_STATUS\020\013\022\025\n\021CHAIN_PEER_ONLI"
+    "NE\020\014\022\026\n\022CHAIN_PEER_OFFLINE\020\r\022\026\n\022CHAIN_PE"
+    "ER_MESSAGE\020\016\022\033\n\027CHAIN_SUBMITTRANSACTION\020"
+    "\017\022\027\n\023CHAIN_LEDGER_HEADER\020\020\022\026\n\022CHAIN_SUBS"
+    "CRIBE_TX\020\021\022\026\n\022CHAIN_TX_ENV_STORE\020\022b\006prot"
+    "o3", 2602);
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedFile(
     "overlay.proto", &protobuf_RegisterTypes);
   Hello::default_instance_ = new Hello();
@@ -501,6 +606,10 @@ void protobuf_AddDesc_overlay_2eproto() {
   Ledgers::default_instance_ = new Ledgers();
   DontHave::default_instance_ = new DontHave();
   LedgerUpgradeNotify::default_instance_ = new LedgerUpgradeNotify();
+  PbftCompactEnv::default_instance_ = new PbftCompactEnv();
+  GetPbftTxs::default_instance_ = new GetPbftTxs();
+  PbftTxs::default_instance_ = new PbftTxs();
+  TransactionInv::default_instance_ = new TransactionInv();
   EntryList::default_instance_ = new EntryList();
   ChainHello::default_instance_ = new ChainHello();
   ChainStatus::default_instance_ = new ChainStatus();
@@ -516,6 +625,10 @@ void protobuf_AddDesc_overlay_2eproto() {
   Ledgers::default_instance_->InitAsDefaultInstance();
   DontHave::default_instance_->InitAsDefaultInstance();
   LedgerUpgradeNotify::default_instance_->InitAsDefaultInstance();
+  PbftCompactEnv::default_instance_->InitAsDefaultInstance();
+  GetPbftTxs::default_instance_->InitAsDefaultInstance();
+  PbftTxs::default_instance_->InitAsDefaultInstance();
+  TransactionInv::default_instance_->InitAsDefaultInstance();
   EntryList::default_instance_->InitAsDefaultInstance();
   ChainHello::default_instance_->InitAsDefaultInstance();
   ChainStatus::default_instance_->InitAsDefaultInstance();
@@ -546,6 +659,10 @@ bool OVERLAY_MESSAGE_TYPE_IsValid(int value) {
     case 5:
     case 6:
     case 7:
+    case 8:
+    case 9:
+    case 10:
+    case 11:
       return true;
     default:
       return false;
@@ -585,6 +702,8 @@ const int Hello::kRexxVersionFieldNumber;
 const int Hello::kListeningPortFieldNumber;
 const int Hello::kNodeAddressFieldNumber;
 const int Hello::kNodeRandFieldNumber;
+const int Hello::kCompressionFieldNumber;
+const int Hello::kBatchFieldNumber;
 #endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
 
 Hello::Hello()
@@ -616,6 +735,8 @@ void Hello::SharedCtor() {
   listening_port_ = GOOGLE_LONGLONG(0);
   node_address_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
   node_rand_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  compression_ = false;
+  batch_ = false;
 }
 
 Hello::~Hello() {
@@ -679,6 +800,8 @@ void Hello::Clear() {
   listening_port_ = GOOGLE_LONGLONG(0);
   node_address_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
   node_rand_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  compression_ = false;
+  batch_ = false;
 
 #undef ZR_HELPER_
 #undef ZR_
@@ -801,6 +924,36 @@ bool Hello::MergePartialFromCodedStream(
         } else {
           goto handle_unusual;
         }
+        if (input->ExpectTag(64)) goto parse_compression;
+        break;
+      }
+
+      // optional bool compression = 8;
+      case 8: {
+        if (tag == 64) {
+         parse_compression:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   bool, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL>(
+                 input, &compression_)));
+
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(72)) goto parse_batch;
+        break;
+      }
+
+      // optional bool batch = 9;
+      case 9: {
+        if (tag == 72) {
+         parse_batch:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   bool, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL>(
+                 input, &batch_)));
+
+        } else {
+          goto handle_unusual;
+        }
         if (input->ExpectAtEnd()) goto success;
         break;
       }
@@ -879,6 +1032,16 @@ void Hello::SerializeWithCachedSizes(
       7, this->node_rand(), output);
   }
 
+  // optional bool compression = 8;
+  if (this->compression() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteBool(8, this->compression(), output);
+  }
+
+  // optional bool batch = 9;
+  if (this->batch() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteBool(9, this->batch(), output);
+  }
+
   // @@protoc_insertion_point(serialize_end:protocol.Hello)
 }
 
@@ -938,6 +1101,16 @@ void Hello::SerializeWithCachedSizes(
         7, this->node_rand(), target);
   }
 
+  // optional bool compression = 8;
+  if (this->compression() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteBoolToArray(8, this->compression(), target);
+  }
+
+  // optional bool batch = 9;
+  if (this->batch() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteBoolToArray(9, this->batch(), target);
+  }
+
   // @@protoc_insertion_point(serialize_to_array_end:protocol.Hello)
   return target;
 }
@@ -995,6 +1168,16 @@ int Hello::ByteSize() const {
         this->node_rand());
   }
 
+  // optional bool compression = 8;
+  if (this->compression() != 0) {
+    total_size += 1 + 1;
+  }
+
+  // optional bool batch = 9;
+  if (this->batch() != 0) {
+    total_size += 1 + 1;
+  }
+
   GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
   _cached_size_ = total_size;
   GOOGLE_SAFE_CONCURRENT_WRITES_END();
@@ -1047,6 +1230,12 @@ void Hello::MergeFrom(const Hello& from) {
 
     node_rand_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.node_rand_);
   }
+  if (from.compression() != 0) {
+    set_compression(from.compression());
+  }
+  if (from.batch() != 0) {
+    set_batch(from.batch());
+  }
 }
 
 void Hello::CopyFrom(const ::google::protobuf::Message& from) {
@@ -1080,6 +1269,8 @@ void Hello::InternalSwap(Hello* other) {
   std::swap(listening_port_, other->listening_port_);
   node_address_.Swap(&other->node_address_);
   node_rand_.Swap(&other->node_rand_);
+  std::swap(compression_, other->compression_);
+  std::swap(batch_, other->batch_);
   _internal_metadata_.Swap(&other->_internal_metadata_);
   std::swap(_cached_size_, other->_cached_size_);
 }
@@ -1283,6 +1474,34 @@ void Hello::clear_node_rand() {
   // @@protoc_insertion_point(field_set_allocated:protocol.Hello.node_rand)
 }
 
+// optional bool compression = 8;
+void Hello::clear_compression() {
+  compression_ = false;
+}
+ bool Hello::compression() const {
+  // @@protoc_insertion_point(field_get:protocol.Hello.compression)
+  return compression_;
+}
+ void Hello::set_compression(bool value) {
+  
+  compression_ = value;
+  // @@protoc_insertion_point(field_set:protocol.Hello.compression)
+}
+
+// optional bool batch = 9;
+void Hello::clear_batch() {
+  batch_ = false;
+}
+ bool Hello::batch() const {
+  // @@protoc_insertion_point(field_get:protocol.Hello.batch)
+  return batch_;
+}
+ void Hello::set_batch(bool value) {
+  
+  batch_ = value;
+  // @@protoc_insertion_point(field_set:protocol.Hello.batch)
+}
+
 #endif  // PROTOBUF_INLINE_NOT_IN_HEADERS
 
 // ===================================================================
@@ -4016,6 +4235,1446 @@ void LedgerUpgradeNotify::set_allocated_signature(::protocol::Signature* signatu
 
 // ===================================================================
 
+#if !defined(_MSC_VER) || _MSC_VER >= 1900
+const int PbftCompactEnv::kEnvFieldNumber;
+const int PbftCompactEnv::kTxHashesFieldNumber;
+#endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
+
+PbftCompactEnv::PbftCompactEnv()
+  : ::google::protobuf::Message(), _internal_metadata_(NULL) {
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:protocol.PbftCompactEnv)
+}
+
+void PbftCompactEnv::InitAsDefaultInstance() {
+  _is_default_instance_ = true;
+  env_ = const_cast< ::protocol::PbftEnv*>(&::protocol::PbftEnv::default_instance());
+}
+
+PbftCompactEnv::PbftCompactEnv(const PbftCompactEnv& from)
+  : ::google::protobuf::Message(),
+    _internal_metadata_(NULL) {
+  SharedCtor();
+  MergeFrom(from);
+  // @@protoc_insertion_point(copy_constructor:protocol.PbftCompactEnv)
+}
+
+void PbftCompactEnv::SharedCtor() {
+    _is_default_instance_ = false;
+  ::google::protobuf::internal::GetEmptyString();
+  _cached_size_ = 0;
+  env_ = NULL;
+}
+
+PbftCompactEnv::~PbftCompactEnv() {
+  // @@protoc_insertion_point(destructor:protocol.PbftCompactEnv)
+  SharedDtor();
+}
+
+void PbftCompactEnv::SharedDtor() {
+  if (this != default_instance_) {
+    delete env_;
+  }
+}
+
+void PbftCompactEnv::SetCachedSize(int size) const {
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+}
+const ::google::protobuf::Descriptor* PbftCompactEnv::descriptor() {
+  protobuf_AssignDescriptorsOnce();
+  return PbftCompactEnv_descriptor_;
+}
+
+const PbftCompactEnv& PbftCompactEnv::default_instance() {
+  if (default_instance_ == NULL) protobuf_AddDesc_overlay_2eproto();
+  return *default_instance_;
+}
+
+PbftCompactEnv* PbftCompactEnv::default_instance_ = NULL;
+
+PbftCompactEnv* PbftCompactEnv::New(::google::protobuf::Arena* arena) const {
+  PbftCompactEnv* n = new PbftCompactEnv;
+  if (arena != NULL) {
+    arena->Own(n);
+  }
+  return n;
+}
+
+void PbftCompactEnv::Clear() {
+// @@protoc_insertion_point(message_clear_start:protocol.PbftCompactEnv)
+  if (GetArenaNoVirtual() == NULL && env_ != NULL) delete env_;
+  env_ = NULL;
+  tx_hashes_.Clear();
+}
+
+bool PbftCompactEnv::MergePartialFromCodedStream(
+    ::google::protobuf::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!GOOGLE_PREDICT_TRUE(EXPRESSION)) goto failure
+  ::google::protobuf::uint32 tag;
+  // @@protoc_insertion_point(parse_start:protocol.PbftCompactEnv)
+  for (;;) {
+    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
+    tag = p.first;
+    if (!p.second) goto handle_unusual;
+    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // optional .protocol.PbftEnv env = 1;
+      case 1: {
+        if (tag == 10) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
+               input, mutable_env()));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(18)) goto parse_tx_hashes;
+        break;
+      }
+
+      // repeated bytes tx_hashes = 2;
+      case 2: {
+        if (tag == 18) {
+         parse_tx_hashes:
+          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
+                input, this->add_tx_hashes()));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(18)) goto parse_tx_hashes;
+        if (input->ExpectAtEnd()) goto success;
+        break;
+      }
+
+      default: {
+      handle_unusual:
+        if (tag == 0 ||
+            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
+          goto success;
+        }
+        DO_(::google::protobuf::internal::WireFormatLite::SkipField(input, tag));
+        break;
+      }
+    }
+  }
+success:
+  // @@protoc_insertion_point(parse_success:protocol.PbftCompactEnv)
+  return true;
+failure:
+  // @@protoc_insertion_point(parse_failure:protocol.PbftCompactEnv)
+  return false;
+#undef DO_
+}
+
+void PbftCompactEnv::SerializeWithCachedSizes(
+    ::google::protobuf::io::CodedOutputStream* output) const {
+  // @@protoc_insertion_point(serialize_start:protocol.PbftCompactEnv)
+  // optional .protocol.PbftEnv env = 1;
+  if (this->has_env()) {
+    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
+      1, *this->env_, output);
+  }
+
+  // repeated bytes tx_hashes = 2;
+  for (int i = 0; i < this->tx_hashes_size(); i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytes(
+      2, this->tx_hashes(i), output);
+  }
+
+  // @@protoc_insertion_point(serialize_end:protocol.PbftCompactEnv)
+}
+
+::google::protobuf::uint8* PbftCompactEnv::InternalSerializeWithCachedSizesToArray(
+    bool deterministic, ::google::protobuf::uint8* target) const {
+  // @@protoc_insertion_point(serialize_to_array_start:protocol.PbftCompactEnv)
+  // optional .protocol.PbftEnv env = 1;
+  if (this->has_env()) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      InternalWriteMessageNoVirtualToArray(
+        1, *this->env_, false, target);
+  }
+
+  // repeated bytes tx_hashes = 2;
+  for (int i = 0; i < this->tx_hashes_size(); i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      WriteBytesToArray(2, this->tx_hashes(i), target);
+  }
+
+  // @@protoc_insertion_point(serialize_to_array_end:protocol.PbftCompactEnv)
+  return target;
+}
+
+int PbftCompactEnv::ByteSize() const {
+// @@protoc_insertion_point(message_byte_size_start:protocol.PbftCompactEnv)
+  int total_size = 0;
+
+  // optional .protocol.PbftEnv env = 1;
+  if (this->has_env()) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
+        *this->env_);
+  }
+
+  // repeated bytes tx_hashes = 2;
+  total_size += 1 * this->tx_hashes_size();
+  for (int i = 0; i < this->tx_hashes_size(); i++) {
+    total_size += ::google::protobuf::internal::WireFormatLite::BytesSize(
+      this->tx_hashes(i));
+  }
+
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = total_size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+  return total_size;
+}
+
+void PbftCompactEnv::MergeFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:protocol.PbftCompactEnv)
+  if (GOOGLE_PREDICT_FALSE(&from == this)) {
+    ::google::protobuf::internal::MergeFromFail(__FILE__, __LINE__);
+  }
+  const PbftCompactEnv* source = 
+      ::google::protobuf::internal::DynamicCastToGenerated<const PbftCompactEnv>(
+          &from);
+  if (source == NULL) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:protocol.PbftCompactEnv)
+    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:protocol.PbftCompactEnv)
+    MergeFrom(*source);
+  }
+}
+
+void PbftCompactEnv::MergeFrom(const PbftCompactEnv& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:protocol.PbftCompactEnv)
+  if (GOOGLE_PREDICT_FALSE(&from == this)) {
+    ::google::protobuf::internal::MergeFromFail(__FILE__, __LINE__);
+  }
+  tx_hashes_.MergeFrom(from.tx_hashes_);
+  if (from.has_env()) {
+    mutable_env()->::protocol::PbftEnv::MergeFrom(from.env());
+  }
+}
+
+void PbftCompactEnv::CopyFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:protocol.PbftCompactEnv)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void PbftCompactEnv::CopyFrom(const PbftCompactEnv& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:protocol.PbftCompactEnv)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool PbftCompactEnv::IsInitialized() const {
+
+  return true;
+}
+
+void PbftCompactEnv::Swap(PbftCompactEnv* other) {
+  if (other == this) return;
+  InternalSwap(other);
+}
+void PbftCompactEnv::InternalSwap(PbftCompactEnv* other) {
+  std::swap(env_, other->env_);
+  tx_hashes_.UnsafeArenaSwap(&other->tx_hashes_);
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+  std::swap(_cached_size_, other->_cached_size_);
+}
+
+::google::protobuf::Metadata PbftCompactEnv::GetMetadata() const {
+  protobuf_AssignDescriptorsOnce();
+  ::google::protobuf::Metadata metadata;
+  metadata.descriptor = PbftCompactEnv_descriptor_;
+  metadata.reflection = PbftCompactEnv_reflection_;
+  return metadata;
+}
+
+#if PROTOBUF_INLINE_NOT_IN_HEADERS
+// PbftCompactEnv
+
+// optional .protocol.PbftEnv env = 1;
+bool PbftCompactEnv::has_env() const {
+  return !_is_default_instance_ && env_ != NULL;
+}
+void PbftCompactEnv::clear_env() {
+  if (GetArenaNoVirtual() == NULL && env_ != NULL) delete env_;
+  env_ = NULL;
+}
+const ::protocol::PbftEnv& PbftCompactEnv::env() const {
+  // @@protoc_insertion_point(field_get:protocol.PbftCompactEnv.env)
+  return env_ != NULL ? *env_ : *default_instance_->env_;
+}
+::protocol::PbftEnv* PbftCompactEnv::mutable_env() {
+  
+  if (env_ == NULL) {
+    env_ = new ::protocol::PbftEnv;
+  }
+  // @@protoc_insertion_point(field_mutable:protocol.PbftCompactEnv.env)
+  return env_;
+}
+::protocol::PbftEnv* PbftCompactEnv::release_env() {
+  // @@protoc_insertion_point(field_release:protocol.PbftCompactEnv.env)
+  
+  ::protocol::PbftEnv* temp = env_;
+  env_ = NULL;
+  return temp;
+}
+void PbftCompactEnv::set_allocated_env(::protocol::PbftEnv* env) {
+  delete env_;
+  env_ = env;
+  if (env) {
+    
+  } else {
+    
+  }
+  // @@protoc_insertion_point(field_set_allocated:protocol.PbftCompactEnv.env)
+}
+
+// repeated bytes tx_hashes = 2;
+int PbftCompactEnv::tx_hashes_size() const {
+  return tx_hashes_.size();
+}
+void PbftCompactEnv::clear_tx_hashes() {
+  tx_hashes_.Clear();
+}
+ const ::std::string& PbftCompactEnv::tx_hashes(int index) const {
+  // @@protoc_insertion_point(field_get:protocol.PbftCompactEnv.tx_hashes)
+  return tx_hashes_.Get(index);
+}
+ ::std::string* PbftCompactEnv::mutable_tx_hashes(int index) {
+  // @@protoc_insertion_point(field_mutable:protocol.PbftCompactEnv.tx_hashes)
+  return tx_hashes_.Mutable(index);
+}
+ void PbftCompactEnv::set_tx_hashes(int index, const ::std::string& value) {
+  // @@protoc_insertion_point(field_set:protocol.PbftCompactEnv.tx_hashes)
+  tx_hashes_.Mutable(index)->assign(value);
+}
+ void PbftCompactEnv::set_tx_hashes(int index, const char* value) {
+  tx_hashes_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set_char:protocol.PbftCompactEnv.tx_hashes)
+}
+ void PbftCompactEnv::set_tx_hashes(int index, const void* value, size_t size) {
+  tx_hashes_.Mutable(index)->assign(
+    reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_set_pointer:protocol.PbftCompactEnv.tx_hashes)
+}
+ ::std::string* PbftCompactEnv::add_tx_hashes() {
+  // @@protoc_insertion_point(field_add_mutable:protocol.PbftCompactEnv.tx_hashes)
+  return tx_hashes_.Add();
+}
+ void PbftCompactEnv::add_tx_hashes(const ::std::string& value) {
+  tx_hashes_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add:protocol.PbftCompactEnv.tx_hashes)
+}
+ void PbftCompactEnv::add_tx_hashes(const char* value) {
+  tx_hashes_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add_char:protocol.PbftCompactEnv.tx_hashes)
+}
+ void PbftCompactEnv::add_tx_hashes(const void* value, size_t size) {
+  tx_hashes_.Add()->assign(reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_add_pointer:protocol.PbftCompactEnv.tx_hashes)
+}
+ const ::google::protobuf::RepeatedPtrField< ::std::string>&
+PbftCompactEnv::tx_hashes() const {
+  // @@protoc_insertion_point(field_list:protocol.PbftCompactEnv.tx_hashes)
+  return tx_hashes_;
+}
+ ::google::protobuf::RepeatedPtrField< ::std::string>*
+PbftCompactEnv::mutable_tx_hashes() {
+  // @@protoc_insertion_point(field_mutable_list:protocol.PbftCompactEnv.tx_hashes)
+  return &tx_hashes_;
+}
+
+#endif  // PROTOBUF_INLINE_NOT_IN_HEADERS
+
+// ===================================================================
+
+#if !defined(_MSC_VER) || _MSC_VER >= 1900
+const int GetPbftTxs::kValueDigestFieldNumber;
+const int GetPbftTxs::kIndexesFieldNumber;
+#endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
+
+GetPbftTxs::GetPbftTxs()
+  : ::google::protobuf::Message(), _internal_metadata_(NULL) {
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:protocol.GetPbftTxs)
+}
+
+void GetPbftTxs::InitAsDefaultInstance() {
+  _is_default_instance_ = true;
+}
+
+GetPbftTxs::GetPbftTxs(const GetPbftTxs& from)
+  : ::google::protobuf::Message(),
+    _internal_metadata_(NULL) {
+  SharedCtor();
+  MergeFrom(from);
+  // @@protoc_insertion_point(copy_constructor:protocol.GetPbftTxs)
+}
+
+void GetPbftTxs::SharedCtor() {
+    _is_default_instance_ = false;
+  ::google::protobuf::internal::GetEmptyString();
+  _cached_size_ = 0;
+  value_digest_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+
+GetPbftTxs::~GetPbftTxs() {
+  // @@protoc_insertion_point(destructor:protocol.GetPbftTxs)
+  SharedDtor();
+}
+
+void GetPbftTxs::SharedDtor() {
+  value_digest_.DestroyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  if (this != default_instance_) {
+  }
+}
+
+void GetPbftTxs::SetCachedSize(int size) const {
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+}
+const ::google::protobuf::Descriptor* GetPbftTxs::descriptor() {
+  protobuf_AssignDescriptorsOnce();
+  return GetPbftTxs_descriptor_;
+}
+
+const GetPbftTxs& GetPbftTxs::default_instance() {
+  if (default_instance_ == NULL) protobuf_AddDesc_overlay_2eproto();
+  return *default_instance_;
+}
+
+GetPbftTxs* GetPbftTxs::default_instance_ = NULL;
+
+GetPbftTxs* GetPbftTxs::New(::google::protobuf::Arena* arena) const {
+  GetPbftTxs* n = new GetPbftTxs;
+  if (arena != NULL) {
+    arena->Own(n);
+  }
+  return n;
+}
+
+void GetPbftTxs::Clear() {
+// @@protoc_insertion_point(message_clear_start:protocol.GetPbftTxs)
+  value_digest_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  indexes_.Clear();
+}
+
+bool GetPbftTxs::MergePartialFromCodedStream(
+    ::google::protobuf::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!GOOGLE_PREDICT_TRUE(EXPRESSION)) goto failure
+  ::google::protobuf::uint32 tag;
+  // @@protoc_insertion_point(parse_start:protocol.GetPbftTxs)
+  for (;;) {
+    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
+    tag = p.first;
+    if (!p.second) goto handle_unusual;
+    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // optional bytes value_digest = 1;
+      case 1: {
+        if (tag == 10) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
+                input, this->mutable_value_digest()));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(18)) goto parse_indexes;
+        break;
+      }
+
+      // repeated int32 indexes = 2;
+      case 2: {
+        if (tag == 18) {
+         parse_indexes:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPackedPrimitive<
+                   ::google::protobuf::int32, ::google::protobuf::internal::WireFormatLite::TYPE_INT32>(
+                 input, this->mutable_indexes())));
+        } else if (tag == 16) {
+          DO_((::google::protobuf::internal::WireFormatLite::ReadRepeatedPrimitiveNoInline<
+                   ::google::protobuf::int32, ::google::protobuf::internal::WireFormatLite::TYPE_INT32>(
+                 1, 18, input, this->mutable_indexes())));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectAtEnd()) goto success;
+        break;
+      }
+
+      default: {
+      handle_unusual:
+        if (tag == 0 ||
+            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
+          goto success;
+        }
+        DO_(::google::protobuf::internal::WireFormatLite::SkipField(input, tag));
+        break;
+      }
+    }
+  }
+success:
+  // @@protoc_insertion_point(parse_success:protocol.GetPbftTxs)
+  return true;
+failure:
+  // @@protoc_insertion_point(parse_failure:protocol.GetPbftTxs)
+  return false;
+#undef DO_
+}
+
+void GetPbftTxs::SerializeWithCachedSizes(
+    ::google::protobuf::io::CodedOutputStream* output) const {
+  // @@protoc_insertion_point(serialize_start:protocol.GetPbftTxs)
+  // optional bytes value_digest = 1;
+  if (this->value_digest().size() > 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytesMaybeAliased(
+      1, this->value_digest(), output);
+  }
+
+  // repeated int32 indexes = 2;
+  if (this->indexes_size() > 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteTag(2, ::google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED, output);
+    output->WriteVarint32(_indexes_cached_byte_size_);
+  }
+  for (int i = 0; i < this->indexes_size(); i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteInt32NoTag(
+      this->indexes(i), output);
+  }
+
+  // @@protoc_insertion_point(serialize_end:protocol.GetPbftTxs)
+}
+
+::google::protobuf::uint8* GetPbftTxs::InternalSerializeWithCachedSizesToArray(
+    bool deterministic, ::google::protobuf::uint8* target) const {
+  // @@protoc_insertion_point(serialize_to_array_start:protocol.GetPbftTxs)
+  // optional bytes value_digest = 1;
+  if (this->value_digest().size() > 0) {
+    target =
+      ::google::protobuf::internal::WireFormatLite::WriteBytesToArray(
+        1, this->value_digest(), target);
+  }
+
+  // repeated int32 indexes = 2;
+  if (this->indexes_size() > 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteTagToArray(
+      2,
+      ::google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED,
+      target);
+    target = ::google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(
+      _indexes_cached_byte_size_, target);
+  }
+  for (int i = 0; i < this->indexes_size(); i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      WriteInt32NoTagToArray(this->indexes(i), target);
+  }
+
+  // @@protoc_insertion_point(serialize_to_array_end:protocol.GetPbftTxs)
+  return target;
+}
+
+int GetPbftTxs::ByteSize() const {
+// @@protoc_insertion_point(message_byte_size_start:protocol.GetPbftTxs)
+  int total_size = 0;
+
+  // optional bytes value_digest = 1;
+  if (this->value_digest().size() > 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::BytesSize(
+        this->value_digest());
+  }
+
+  // repeated int32 indexes = 2;
+  {
+    int data_size = 0;
+    for (int i = 0; i < this->indexes_size(); i++) {
+      data_size += ::google::protobuf::internal::WireFormatLite::
+        Int32Size(this->indexes(i));
+    }
+    if (data_size > 0) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::Int32Size(data_size);
+    }
+    GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+    _indexes_cached_byte_size_ = data_size;
+    GOOGLE_SAFE_CONCURRENT_WRITES_END();
+    total_size += data_size;
+  }
+
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = total_size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+  return total_size;
+}
+
+void GetPbftTxs::MergeFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:protocol.GetPbftTxs)
+  if (GOOGLE_PREDICT_FALSE(&from == this)) {
+    ::google::protobuf::internal::MergeFromFail(__FILE__, __LINE__);
+  }
+  const GetPbftTxs* source = 
+      ::google::protobuf::internal::DynamicCastToGenerated<const GetPbftTxs>(
+          &from);
+  if (source == NULL) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:protocol.GetPbftTxs)
+    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:protocol.GetPbftTxs)
+    MergeFrom(*source);
+  }
+}
+
+void GetPbftTxs::MergeFrom(const GetPbftTxs& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:protocol.GetPbftTxs)
+  if (GOOGLE_PREDICT_FALSE(&from == this)) {
+    ::google::protobuf::internal::MergeFromFail(__FILE__, __LINE__);
+  }
+  indexes_.MergeFrom(from.indexes_);
+  if (from.value_digest().size() > 0) {
+
+    value_digest_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.value_digest_);
+  }
+}
+
+void GetPbftTxs::CopyFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:protocol.GetPbftTxs)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void GetPbftTxs::CopyFrom(const GetPbftTxs& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:protocol.GetPbftTxs)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool GetPbftTxs::IsInitialized() const {
+
+  return true;
+}
+
+void GetPbftTxs::Swap(GetPbftTxs* other) {
+  if (other == this) return;
+  InternalSwap(other);
+}
+void GetPbftTxs::InternalSwap(GetPbftTxs* other) {
+  value_digest_.Swap(&other->value_digest_);
+  indexes_.UnsafeArenaSwap(&other->indexes_);
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+  std::swap(_cached_size_, other->_cached_size_);
+}
+
+::google::protobuf::Metadata GetPbftTxs::GetMetadata() const {
+  protobuf_AssignDescriptorsOnce();
+  ::google::protobuf::Metadata metadata;
+  metadata.descriptor = GetPbftTxs_descriptor_;
+  metadata.reflection = GetPbftTxs_reflection_;
+  return metadata;
+}
+
+#if PROTOBUF_INLINE_NOT_IN_HEADERS
+// GetPbftTxs
+
+// optional bytes value_digest = 1;
+void GetPbftTxs::clear_value_digest() {
+  value_digest_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ const ::std::string& GetPbftTxs::value_digest() const {
+  // @@protoc_insertion_point(field_get:protocol.GetPbftTxs.value_digest)
+  return value_digest_.GetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ void GetPbftTxs::set_value_digest(const ::std::string& value) {
+  
+  value_digest_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:protocol.GetPbftTxs.value_digest)
+}
+ void GetPbftTxs::set_value_digest(const char* value) {
+  
+  value_digest_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:protocol.GetPbftTxs.value_digest)
+}
+ void GetPbftTxs::set_value_digest(const void* value, size_t size) {
+  
+  value_digest_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:protocol.GetPbftTxs.value_digest)
+}
+ ::std::string* GetPbftTxs::mutable_value_digest() {
+  
+  // @@protoc_insertion_point(field_mutable:protocol.GetPbftTxs.value_digest)
+  return value_digest_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ ::std::string* GetPbftTxs::release_value_digest() {
+  // @@protoc_insertion_point(field_release:protocol.GetPbftTxs.value_digest)
+  
+  return value_digest_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ void GetPbftTxs::set_allocated_value_digest(::std::string* value_digest) {
+  if (value_digest != NULL) {
+    
+  } else {
+    
+  }
+  value_digest_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value_digest);
+  // @@protoc_insertion_point(field_set_allocated:protocol.GetPbftTxs.value_digest)
+}
+
+// repeated int32 indexes = 2;
+int GetPbftTxs::indexes_size() const {
+  return indexes_.size();
+}
+void GetPbftTxs::clear_indexes() {
+  indexes_.Clear();
+}
+ ::google::protobuf::int32 GetPbftTxs::indexes(int index) const {
+  // @@protoc_insertion_point(field_get:protocol.GetPbftTxs.indexes)
+  return indexes_.Get(index);
+}
+ void GetPbftTxs::set_indexes(int index, ::google::protobuf::int32 value) {
+  indexes_.Set(index, value);
+  // @@protoc_insertion_point(field_set:protocol.GetPbftTxs.indexes)
+}
+ void GetPbftTxs::add_indexes(::google::protobuf::int32 value) {
+  indexes_.Add(value);
+  // @@protoc_insertion_point(field_add:protocol.GetPbftTxs.indexes)
+}
+ const ::google::protobuf::RepeatedField< ::google::protobuf::int32 >&
+GetPbftTxs::indexes() const {
+  // @@protoc_insertion_point(field_list:protocol.GetPbftTxs.indexes)
+  return indexes_;
+}
+ ::google::protobuf::RepeatedField< ::google::protobuf::int32 >*
+GetPbftTxs::mutable_indexes() {
+  // @@protoc_insertion_point(field_mutable_list:protocol.GetPbftTxs.indexes)
+  return &indexes_;
+}
+
+#endif  // PROTOBUF_INLINE_NOT_IN_HEADERS
+
+// ===================================================================
+
+#if !defined(_MSC_VER) || _MSC_VER >= 1900
+const int PbftTxs::kValueDigestFieldNumber;
+const int PbftTxs::kIndexesFieldNumber;
+const int PbftTxs::kTxsFieldNumber;
+#endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
+
+PbftTxs::PbftTxs()
+  : ::google::protobuf::Message(), _internal_metadata_(NULL) {
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:protocol.PbftTxs)
+}
+
+void PbftTxs::InitAsDefaultInstance() {
+  _is_default_instance_ = true;
+}
+
+PbftTxs::PbftTxs(const PbftTxs& from)
+  : ::google::protobuf::Message(),
+    _internal_metadata_(NULL) {
+  SharedCtor();
+  MergeFrom(from);
+  // @@protoc_insertion_point(copy_constructor:protocol.PbftTxs)
+}
+
+void PbftTxs::SharedCtor() {
+    _is_default_instance_ = false;
+  ::google::protobuf::internal::GetEmptyString();
+  _cached_size_ = 0;
+  value_digest_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+
+PbftTxs::~PbftTxs() {
+  // @@protoc_insertion_point(destructor:protocol.PbftTxs)
+  SharedDtor();
+}
+
+void PbftTxs::SharedDtor() {
+  value_digest_.DestroyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  if (this != default_instance_) {
+  }
+}
+
+void PbftTxs::SetCachedSize(int size) const {
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+}
+const ::google::protobuf::Descriptor* PbftTxs::descriptor() {
+  protobuf_AssignDescriptorsOnce();
+  return PbftTxs_descriptor_;
+}
+
+const PbftTxs& PbftTxs::default_instance() {
+  if (default_instance_ == NULL) protobuf_AddDesc_overlay_2eproto();
+  return *default_instance_;
+}
+
+PbftTxs* PbftTxs::default_instance_ = NULL;
+
+PbftTxs* PbftTxs::New(::google::protobuf::Arena* arena) const {
+  PbftTxs* n = new PbftTxs;
+  if (arena != NULL) {
+    arena->Own(n);
+  }
+  return n;
+}
+
+void PbftTxs::Clear() {
+// @@protoc_insertion_point(message_clear_start:protocol.PbftTxs)
+  value_digest_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  indexes_.Clear();
+  txs_.Clear();
+}
+
+bool PbftTxs::MergePartialFromCodedStream(
+    ::google::protobuf::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!GOOGLE_PREDICT_TRUE(EXPRESSION)) goto failure
+  ::google::protobuf::uint32 tag;
+  // @@protoc_insertion_point(parse_start:protocol.PbftTxs)
+  for (;;) {
+    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
+    tag = p.first;
+    if (!p.second) goto handle_unusual;
+    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // optional bytes value_digest = 1;
+      case 1: {
+        if (tag == 10) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
+                input, this->mutable_value_digest()));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(18)) goto parse_indexes;
+        break;
+      }
+
+      // repeated int32 indexes = 2;
+      case 2: {
+        if (tag == 18) {
+         parse_indexes:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPackedPrimitive<
+                   ::google::protobuf::int32, ::google::protobuf::internal::WireFormatLite::TYPE_INT32>(
+                 input, this->mutable_indexes())));
+        } else if (tag == 16) {
+          DO_((::google::protobuf::internal::WireFormatLite::ReadRepeatedPrimitiveNoInline<
+                   ::google::protobuf::int32, ::google::protobuf::internal::WireFormatLite::TYPE_INT32>(
+                 1, 18, input, this->mutable_indexes())));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(26)) goto parse_txs;
+        break;
+      }
+
+      // repeated .protocol.TransactionEnv txs = 3;
+      case 3: {
+        if (tag == 26) {
+         parse_txs:
+          DO_(input->IncrementRecursionDepth());
+         parse_loop_txs:
+          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtualNoRecursionDepth(
+                input, add_txs()));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(26)) goto parse_loop_txs;
+        input->UnsafeDecrementRecursionDepth();
+        if (input->ExpectAtEnd()) goto success;
+        break;
+      }
+
+      default: {
+      handle_unusual:
+        if (tag == 0 ||
+            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
+          goto success;
+        }
+        DO_(::google::protobuf::internal::WireFormatLite::SkipField(input, tag));
+        break;
+      }
+    }
+  }
+success:
+  // @@protoc_insertion_point(parse_success:protocol.PbftTxs)
+  return true;
+failure:
+  // @@protoc_insertion_point(parse_failure:protocol.PbftTxs)
+  return false;
+#undef DO_
+}
+
+void PbftTxs::SerializeWithCachedSizes(
+    ::google::protobuf::io::CodedOutputStream* output) const {
+  // @@protoc_insertion_point(serialize_start:protocol.PbftTxs)
+  // optional bytes value_digest = 1;
+  if (this->value_digest().size() > 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytesMaybeAliased(
+      1, this->value_digest(), output);
+  }
+
+  // repeated int32 indexes = 2;
+  if (this->indexes_size() > 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteTag(2, ::google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED, output);
+    output->WriteVarint32(_indexes_cached_byte_size_);
+  }
+  for (int i = 0; i < this->indexes_size(); i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteInt32NoTag(
+      this->indexes(i), output);
+  }
+
+  // repeated .protocol.TransactionEnv txs = 3;
+  for (unsigned int i = 0, n = this->txs_size(); i < n; i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
+      3, this->txs(i), output);
+  }
+
+  // @@protoc_insertion_point(serialize_end:protocol.PbftTxs)
+}
+
+::google::protobuf::uint8* PbftTxs::InternalSerializeWithCachedSizesToArray(
+    bool deterministic, ::google::protobuf::uint8* target) const {
+  // @@protoc_insertion_point(serialize_to_array_start:protocol.PbftTxs)
+  // optional bytes value_digest = 1;
+  if (this->value_digest().size() > 0) {
+    target =
+      ::google::protobuf::internal::WireFormatLite::WriteBytesToArray(
+        1, this->value_digest(), target);
+  }
+
+  // repeated int32 indexes = 2;
+  if (this->indexes_size() > 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteTagToArray(
+      2,
+      ::google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED,
+      target);
+    target = ::google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(
+      _indexes_cached_byte_size_, target);
+  }
+  for (int i = 0; i < this->indexes_size(); i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      WriteInt32NoTagToArray(this->indexes(i), target);
+  }
+
+  // repeated .protocol.TransactionEnv txs = 3;
+  for (unsigned int i = 0, n = this->txs_size(); i < n; i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      InternalWriteMessageNoVirtualToArray(
+        3, this->txs(i), false, target);
+  }
+
+  // @@protoc_insertion_point(serialize_to_array_end:protocol.PbftTxs)
+  return target;
+}
+
+int PbftTxs::ByteSize() const {
+// @@protoc_insertion_point(message_byte_size_start:protocol.PbftTxs)
+  int total_size = 0;
+
+  // optional bytes value_digest = 1;
+  if (this->value_digest().size() > 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::BytesSize(
+        this->value_digest());
+  }
+
+  // repeated int32 indexes = 2;
+  {
+    int data_size = 0;
+    for (int i = 0; i < this->indexes_size(); i++) {
+      data_size += ::google::protobuf::internal::WireFormatLite::
+        Int32Size(this->indexes(i));
+    }
+    if (data_size > 0) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::Int32Size(data_size);
+    }
+    GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+    _indexes_cached_byte_size_ = data_size;
+    GOOGLE_SAFE_CONCURRENT_WRITES_END();
+    total_size += data_size;
+  }
+
+  // repeated .protocol.TransactionEnv txs = 3;
+  total_size += 1 * this->txs_size();
+  for (int i = 0; i < this->txs_size(); i++) {
+    total_size +=
+      ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
+        this->txs(i));
+  }
+
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = total_size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+  return total_size;
+}
+
+void PbftTxs::MergeFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:protocol.PbftTxs)
+  if (GOOGLE_PREDICT_FALSE(&from == this)) {
+    ::google::protobuf::internal::MergeFromFail(__FILE__, __LINE__);
+  }
+  const PbftTxs* source = 
+      ::google::protobuf::internal::DynamicCastToGenerated<const PbftTxs>(
+          &from);
+  if (source == NULL) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:protocol.PbftTxs)
+    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:protocol.PbftTxs)
+    MergeFrom(*source);
+  }
+}
+
+void PbftTxs::MergeFrom(const PbftTxs& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:protocol.PbftTxs)
+  if (GOOGLE_PREDICT_FALSE(&from == this)) {
+    ::google::protobuf::internal::MergeFromFail(__FILE__, __LINE__);
+  }
+  indexes_.MergeFrom(from.indexes_);
+  txs_.MergeFrom(from.txs_);
+  if (from.value_digest().size() > 0) {
+
+    value_digest_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.value_digest_);
+  }
+}
+
+void PbftTxs::CopyFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:protocol.PbftTxs)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void PbftTxs::CopyFrom(const PbftTxs& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:protocol.PbftTxs)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool PbftTxs::IsInitialized() const {
+
+  return true;
+}
+
+void PbftTxs::Swap(PbftTxs* other) {
+  if (other == this) return;
+  InternalSwap(other);
+}
+void PbftTxs::InternalSwap(PbftTxs* other) {
+  value_digest_.Swap(&other->value_digest_);
+  indexes_.UnsafeArenaSwap(&other->indexes_);
+  txs_.UnsafeArenaSwap(&other->txs_);
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+  std::swap(_cached_size_, other->_cached_size_);
+}
+
+::google::protobuf::Metadata PbftTxs::GetMetadata() const {
+  protobuf_AssignDescriptorsOnce();
+  ::google::protobuf::Metadata metadata;
+  metadata.descriptor = PbftTxs_descriptor_;
+  metadata.reflection = PbftTxs_reflection_;
+  return metadata;
+}
+
+#if PROTOBUF_INLINE_NOT_IN_HEADERS
+// PbftTxs
+
+// optional bytes value_digest = 1;
+void PbftTxs::clear_value_digest() {
+  value_digest_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ const ::std::string& PbftTxs::value_digest() const {
+  // @@protoc_insertion_point(field_get:protocol.PbftTxs.value_digest)
+  return value_digest_.GetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ void PbftTxs::set_value_digest(const ::std::string& value) {
+  
+  value_digest_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:protocol.PbftTxs.value_digest)
+}
+ void PbftTxs::set_value_digest(const char* value) {
+  
+  value_digest_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:protocol.PbftTxs.value_digest)
+}
+ void PbftTxs::set_value_digest(const void* value, size_t size) {
+  
+  value_digest_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:protocol.PbftTxs.value_digest)
+}
+ ::std::string* PbftTxs::mutable_value_digest() {
+  
+  // @@protoc_insertion_point(field_mutable:protocol.PbftTxs.value_digest)
+  return value_digest_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ ::std::string* PbftTxs::release_value_digest() {
+  // @@protoc_insertion_point(field_release:protocol.PbftTxs.value_digest)
+  
+  return value_digest_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ void PbftTxs::set_allocated_value_digest(::std::string* value_digest) {
+  if (value_digest != NULL) {
+    
+  } else {
+    
+  }
+  value_digest_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value_digest);
+  // @@protoc_insertion_point(field_set_allocated:protocol.PbftTxs.value_digest)
+}
+
+// repeated int32 indexes = 2;
+int PbftTxs::indexes_size() const {
+  return indexes_.size();
+}
+void PbftTxs::clear_indexes() {
+  indexes_.Clear();
+}
+ ::google::protobuf::int32 PbftTxs::indexes(int index) const {
+  // @@protoc_insertion_point(field_get:protocol.PbftTxs.indexes)
+  return indexes_.Get(index);
+}
+ void PbftTxs::set_indexes(int index, ::google::protobuf::int32 value) {
+  indexes_.Set(index, value);
+  // @@protoc_insertion_point(field_set:protocol.PbftTxs.indexes)
+}
+ void PbftTxs::add_indexes(::google::protobuf::int32 value) {
+  indexes_.Add(value);
+  // @@protoc_insertion_point(field_add:protocol.PbftTxs.indexes)
+}
+ const ::google::protobuf::RepeatedField< ::google::protobuf::int32 >&
+PbftTxs::indexes() const {
+  // @@protoc_insertion_point(field_list:protocol.PbftTxs.indexes)
+  return indexes_;
+}
+ ::google::protobuf::RepeatedField< ::google::protobuf::int32 >*
+PbftTxs::mutable_indexes() {
+  // @@protoc_insertion_point(field_mutable_list:protocol.PbftTxs.indexes)
+  return &indexes_;
+}
+
+// repeated .protocol.TransactionEnv txs = 3;
+int PbftTxs::txs_size() const {
+  return txs_.size();
+}
+void PbftTxs::clear_txs() {
+  txs_.Clear();
+}
+const ::protocol::TransactionEnv& PbftTxs::txs(int index) const {
+  // @@protoc_insertion_point(field_get:protocol.PbftTxs.txs)
+  return txs_.Get(index);
+}
+::protocol::TransactionEnv* PbftTxs::mutable_txs(int index) {
+  // @@protoc_insertion_point(field_mutable:protocol.PbftTxs.txs)
+  return txs_.Mutable(index);
+}
+::protocol::TransactionEnv* PbftTxs::add_txs() {
+  // @@protoc_insertion_point(field_add:protocol.PbftTxs.txs)
+  return txs_.Add();
+}
+::google::protobuf::RepeatedPtrField< ::protocol::TransactionEnv >*
+PbftTxs::mutable_txs() {
+  // @@protoc_insertion_point(field_mutable_list:protocol.PbftTxs.txs)
+  return &txs_;
+}
+const ::google::protobuf::RepeatedPtrField< ::protocol::TransactionEnv >&
+PbftTxs::txs() const {
+  // @@protoc_insertion_point(field_list:protocol.PbftTxs.txs)
+  return txs_;
+}
+
+#endif  // PROTOBUF_INLINE_NOT_IN_HEADERS
+
+// ===================================================================
+
+#if !defined(_MSC_VER) || _MSC_VER >= 1900
+const int TransactionInv::kHashesFieldNumber;
+#endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
+
+TransactionInv::TransactionInv()
+  : ::google::protobuf::Message(), _internal_metadata_(NULL) {
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:protocol.TransactionInv)
+}
+
+void TransactionInv::InitAsDefaultInstance() {
+  _is_default_instance_ = true;
+}
+
+TransactionInv::TransactionInv(const TransactionInv& from)
+  : ::google::protobuf::Message(),
+    _internal_metadata_(NULL) {
+  SharedCtor();
+  MergeFrom(from);
+  // @@protoc_insertion_point(copy_constructor:protocol.TransactionInv)
+}
+
+void TransactionInv::SharedCtor() {
+    _is_default_instance_ = false;
+  ::google::protobuf::internal::GetEmptyString();
+  _cached_size_ = 0;
+}
+
+TransactionInv::~TransactionInv() {
+  // @@protoc_insertion_point(destructor:protocol.TransactionInv)
+  SharedDtor();
+}
+
+void TransactionInv::SharedDtor() {
+  if (this != default_instance_) {
+  }
+}
+
+void TransactionInv::SetCachedSize(int size) const {
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+}
+const ::google::protobuf::Descriptor* TransactionInv::descriptor() {
+  protobuf_AssignDescriptorsOnce();
+  return TransactionInv_descriptor_;
+}
+
+const TransactionInv& TransactionInv::default_instance() {
+  if (default_instance_ == NULL) protobuf_AddDesc_overlay_2eproto();
+  return *default_instance_;
+}
+
+TransactionInv* TransactionInv::default_instance_ = NULL;
+
+TransactionInv* TransactionInv::New(::google::protobuf::Arena* arena) const {
+  TransactionInv* n = new TransactionInv;
+  if (arena != NULL) {
+    arena->Own(n);
+  }
+  return n;
+}
+
+void TransactionInv::Clear() {
+// @@protoc_insertion_point(message_clear_start:protocol.TransactionInv)
+  hashes_.Clear();
+}
+
+bool TransactionInv::MergePartialFromCodedStream(
+    ::google::protobuf::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!GOOGLE_PREDICT_TRUE(EXPRESSION)) goto failure
+  ::google::protobuf::uint32 tag;
+  // @@protoc_insertion_point(parse_start:protocol.TransactionInv)
+  for (;;) {
+    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
+    tag = p.first;
+    if (!p.second) goto handle_unusual;
+    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // repeated bytes hashes = 1;
+      case 1: {
+        if (tag == 10) {
+         parse_hashes:
+          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
+                input, this->add_hashes()));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(10)) goto parse_hashes;
+        if (input->ExpectAtEnd()) goto success;
+        break;
+      }
+
+      default: {
+      handle_unusual:
+        if (tag == 0 ||
+            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
+          goto success;
+        }
+        DO_(::google::protobuf::internal::WireFormatLite::SkipField(input, tag));
+        break;
+      }
+    }
+  }
+success:
+  // @@protoc_insertion_point(parse_success:protocol.TransactionInv)
+  return true;
+failure:
+  // @@protoc_insertion_point(parse_failure:protocol.TransactionInv)
+  return false;
+#undef DO_
+}
+
+void TransactionInv::SerializeWithCachedSizes(
+    ::google::protobuf::io::CodedOutputStream* output) const {
+  // @@protoc_insertion_point(serialize_start:protocol.TransactionInv)
+  // repeated bytes hashes = 1;
+  for (int i = 0; i < this->hashes_size(); i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytes(
+      1, this->hashes(i), output);
+  }
+
+  // @@protoc_insertion_point(serialize_end:protocol.TransactionInv)
+}
+
+::google::protobuf::uint8* TransactionInv::InternalSerializeWithCachedSizesToArray(
+    bool deterministic, ::google::protobuf::uint8* target) const {
+  // @@protoc_insertion_point(serialize_to_array_start:protocol.TransactionInv)
+  // repeated bytes hashes = 1;
+  for (int i = 0; i < this->hashes_size(); i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      WriteBytesToArray(1, this->hashes(i), target);
+  }
+
+  // @@protoc_insertion_point(serialize_to_array_end:protocol.TransactionInv)
+  return target;
+}
+
+int TransactionInv::ByteSize() const {
+// @@protoc_insertion_point(message_byte_size_start:protocol.TransactionInv)
+  int total_size = 0;
+
+  // repeated bytes hashes = 1;
+  total_size += 1 * this->hashes_size();
+  for (int i = 0; i < this->hashes_size(); i++) {
+    total_size += ::google::protobuf::internal::WireFormatLite::BytesSize(
+      this->hashes(i));
+  }
+
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = total_size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+  return total_size;
+}
+
+void TransactionInv::MergeFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:protocol.TransactionInv)
+  if (GOOGLE_PREDICT_FALSE(&from == this)) {
+    ::google::protobuf::internal::MergeFromFail(__FILE__, __LINE__);
+  }
+  const TransactionInv* source = 
+      ::google::protobuf::internal::DynamicCastToGenerated<const TransactionInv>(
+          &from);
+  if (source == NULL) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:protocol.TransactionInv)
+    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:protocol.TransactionInv)
+    MergeFrom(*source);
+  }
+}
+
+void TransactionInv::MergeFrom(const TransactionInv& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:protocol.TransactionInv)
+  if (GOOGLE_PREDICT_FALSE(&from == this)) {
+    ::google::protobuf::internal::MergeFromFail(__FILE__, __LINE__);
+  }
+  hashes_.MergeFrom(from.hashes_);
+}
+
+void TransactionInv::CopyFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:protocol.TransactionInv)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void TransactionInv::CopyFrom(const TransactionInv& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:protocol.TransactionInv)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool TransactionInv::IsInitialized() const {
+
+  return true;
+}
+
+void TransactionInv::Swap(TransactionInv* other) {
+  if (other == this) return;
+  InternalSwap(other);
+}
+void TransactionInv::InternalSwap(TransactionInv* other) {
+  hashes_.UnsafeArenaSwap(&other->hashes_);
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+  std::swap(_cached_size_, other->_cached_size_);
+}
+
+::google::protobuf::Metadata TransactionInv::GetMetadata() const {
+  protobuf_AssignDescriptorsOnce();
+  ::google::protobuf::Metadata metadata;
+  metadata.descriptor = TransactionInv_descriptor_;
+  metadata.reflection = TransactionInv_reflection_;
+  return metadata;
+}
+
+#if PROTOBUF_INLINE_NOT_IN_HEADERS
+// TransactionInv
+
+// repeated bytes hashes = 1;
+int TransactionInv::hashes_size() const {
+  return hashes_.size();
+}
+void TransactionInv::clear_hashes() {
+  hashes_.Clear();
+}
+ const ::std::string& TransactionInv::hashes(int index) const {
+  // @@protoc_insertion_point(field_get:protocol.TransactionInv.hashes)
+  return hashes_.Get(index);
+}
+ ::std::string* TransactionInv::mutable_hashes(int index) {
+  // @@protoc_insertion_point(field_mutable:protocol.TransactionInv.hashes)
+  return hashes_.Mutable(index);
+}
+ void TransactionInv::set_hashes(int index, const ::std::string& value) {
+  // @@protoc_insertion_point(field_set:protocol.TransactionInv.hashes)
+  hashes_.Mutable(index)->assign(value);
+}
+ void TransactionInv::set_hashes(int index, const char* value) {
+  hashes_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set_char:protocol.TransactionInv.hashes)
+}
+ void TransactionInv::set_hashes(int index, const void* value, size_t size) {
+  hashes_.Mutable(index)->assign(
+    reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_set_pointer:protocol.TransactionInv.hashes)
+}
+ ::std::string* TransactionInv::add_hashes() {
+  // @@protoc_insertion_point(field_add_mutable:protocol.TransactionInv.hashes)
+  return hashes_.Add();
+}
+ void TransactionInv::add_hashes(const ::std::string& value) {
+  hashes_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add:protocol.TransactionInv.hashes)
+}
+ void TransactionInv::add_hashes(const char* value) {
+  hashes_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add_char:protocol.TransactionInv.hashes)
+}
+ void TransactionInv::add_hashes(const void* value, size_t size) {
+  hashes_.Add()->assign(reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_add_pointer:protocol.TransactionInv.hashes)
+}
+ const ::google::protobuf::RepeatedPtrField< ::std::string>&
+TransactionInv::hashes() const {
+  // @@protoc_insertion_point(field_list:protocol.TransactionInv.hashes)
+  return hashes_;
+}
+ ::google::protobuf::RepeatedPtrField< ::std::string>*
+TransactionInv::mutable_hashes() {
+  // @@protoc_insertion_point(field_mutable_list:protocol.TransactionInv.hashes)
+  return &hashes_;
+}
+
+#endif  // PROTOBUF_INLINE_NOT_IN_HEADERS
+
+// ===================================================================
+
 #if !defined(_MSC_VER) || _MSC_VER >= 1900
 const int EntryList::kEntryFieldNumber;
 #endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
@@ -29,6 +29,7 @@
 #include <google/protobuf/unknown_field_set.h>
 #include "common.pb.h"
 #include "chain.pb.h"
+#include "consensus.pb.h"
 // @@protoc_insertion_point(includes)
 
 namespace protocol {
@@ -47,12 +48,16 @@ class ChainTxStatus;
 class DontHave;
 class EntryList;
 class GetLedgers;
+class GetPbftTxs;
 class Hello;
 class HelloResponse;
 class LedgerUpgradeNotify;
 class Ledgers;
+class PbftCompactEnv;
+class PbftTxs;
 class Peer;
 class Peers;
+class TransactionInv;
 
 enum Ledgers_SyncCode {
   Ledgers_SyncCode_OK = 0,
@@ -112,12 +117,16 @@ enum OVERLAY_MESSAGE_TYPE {
   OVERLAY_MSGTYPE_LEDGERS = 5,
   OVERLAY_MSGTYPE_PBFT = 6,
   OVERLAY_MSGTYPE_LEDGER_UPGRADE_NOTIFY = 7,
+  OVERLAY_MSGTYPE_PBFT_COMPACT = 8,
+  OVERLAY_MSGTYPE_PBFT_TXS = 9,
+  OVERLAY_MSGTYPE_TX_INV = 10,
+  OVERLAY_MSGTYPE_GET_TXS = 11,
   OVERLAY_MESSAGE_TYPE_INT_MIN_SENTINEL_DO_NOT_USE_ = ::google::protobuf::kint32min,
   OVERLAY_MESSAGE_TYPE_INT_MAX_SENTINEL_DO_NOT_USE_ = ::google::protobuf::kint32max
 };
 bool OVERLAY_MESSAGE_TYPE_IsValid(int value);
 const OVERLAY_MESSAGE_TYPE OVERLAY_MESSAGE_TYPE_MIN = OVERLAY_MSGTYPE_NONE;
-const OVERLAY_MESSAGE_TYPE OVERLAY_MESSAGE_TYPE_MAX = OVERLAY_MSGTYPE_LEDGER_UPGRADE_NOTIFY;
+const OVERLAY_MESSAGE_TYPE OVERLAY_MESSAGE_TYPE_MAX = OVERLAY_MSGTYPE_GET_TXS;
 const int OVERLAY_MESSAGE_TYPE_ARRAYSIZE = OVERLAY_MESSAGE_TYPE_MAX + 1;
 
 const ::google::protobuf::EnumDescriptor* OVERLAY_MESSAGE_TYPE_descriptor();
@@ -278,6 +287,18 @@ class Hello : public ::google::protobuf::Message /* @@protoc_insertion_point(cla
   ::std::string* release_node_rand();
   void set_allocated_node_rand(::std::string* node_rand);
 
+  // optional bool compression = 8;
+  void clear_compression();
+  static const int kCompressionFieldNumber = 8;
+  bool compression() const;
+  void set_compression(bool value);
+
+  // optional bool batch = 9;
+  void clear_batch();
+  static const int kBatchFieldNumber = 9;
+  bool batch() const;
+  void set_batch(bool value);
+
   // @@protoc_insertion_point(class_scope:protocol.Hello)
  private:
 
@@ -290,6 +311,8 @@ class Hello : public ::google::protobuf::Message /* @@protoc_insertion_point(cla
   ::google::protobuf::int64 listening_port_;
   ::google::protobuf::internal::ArenaStringPtr node_address_;
   ::google::protobuf::internal::ArenaStringPtr node_rand_;
+  bool compression_;
+  bool batch_;
   mutable int _cached_size_;
   friend void  protobuf_AddDesc_overlay_2eproto();
   friend void protobuf_AssignDesc_overlay_2eproto();
@@ -1044,6 +1067,415 @@ class LedgerUpgradeNotify : public ::google::protobuf::Message /* @@protoc_inser
 };
 // -------------------------------------------------------------------
 
+class PbftCompactEnv : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:protocol.PbftCompactEnv) */ {
+ public:
+  PbftCompactEnv();
+  virtual ~PbftCompactEnv();
+
+  PbftCompactEnv(const PbftCompactEnv& from);
+
+  inline PbftCompactEnv& operator=(const PbftCompactEnv& from) {
+    CopyFrom(from);
+    return *this;
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor();
+  static const PbftCompactEnv& default_instance();
+
+  void Swap(PbftCompactEnv* other);
+
+  // implements Message ----------------------------------------------
+
+  inline PbftCompactEnv* New() const { return New(NULL); }
+
+  PbftCompactEnv* New(::google::protobuf::Arena* arena) const;
+  void CopyFrom(const ::google::protobuf::Message& from);
+  void MergeFrom(const ::google::protobuf::Message& from);
+  void CopyFrom(const PbftCompactEnv& from);
+  void MergeFrom(const PbftCompactEnv& from);
+  void Clear();
+  bool IsInitialized() const;
+
+  int ByteSize() const;
+  bool MergePartialFromCodedStream(
+      ::google::protobuf::io::CodedInputStream* input);
+  void SerializeWithCachedSizes(
+      ::google::protobuf::io::CodedOutputStream* output) const;
+  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
+      bool deterministic, ::google::protobuf::uint8* output) const;
+  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const {
+    return InternalSerializeWithCachedSizesToArray(false, output);
+  }
+  int GetCachedSize() const { return _cached_size_; }
+  private:
+  void SharedCtor();
+  void SharedDtor();
+  void SetCachedSize(int size) const;
+  void InternalSwap(PbftCompactEnv* other);
+  private:
+  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
+    return _internal_metadata_.arena();
+  }
+  inline void* MaybeArenaPtr() const {
+    return _internal_metadata_.raw_arena_ptr();
+  }
+  public:
+
+  ::google::protobuf::Metadata GetMetadata() const;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // optional .protocol.PbftEnv env = 1;
+  bool has_env() const;
+  void clear_env();
+  static const int kEnvFieldNumber = 1;
+  const ::protocol::PbftEnv& env() const;
+  ::protocol::PbftEnv* mutable_env();
+  ::protocol::PbftEnv* release_env();
+  void set_allocated_env(::protocol::PbftEnv* env);
+
+  // repeated bytes tx_hashes = 2;
+  int tx_hashes_size() const;
+  void clear_tx_hashes();
+  static const int kTxHashesFieldNumber = 2;
+  const ::std::string& tx_hashes(int index) const;
+  ::std::string* mutable_tx_hashes(int index);
+  void set_tx_hashes(int index, const ::std::string& value);
+  void set_tx_hashes(int index, const char* value);
+  void set_tx_hashes(int index, const void* value, size_t size);
+  ::std::string* add_tx_hashes();
+  void add_tx_hashes(const ::std::string& value);
+  void add_tx_hashes(const char* value);
+  void add_tx_hashes(const void* value, size_t size);
+  const ::google::protobuf::RepeatedPtrField< ::std::string>& tx_hashes() const;
+  ::google::protobuf::RepeatedPtrField< ::std::string>* mutable_tx_hashes();
+
+  // @@protoc_insertion_point(class_scope:protocol.PbftCompactEnv)
+ private:
+
+  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
+  bool _is_default_instance_;
+  ::protocol::PbftEnv* env_;
+  ::google::protobuf::RepeatedPtrField< ::std::string> tx_hashes_;
+  mutable int _cached_size_;
+  friend void  protobuf_AddDesc_overlay_2eproto();
+  friend void protobuf_AssignDesc_overlay_2eproto();
+  friend void protobuf_ShutdownFile_overlay_2eproto();
+
+  void InitAsDefaultInstance();
+  static PbftCompactEnv* default_instance_;
+};
+// -------------------------------------------------------------------
+
+class GetPbftTxs : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:protocol.GetPbftTxs) */ {
+ public:
+  GetPbftTxs();
+  virtual ~GetPbftTxs();
+
+  GetPbftTxs(const GetPbftTxs& from);
+
+  inline GetPbftTxs& operator=(const GetPbftTxs& from) {
+    CopyFrom(from);
+    return *this;
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor();
+  static const GetPbftTxs& default_instance();
+
+  void Swap(GetPbftTxs* other);
+
+  // implements Message ----------------------------------------------
+
+  inline GetPbftTxs* New() const { return New(NULL); }
+
+  GetPbftTxs* New(::google::protobuf::Arena* arena) const;
+  void CopyFrom(const ::google::protobuf::Message& from);
+  void MergeFrom(const ::google::protobuf::Message& from);
+  void CopyFrom(const GetPbftTxs& from);
+  void MergeFrom(const GetPbftTxs& from);
+  void Clear();
+  bool IsInitialized() const;
+
+  int ByteSize() const;
+  bool MergePartialFromCodedStream(
+      ::google::protobuf::io::CodedInputStream* input);
+  void SerializeWithCachedSizes(
+      ::google::protobuf::io::CodedOutputStream* output) const;
+  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
+      bool deterministic, ::google::protobuf::uint8* output) const;
+  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const {
+    return InternalSerializeWithCachedSizesToArray(false, output);
+  }
+  int GetCachedSize() const { return _cached_size_; }
+  private:
+  void SharedCtor();
+  void SharedDtor();
+  void SetCachedSize(int size) const;
+  void InternalSwap(GetPbftTxs* other);
+  private:
+  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
+    return _internal_metadata_.arena();
+  }
+  inline void* MaybeArenaPtr() const {
+    return _internal_metadata_.raw_arena_ptr();
+  }
+  public:
+
+  ::google::protobuf::Metadata GetMetadata() const;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // optional bytes value_digest = 1;
+  void clear_value_digest();
+  static const int kValueDigestFieldNumber = 1;
+  const ::std::string& value_digest() const;
+  void set_value_digest(const ::std::string& value);
+  void set_value_digest(const char* value);
+  void set_value_digest(const void* value, size_t size);
+  ::std::string* mutable_value_digest();
+  ::std::string* release_value_digest();
+  void set_allocated_value_digest(::std::string* value_digest);
+
+  // repeated int32 indexes = 2;
+  int indexes_size() const;
+  void clear_indexes();
+  static const int kIndexesFieldNumber = 2;
+  ::google::protobuf::int32 indexes(int index) const;
+  void set_indexes(int index, ::google::protobuf::int32 value);
+  void add_indexes(::google::protobuf::int32 value);
+  const ::google::protobuf::RepeatedField< ::google::protobuf::int32 >&
+      indexes() const;
+  ::google::protobuf::RepeatedField< ::google::protobuf::int32 >*
+      mutable_indexes();
+
+  // @@protoc_insertion_point(class_scope:protocol.GetPbftTxs)
+ private:
+
+  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
+  bool _is_default_instance_;
+  ::google::protobuf::internal::ArenaStringPtr value_digest_;
+  ::google::protobuf::RepeatedField< ::google::protobuf::int32 > indexes_;
+  mutable int _indexes_cached_byte_size_;
+  mutable int _cached_size_;
+  friend void  protobuf_AddDesc_overlay_2eproto();
+  friend void protobuf_AssignDesc_overlay_2eproto();
+  friend void protobuf_ShutdownFile_overlay_2eproto();
+
+  void InitAsDefaultInstance();
+  static GetPbftTxs* default_instance_;
+};
+// -------------------------------------------------------------------
+
+class PbftTxs : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:protocol.PbftTxs) */ {
+ public:
+  PbftTxs();
+  virtual ~PbftTxs();
+
+  PbftTxs(const PbftTxs& from);
+
+  inline PbftTxs& operator=(const PbftTxs& from) {
+    CopyFrom(from);
+    return *this;
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor();
+  static const PbftTxs& default_instance();
+
+  void Swap(PbftTxs* other);
+
+  // implements Message ----------------------------------------------
+
+  inline PbftTxs* New() const { return New(NULL); }
+
+  PbftTxs* New(::google::protobuf::Arena* arena) const;
+  void CopyFrom(const ::google::protobuf::Message& from);
+  void MergeFrom(const ::google::protobuf::Message& from);
+  void CopyFrom(const PbftTxs& from);
+  void MergeFrom(const PbftTxs& from);
+  void Clear();
+  bool IsInitialized() const;
+
+  int ByteSize() const;
+  bool MergePartialFromCodedStream(
+      ::google::protobuf::io::CodedInputStream* input);
+  void SerializeWithCachedSizes(
+      ::google::protobuf::io::CodedOutputStream* output) const;
+  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
+      bool deterministic, ::google::protobuf::uint8* output) const;
+  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const {
+    return InternalSerializeWithCachedSizesToArray(false, output);
+  }
+  int GetCachedSize() const { return _cached_size_; }
+  private:
+  void SharedCtor();
+  void SharedDtor();
+  void SetCachedSize(int size) const;
+  void InternalSwap(PbftTxs* other);
+  private:
+  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
+    return _internal_metadata_.arena();
+  }
+  inline void* MaybeArenaPtr() const {
+    return _internal_metadata_.raw_arena_ptr();
+  }
+  public:
+
+  ::google::protobuf::Metadata GetMetadata() const;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // optional bytes value_digest = 1;
+  void clear_value_digest();
+  static const int kValueDigestFieldNumber = 1;
+  const ::std::string& value_digest() const;
+  void set_value_digest(const ::std::string& value);
+  void set_value_digest(const char* value);
+  void set_value_digest(const void* value, size_t size);
+  ::std::string* mutable_value_digest();
+  ::std::string* release_value_digest();
+  void set_allocated_value_digest(::std::string* value_digest);
+
+  // repeated int32 indexes = 2;
+  int indexes_size() const;
+  void clear_indexes();
+  static const int kIndexesFieldNumber = 2;
+  ::google::protobuf::int32 indexes(int index) const;
+  void set_indexes(int index, ::google::protobuf::int32 value);
+  void add_indexes(::google::protobuf::int32 value);
+  const ::google::protobuf::RepeatedField< ::google::protobuf::int32 >&
+      indexes() const;
+  ::google::protobuf::RepeatedField< ::google::protobuf::int32 >*
+      mutable_indexes();
+
+  // repeated .protocol.TransactionEnv txs = 3;
+  int txs_size() const;
+  void clear_txs();
+  static const int kTxsFieldNumber = 3;
+  const ::protocol::TransactionEnv& txs(int index) const;
+  ::protocol::TransactionEnv* mutable_txs(int index);
+  ::protocol::TransactionEnv* add_txs();
+  ::google::protobuf::RepeatedPtrField< ::protocol::TransactionEnv >*
+      mutable_txs();
+  const ::google::protobuf::RepeatedPtrField< ::protocol::TransactionEnv >&
+      txs() const;
+
+  // @@protoc_insertion_point(class_scope:protocol.PbftTxs)
+ private:
+
+  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
+  bool _is_default_instance_;
+  ::google::protobuf::internal::ArenaStringPtr value_digest_;
+  ::google::protobuf::RepeatedField< ::google::protobuf::int32 > indexes_;
+  mutable int _indexes_cached_byte_size_;
+  ::google::protobuf::RepeatedPtrField< ::protocol::TransactionEnv > txs_;
+  mutable int _cached_size_;
+  friend void  protobuf_AddDesc_overlay_2eproto();
+  friend void protobuf_AssignDesc_overlay_2eproto();
+  friend void protobuf_ShutdownFile_overlay_2eproto();
+
+  void InitAsDefaultInstance();
+  static PbftTxs* default_instance_;
+};
+// -------------------------------------------------------------------
+
+class TransactionInv : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:protocol.TransactionInv) */ {
+ public:
+  TransactionInv();
+  virtual ~TransactionInv();
+
+  TransactionInv(const TransactionInv& from);
+
+  inline TransactionInv& operator=(const TransactionInv& from) {
+    CopyFrom(from);
+    return *this;
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor();
+  static const TransactionInv& default_instance();
+
+  void Swap(TransactionInv* other);
+
+  // implements Message ----------------------------------------------
+
+  inline TransactionInv* New() const { return New(NULL); }
+
+  TransactionInv* New(::google::protobuf::Arena* arena) const;
+  void CopyFrom(const ::google::protobuf::Message& from);
+  void MergeFrom(const ::google::protobuf::Message& from);
+  void CopyFrom(const TransactionInv& from);
+  void MergeFrom(const TransactionInv& from);
+  void Clear();
+  bool IsInitialized() const;
+
+  int ByteSize() const;
+  bool MergePartialFromCodedStream(
+      ::google::protobuf::io::CodedInputStream* input);
+  void SerializeWithCachedSizes(
+      ::google::protobuf::io::CodedOutputStream* output) const;
+  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
+      bool deterministic, ::google::protobuf::uint8* output) const;
+  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const {
+    return InternalSerializeWithCachedSizesToArray(false, output);
+  }
+  int GetCachedSize() const { return _cached_size_; }
+  private:
+  void SharedCtor();
+  void SharedDtor();
+  void SetCachedSize(int size) const;
+  void InternalSwap(TransactionInv* other);
+  private:
+  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
+    return _internal_metadata_.arena();
+  }
+  inline void* MaybeArenaPtr() const {
+    return _internal_metadata_.raw_arena_ptr();
+  }
+  public:
+
+  ::google::protobuf::Metadata GetMetadata() const;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // repeated bytes hashes = 1;
+  int hashes_size() const;
+  void clear_hashes();
+  static const int kHashesFieldNumber = 1;
+  const ::std::string& hashes(int index) const;
+  ::std::string* mutable_hashes(int index);
+  void set_hashes(int index, const ::std::string& value);
+  void set_hashes(int index, const char* value);
+  void set_hashes(int index, const void* value, size_t size);
+  ::std::string* add_hashes();
+  void add_hashes(const ::std::string& value);
+  void add_hashes(const char* value);
+  void add_hashes(const void* value, size_t size);
+  const ::google::protobuf::RepeatedPtrField< ::std::string>& hashes() const;
+  ::google::protobuf::RepeatedPtrField< ::std::string>* mutable_hashes();
+
+  // @@protoc_insertion_point(class_scope:protocol.TransactionInv)
+ private:
+
+  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
+  bool _is_default_instance_;
+  ::google::protobuf::RepeatedPtrField< ::std::string> hashes_;
+  mutable int _cached_size_;
+  friend void  protobuf_AddDesc_overlay_2eproto();
+  friend void protobuf_AssignDesc_overlay_2eproto();
+  friend void protobuf_ShutdownFile_overlay_2eproto();
+
+  void InitAsDefaultInstance();
+  static TransactionInv* default_instance_;
+};
+// -------------------------------------------------------------------
+
 class EntryList : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:protocol.EntryList) */ {
  public:
   EntryList();
@@ -2031,6 +2463,34 @@ inline void Hello::set_allocated_node_rand(::std::string* node_rand) {
   // @@protoc_insertion_point(field_set_allocated:protocol.Hello.node_rand)
 }
 
+// optional bool compression = 8;
+inline void Hello::clear_compression() {
+  compression_ = false;
+}
+inline bool Hello::compression() const {
+  // @@protoc_insertion_point(field_get:protocol.Hello.compression)
+  return compression_;
+}
+inline void Hello::set_compression(bool value) {
+  
+  compression_ = value;
+  // @@protoc_insertion_point(field_set:protocol.Hello.compression)
+}
+
+// optional bool batch = 9;
+inline void Hello::clear_batch() {
+  batch_ = false;
+}
+inline bool Hello::batch() const {
+  // @@protoc_insertion_point(field_get:protocol.Hello.batch)
+  return batch_;
+}
+inline void Hello::set_batch(bool value) {
+  
+  batch_ = value;
+  // @@protoc_insertion_point(field_set:protocol.Hello.batch)
+}
+
 // -------------------------------------------------------------------
 
 // HelloResponse
@@ -2555,6 +3015,348 @@ inline void LedgerUpgradeNotify::set_allocated_signature(::protocol::Signature*
 
 // -------------------------------------------------------------------
 
+// PbftCompactEnv
+
+// optional .protocol.PbftEnv env = 1;
+inline bool PbftCompactEnv::has_env() const {
+  return !_is_default_instance_ && env_ != NULL;
+}
+inline void PbftCompactEnv::clear_env() {
+  if (GetArenaNoVirtual() == NULL && env_ != NULL) delete env_;
+  env_ = NULL;
+}
+inline const ::protocol::PbftEnv& PbftCompactEnv::env() const {
+  // @@protoc_insertion_point(field_get:protocol.PbftCompactEnv.env)
+  return env_ != NULL ? *env_ : *default_instance_->env_;
+}
+inline ::protocol::PbftEnv* PbftCompactEnv::mutable_env() {
+  
+  if (env_ == NULL) {
+    env_ = new ::protocol::PbftEnv;
+  }
+  // @@protoc_insertion_point(field_mutable:protocol.PbftCompactEnv.env)
+  return env_;
+}
+inline ::protocol::PbftEnv* PbftCompactEnv::release_env() {
+  // @@protoc_insertion_point(field_release:protocol.PbftCompactEnv.env)
+  
+  ::protocol::PbftEnv* temp = env_;
+  env_ = NULL;
+  return temp;
+}
+inline void PbftCompactEnv::set_allocated_env(::protocol::PbftEnv* env) {
+  delete env_;
+  env_ = env;
+  if (env) {
+    
+  } else {
+    
+  }
+  // @@protoc_insertion_point(field_set_allocated:protocol.PbftCompactEnv.env)
+}
+
+// repeated bytes tx_hashes = 2;
+inline int PbftCompactEnv::tx_hashes_size() const {
+  return tx_hashes_.size();
+}
+inline void PbftCompactEnv::clear_tx_hashes() {
+  tx_hashes_.Clear();
+}
+inline const ::std::string& PbftCompactEnv::tx_hashes(int index) const {
+  // @@protoc_insertion_point(field_get:protocol.PbftCompactEnv.tx_hashes)
+  return tx_hashes_.Get(index);
+}
+inline ::std::string* PbftCompactEnv::mutable_tx_hashes(int index) {
+  // @@protoc_insertion_point(field_mutable:protocol.PbftCompactEnv.tx_hashes)
+  return tx_hashes_.Mutable(index);
+}
+inline void PbftCompactEnv::set_tx_hashes(int index, const ::std::string& value) {
+  // @@protoc_insertion_point(field_set:protocol.PbftCompactEnv.tx_hashes)
+  tx_hashes_.Mutable(index)->assign(value);
+}
+inline void PbftCompactEnv::set_tx_hashes(int index, const char* value) {
+  tx_hashes_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set_char:protocol.PbftCompactEnv.tx_hashes)
+}
+inline void PbftCompactEnv::set_tx_hashes(int index, const void* value, size_t size) {
+  tx_hashes_.Mutable(index)->assign(
+    reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_set_pointer:protocol.PbftCompactEnv.tx_hashes)
+}
+inline ::std::string* PbftCompactEnv::add_tx_hashes() {
+  // @@protoc_insertion_point(field_add_mutable:protocol.PbftCompactEnv.tx_hashes)
+  return tx_hashes_.Add();
+}
+inline void PbftCompactEnv::add_tx_hashes(const ::std::string& value) {
+  tx_hashes_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add:protocol.PbftCompactEnv.tx_hashes)
+}
+inline void PbftCompactEnv::add_tx_hashes(const char* value) {
+  tx_hashes_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add_char:protocol.PbftCompactEnv.tx_hashes)
+}
+inline void PbftCompactEnv::add_tx_hashes(const void* value, size_t size) {
+  tx_hashes_.Add()->assign(reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_add_pointer:protocol.PbftCompactEnv.tx_hashes)
+}
+inline const ::google::protobuf::RepeatedPtrField< ::std::string>&
+PbftCompactEnv::tx_hashes() const {
+  // @@protoc_insertion_point(field_list:protocol.PbftCompactEnv.tx_hashes)
+  return tx_hashes_;
+}
+inline ::google::protobuf::RepeatedPtrField< ::std::string>*
+PbftCompactEnv::mutable_tx_hashes() {
+  // @@protoc_insertion_point(field_mutable_list:protocol.PbftCompactEnv.tx_hashes)
+  return &tx_hashes_;
+}
+
+// -------------------------------------------------------------------
+
+// GetPbftTxs
+
+// optional bytes value_digest = 1;
+inline void GetPbftTxs::clear_value_digest() {
+  value_digest_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline const ::std::string& GetPbftTxs::value_digest() const {
+  // @@protoc_insertion_point(field_get:protocol.GetPbftTxs.value_digest)
+  return value_digest_.GetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void GetPbftTxs::set_value_digest(const ::std::string& value) {
+  
+  value_digest_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:protocol.GetPbftTxs.value_digest)
+}
+inline void GetPbftTxs::set_value_digest(const char* value) {
+  
+  value_digest_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:protocol.GetPbftTxs.value_digest)
+}
+inline void GetPbftTxs::set_value_digest(const void* value, size_t size) {
+  
+  value_digest_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:protocol.GetPbftTxs.value_digest)
+}
+inline ::std::string* GetPbftTxs::mutable_value_digest() {
+  
+  // @@protoc_insertion_point(field_mutable:protocol.GetPbftTxs.value_digest)
+  return value_digest_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline ::std::string* GetPbftTxs::release_value_digest() {
+  // @@protoc_insertion_point(field_release:protocol.GetPbftTxs.value_digest)
+  
+  return value_digest_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void GetPbftTxs::set_allocated_value_digest(::std::string* value_digest) {
+  if (value_digest != NULL) {
+    
+  } else {
+    
+  }
+  value_digest_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value_digest);
+  // @@protoc_insertion_point(field_set_allocated:protocol.GetPbftTxs.value_digest)
+}
+
+// repeated int32 indexes = 2;
+inline int GetPbftTxs::indexes_size() const {
+  return indexes_.size();
+}
+inline void GetPbftTxs::clear_indexes() {
+  indexes_.Clear();
+}
+inline ::google::protobuf::int32 GetPbftTxs::indexes(int index) const {
+  // @@protoc_insertion_point(field_get:protocol.GetPbftTxs.indexes)
+  return indexes_.Get(index);
+}
+inline void GetPbftTxs::set_indexes(int index, ::google::protobuf::int32 value) {
+  indexes_.Set(index, value);
+  // @@protoc_insertion_point(field_set:protocol.GetPbftTxs.indexes)
+}
+inline void GetPbftTxs::add_indexes(::google::protobuf::int32 value) {
+  indexes_.Add(value);
+  // @@protoc_insertion_point(field_add:protocol.GetPbftTxs.indexes)
+}
+inline const ::google::protobuf::RepeatedField< ::google::protobuf::int32 >&
+GetPbftTxs::indexes() const {
+  // @@protoc_insertion_point(field_list:protocol.GetPbftTxs.indexes)
+  return indexes_;
+}
+inline ::google::protobuf::RepeatedField< ::google::protobuf::int32 >*
+GetPbftTxs::mutable_indexes() {
+  // @@protoc_insertion_point(field_mutable_list:protocol.GetPbftTxs.indexes)
+  return &indexes_;
+}
+
+// -------------------------------------------------------------------
+
+// PbftTxs
+
+// optional bytes value_digest = 1;
+inline void PbftTxs::clear_value_digest() {
+  value_digest_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline const ::std::string& PbftTxs::value_digest() const {
+  // @@protoc_insertion_point(field_get:protocol.PbftTxs.value_digest)
+  return value_digest_.GetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void PbftTxs::set_value_digest(const ::std::string& value) {
+  
+  value_digest_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:protocol.PbftTxs.value_digest)
+}
+inline void PbftTxs::set_value_digest(const char* value) {
+  
+  value_digest_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:protocol.PbftTxs.value_digest)
+}
+inline void PbftTxs::set_value_digest(const void* value, size_t size) {
+  
+  value_digest_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:protocol.PbftTxs.value_digest)
+}
+inline ::std::string* PbftTxs::mutable_value_digest() {
+  
+  // @@protoc_insertion_point(field_mutable:protocol.PbftTxs.value_digest)
+  return value_digest_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline ::std::string* PbftTxs::release_value_digest() {
+  // @@protoc_insertion_point(field_release:protocol.PbftTxs.value_digest)
+  
+  return value_digest_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void PbftTxs::set_allocated_value_digest(::std::string* value_digest) {
+  if (value_digest != NULL) {
+    
+  } else {
+    
+  }
+  value_digest_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value_digest);
+  // @@protoc_insertion_point(field_set_allocated:protocol.PbftTxs.value_digest)
+}
+
+// repeated int32 indexes = 2;
+inline int PbftTxs::indexes_size() const {
+  return indexes_.size();
+}
+inline void PbftTxs::clear_indexes() {
+  indexes_.Clear();
+}
+inline ::google::protobuf::int32 PbftTxs::indexes(int index) const {
+  // @@protoc_insertion_point(field_get:protocol.PbftTxs.indexes)
+  return indexes_.Get(index);
+}
+inline void PbftTxs::set_indexes(int index, ::google::protobuf::int32 value) {
+  indexes_.Set(index, value);
+  // @@protoc_insertion_point(field_set:protocol.PbftTxs.indexes)
+}
+inline void PbftTxs::add_indexes(::google::protobuf::int32 value) {
+  indexes_.Add(value);
+  // @@protoc_insertion_point(field_add:protocol.PbftTxs.indexes)
+}
+inline const ::google::protobuf::RepeatedField< ::google::protobuf::int32 >&
+PbftTxs::indexes() const {
+  // @@protoc_insertion_point(field_list:protocol.PbftTxs.indexes)
+  return indexes_;
+}
+inline ::google::protobuf::RepeatedField< ::google::protobuf::int32 >*
+PbftTxs::mutable_indexes() {
+  // @@protoc_insertion_point(field_mutable_list:protocol.PbftTxs.indexes)
+  return &indexes_;
+}
+
+// repeated .protocol.TransactionEnv txs = 3;
+inline int PbftTxs::txs_size() const {
+  return txs_.size();
+}
+inline void PbftTxs::clear_txs() {
+  txs_.Clear();
+}
+inline const ::protocol::TransactionEnv& PbftTxs::txs(int index) const {
+  // @@protoc_insertion_point(field_get:protocol.PbftTxs.txs)
+  return txs_.Get(index);
+}
+inline ::protocol::TransactionEnv* PbftTxs::mutable_txs(int index) {
+  // @@protoc_insertion_point(field_mutable:protocol.PbftTxs.txs)
+  return txs_.Mutable(index);
+}
+inline ::protocol::TransactionEnv* PbftTxs::add_txs() {
+  // @@protoc_insertion_point(field_add:protocol.PbftTxs.txs)
+  return txs_.Add();
+}
+inline ::google::protobuf::RepeatedPtrField< ::protocol::TransactionEnv >*
+PbftTxs::mutable_txs() {
+  // @@protoc_insertion_point(field_mutable_list:protocol.PbftTxs.txs)
+  return &txs_;
+}
+inline const ::google::protobuf::RepeatedPtrField< ::protocol::TransactionEnv >&
+PbftTxs::txs() const {
+  // @@protoc_insertion_point(field_list:protocol.PbftTxs.txs)
+  return txs_;
+}
+
+// -------------------------------------------------------------------
+
+// TransactionInv
+
+// repeated bytes hashes = 1;
+inline int TransactionInv::hashes_size() const {
+  return hashes_.size();
+}
+inline void TransactionInv::clear_hashes() {
+  hashes_.Clear();
+}
+inline const ::std::string& TransactionInv::hashes(int index) const {
+  // @@protoc_insertion_point(field_get:protocol.TransactionInv.hashes)
+  return hashes_.Get(index);
+}
+inline ::std::string* TransactionInv::mutable_hashes(int index) {
+  // @@protoc_insertion_point(field_mutable:protocol.TransactionInv.hashes)
+  return hashes_.Mutable(index);
+}
+inline void TransactionInv::set_hashes(int index, const ::std::string& value) {
+  // @@protoc_insertion_point(field_set:protocol.TransactionInv.hashes)
+  hashes_.Mutable(index)->assign(value);
+}
+inline void TransactionInv::set_hashes(int index, const char* value) {
+  hashes_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set_char:protocol.TransactionInv.hashes)
+}
+inline void TransactionInv::set_hashes(int index, const void* value, size_t size) {
+  hashes_.Mutable(index)->assign(
+    reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_set_pointer:protocol.TransactionInv.hashes)
+}
+inline ::std::string* TransactionInv::add_hashes() {
+  // @@protoc_insertion_point(field_add_mutable:protocol.TransactionInv.hashes)
+  return hashes_.Add();
+}
+inline void TransactionInv::add_hashes(const ::std::string& value) {
+  hashes_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add:protocol.TransactionInv.hashes)
+}
+inline void TransactionInv::add_hashes(const char* value) {
+  hashes_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add_char:protocol.TransactionInv.hashes)
+}
+inline void TransactionInv::add_hashes(const void* value, size_t size) {
+  hashes_.Add()->assign(reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_add_pointer:protocol.TransactionInv.hashes)
+}
+inline const ::google::protobuf::RepeatedPtrField< ::std::string>&
+TransactionInv::hashes() const {
+  // @@protoc_insertion_point(field_list:protocol.TransactionInv.hashes)
+  return hashes_;
+}
+inline ::google::protobuf::RepeatedPtrField< ::std::string>*
+TransactionInv::mutable_hashes() {
+  // @@protoc_insertion_point(field_mutable_list:protocol.TransactionInv.hashes)
+  return &hashes_;
+}
+
+// -------------------------------------------------------------------
+
 // EntryList
 
 // repeated bytes entry = 1;
@@ -3311,6 +4113,14 @@ inline void ChainTxStatus::set_timestamp(::google::protobuf::int64 value) {
 
 // -------------------------------------------------------------------
 
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
@@ -0,0 +1,454 @@
+//Checks that the parallel executor is deterministic. Random ledgers of payments, asset payments and metadata
+//are applied in the propose mode once serially and once in parallel over the same state in a temporary database,
+//the dropped transactions, the results, the total fee and the account tree hash must be the same.
+//Usage: rexx_parallel_check [rounds] [txs per ledger] [accounts] [seed] [threads] [path]
+
+#include <random>
+#include <utils/headers.h>
+#include <common/general.h>
+#include <common/storage.h>
+#include <common/private_key.h>
+#include <ledger/ledger_manager.h>
+#include <ledger/parallel_executor.h>
+#include <main/configure.h>
+
+namespace rexx {
+
+	class ParallelCheck {
+	public:
+		struct Outcome {
+			std::set<int32_t> dropped_;
+			std::string validation_;
+			std::vector<int32_t> codes_;
+			int64_t total_fee_;
+			std::string hash_;
+		};
+
+		ParallelCheck(uint32_t seed, size_t account_count, size_t batch_size);
+		~ParallelCheck();
+
+		//Create the accounts, each of them issues the asset paid in the rounds
+		bool Initialize();
+		bool Round(int64_t round, size_t tx_count);
+
+	private:
+		int64_t Rand(int64_t n);
+		bool Chance(int32_t percent);
+		size_t RandAccount();
+
+		bool Fund(size_t index, int64_t balance);
+		bool Write();
+		bool LoadAccounts();
+
+		protocol::TransactionEnv NewTransaction(size_t source, size_t &dest, bool issue);
+		bool Apply(const protocol::ConsensusValue &value, bool parallel, KVTrie *trie, Outcome &outcome);
+		bool Compare(int64_t round, const Outcome &serial, const Outcome &parallel);
+
+		std::mt19937_64 rand_;
+		std::vector<std::shared_ptr<PrivateKey>> keys_;
+		std::vector<int64_t> nonces_; //the last nonce used by each account
+		std::vector<int64_t> balances_; //the balances before the round
+		size_t whale_count_; //accounts paying fee limits near the int64 range, two of them overflow the total fee
+		size_t batch_size_;
+		int64_t gas_price_;
+		int64_t base_reserve_;
+	};
+
+	static const std::string ASSET_CODE = "RX";
+	static const int64_t ACCOUNT_BALANCE = 1000000000000000;
+	static const int64_t WHALE_BALANCE = 8000000000000000000;
+
+	ParallelCheck::ParallelCheck(uint32_t seed, size_t account_count, size_t batch_size) :
+		rand_(seed),
+		whale_count_(2),
+		batch_size_(batch_size),
+		gas_price_(0),
+		base_reserve_(0) {
+		for (size_t i = 0; i < account_count + whale_count_; i++) {
+			keys_.push_back(std::make_shared<PrivateKey>(SIGNTYPE_ED25519));
+		}
+		nonces_.resize(keys_.size(), 0);
+		balances_.resize(keys_.size(), 0);
+	}
+
+	ParallelCheck::~ParallelCheck() {}
+
+	int64_t ParallelCheck::Rand(int64_t n) {
+		return (int64_t)(rand_() % (uint64_t)n);
+	}
+
+	bool ParallelCheck::Chance(int32_t percent) {
+		return Rand(100) < percent;
+	}
+
+	size_t ParallelCheck::RandAccount() {
+		return (size_t)Rand(keys_.size());
+	}
+
+	bool ParallelCheck::Initialize() {
+		gas_price_ = LedgerManager::Instance().GetCurFeeConfig().gas_price();
+		base_reserve_ = LedgerManager::Instance().GetCurFeeConfig().base_reserve();
+		for (size_t i = 0; i < keys_.size(); i++) {
+			if (!Fund(i, i < whale_count_ ? WHALE_BALANCE : ACCOUNT_BALANCE)) {
+				return false;
+			}
+		}
+
+		if (!Write() || !LoadAccounts()) {
+			return false;
+		}
+
+		//The issues are not executed in parallel, the ledger is still compared
+		protocol::ConsensusValue value;
+		value.set_ledger_seq(2);
+		value.set_close_time(utils::Timestamp::HighResolution());
+		for (size_t i = 0; i < keys_.size(); i++) {
+			size_t dest = 0;
+			*value.mutable_txset()->add_txs() = NewTransaction(i, dest, true);
+		}
+
+		KVTrie trie;
+		trie.Init(Storage::Instance().account_db(), std::make_shared<WRITE_BATCH>(), General::ACCOUNT_PREFIX, 4);
+		Outcome serial, parallel;
+		if (!Apply(value, true, &trie, parallel) || !Apply(value, false, LedgerManager::Instance().tree_, serial)) {
+			return false;
+		}
+
+		return Compare(0, serial, parallel) && Write();
+	}
+
+	bool ParallelCheck::Fund(size_t index, int64_t balance) {
+		std::string address = keys_[index]->GetEncAddress();
+		AccountFrm::pointer account;
+		if (!Environment::AccountFromDB(address, account)) {
+			account = AccountFrm::CreatAccountFrm(address, balance);
+		}
+		account->GetProtoAccount().set_balance(balance);
+		LedgerManager::Instance().tree_->Set(DecodeAddress(address), account->Serializer());
+		return true;
+	}
+
+	bool ParallelCheck::Write() {
+		LedgerManager &manager = LedgerManager::Instance();
+		manager.tree_->UpdateHash();
+		WRITE_BATCH ledger_batch;
+		if (!Storage::Instance().WriteLedger(1, ledger_batch, *manager.tree_->batch_, [&manager]() { manager.trie_cache_.InvalidateDirty(); })) {
+			LOG_ERROR("Failed to write the accounts");
+			return false;
+		}
+		manager.tree_->batch_ = std::make_shared<WRITE_BATCH>();
+		return true;
+	}
+
+	bool ParallelCheck::LoadAccounts() {
+		for (size_t i = 0; i < keys_.size(); i++) {
+			AccountFrm::pointer account;
+			if (!Environment::AccountFromDB(keys_[i]->GetEncAddress(), account)) {
+				LOG_ERROR("Failed to load account(%s)", keys_[i]->GetEncAddress().c_str());
+				return false;
+			}
+			nonces_[i] = account->GetAccountNonce();
+			balances_[i] = account->GetAccountBalance();
+		}
+		return true;
+	}
+
+	protocol::TransactionEnv ParallelCheck::NewTransaction(size_t source, size_t &dest, bool issue) {
+		protocol::TransactionEnv env;
+		protocol::Transaction *tx = env.mutable_transaction();
+		tx->set_source_address(keys_[source]->GetEncAddress());
+		tx->set_gas_price(gas_price_);
+
+		//A replayed nonce or a gap drops the transaction, and the later ones of the source in the ledger
+		if (Chance(3)) {
+			tx->set_nonce(Chance(50) ? nonces_[source] : nonces_[source] + 2);
+		}
+		else {
+			tx->set_nonce(++nonces_[source]);
+		}
+
+		//Fee limits at the edge of the balance of the ledger before, earlier payments of the ledger move the edge
+		int64_t fee_limit = gas_price_ * 1000000;
+		if (source < whale_count_) {
+			fee_limit = balances_[source] - base_reserve_ - Rand(1000);
+		}
+		else if (Chance(3)) {
+			fee_limit = balances_[source] - base_reserve_;
+		}
+		else if (Chance(3)) {
+			fee_limit = balances_[source] - base_reserve_ + 1;
+		}
+		tx->set_fee_limit(fee_limit);
+
+		std::set<size_t> signers;
+		signers.insert(source);
+		int64_t op_count = issue ? 1 : 1 + (Chance(20) ? Rand(3) : 0);
+		for (int64_t i = 0; i < op_count; i++) {
+			protocol::Operation *op = tx->add_operations();
+
+			//An operation of another account, without its signature the transaction fails
+			if (!issue && Chance(5)) {
+				size_t op_source = RandAccount();
+				op->set_source_address(keys_[op_source]->GetEncAddress());
+				if (Chance(70)) {
+					signers.insert(op_source);
+				}
+			}
+
+			int64_t type = issue ? -1 : Rand(100);
+			dest = RandAccount();
+			if (type < 0 || type >= 98) {
+				op->set_type(protocol::Operation_Type_ISSUE_ASSET);
+				op->mutable_issue_asset()->set_code(ASSET_CODE);
+				op->mutable_issue_asset()->set_amount(1000000000);
+			}
+			else if (type < 55) {
+				op->set_type(protocol::Operation_Type_PAY_COIN);
+				protocol::OperationPayCoin *pay_coin = op->mutable_pay_coin();
+				if (Chance(5)) {
+					pay_coin->set_dest_address(PrivateKey(SIGNTYPE_ED25519).GetEncAddress());
+					pay_coin->set_amount(base_reserve_ + Rand(2) - 1);
+				}
+				else {
+					pay_coin->set_dest_address(keys_[dest]->GetEncAddress());
+					pay_coin->set_amount(Chance(3) ? balances_[source] : 1 + Rand(1000000));
+				}
+			}
+			else if (type < 80) {
+				op->set_type(protocol::Operation_Type_PAY_ASSET);
+				protocol::OperationPayAsset *pay_asset = op->mutable_pay_asset();
+				pay_asset->set_dest_address(keys_[dest]->GetEncAddress());
+				pay_asset->mutable_asset()->mutable_key()->set_issuer(keys_[RandAccount()]->GetEncAddress());
+				pay_asset->mutable_asset()->mutable_key()->set_code(ASSET_CODE);
+				pay_asset->mutable_asset()->set_amount(1 + Rand(Chance(3) ? 2000000000 : 1000));
+			}
+			else {
+				op->set_type(protocol::Operation_Type_SET_METADATA);
+				protocol::OperationSetMetadata *set_metadata = op->mutable_set_metadata();
+				set_metadata->set_key(utils::String::Format("key%d", (int32_t)Rand(4)));
+				set_metadata->set_value(utils::String::Format(FMT_I64, Rand(1000000)));
+				set_metadata->set_delete_flag(Chance(10));
+			}
+		}
+
+		std::string content = tx->SerializeAsString();
+		for (std::set<size_t>::iterator iter = signers.begin(); iter != signers.end(); iter++) {
+			protocol::Signature *signature = env.add_signatures();
+			signature->set_public_key(keys_[*iter]->GetEncPublicKey());
+			signature->set_sign_data(keys_[*iter]->Sign(content));
+		}
+		return env;
+	}
+
+	bool ParallelCheck::Apply(const protocol::ConsensusValue &value, bool parallel, KVTrie *trie, Outcome &outcome) {
+		Configure::Instance().ledger_configure_.parallel_batch_size_ = parallel ? batch_size_ : 1;
+
+		LedgerContext context(HashWrapper::Crypto(value.SerializeAsString()), value);
+		LedgerFrm::pointer ledger = context.closing_ledger_;
+		ledger->ProtoLedger().mutable_header()->set_seq(value.ledger_seq());
+		ProposeTxsResult result;
+		if (!ledger->ApplyPropose(value, &context, result)) {
+			LOG_ERROR("Failed to apply the ledger %s", parallel ? "in parallel" : "serially");
+			return false;
+		}
+
+		outcome.dropped_ = result.need_dropped_tx_;
+		outcome.validation_ = result.cons_validation_.SerializeAsString();
+		outcome.codes_.clear();
+		for (size_t i = 0; i < ledger->apply_tx_frms_.size(); i++) {
+			outcome.codes_.push_back(ledger->apply_tx_frms_[i]->GetResult().code());
+		}
+		outcome.total_fee_ = ledger->total_fee_;
+
+		int64_t new_count = 0, change_count = 0;
+		ledger->Commit(trie, new_count, change_count);
+		trie->UpdateHash();
+		outcome.hash_ = trie->GetRootHash();
+		return true;
+	}
+
+	bool ParallelCheck::Compare(int64_t round, const Outcome &serial, const Outcome &parallel) {
+		bool same = true;
+		if (serial.dropped_ != parallel.dropped_) {
+			printf("round " FMT_I64 ": dropped " FMT_SIZE " transactions serially, " FMT_SIZE " in parallel\n",
+				round, serial.dropped_.size(), parallel.dropped_.size());
+			same = false;
+		}
+
+		if (serial.validation_ != parallel.validation_) {
+			printf("round " FMT_I64 ": the validations are different\n", round);
+			same = false;
+		}
+
+		if (serial.codes_.size() != parallel.codes_.size()) {
+			printf("round " FMT_I64 ": applied " FMT_SIZE " transactions serially, " FMT_SIZE " in parallel\n",
+				round, serial.codes_.size(), parallel.codes_.size());
+			same = false;
+		}
+		else {
+			for (size_t i = 0; i < serial.codes_.size(); i++) {
+				if (serial.codes_[i] != parallel.codes_[i]) {
+					printf("round " FMT_I64 ": transaction " FMT_SIZE " has result %d serially, %d in parallel\n",
+						round, i, serial.codes_[i], parallel.codes_[i]);
+					same = false;
+				}
+			}
+		}
+
+		if (serial.total_fee_ != parallel.total_fee_) {
+			printf("round " FMT_I64 ": total fee " FMT_I64 " serially, " FMT_I64 " in parallel\n",
+				round, serial.total_fee_, parallel.total_fee_);
+			same = false;
+		}
+
+		if (serial.hash_ != parallel.hash_) {
+			printf("round " FMT_I64 ": account tree hash %s serially, %s in parallel\n", round,
+				utils::String::BinToHexString(serial.hash_).c_str(), utils::String::BinToHexString(parallel.hash_).c_str());
+			same = false;
+		}
+		return same;
+	}
+
+	bool ParallelCheck::Round(int64_t round, size_t tx_count) {
+		//The whales are funded again, failed transactions keep the fee limits they paid
+		for (size_t i = 0; i < whale_count_; i++) {
+			if (!Fund(i, WHALE_BALANCE)) {
+				return false;
+			}
+		}
+
+		if (!Write() || !LoadAccounts()) {
+			return false;
+		}
+
+		//Every ledger follows the genesis one, so that the reward goes to its validators
+		protocol::ConsensusValue value;
+		value.set_ledger_seq(2);
+		value.set_close_time(utils::Timestamp::HighResolution());
+		size_t source = RandAccount(), dest = 0;
+		for (size_t i = 0; i < tx_count; i++) {
+			//The same source again or the destination of the last payment, so that the transactions conflict
+			if (i > 0 && !Chance(40)) {
+				source = Chance(50) ? dest : RandAccount();
+			}
+			*value.mutable_txset()->add_txs() = NewTransaction(source, dest, false);
+		}
+
+		//The parallel run first, the serial one changes the account tree of the ledger manager
+		KVTrie trie;
+		trie.Init(Storage::Instance().account_db(), std::make_shared<WRITE_BATCH>(), General::ACCOUNT_PREFIX, 4);
+		Outcome serial, parallel;
+		if (!Apply(value, true, &trie, parallel) || !Apply(value, false, LedgerManager::Instance().tree_, serial)) {
+			return false;
+		}
+
+		return Compare(round, serial, parallel) && Write();
+	}
+}
+
+int main(int argc, char *argv[]) {
+	int64_t rounds = argc > 1 ? utils::String::Stoi64(argv[1]) : 100;
+	size_t tx_count = argc > 2 ? (size_t)utils::String::Stoi64(argv[2]) : 500;
+	size_t account_count = argc > 3 ? (size_t)utils::String::Stoi64(argv[3]) : 50;
+	uint32_t seed = argc > 4 ? (uint32_t)utils::String::Stoi64(argv[4]) : (uint32_t)time(NULL);
+	uint32_t thread_count = argc > 5 ? (uint32_t)utils::String::Stoi64(argv[5]) : 4;
+	std::string path = argc > 6 ? argv[6] : utils::String::Format("%s/rexx_parallel_check", utils::File::GetTempDirectory().c_str());
+	if (rounds <= 0 || tx_count == 0 || account_count < 2 || thread_count == 0) {
+		printf("Usage: %s [rounds] [txs per ledger] [accounts >= 2] [seed] [threads > 0] [path]\n", argv[0]);
+		return 1;
+	}
+
+	utils::Thread::SetCurrentThreadName("parallel-check");
+	utils::OpenSslLock::Initialize();
+	utils::Timer::InitInstance();
+	rexx::Configure::InitInstance();
+	rexx::Storage::InitInstance();
+	rexx::Global::InitInstance();
+	utils::Logger::InitInstance();
+	rexx::LedgerManager::InitInstance();
+
+	bool same = false;
+	do {
+		utils::ObjectExit object_exit;
+		rexx::StatusModule::modules_status_ = new Json::Value;
+
+		if (utils::File::IsExist(path) && !utils::File::DeleteFolder(path)) {
+			printf("Failed to delete the directory(%s)\n", path.c_str());
+			break;
+		}
+		if (!utils::File::CreateDir(path)) {
+			printf("Failed to create the directory(%s)\n", path.c_str());
+			break;
+		}
+
+		//The failed transactions log errors, they go to the file
+		utils::Logger &logger = utils::Logger::Instance();
+		if (!logger.Initialize(utils::LOG_DEST_FILE, (utils::LogLevel)(utils::LOG_LEVEL_WARN | utils::LOG_LEVEL_ERROR | utils::LOG_LEVEL_FATAL),
+			utils::String::Format("%s/parallel_check.log", path.c_str()), true)) {
+			printf("Failed to initialize logger\n");
+			break;
+		}
+		object_exit.Push(std::bind(&utils::Logger::Exit, &logger));
+
+		//The default configuration with the fees of the single node one and a database of its own
+		rexx::Configure &config = rexx::Configure::Instance();
+		config.db_configure_.keyvalue_db_path_ = path + "/keyvalue.db";
+		config.db_configure_.ledger_db_path_ = path + "/ledger.db";
+		config.db_configure_.account_db_path_ = path + "/account.db";
+		config.db_configure_.unified_db_path_ = path + "/unified.db";
+		config.ledger_configure_.use_atom_map_ = true;
+		config.ledger_configure_.parallel_thread_count_ = thread_count;
+		config.ledger_configure_.parallel_verify_ = false;
+		size_t batch_size = config.ledger_configure_.parallel_batch_size_ > 1 ? config.ledger_configure_.parallel_batch_size_ : 64;
+		rexx::PrivateKey genesis(rexx::SIGNTYPE_ED25519), validator(rexx::SIGNTYPE_ED25519);
+		config.genesis_configure_.fees_.gas_price_ = 1000;
+		config.genesis_configure_.fees_.base_reserve_ = 10000000;
+		config.genesis_configure_.account_ = genesis.GetEncAddress();
+		config.genesis_configure_.validators_.clear();
+		config.genesis_configure_.validators_.push_back(validator.GetEncAddress());
+
+		rexx::Storage &storage = rexx::Storage::Instance();
+		if (!storage.Initialize(config.db_configure_, false)) {
+			printf("Failed to initialize database\n");
+			break;
+		}
+		object_exit.Push(std::bind(&rexx::Storage::Exit, &storage));
+
+		rexx::LedgerManager &ledger_manager = rexx::LedgerManager::Instance();
+		if (!ledger_manager.Initialize()) {
+			printf("Failed to initialize ledger manager\n");
+			break;
+		}
+		object_exit.Push(std::bind(&rexx::LedgerManager::Exit, &ledger_manager));
+
+		printf("Checking " FMT_I64 " ledgers of " FMT_SIZE " transactions over " FMT_SIZE " accounts, seed %u, %u threads, batch size " FMT_SIZE "\n",
+			rounds, tx_count, account_count, seed, thread_count, batch_size);
+		rexx::ParallelCheck check(seed, account_count, batch_size);
+		same = check.Initialize();
+		for (int64_t i = 1; i <= rounds && same; i++) {
+			same = check.Round(i, tx_count);
+		}
+
+		Json::Value status;
+		rexx::ParallelExecutor::GetModuleStatus(status);
+		printf("%s", status.toStyledString().c_str());
+		if (same && status["speculated_count"].asInt64() == 0) {
+			printf("No transaction was executed in parallel\n");
+			same = false;
+		}
+	} while (false);
+
+	if (same) {
+		utils::File::DeleteFolder(path);
+	}
+	printf("%s, seed %u\n", same ? "PASS" : "FAIL", seed);
+
+	rexx::LedgerManager::ExitInstance();
+	utils::Logger::ExitInstance();
+	rexx::Global::ExitInstance();
+	rexx::Storage::ExitInstance();
+	rexx::Configure::ExitInstance();
+	utils::Timer::ExitInstance();
+	delete rexx::StatusModule::modules_status_;
+	return same ? 0 : 1;
+}
@@ -2,6 +2,7 @@
 #define TEMPLATE_ATOMIC_MAP_H
 
 #include <map>
+#include <vector>
 #include <string>
 #include <memory>
 #include <exception>
@@ -180,33 +181,68 @@ namespace rexx
 		}
 
 	private:
-		bool CopyCommit()
+		struct UndoValue
 		{
-			mapKV copyBuf = *data_;
+			KEY key_;
+			bool exist_;
+			ActValue value_;
+			UndoValue(const KEY& key, bool exist, const ActValue& value) :key_(key), exist_(exist), value_(value){}
+		};
+		typedef std::vector<UndoValue> undoLog;
+
+		//Put the previous entries back in reverse order, so data_ ends up as it was before the commit.
+		void Rollback(undoLog& undo)
+		{
+			for (auto it = undo.rbegin(); it != undo.rend(); it++)
+			{
+				if (it->exist_)
+					(*data_)[it->key_] = it->value_;
+				else
+					data_->erase(it->key_);
+			}
+			undo.clear();
+		}
+
+		//Apply only the entries of actionBuf_ to data_, recording what each one replaces.
+		bool JournalCommit()
+		{
+			undoLog undo;
 			try
 			{
-				for (auto act : actionBuf_)
-					copyBuf[act.first] = act.second;
+				undo.reserve(actionBuf_.size());
+				for (auto& act : actionBuf_)
+				{
+					auto itData = data_->find(act.first);
+					if (itData != data_->end())
+					{
+						undo.push_back(UndoValue(act.first, true, itData->second));
+						itData->second = act.second;
+					}
+					else
+					{
+						undo.push_back(UndoValue(act.first, false, ActValue()));
+						data_->insert(std::make_pair(act.first, act.second));
+					}
+				}
 			}
 			catch (std::exception& e)
 			{
-				LOG_ERROR("Catched an copy exception, detail: %s", e.what());
+				LOG_ERROR("Catched an commit exception, detail: %s", e.what());
+				Rollback(undo);
 				actionBuf_.clear();
 				return false;
 			}
 
-			data_->swap(copyBuf);
-
-			//CAUTION: now the pointers in actionBuf_ and dataCopy_ are overlapped with data_,
+			//CAUTION: now the pointers in actionBuf_ are overlapped with data_,
 			//so it must be clear, otherwise the later modification to them will aslo directly act on data_.
-			actionBuf_.clear(); 
+			actionBuf_.clear();
 			return true;
 		}
 
 	public:
 		bool Commit()
 		{
-			return CopyCommit();
+			return JournalCommit();
 		}
 
 		//Call ClearChange to discard the modification if Commit failed
@@ -820,4 +820,25 @@ namespace utils {
 	}
 
 	AesCtr::~AesCtr() {}
+
+	std::vector<std::mutex> *OpenSslLock::mutexes_ = NULL;
+
+	bool OpenSslLock::Initialize() {
+		if (mutexes_ != NULL) {
+			return true;
+		}
+
+		mutexes_ = new std::vector<std::mutex>(CRYPTO_num_locks());
+		CRYPTO_set_locking_callback(OpenSslLock::Lock);
+		return true;
+	}
+
+	void OpenSslLock::Lock(int mode, int n, const char *file, int line) {
+		if (mode & CRYPTO_LOCK) {
+			(*mutexes_)[n].lock();
+		}
+		else {
+			(*mutexes_)[n].unlock();
+		}
+	}
 }
@@ -4,6 +4,7 @@
 
 #include <vector>
 #include <string>
+#include <mutex>
 
 #include <stdio.h>
 #include <string.h>
@@ -131,6 +132,16 @@ namespace utils {
 		static std::string CryptoHex(const std::string &input, const std::string &key);
 		static std::string HexDecrypto(const std::string &input, const std::string &key);
 	};
+
+	//OpenSSL 1.0 is only thread safe once the locking callbacks are set, the signature
+	//verifiers draw their batch randomness from RAND_bytes on several threads
+	class OpenSslLock {
+	public:
+		static bool Initialize();
+	private:
+		static void Lock(int mode, int n, const char *file, int line);
+		static std::vector<std::mutex> *mutexes_;
+	};
 }
 
 #endif //CRYPTO_H
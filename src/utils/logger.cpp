@@ -6,6 +6,76 @@
 #include "strings.h"
 #include "logger.h"
 
+namespace utils {
+	//Closes the ring of a thread when the thread ends
+	class LogRingHolder {
+	public:
+		LogRingHolder() : ring_(NULL) {}
+		~LogRingHolder() {
+			if (ring_ != NULL) {
+				ring_->Close();
+			}
+		}
+		LogRing *ring_;
+	};
+
+	static thread_local LogRingHolder thread_ring_;
+}
+
+utils::LogRing::LogRing(size_t capacity) : head_(0), tail_(0), closed_(false) {
+	size_t size = 1;
+	while (size < capacity) {
+		size <<= 1;
+	}
+	records_.resize(size);
+	mask_ = size - 1;
+}
+
+utils::LogRing::~LogRing() {}
+
+bool utils::LogRing::Push(LogLevel level, std::string &text) {
+	size_t tail = tail_.load(std::memory_order_relaxed);
+	if (tail - head_.load(std::memory_order_acquire) >= records_.size()) {
+		return false;
+	}
+
+	Record &record = records_[tail & mask_];
+	record.level_ = level;
+	record.text_.swap(text);
+	tail_.store(tail + 1, std::memory_order_release);
+	return true;
+}
+
+bool utils::LogRing::Pop(Record &record) {
+	size_t head = head_.load(std::memory_order_relaxed);
+	if (head == tail_.load(std::memory_order_acquire)) {
+		return false;
+	}
+
+	Record &slot = records_[head & mask_];
+	record.level_ = slot.level_;
+	record.text_.swap(slot.text_);
+	slot.text_.clear();
+	head_.store(head + 1, std::memory_order_release);
+	return true;
+}
+
+bool utils::LogRing::Empty() const {
+	return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+}
+
+size_t utils::LogRing::Capacity() const {
+	return records_.size();
+}
+
+void utils::LogRing::Close() {
+	closed_.store(true, std::memory_order_release);
+}
+
+bool utils::LogRing::IsClosed() const {
+	return closed_.load(std::memory_order_acquire);
+}
+
 utils::LogWriter::LogWriter() {
 	file_ptr_ = NULL;
 }
@@ -73,7 +143,30 @@ bool utils::LogWriter::Write(
 		return false;
 	}
 
-	if (dest_ == LOG_DEST_FILE) {
+	CheckRotate(logger, current_time);
+	if (file_ptr_ == NULL) {
+		return false;
+	}
+
+	fprintf(file_ptr_, "[%s - %s] <%lX> ", current_time, GetLogPrefix(logLevel).c_str(), utils::Thread::current_thread_id());
+	fprintf(file_ptr_, "%s(%d):", file, lineNum);
+	//fprintf(file_ptr_, "%s(%s:%d):", file, funcName, lineNum);
+	// under linux, va_list can't been reused
+#ifdef WIN32
+	vfprintf(file_ptr_, fmt, ap);
+#else
+	va_list copy_ap;
+	va_copy(copy_ap, ap);
+	vfprintf(file_ptr_, fmt, copy_ap);
+	va_end(copy_ap);
+#endif
+	fprintf(file_ptr_, "\n");
+	fflush(file_ptr_);
+	return true;
+}
+
+void utils::LogWriter::CheckRotate(Logger *logger, const char *current_time) {
+	if (dest_ == LOG_DEST_FILE && file_ptr_ != NULL) {
 		size_ = ftell64(file_ptr_);
 
 		if (size_ > logger->size_capacity_ || begin_time_ + logger->time_capacity_ <= time(NULL)) {
@@ -140,20 +233,51 @@ bool utils::LogWriter::Write(
 			}
 		}
 	}
+}
 
-	fprintf(file_ptr_, "[%s - %s] <%lX> ", current_time, GetLogPrefix(logLevel).c_str(), utils::Thread::current_thread_id());
-	fprintf(file_ptr_, "%s(%d):", file, lineNum);
-	//fprintf(file_ptr_, "%s(%s:%d):", file, funcName, lineNum);
-	// under linux, va_list can't been reused
-#ifdef WIN32
-	vfprintf(file_ptr_, fmt, ap);
-#else
+std::string utils::LogWriter::Format(const LogLevel logLevel,
+	const char *current_time,
+	const char* file, const int lineNum,
+	const char* fmt, va_list ap) {
+	std::string text = utils::String::Format("[%s - %s] <%lX> %s(%d):",
+		current_time, GetLogPrefix(logLevel).c_str(), utils::Thread::current_thread_id(), file, lineNum);
+
+	char buffer[1024];
 	va_list copy_ap;
 	va_copy(copy_ap, ap);
-	vfprintf(file_ptr_, fmt, copy_ap);
+	int size = vsnprintf(buffer, sizeof(buffer), fmt, copy_ap);
 	va_end(copy_ap);
-#endif
-	fprintf(file_ptr_, "\n");
+	if (size < 0) {
+		size = 0;
+	}
+
+	if ((size_t)size < sizeof(buffer)) {
+		text.append(buffer, size);
+	}
+	else {
+		std::string message;
+		message.resize(size + 1);
+		va_copy(copy_ap, ap);
+		vsnprintf(&message[0], message.size(), fmt, copy_ap);
+		va_end(copy_ap);
+		text.append(message.data(), size);
+	}
+	text += "\n";
+	return text;
+}
+
+bool utils::LogWriter::WriteData(Logger *logger, const std::string &data) {
+	if (file_ptr_ == NULL) {
+		utils::set_error_code(ERROR_NOT_READY);
+		return false;
+	}
+
+	CheckRotate(logger, utils::Timestamp::Now().Format(true).c_str());
+	if (file_ptr_ == NULL) {
+		return false;
+	}
+
+	fwrite(data.data(), 1, data.size(), file_ptr_);
 	fflush(file_ptr_);
 	return true;
 }
@@ -174,6 +298,12 @@ utils::Logger::Logger() {
 	size_capacity_ = 10 * utils::BYTES_PER_MEGA;
 	expire_days_ = 10;
 	m_nCheckRunLogTime = 0;
+	async_ = false;
+	overflow_ = LOG_OVERFLOW_DROP;
+	ring_size_ = 8192;
+	async_thread_ = NULL;
+	dropped_count_ = 0;
+	async_written_count_ = 0;
 }
 
 utils::Logger::~Logger() {}
@@ -218,12 +348,121 @@ bool utils::Logger::Initialize(utils::LogDest log_dest, utils::LogLevel log_leve
 }
 
 bool utils::Logger::Exit() {
+	if (async_thread_ != NULL) {
+		//Later records are written directly, the rings of living threads are left to them
+		async_ = false;
+		async_thread_->JoinWithStop();
+		delete async_thread_;
+		async_thread_ = NULL;
+		DrainRings();
+	}
+
 	for (size_t i = 0; i < utils::LOG_DEST_COUNT; i++) {
 		log_writers_[i].Close();
 	}
 	return true;
 }
 
+bool utils::Logger::StartAsync(size_t ring_size, LogOverflow overflow) {
+	if (async_thread_ != NULL) {
+		return true;
+	}
+
+	ring_size_ = ring_size > 0 ? ring_size : 1;
+	overflow_ = overflow;
+	async_thread_ = new utils::Thread(this);
+	async_ = true;
+	if (!async_thread_->Start("log-writer")) {
+		async_ = false;
+		delete async_thread_;
+		async_thread_ = NULL;
+		return false;
+	}
+	return true;
+}
+
+void utils::Logger::Run(utils::Thread *this_thread) {
+	while (this_thread->enabled()) {
+		if (DrainRings() == 0) {
+			utils::Sleep(1);
+		}
+	}
+}
+
+utils::LogRing *utils::Logger::GetThreadRing() {
+	if (thread_ring_.ring_ == NULL) {
+		LogRing *ring = new LogRing(ring_size_);
+		utils::MutexGuard guard(rings_mutex_);
+		rings_.push_back(ring);
+		thread_ring_.ring_ = ring;
+	}
+	return thread_ring_.ring_;
+}
+
+int utils::Logger::LogAsync(utils::LogLevel log_Level, const char *current_time,
+	const char* file, const int lineNum,
+	const char* fmt, va_list ap) {
+	std::string text = LogWriter::Format(log_Level, current_time, file, lineNum, fmt, ap);
+	LogRing *ring = GetThreadRing();
+	while (!ring->Push(log_Level, text)) {
+		if (overflow_ == LOG_OVERFLOW_DROP || !async_) {
+			dropped_count_++;
+			return 0;
+		}
+		utils::Sleep(1);
+	}
+	return 0;
+}
+
+size_t utils::Logger::DrainRings() {
+	size_t count = 0;
+	LogRing::Record record;
+	{
+		utils::MutexGuard guard(rings_mutex_);
+		for (auto iter = rings_.begin(); iter != rings_.end();) {
+			LogRing *ring = *iter;
+			//Read the flag first, whatever was pushed before closing is popped below
+			bool closed = ring->IsClosed();
+
+			//Bound the pass, so a busy thread can not hold the others back
+			for (size_t i = 0; i < ring->Capacity() && ring->Pop(record); i++) {
+				if (log_dest_ & LOG_DEST_FILE) {
+					batches_[record.level_ <= LOG_LEVEL_INFO ? LOG_DEST_FILE_OUT_ID : LOG_DEST_FILE_ERR_ID] += record.text_;
+				}
+
+				if (record.level_ < LOG_LEVEL_WARN && log_dest_ & LOG_DEST_OUT) {
+					batches_[LOG_DEST_OUT_ID] += record.text_;
+				}
+
+				if (record.level_ >= LOG_LEVEL_WARN && log_dest_ & LOG_DEST_ERR) {
+					batches_[LOG_DEST_ERR_ID] += record.text_;
+				}
+				count++;
+			}
+
+			if (closed && ring->Empty()) {
+				delete ring;
+				iter = rings_.erase(iter);
+			}
+			else {
+				iter++;
+			}
+		}
+	}
+
+	//Uncontended while async, Exit drains once more after direct writes are back
+	utils::MutexGuard guard(mutex_);
+	for (size_t i = 0; i < utils::LOG_DEST_COUNT; i++) {
+		if (!batches_[i].empty()) {
+			log_writers_[i].WriteData(this, batches_[i]);
+			batches_[i].clear();
+		}
+	}
+
+	async_written_count_ += count;
+	return count;
+}
+
 void utils::Logger::SetCapacity(uint32_t time_cap, uint64_t size_cap) {
 	time_capacity_ = time_cap;
 	size_capacity_ = size_cap;
@@ -282,14 +521,17 @@ int utils::Logger::LogStub(utils::LogLevel log_Level,
 	const char* fmt, va_list ap) {
 	int ret_val = 0;
 
-	if (log_Level != LOG_LEVEL_ALL && ((log_level_ & log_Level) == LOG_LEVEL_NONE)) {
+	if (!IsEnabled(log_Level)) {
 		return 0;
 	}
 
-	utils::MutexGuard _access_(mutex_);
-
 	std::string time_string = utils::Timestamp::Now().Format(true);
 	std::string file_name = utils::File::GetFileFromPath(file);
+	if (async_) {
+		return LogAsync(log_Level, time_string.c_str(), file_name.c_str(), lineNum, fmt, ap);
+	}
+
+	utils::MutexGuard _access_(mutex_);
 
 	if (log_dest_ & LOG_DEST_FILE) {
 		log_writers_[log_Level <= LOG_LEVEL_INFO ? LOG_DEST_FILE_OUT_ID : LOG_DEST_FILE_ERR_ID].Write(this, log_Level, time_string.c_str(),
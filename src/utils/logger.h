@@ -5,21 +5,24 @@
 #include "common.h"
 #include "singleton.h"
 #include "thread.h"
+#include <atomic>
+#include <list>
+#include <vector>
 
-#define LOG_TRACE(fmt, ...) utils::Logger::Instance().LogStubVm(utils::LOG_LEVEL_TRACE,__FILE__,__func__, __LINE__ , fmt , ## __VA_ARGS__)
-#define LOG_DEBUG(fmt, ...) utils::Logger::Instance().LogStubVm(utils::LOG_LEVEL_DEBUG,__FILE__,__func__, __LINE__ , fmt , ## __VA_ARGS__)
-#define LOG_INFO(fmt, ...) utils::Logger::Instance().LogStubVm(utils::LOG_LEVEL_INFO,__FILE__,__func__, __LINE__ , fmt , ## __VA_ARGS__)
-#define LOG_WARN(fmt, ...) utils::Logger::Instance().LogStubVm(utils::LOG_LEVEL_WARN,__FILE__,__func__, __LINE__ , fmt , ## __VA_ARGS__)
-#define LOG_ERROR(fmt, ...) utils::Logger::Instance().LogStubVm(utils::LOG_LEVEL_ERROR,__FILE__,__func__, __LINE__ , fmt , ## __VA_ARGS__)
-#define LOG_FATAL(fmt, ...) utils::Logger::Instance().LogStubVm(utils::LOG_LEVEL_FATAL,__FILE__,__func__, __LINE__ , fmt , ## __VA_ARGS__)
+#define LOG_TRACE(fmt, ...) (utils::Logger::Instance().IsEnabled(utils::LOG_LEVEL_TRACE) ? utils::Logger::Instance().LogStubVm(utils::LOG_LEVEL_TRACE,__FILE__,__func__, __LINE__ , fmt , ## __VA_ARGS__) : 0)
+#define LOG_DEBUG(fmt, ...) (utils::Logger::Instance().IsEnabled(utils::LOG_LEVEL_DEBUG) ? utils::Logger::Instance().LogStubVm(utils::LOG_LEVEL_DEBUG,__FILE__,__func__, __LINE__ , fmt , ## __VA_ARGS__) : 0)
+#define LOG_INFO(fmt, ...) (utils::Logger::Instance().IsEnabled(utils::LOG_LEVEL_INFO) ? utils::Logger::Instance().LogStubVm(utils::LOG_LEVEL_INFO,__FILE__,__func__, __LINE__ , fmt , ## __VA_ARGS__) : 0)
+#define LOG_WARN(fmt, ...) (utils::Logger::Instance().IsEnabled(utils::LOG_LEVEL_WARN) ? utils::Logger::Instance().LogStubVm(utils::LOG_LEVEL_WARN,__FILE__,__func__, __LINE__ , fmt , ## __VA_ARGS__) : 0)
+#define LOG_ERROR(fmt, ...) (utils::Logger::Instance().IsEnabled(utils::LOG_LEVEL_ERROR) ? utils::Logger::Instance().LogStubVm(utils::LOG_LEVEL_ERROR,__FILE__,__func__, __LINE__ , fmt , ## __VA_ARGS__) : 0)
+#define LOG_FATAL(fmt, ...) (utils::Logger::Instance().IsEnabled(utils::LOG_LEVEL_FATAL) ? utils::Logger::Instance().LogStubVm(utils::LOG_LEVEL_FATAL,__FILE__,__func__, __LINE__ , fmt , ## __VA_ARGS__) : 0)
 
 
-#define LOG_TRACE_ERRNO(fmt, ...) utils::Logger::Instance().LogStubVm(utils::LOG_LEVEL_TRACE,__FILE__,__func__, __LINE__ , fmt" (%u:%s)" , ## __VA_ARGS__)
-#define LOG_DEBUG_ERRNO(fmt, ...) utils::Logger::Instance().LogStubVm(utils::LOG_LEVEL_DEBUG,__FILE__,__func__, __LINE__ , fmt" (%u:%s)" , ## __VA_ARGS__)
-#define LOG_INFO_ERRNO(fmt, ...) utils::Logger::Instance().LogStubVm(utils::LOG_LEVEL_INFO,__FILE__,__func__, __LINE__ , fmt" (%u:%s)" , ## __VA_ARGS__)
-#define LOG_WARN_ERRNO(fmt, ...) utils::Logger::Instance().LogStubVm(utils::LOG_LEVEL_WARN,__FILE__,__func__, __LINE__ , fmt" (%u:%s)" , ## __VA_ARGS__)
-#define LOG_ERROR_ERRNO(fmt, ...) utils::Logger::Instance().LogStubVm(utils::LOG_LEVEL_ERROR,__FILE__,__func__, __LINE__ , fmt" (%u:%s)" , ## __VA_ARGS__)
-#define LOG_FATAL_ERRNO(fmt, ...) utils::Logger::Instance().LogStubVm(utils::LOG_LEVEL_FATAL,__FILE__,__func__, __LINE__ , fmt" (%u:%s)" , ## __VA_ARGS__)
+#define LOG_TRACE_ERRNO(fmt, ...) (utils::Logger::Instance().IsEnabled(utils::LOG_LEVEL_TRACE) ? utils::Logger::Instance().LogStubVm(utils::LOG_LEVEL_TRACE,__FILE__,__func__, __LINE__ , fmt" (%u:%s)" , ## __VA_ARGS__) : 0)
+#define LOG_DEBUG_ERRNO(fmt, ...) (utils::Logger::Instance().IsEnabled(utils::LOG_LEVEL_DEBUG) ? utils::Logger::Instance().LogStubVm(utils::LOG_LEVEL_DEBUG,__FILE__,__func__, __LINE__ , fmt" (%u:%s)" , ## __VA_ARGS__) : 0)
+#define LOG_INFO_ERRNO(fmt, ...) (utils::Logger::Instance().IsEnabled(utils::LOG_LEVEL_INFO) ? utils::Logger::Instance().LogStubVm(utils::LOG_LEVEL_INFO,__FILE__,__func__, __LINE__ , fmt" (%u:%s)" , ## __VA_ARGS__) : 0)
+#define LOG_WARN_ERRNO(fmt, ...) (utils::Logger::Instance().IsEnabled(utils::LOG_LEVEL_WARN) ? utils::Logger::Instance().LogStubVm(utils::LOG_LEVEL_WARN,__FILE__,__func__, __LINE__ , fmt" (%u:%s)" , ## __VA_ARGS__) : 0)
+#define LOG_ERROR_ERRNO(fmt, ...) (utils::Logger::Instance().IsEnabled(utils::LOG_LEVEL_ERROR) ? utils::Logger::Instance().LogStubVm(utils::LOG_LEVEL_ERROR,__FILE__,__func__, __LINE__ , fmt" (%u:%s)" , ## __VA_ARGS__) : 0)
+#define LOG_FATAL_ERRNO(fmt, ...) (utils::Logger::Instance().IsEnabled(utils::LOG_LEVEL_FATAL) ? utils::Logger::Instance().LogStubVm(utils::LOG_LEVEL_FATAL,__FILE__,__func__, __LINE__ , fmt" (%u:%s)" , ## __VA_ARGS__) : 0)
 
 
 #define LOG_STD_ERR(fmt, ...) utils::Logger::Instance().LogStubVmError(__FILE__,__func__, __LINE__ , fmt , ## __VA_ARGS__)
@@ -60,6 +63,42 @@ namespace utils {
 		LOG_LEVEL_ALL = 0xFF
 	}LogLevel;
 
+	typedef enum tagLogOverflow {
+		LOG_OVERFLOW_DROP = 0,
+		LOG_OVERFLOW_BLOCK = 1
+	}LogOverflow;
+
+	//Formatted records of one logging thread. The thread is the only writer and the async
+	//log writer the only reader, so neither side takes a lock.
+	class LogRing {
+	public:
+		struct Record {
+			LogLevel level_;
+			std::string text_;
+		};
+
+		//The capacity is rounded up to a power of two
+		explicit LogRing(size_t capacity);
+		~LogRing();
+
+		//The text is moved into the ring, return false if it is full
+		bool Push(LogLevel level, std::string &text);
+		bool Pop(Record &record);
+		bool Empty() const;
+		size_t Capacity() const;
+
+		//The owner thread has ended, the ring is freed once drained
+		void Close();
+		bool IsClosed() const;
+
+	private:
+		std::vector<Record> records_;
+		size_t mask_;
+		std::atomic<size_t> head_;
+		std::atomic<size_t> tail_;
+		std::atomic<bool> closed_;
+	};
+
 	class Logger;
 	class LogWriter {
 	private:
@@ -78,14 +117,25 @@ namespace utils {
 			const char *current_time,
 			const char* file, const char* funcName, const int lineNum,
 			const char* fmt, va_list ap);
+		//Write formatted records in one call
+		bool WriteData(Logger *logger, const std::string &data);
 		bool Close();
 		LogDest log_dest();
 
 		static std::string GetLogPrefix(const LogLevel logLevel);
+		//Format a record the same way as Write
+		static std::string Format(const LogLevel logLevel,
+			const char *current_time,
+			const char* file, const int lineNum,
+			const char* fmt, va_list ap);
+
+	private:
+		//Move the file to a backup when it exceeds the size or time capacity
+		void CheckRotate(Logger *logger, const char *current_time);
 
 	};
 
-	class Logger : public Singleton<Logger> {
+	class Logger : public Singleton<Logger>, public Runnable {
 		friend class Singleton<Logger>;
 		friend class LogWriter;
 	private:
@@ -96,6 +146,17 @@ namespace utils {
 		bool Initialize(utils::LogDest log_dest, utils::LogLevel log_level, const std::string &file_name, bool open_mode);
 		bool Exit();
 
+		//Move the writes to a background thread. Every logging thread queues its formatted records in a ring
+		//of ring_size records, and a full ring drops the record or waits for the writer by the overflow policy.
+		bool StartAsync(size_t ring_size, LogOverflow overflow);
+		bool IsAsync() const { return async_; }
+		int64_t GetDroppedCount() const { return dropped_count_; }
+		int64_t GetAsyncWrittenCount() const { return async_written_count_; }
+
+		bool IsEnabled(LogLevel log_level) const {
+			return log_level == LOG_LEVEL_ALL || (log_level_ & log_level) != LOG_LEVEL_NONE;
+		}
+
 		int LogStubVm(LogLevel logLevel,
 			const char* file,
 			const char* funcName, const int lineNum,
@@ -118,6 +179,16 @@ namespace utils {
 		void CheckExpiredLog();
 		bool GetBackupNameTime(const std::string &strBackupName, time_t &nTimeFrom, time_t &nTimeTo);
 
+	private:
+		virtual void Run(utils::Thread *this_thread) override;
+
+		int LogAsync(utils::LogLevel log_Level, const char *current_time,
+			const char* file, const int lineNum,
+			const char* fmt, va_list ap);
+		LogRing *GetThreadRing();
+		//Write what the rings hold in one batch per destination, return the number of records
+		size_t DrainRings();
+
 	private:
 		LogWriter log_writers_[LOG_DEST_COUNT];
 		LogLevel log_level_;
@@ -130,6 +201,17 @@ namespace utils {
 
 		std::string log_path_;
 		int64_t m_nCheckRunLogTime;
+
+		std::atomic<bool> async_;
+		LogOverflow overflow_;
+		size_t ring_size_;
+		utils::Thread *async_thread_;
+		utils::Mutex rings_mutex_;
+		std::list<LogRing *> rings_;
+		//Only touched by the async writer thread
+		std::string batches_[LOG_DEST_COUNT];
+		std::atomic<int64_t> dropped_count_;
+		std::atomic<int64_t> async_written_count_;
 	};
 
 }